@@ -703,6 +703,12 @@ gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
   return ConvertToStringExplicit(behaviorName);
 }
 
+gd::String EventsCodeGenerator::GenerateAllInstancesGetterCode(
+    const gd::String& objectName) {
+  return "runtimeContext->GetObjectsRawPointers(\"" +
+         ConvertToString(objectName) + "\")";
+}
+
 gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
     EventsCodeGenerationContext& context) {
   auto declareObjectList = [this](gd::String object,
@@ -738,9 +744,8 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
     gd::String objectListDeclaration = "";
     if (!context.ObjectAlreadyDeclared(object)) {
       objectListDeclaration = "std::vector<RuntimeObject*> " +
-                              GetObjectListName(object, context) +
-                              " = runtimeContext->GetObjectsRawPointers(\"" +
-                              ConvertToString(object) + "\");\n";
+                              GetObjectListName(object, context) + " = " +
+                              GenerateAllInstancesGetterCode(object) + ";\n";
       context.SetObjectDeclared(object);
     } else
       objectListDeclaration = declareObjectList(object, context);
@@ -377,6 +377,16 @@ class GD_CORE_API EventsCodeGenerator {
   virtual gd::String GetObjectListName(
       const gd::String& name, const gd::EventsCodeGenerationContext& context);
 
+  /**
+   * \brief Generate the code returning a list of all the instances of an
+   * object, used to declare the objects lists which are not yet declared.
+   *
+   * Default implementation calls runtimeContext->GetObjectsRawPointers
+   * with the name of the object.
+   */
+  virtual gd::String GenerateAllInstancesGetterCode(
+      const gd::String& objectName);
+
   /**
    * \brief Generate the code to notify the profiler of the beginning of a
    * section.
@@ -437,9 +447,9 @@ class GD_CORE_API EventsCodeGenerator {
    * <br><br>
    * Other standard parameters type that should be implemented by platforms:
    * - currentScene: Reference to the current runtime scene.
-   * - objectList : a map containing lists of objects which are specified by the
-  object name in another parameter. (C++: std::map <gd::String,
-  std::vector<RuntimeObject*> *>). Example:
+   * - objectList : lists of objects which are specified by the object name in
+  another parameter. (C++: a RuntimeObjectsLists, a view on the lists, passed as
+  const RuntimeObjectsLists &). Example:
    * \code
       AddExpression("Count", _("Object count"), _("Count the number of picked
   objects"), _("Objects"), "res/conditions/nbObjet.png")
@@ -17,6 +17,7 @@ void Polygon2d::Rotate(float angle) {
     vertices[i].x = t * cosa + vertices[i].y * sina;
     vertices[i].y = -t * sina + vertices[i].y * cosa;
   }
+  ComputeEdges();
 }
 
 void Polygon2d::Move(float x, float y) {
@@ -24,7 +24,8 @@ class GD_CORE_API Polygon2d {
 
   std::vector<sf::Vector2f> vertices;  ///< The vertices composing the polygon
   mutable std::vector<sf::Vector2f>
-      edges;  ///< Edges. Can be computed from vertices using ComputeEdges()
+      edges;  ///< Edges. Can be computed from vertices using ComputeEdges(),
+              ///< which must be called after changing the vertices directly.
 
   /**
    * \brief Get the vertices composing the polygon.
@@ -49,8 +50,8 @@ class GD_CORE_API Polygon2d {
    * \param angle Angle in radians
    *
    * \warning Rotation is made clockwise
-   * \warning edges vector is not updated, you have to call ComputeEdges if
-   * needed.
+   * \note Edges are updated, there is no need to call ComputeEdges after
+   * calling Rotate.
    */
   void Rotate(float angle);
 
@@ -114,7 +114,8 @@ void Sprite::SetCustomCollisionMask(
 #if !defined(EMSCRIPTEN)
 void Sprite::LoadImage(std::shared_ptr<SFMLTextureWrapper> image_) {
   sfmlImage = image_;
-  sfmlSprite.setTexture(sfmlImage->texture, true);
+  sfmlSprite.setTexture(sfmlImage->GetDrawableTexture());
+  sfmlSprite.setTextureRect(sfmlImage->GetDrawableTextureRect());
   hasItsOwnImage = false;
 
   if (automaticCentre)
@@ -124,9 +125,17 @@ void Sprite::LoadImage(std::shared_ptr<SFMLTextureWrapper> image_) {
 
 void Sprite::MakeSpriteOwnsItsImage() {
   if (!hasItsOwnImage || sfmlImage == std::shared_ptr<SFMLTextureWrapper>()) {
-    sfmlImage = std::make_shared<SFMLTextureWrapper>(
-        sfmlImage->texture);  // Copy the texture.
-    sfmlSprite.setTexture(sfmlImage->texture);
+    if (sfmlImage->atlas) {
+      // The image is in an atlas: create its own texture from the image.
+      auto ownImage = std::make_shared<SFMLTextureWrapper>();
+      ownImage->image = sfmlImage->image;
+      ownImage->UpdateFromImage();
+      sfmlImage = ownImage;
+    } else {
+      sfmlImage = std::make_shared<SFMLTextureWrapper>(
+          sfmlImage->texture);  // Copy the texture.
+    }
+    sfmlSprite.setTexture(sfmlImage->texture, true);
     hasItsOwnImage = true;
   }
 }
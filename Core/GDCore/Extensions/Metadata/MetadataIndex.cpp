@@ -0,0 +1,97 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Extensions/Metadata/MetadataIndex.h"
+#include <map>
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/EffectMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+
+namespace gd {
+
+namespace {
+/**
+ * Add all the metadata of a map to an index. Metadata already in the index
+ * are kept, so that the first declared one is found.
+ */
+template <class T>
+void AddToIndex(MetadataIndex::Index<T>& index,
+                const gd::PlatformExtension& extension,
+                const std::map<gd::String, T>& allMetadata) {
+  for (auto& it : allMetadata)
+    index.emplace(it.first, ExtensionAndMetadata<T>(extension, it.second));
+}
+}  // namespace
+
+MetadataIndex::MetadataIndex(const gd::Platform& platform) {
+  for (auto& extensionPtr : platform.GetAllPlatformExtensions()) {
+    gd::PlatformExtension& extension = *extensionPtr;
+
+    for (const gd::String& objectType : extension.GetExtensionObjectsTypes())
+      objects.emplace(objectType,
+                      ExtensionAndMetadata<ObjectMetadata>(
+                          extension, extension.GetObjectMetadata(objectType)));
+    for (const gd::String& behaviorType : extension.GetBehaviorsTypes())
+      behaviors.emplace(
+          behaviorType,
+          ExtensionAndMetadata<BehaviorMetadata>(
+              extension, extension.GetBehaviorMetadata(behaviorType)));
+    for (const gd::String& effectType : extension.GetExtensionEffectTypes())
+      effects.emplace(effectType,
+                      ExtensionAndMetadata<EffectMetadata>(
+                          extension, extension.GetEffectMetadata(effectType)));
+
+#if defined(GD_IDE_ONLY)
+    // Actions and conditions are searched in the extension, then in its
+    // objects and finally in its behaviors.
+    AddToIndex(actions, extension, extension.GetAllActions());
+    AddToIndex(conditions, extension, extension.GetAllConditions());
+    AddToIndex(freeActions, extension, extension.GetAllActions());
+    AddToIndex(freeConditions, extension, extension.GetAllConditions());
+    AddToIndex(freeExpressions, extension, extension.GetAllExpressions());
+    AddToIndex(freeStrExpressions, extension, extension.GetAllStrExpressions());
+
+    for (const gd::String& objectType : extension.GetExtensionObjectsTypes()) {
+      const auto& objectActions = extension.GetAllActionsForObject(objectType);
+      const auto& objectConditions =
+          extension.GetAllConditionsForObject(objectType);
+      AddToIndex(actions, extension, objectActions);
+      AddToIndex(conditions, extension, objectConditions);
+      AddToIndex(objectsActions[objectType], extension, objectActions);
+      AddToIndex(objectsConditions[objectType], extension, objectConditions);
+      AddToIndex(objectsExpressions[objectType],
+                 extension,
+                 extension.GetAllExpressionsForObject(objectType));
+      AddToIndex(objectsStrExpressions[objectType],
+                 extension,
+                 extension.GetAllStrExpressionsForObject(objectType));
+    }
+
+    for (const gd::String& behaviorType : extension.GetBehaviorsTypes()) {
+      const auto& behaviorActions =
+          extension.GetAllActionsForBehavior(behaviorType);
+      const auto& behaviorConditions =
+          extension.GetAllConditionsForBehavior(behaviorType);
+      AddToIndex(actions, extension, behaviorActions);
+      AddToIndex(conditions, extension, behaviorConditions);
+      AddToIndex(behaviorsActions[behaviorType], extension, behaviorActions);
+      AddToIndex(
+          behaviorsConditions[behaviorType], extension, behaviorConditions);
+      AddToIndex(behaviorsExpressions[behaviorType],
+                 extension,
+                 extension.GetAllExpressionsForBehavior(behaviorType));
+      AddToIndex(behaviorsStrExpressions[behaviorType],
+                 extension,
+                 extension.GetAllStrExpressionsForBehavior(behaviorType));
+    }
+#endif
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,101 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_METADATAINDEX_H
+#define GDCORE_METADATAINDEX_H
+#include <unordered_map>
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/String.h"
+namespace gd {
+class BehaviorMetadata;
+class ObjectMetadata;
+class EffectMetadata;
+class ExpressionMetadata;
+class InstructionMetadata;
+class Platform;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Index of the metadata declared by the extensions of a platform, so
+ * that gd::MetadataProvider can find them without iterating over all the
+ * extensions, objects and behaviors.
+ *
+ * When a type is declared by more than one extension (or more than once in an
+ * extension), the index gives the same metadata as the one that would be found
+ * by iterating over the extensions, in the order they were loaded.
+ *
+ * \see gd::Platform::GetMetadataIndex
+ * \ingroup PlatformDefinition
+ */
+class GD_CORE_API MetadataIndex {
+ public:
+  template <class T>
+  using Index = std::unordered_map<gd::String, ExtensionAndMetadata<T>>;
+
+  /**
+   * \brief Indexes for each object or behavior type.
+   */
+  template <class T>
+  using IndexByType = std::unordered_map<gd::String, Index<T>>;
+
+  /**
+   * \brief Build the index of the extensions currently loaded by the platform.
+   */
+  MetadataIndex(const gd::Platform& platform);
+
+  /**
+   * \brief Find the metadata having the specified type in an index.
+   * \return nullptr if not found.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const Index<T>& index,
+                                             const gd::String& type) {
+    auto it = index.find(type);
+    return it != index.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * \brief Find the metadata having the specified type in the index of an
+   * object or behavior type.
+   * \return nullptr if not found.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const IndexByType<T>& index,
+                                             const gd::String& objectType,
+                                             const gd::String& type) {
+    auto it = index.find(objectType);
+    return it != index.end() ? Find(it->second, type) : nullptr;
+  }
+
+  Index<ObjectMetadata> objects;
+  Index<BehaviorMetadata> behaviors;
+  Index<EffectMetadata> effects;
+
+#if defined(GD_IDE_ONLY)
+  Index<InstructionMetadata> actions;  ///< Free, object and behavior actions.
+  Index<InstructionMetadata> conditions;  ///< Free, object and behavior
+                                          ///< conditions.
+  Index<InstructionMetadata> freeActions;
+  Index<InstructionMetadata> freeConditions;
+  Index<ExpressionMetadata> freeExpressions;
+  Index<ExpressionMetadata> freeStrExpressions;
+
+  IndexByType<InstructionMetadata> objectsActions;
+  IndexByType<InstructionMetadata> objectsConditions;
+  IndexByType<ExpressionMetadata> objectsExpressions;
+  IndexByType<ExpressionMetadata> objectsStrExpressions;
+
+  IndexByType<InstructionMetadata> behaviorsActions;
+  IndexByType<InstructionMetadata> behaviorsConditions;
+  IndexByType<ExpressionMetadata> behaviorsExpressions;
+  IndexByType<ExpressionMetadata> behaviorsStrExpressions;
+#endif
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_METADATAINDEX_H
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
 #include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/MetadataIndex.h"
 #include "GDCore/Extensions/Metadata/ObjectMetadata.h"
 #include "GDCore/Extensions/Metadata/EffectMetadata.h"
 #include "GDCore/Extensions/Platform.h"
@@ -28,14 +29,9 @@ gd::PlatformExtension MetadataProvider::badExtension;
 ExtensionAndMetadata<BehaviorMetadata>
 MetadataProvider::GetExtensionAndBehaviorMetadata(const gd::Platform& platform,
                                                   gd::String behaviorType) {
-  for (auto& extension : platform.GetAllPlatformExtensions()) {
-    auto behaviorTypes = extension->GetBehaviorsTypes();
-    for (std::size_t j = 0; j < behaviorTypes.size(); ++j) {
-      if (behaviorTypes[j] == behaviorType)
-        return ExtensionAndMetadata<BehaviorMetadata>(
-            *extension, extension->GetBehaviorMetadata(behaviorType));
-    }
-  }
+  auto found = MetadataIndex::Find(platform.GetMetadataIndex().behaviors,
+                                   behaviorType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<BehaviorMetadata>(badExtension, badBehaviorInfo);
 }
@@ -48,14 +44,9 @@ const BehaviorMetadata& MetadataProvider::GetBehaviorMetadata(
 ExtensionAndMetadata<ObjectMetadata>
 MetadataProvider::GetExtensionAndObjectMetadata(const gd::Platform& platform,
                                                 gd::String objectType) {
-  for (auto& extension : platform.GetAllPlatformExtensions()) {
-    auto objectsTypes = extension->GetExtensionObjectsTypes();
-    for (std::size_t j = 0; j < objectsTypes.size(); ++j) {
-      if (objectsTypes[j] == objectType)
-        return ExtensionAndMetadata<ObjectMetadata>(
-            *extension, extension->GetObjectMetadata(objectType));
-    }
-  }
+  auto found =
+      MetadataIndex::Find(platform.GetMetadataIndex().objects, objectType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ObjectMetadata>(badExtension, badObjectInfo);
 }
@@ -68,14 +59,8 @@ const ObjectMetadata& MetadataProvider::GetObjectMetadata(
 ExtensionAndMetadata<EffectMetadata>
 MetadataProvider::GetExtensionAndEffectMetadata(const gd::Platform& platform,
                                                 gd::String type) {
-  for (auto& extension : platform.GetAllPlatformExtensions()) {
-    auto objectsTypes = extension->GetExtensionEffectTypes();
-    for (std::size_t j = 0; j < objectsTypes.size(); ++j) {
-      if (objectsTypes[j] == type)
-        return ExtensionAndMetadata<EffectMetadata>(
-            *extension, extension->GetEffectMetadata(type));
-    }
-  }
+  auto found = MetadataIndex::Find(platform.GetMetadataIndex().effects, type);
+  if (found) return *found;
 
   return ExtensionAndMetadata<EffectMetadata>(badExtension, badEffectMetadata);
 }
@@ -88,31 +73,9 @@ const EffectMetadata& MetadataProvider::GetEffectMetadata(
 ExtensionAndMetadata<InstructionMetadata>
 MetadataProvider::GetExtensionAndActionMetadata(const gd::Platform& platform,
                                                 gd::String actionType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allActions = extension->GetAllActions();
-    if (allActions.find(actionType) != allActions.end())
-      return ExtensionAndMetadata<InstructionMetadata>(
-          *extension, allActions.find(actionType)->second);
-
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    for (const gd::String& extObjectType : objects) {
-      const auto& allObjectsActions =
-          extension->GetAllActionsForObject(extObjectType);
-      if (allObjectsActions.find(actionType) != allObjectsActions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allObjectsActions.find(actionType)->second);
-    }
-
-    const auto& autos = extension->GetBehaviorsTypes();
-    for (std::size_t j = 0; j < autos.size(); ++j) {
-      const auto& allAutosActions =
-          extension->GetAllActionsForBehavior(autos[j]);
-      if (allAutosActions.find(actionType) != allAutosActions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allAutosActions.find(actionType)->second);
-    }
-  }
+  auto found =
+      MetadataIndex::Find(platform.GetMetadataIndex().actions, actionType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<InstructionMetadata>(badExtension,
                                                    badInstructionMetadata);
@@ -126,31 +89,9 @@ const gd::InstructionMetadata& MetadataProvider::GetActionMetadata(
 ExtensionAndMetadata<InstructionMetadata>
 MetadataProvider::GetExtensionAndConditionMetadata(const gd::Platform& platform,
                                                    gd::String conditionType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allConditions = extension->GetAllConditions();
-    if (allConditions.find(conditionType) != allConditions.end())
-      return ExtensionAndMetadata<InstructionMetadata>(
-          *extension, allConditions.find(conditionType)->second);
-
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    for (const gd::String& extObjectType : objects) {
-      const auto& allObjetsConditions =
-          extension->GetAllConditionsForObject(extObjectType);
-      if (allObjetsConditions.find(conditionType) != allObjetsConditions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allObjetsConditions.find(conditionType)->second);
-    }
-
-    const auto& autos = extension->GetBehaviorsTypes();
-    for (std::size_t j = 0; j < autos.size(); ++j) {
-      const auto& allAutosConditions =
-          extension->GetAllConditionsForBehavior(autos[j]);
-      if (allAutosConditions.find(conditionType) != allAutosConditions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allAutosConditions.find(conditionType)->second);
-    }
-  }
+  auto found = MetadataIndex::Find(platform.GetMetadataIndex().conditions,
+                                   conditionType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<InstructionMetadata>(badExtension,
                                                    badInstructionMetadata);
@@ -165,26 +106,14 @@ const gd::InstructionMetadata& MetadataProvider::GetConditionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndObjectExpressionMetadata(
     const gd::Platform& platform, gd::String objectType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    if (find(objects.begin(), objects.end(), objectType) != objects.end()) {
-      const auto& allObjectExpressions =
-          extension->GetAllExpressionsForObject(objectType);
-      if (allObjectExpressions.find(exprType) != allObjectExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allObjectExpressions.find(exprType)->second);
-    }
-  }
+  const auto& objectsExpressions =
+      platform.GetMetadataIndex().objectsExpressions;
+  auto found = MetadataIndex::Find(objectsExpressions, objectType, exprType);
+  if (found) return *found;
 
   // Then check base
-  for (auto& extension : extensions) {
-    const auto& allObjectExpressions =
-        extension->GetAllExpressionsForObject("");
-    if (allObjectExpressions.find(exprType) != allObjectExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allObjectExpressions.find(exprType)->second);
-  }
+  found = MetadataIndex::Find(objectsExpressions, "", exprType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
                                                   badExpressionMetadata);
@@ -199,26 +128,14 @@ const gd::ExpressionMetadata& MetadataProvider::GetObjectExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndBehaviorExpressionMetadata(
     const gd::Platform& platform, gd::String autoType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& autos = extension->GetBehaviorsTypes();
-    if (find(autos.begin(), autos.end(), autoType) != autos.end()) {
-      const auto& allAutoExpressions =
-          extension->GetAllExpressionsForBehavior(autoType);
-      if (allAutoExpressions.find(exprType) != allAutoExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allAutoExpressions.find(exprType)->second);
-    }
-  }
+  const auto& behaviorsExpressions =
+      platform.GetMetadataIndex().behaviorsExpressions;
+  auto found = MetadataIndex::Find(behaviorsExpressions, autoType, exprType);
+  if (found) return *found;
 
   // Then check base
-  for (auto& extension : extensions) {
-    const auto& allAutoExpressions =
-        extension->GetAllExpressionsForBehavior("");
-    if (allAutoExpressions.find(exprType) != allAutoExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allAutoExpressions.find(exprType)->second);
-  }
+  found = MetadataIndex::Find(behaviorsExpressions, "", exprType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
                                                   badExpressionMetadata);
@@ -233,13 +150,9 @@ const gd::ExpressionMetadata& MetadataProvider::GetBehaviorExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndExpressionMetadata(
     const gd::Platform& platform, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allExpr = extension->GetAllExpressions();
-    if (allExpr.find(exprType) != allExpr.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allExpr.find(exprType)->second);
-  }
+  auto found = MetadataIndex::Find(platform.GetMetadataIndex().freeExpressions,
+                                   exprType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
                                                   badExpressionMetadata);
@@ -253,27 +166,14 @@ const gd::ExpressionMetadata& MetadataProvider::GetExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndObjectStrExpressionMetadata(
     const gd::Platform& platform, gd::String objectType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    if (find(objects.begin(), objects.end(), objectType) != objects.end()) {
-      const auto& allObjectStrExpressions =
-          extension->GetAllStrExpressionsForObject(objectType);
-      if (allObjectStrExpressions.find(exprType) !=
-          allObjectStrExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allObjectStrExpressions.find(exprType)->second);
-    }
-  }
+  const auto& objectsStrExpressions =
+      platform.GetMetadataIndex().objectsStrExpressions;
+  auto found = MetadataIndex::Find(objectsStrExpressions, objectType, exprType);
+  if (found) return *found;
 
   // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& allObjectStrExpressions =
-        extension->GetAllStrExpressionsForObject("");
-    if (allObjectStrExpressions.find(exprType) != allObjectStrExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allObjectStrExpressions.find(exprType)->second);
-  }
+  found = MetadataIndex::Find(objectsStrExpressions, "", exprType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
                                                   badStrExpressionMetadata);
@@ -289,28 +189,15 @@ const gd::ExpressionMetadata& MetadataProvider::GetObjectStrExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndBehaviorStrExpressionMetadata(
     const gd::Platform& platform, gd::String autoType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& autos = extension->GetBehaviorsTypes();
-    if (find(autos.begin(), autos.end(), autoType) != autos.end()) {
-      const auto& allBehaviorStrExpressions =
-          extension->GetAllStrExpressionsForBehavior(autoType);
-      if (allBehaviorStrExpressions.find(exprType) !=
-          allBehaviorStrExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allBehaviorStrExpressions.find(exprType)->second);
-    }
-  }
+  const auto& behaviorsStrExpressions =
+      platform.GetMetadataIndex().behaviorsStrExpressions;
+  auto found =
+      MetadataIndex::Find(behaviorsStrExpressions, autoType, exprType);
+  if (found) return *found;
 
   // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& allBehaviorStrExpressions =
-        extension->GetAllStrExpressionsForBehavior("");
-    if (allBehaviorStrExpressions.find(exprType) !=
-        allBehaviorStrExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allBehaviorStrExpressions.find(exprType)->second);
-  }
+  found = MetadataIndex::Find(behaviorsStrExpressions, "", exprType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
                                                   badStrExpressionMetadata);
@@ -328,13 +215,9 @@ MetadataProvider::GetBehaviorStrExpressionMetadata(const gd::Platform& platform,
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndStrExpressionMetadata(
     const gd::Platform& platform, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allExpr = extension->GetAllStrExpressions();
-    if (allExpr.find(exprType) != allExpr.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allExpr.find(exprType)->second);
-  }
+  auto found = MetadataIndex::Find(
+      platform.GetMetadataIndex().freeStrExpressions, exprType);
+  if (found) return *found;
 
   return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
                                                   badStrExpressionMetadata);
@@ -347,195 +230,111 @@ const gd::ExpressionMetadata& MetadataProvider::GetStrExpressionMetadata(
 
 bool MetadataProvider::HasAction(const gd::Platform& platform,
                                  gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-
-  for (auto& extension : extensions) {
-    const auto& actions = extension->GetAllActions();
-    if (actions.find(name) != actions.end()) return true;
-  }
-
-  return false;
+  return MetadataIndex::Find(platform.GetMetadataIndex().freeActions, name) !=
+         nullptr;
 }
 
 bool MetadataProvider::HasObjectAction(const gd::Platform& platform,
                                        gd::String objectType,
                                        gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& actions = extension->GetAllActionsForObject(objectType);
-    if (actions.find(name) != actions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& actions = extension->GetAllActionsForObject("");
-    if (actions.find(name) != actions.end()) return true;
-  }
+  const auto& objectsActions = platform.GetMetadataIndex().objectsActions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(objectsActions, objectType, name) ||
+         MetadataIndex::Find(objectsActions, "", name);
 }
 
 bool MetadataProvider::HasBehaviorAction(const gd::Platform& platform,
                                          gd::String behaviorType,
                                          gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& actions = extension->GetAllActionsForBehavior(behaviorType);
-    if (actions.find(name) != actions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& actions = extension->GetAllActionsForBehavior("");
-    if (actions.find(name) != actions.end()) return true;
-  }
+  const auto& behaviorsActions = platform.GetMetadataIndex().behaviorsActions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(behaviorsActions, behaviorType, name) ||
+         MetadataIndex::Find(behaviorsActions, "", name);
 }
 
 bool MetadataProvider::HasCondition(const gd::Platform& platform,
                                     gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& conditions = extension->GetAllConditions();
-    if (conditions.find(name) != conditions.end()) return true;
-  }
-
-  return false;
+  return MetadataIndex::Find(platform.GetMetadataIndex().freeConditions,
+                             name) != nullptr;
 }
 
 bool MetadataProvider::HasObjectCondition(const gd::Platform& platform,
                                           gd::String objectType,
                                           gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& conditions = extension->GetAllConditionsForObject(objectType);
-    if (conditions.find(name) != conditions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& conditions = extension->GetAllConditionsForObject("");
-    if (conditions.find(name) != conditions.end()) return true;
-  }
+  const auto& objectsConditions = platform.GetMetadataIndex().objectsConditions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(objectsConditions, objectType, name) ||
+         MetadataIndex::Find(objectsConditions, "", name);
 }
 
 bool MetadataProvider::HasBehaviorCondition(const gd::Platform& platform,
                                             gd::String behaviorType,
                                             gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& conditions =
-        extension->GetAllConditionsForBehavior(behaviorType);
-    if (conditions.find(name) != conditions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& conditions = extension->GetAllConditionsForBehavior("");
-    if (conditions.find(name) != conditions.end()) return true;
-  }
+  const auto& behaviorsConditions =
+      platform.GetMetadataIndex().behaviorsConditions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(behaviorsConditions, behaviorType, name) ||
+         MetadataIndex::Find(behaviorsConditions, "", name);
 }
 
 bool MetadataProvider::HasExpression(const gd::Platform& platform,
                                      gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllExpressions();
-    if (expressions.find(name) != expressions.end()) return true;
-  }
-
-  return false;
+  return MetadataIndex::Find(platform.GetMetadataIndex().freeExpressions,
+                             name) != nullptr;
 }
 
 bool MetadataProvider::HasObjectExpression(const gd::Platform& platform,
                                            gd::String objectType,
                                            gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllExpressionsForObject(objectType);
-    if (expressions.find(name) != expressions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllExpressionsForObject("");
-    if (expressions.find(name) != expressions.end()) return true;
-  }
+  const auto& objectsExpressions =
+      platform.GetMetadataIndex().objectsExpressions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(objectsExpressions, objectType, name) ||
+         MetadataIndex::Find(objectsExpressions, "", name);
 }
 
 bool MetadataProvider::HasBehaviorExpression(const gd::Platform& platform,
                                              gd::String behaviorType,
                                              gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& expressions =
-        extension->GetAllExpressionsForBehavior(behaviorType);
-    if (expressions.find(name) != expressions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllExpressionsForBehavior("");
-    if (expressions.find(name) != expressions.end()) return true;
-  }
+  const auto& behaviorsExpressions =
+      platform.GetMetadataIndex().behaviorsExpressions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(behaviorsExpressions, behaviorType, name) ||
+         MetadataIndex::Find(behaviorsExpressions, "", name);
 }
 
 bool MetadataProvider::HasStrExpression(const gd::Platform& platform,
                                         gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllStrExpressions();
-    if (expressions.find(name) != expressions.end()) return true;
-  }
-
-  return false;
+  return MetadataIndex::Find(platform.GetMetadataIndex().freeStrExpressions,
+                             name) != nullptr;
 }
 
 bool MetadataProvider::HasObjectStrExpression(const gd::Platform& platform,
                                               gd::String objectType,
                                               gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& expressions =
-        extension->GetAllStrExpressionsForObject(objectType);
-    if (expressions.find(name) != expressions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllStrExpressionsForObject("");
-    if (expressions.find(name) != expressions.end()) return true;
-  }
+  const auto& objectsStrExpressions =
+      platform.GetMetadataIndex().objectsStrExpressions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(objectsStrExpressions, objectType, name) ||
+         MetadataIndex::Find(objectsStrExpressions, "", name);
 }
 
 bool MetadataProvider::HasBehaviorStrExpression(const gd::Platform& platform,
                                                 gd::String behaviorType,
                                                 gd::String name) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& expressions =
-        extension->GetAllStrExpressionsForBehavior(behaviorType);
-    if (expressions.find(name) != expressions.end()) return true;
-  }
-
-  // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& expressions = extension->GetAllStrExpressionsForBehavior("");
-    if (expressions.find(name) != expressions.end()) return true;
-  }
+  const auto& behaviorsStrExpressions =
+      platform.GetMetadataIndex().behaviorsStrExpressions;
 
-  return false;
+  // Check also in functions of "Base object".
+  return MetadataIndex::Find(behaviorsStrExpressions, behaviorType, name) ||
+         MetadataIndex::Find(behaviorsStrExpressions, "", name);
 }
 
 MetadataProvider::~MetadataProvider() {}
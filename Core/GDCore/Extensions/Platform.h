@@ -23,6 +23,7 @@ class BehaviorsSharedData;
 class PlatformExtension;
 class LayoutEditorCanvas;
 class ProjectExporter;
+class MetadataIndex;
 }  // namespace gd
 
 typedef std::function<std::unique_ptr<gd::Object>(gd::String name)>
@@ -123,6 +124,25 @@ class GD_CORE_API Platform {
    * anymore.
    */
   virtual void RemoveExtension(const gd::String& name);
+
+#if defined(GD_IDE_ONLY)
+  /**
+   * \brief Get the index of the metadata declared by the extensions, used by
+   * gd::MetadataProvider.
+   *
+   * The index is built the first time it's needed, and rebuilt after an
+   * extension is added or removed.
+   */
+  const gd::MetadataIndex& GetMetadataIndex() const;
+
+  /**
+   * \brief Rebuild the index of the metadata the next time it's used.
+   *
+   * \note Call this if an extension already added to the platform is
+   * modified (for example, if an instruction is added to it).
+   */
+  void InvalidateMetadataIndex();
+#endif
   ///@}
 
   /** \name Factory method
@@ -181,6 +201,11 @@ class GD_CORE_API Platform {
   std::map<gd::String, CreateFunPtr>
       creationFunctionTable;  ///< Creation functions for objects
   bool enableExtensionLoadingLogs;
+#if defined(GD_IDE_ONLY)
+  mutable std::unique_ptr<gd::MetadataIndex>
+      metadataIndex;  ///< Index of the metadata of the extensions, built when
+                      ///< needed.
+#endif
 };
 
 }  // namespace gd
@@ -5,11 +5,19 @@
  */
 #include "ProjectResourcesCopier.h"
 #include <map>
+#include <set>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
 #include "GDCore/IDE/Project/ResourcesAbsolutePathChecker.h"
+#include "GDCore/IDE/Project/ResourcesInUseHelper.h"
 #include "GDCore/IDE/Project/ResourcesMergingHelper.h"
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include "GDCore/Project/EventsFunctionsExtension.h"
+#include "GDCore/Project/ExternalEvents.h"
+#include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Project/ResourcesLoader.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
 
@@ -17,6 +25,102 @@ using namespace std;
 
 namespace gd {
 
+namespace {
+
+#if !defined(EMSCRIPTEN)
+/**
+ * List the images used by the sprite objects of a container, and expose the
+ * resources of the other objects to \a notPackableResources.
+ */
+void ListSpriteObjectsImages(gd::ObjectsContainer& objects,
+                             std::set<gd::String>& spriteImages,
+                             gd::ArbitraryResourceWorker& notPackableResources) {
+  for (std::size_t i = 0; i < objects.GetObjectsCount(); ++i) {
+    gd::Object& object = objects.GetObject(i);
+    gd::SpriteObject* spriteObject = dynamic_cast<gd::SpriteObject*>(&object);
+    if (!spriteObject) {
+      object.ExposeResources(notPackableResources);
+      continue;
+    }
+
+    for (std::size_t a = 0; a < spriteObject->GetAnimationsCount(); ++a) {
+      const gd::Animation& animation = spriteObject->GetAnimation(a);
+      for (std::size_t d = 0; d < animation.GetDirectionsCount(); ++d) {
+        const gd::Direction& direction = animation.GetDirection(d);
+        for (std::size_t s = 0; s < direction.GetSpritesCount(); ++s)
+          spriteImages.insert(direction.GetSprite(s).GetImageName());
+      }
+    }
+  }
+}
+
+/**
+ * Pack images in atlases saved in \a destinationDirectory.
+ * \return true if no error happened
+ */
+bool PackImages(const std::vector<gd::ImageResource*>& images,
+                AbstractFileSystem& fs,
+                const gd::String& destinationDirectory,
+                unsigned int pageSize,
+                std::size_t& atlasesCount) {
+  std::vector<sf::Image> loadedImages(images.size());
+  std::vector<gd::TextureAtlasPacker::Rect> sizes(images.size());
+  for (std::size_t i = 0; i < images.size(); ++i) {
+    gd::String file = images[i]->GetFile();
+    fs.MakeAbsolute(file, destinationDirectory);
+    gd::ResourcesLoader::Get()->LoadSFMLImage(file, loadedImages[i]);
+
+    // Images that can't be loaded have a size of 0 and are not packed.
+    sizes[i].width = loadedImages[i].getSize().x;
+    sizes[i].height = loadedImages[i].getSize().y;
+  }
+
+  gd::TextureAtlasPacker packer(pageSize);
+  std::vector<gd::TextureAtlasPacker::Placement> placements =
+      packer.Pack(sizes);
+
+  bool success = true;
+  for (std::size_t page = 0; page < packer.GetPagesCount(); ++page) {
+    sf::Image atlas;
+    atlas.create(packer.GetPageUsedWidth(page),
+                 packer.GetPageUsedHeight(page),
+                 sf::Color(0, 0, 0, 0));
+    for (std::size_t i = 0; i < images.size(); ++i) {
+      if (placements[i].page == page)
+        atlas.copy(loadedImages[i], placements[i].x, placements[i].y);
+    }
+
+    // Find a name not used by another file
+    gd::String atlasFile, atlasAbsoluteFile;
+    do {
+      atlasFile = "textureAtlas" + gd::String::From(atlasesCount++) + ".png";
+      atlasAbsoluteFile = atlasFile;
+      fs.MakeAbsolute(atlasAbsoluteFile, destinationDirectory);
+    } while (fs.FileExists(atlasAbsoluteFile));
+
+    if (!atlas.saveToFile(atlasAbsoluteFile.ToLocale())) {
+      gd::LogWarning(_("Unable to save the texture atlas \"") +
+                     atlasAbsoluteFile + _("\"."));
+      success = false;
+      continue;
+    }
+
+    for (std::size_t i = 0; i < images.size(); ++i) {
+      if (placements[i].page == page)
+        images[i]->SetAtlas(atlasFile,
+                            placements[i].x,
+                            placements[i].y,
+                            sizes[i].width,
+                            sizes[i].height);
+    }
+  }
+
+  return success;
+}
+#endif
+
+}  // namespace
+
 bool ProjectResourcesCopier::CopyAllResourcesTo(
     gd::Project& originalProject,
     AbstractFileSystem& fs,
@@ -77,4 +181,66 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
   return true;
 }
 
+bool ProjectResourcesCopier::PackImagesInAtlases(
+    gd::Project& project,
+    AbstractFileSystem& fs,
+    gd::String destinationDirectory,
+    unsigned int pageSize) {
+#if defined(EMSCRIPTEN)
+  return false;  // Images can't be loaded without SFML.
+#else
+  // Find the images only used by sprite objects.
+  std::set<gd::String> spriteImages;
+  gd::ResourcesInUseHelper notPackableResources;
+  project.GetPlatformSpecificAssets().ExposeResources(notPackableResources);
+  ListSpriteObjectsImages(project, spriteImages, notPackableResources);
+  for (std::size_t s = 0; s < project.GetLayoutsCount(); s++) {
+    ListSpriteObjectsImages(
+        project.GetLayout(s), spriteImages, notPackableResources);
+    LaunchResourceWorkerOnEvents(
+        project, project.GetLayout(s).GetEvents(), notPackableResources);
+  }
+  for (std::size_t s = 0; s < project.GetExternalEventsCount(); s++) {
+    LaunchResourceWorkerOnEvents(project,
+                                 project.GetExternalEvents(s).GetEvents(),
+                                 notPackableResources);
+  }
+  for (std::size_t e = 0; e < project.GetEventsFunctionsExtensionsCount();
+       e++) {
+    auto& eventsFunctionsExtension = project.GetEventsFunctionsExtension(e);
+    for (auto&& eventsFunction : eventsFunctionsExtension.GetInternalVector()) {
+      LaunchResourceWorkerOnEvents(
+          project, eventsFunction->GetEvents(), notPackableResources);
+    }
+  }
+
+  const std::set<gd::String>& notPackableImages =
+      notPackableResources.GetAllImages();
+  std::vector<gd::ImageResource*> smoothedImages;
+  std::vector<gd::ImageResource*> notSmoothedImages;
+  gd::ResourcesManager& resourcesManager = project.GetResourcesManager();
+  for (const gd::String& name : spriteImages) {
+    if (!resourcesManager.HasResource(name) ||
+        notPackableImages.find(name) != notPackableImages.end())
+      continue;
+
+    gd::ImageResource* image =
+        dynamic_cast<gd::ImageResource*>(&resourcesManager.GetResource(name));
+    if (!image) continue;
+
+    image->RemoveFromAtlas();
+    (image->IsSmooth() ? smoothedImages : notSmoothedImages).push_back(image);
+  }
+
+  std::cout << "Packing " << smoothedImages.size() + notSmoothedImages.size()
+            << " images in texture atlases..." << std::endl;
+  std::size_t atlasesCount = 0;
+  bool success = PackImages(
+      smoothedImages, fs, destinationDirectory, pageSize, atlasesCount);
+  success &= PackImages(
+      notSmoothedImages, fs, destinationDirectory, pageSize, atlasesCount);
+  return success;
+#endif
+}
+
 }  // namespace gd
@@ -47,6 +47,33 @@ class GD_CORE_API ProjectResourcesCopier {
                                  bool updateOriginalProject,
                                  bool preserveAbsoluteFilenames = true,
                                  bool preserveDirectoryStructure = true);
+
+  /**
+   * \brief Pack the images of a project in texture atlases, saved in
+   * `destinationDirectory`, and store in the image resources the area of the
+   * atlas covering them (see gd::ImageResource::SetAtlas).
+   *
+   * Only the images used by sprite objects, and not used by other objects or by
+   * events, are packed: other images can be repeated or modified, and stay in
+   * their own file. Smoothed and not smoothed images are put in different
+   * atlases.
+   *
+   * Must be called on the exported project, after its resources are copied
+   * (see CopyAllResourcesTo). The files of the images are still used by
+   * platforms not using atlases.
+   *
+   * \param project The project to be used
+   * \param fs The abstract file system to be used
+   * \param destinationDirectory The directory containing the copied
+   * resources, where atlases are saved.
+   * \param pageSize The maximum width and height of an atlas.
+   *
+   * \return true if no error happened
+   */
+  static bool PackImagesInAtlases(gd::Project& project,
+                                  gd::AbstractFileSystem& fs,
+                                  gd::String destinationDirectory,
+                                  unsigned int pageSize = 2048);
 };
 
 }  // namespace gd
@@ -0,0 +1,177 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace gd {
+
+namespace {
+
+bool Intersects(const TextureAtlasPacker::Rect& a,
+                const TextureAtlasPacker::Rect& b) {
+  return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+         b.y < a.y + a.height;
+}
+
+bool Contains(const TextureAtlasPacker::Rect& a,
+              const TextureAtlasPacker::Rect& b) {
+  return b.x >= a.x && b.y >= a.y && b.x + b.width <= a.x + a.width &&
+         b.y + b.height <= a.y + a.height;
+}
+
+}  // namespace
+
+const std::size_t TextureAtlasPacker::noPage =
+    std::numeric_limits<std::size_t>::max();
+
+TextureAtlasPacker::TextureAtlasPacker(unsigned int pageSize_,
+                                       unsigned int padding_)
+    : pageSize(pageSize_), padding(padding_) {}
+
+std::vector<TextureAtlasPacker::Placement> TextureAtlasPacker::Pack(
+    const std::vector<Rect>& sizes) {
+  std::vector<Placement> placements(sizes.size());
+
+  // Place the biggest rectangles first: the small ones fill the gaps.
+  std::vector<std::size_t> order(sizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        unsigned int maxSideA = std::max(sizes[a].width, sizes[a].height);
+        unsigned int maxSideB = std::max(sizes[b].width, sizes[b].height);
+        if (maxSideA != maxSideB) return maxSideA > maxSideB;
+        return sizes[a].width * sizes[a].height >
+               sizes[b].width * sizes[b].height;
+      });
+
+  for (std::size_t index : order) {
+    unsigned int width = sizes[index].width + padding;
+    unsigned int height = sizes[index].height + padding;
+    if (sizes[index].width == 0 || sizes[index].height == 0 ||
+        width > pageSize || height > pageSize)
+      continue;
+
+    std::size_t bestPage = noPage;
+    Rect bestPosition;
+    unsigned int bestShortSideFit = std::numeric_limits<unsigned int>::max();
+    unsigned int bestLongSideFit = std::numeric_limits<unsigned int>::max();
+    for (std::size_t p = 0; p < pages.size(); ++p) {
+      Rect position;
+      unsigned int shortSideFit, longSideFit;
+      if (FindPosition(
+              pages[p], width, height, position, shortSideFit, longSideFit) &&
+          (shortSideFit < bestShortSideFit ||
+           (shortSideFit == bestShortSideFit &&
+            longSideFit < bestLongSideFit))) {
+        bestPage = p;
+        bestPosition = position;
+        bestShortSideFit = shortSideFit;
+        bestLongSideFit = longSideFit;
+      }
+    }
+
+    if (bestPage == noPage) {
+      pages.push_back(Page());
+      pages.back().freeRects.push_back(Rect(0, 0, pageSize, pageSize));
+      bestPage = pages.size() - 1;
+      bestPosition = Rect(0, 0, width, height);
+    }
+
+    Page& page = pages[bestPage];
+    Place(page, bestPosition);
+    page.usedWidth =
+        std::max(page.usedWidth, bestPosition.x + sizes[index].width);
+    page.usedHeight =
+        std::max(page.usedHeight, bestPosition.y + sizes[index].height);
+
+    placements[index].page = bestPage;
+    placements[index].x = bestPosition.x;
+    placements[index].y = bestPosition.y;
+  }
+
+  return placements;
+}
+
+bool TextureAtlasPacker::FindPosition(const Page& page,
+                                      unsigned int width,
+                                      unsigned int height,
+                                      Rect& position,
+                                      unsigned int& shortSideFit,
+                                      unsigned int& longSideFit) {
+  bool found = false;
+  for (const Rect& freeRect : page.freeRects) {
+    if (freeRect.width < width || freeRect.height < height) continue;
+
+    unsigned int leftoverX = freeRect.width - width;
+    unsigned int leftoverY = freeRect.height - height;
+    unsigned int shortSide = std::min(leftoverX, leftoverY);
+    unsigned int longSide = std::max(leftoverX, leftoverY);
+    if (!found || shortSide < shortSideFit ||
+        (shortSide == shortSideFit && longSide < longSideFit)) {
+      position = Rect(freeRect.x, freeRect.y, width, height);
+      shortSideFit = shortSide;
+      longSideFit = longSide;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void TextureAtlasPacker::Place(Page& page, const Rect& usedRect) {
+  // Split the free rectangles overlapping the used one into the (up to four)
+  // maximal rectangles around it.
+  std::vector<Rect> newFreeRects;
+  for (std::size_t i = 0; i < page.freeRects.size();) {
+    const Rect freeRect = page.freeRects[i];
+    if (!Intersects(freeRect, usedRect)) {
+      ++i;
+      continue;
+    }
+
+    if (usedRect.x > freeRect.x)
+      newFreeRects.push_back(Rect(
+          freeRect.x, freeRect.y, usedRect.x - freeRect.x, freeRect.height));
+    if (usedRect.x + usedRect.width < freeRect.x + freeRect.width)
+      newFreeRects.push_back(Rect(usedRect.x + usedRect.width,
+                                  freeRect.y,
+                                  freeRect.x + freeRect.width -
+                                      (usedRect.x + usedRect.width),
+                                  freeRect.height));
+    if (usedRect.y > freeRect.y)
+      newFreeRects.push_back(Rect(
+          freeRect.x, freeRect.y, freeRect.width, usedRect.y - freeRect.y));
+    if (usedRect.y + usedRect.height < freeRect.y + freeRect.height)
+      newFreeRects.push_back(Rect(freeRect.x,
+                                  usedRect.y + usedRect.height,
+                                  freeRect.width,
+                                  freeRect.y + freeRect.height -
+                                      (usedRect.y + usedRect.height)));
+
+    page.freeRects[i] = page.freeRects.back();
+    page.freeRects.pop_back();
+  }
+  page.freeRects.insert(
+      page.freeRects.end(), newFreeRects.begin(), newFreeRects.end());
+
+  // Remove the free rectangles contained in another one.
+  for (std::size_t i = 0; i < page.freeRects.size(); ++i) {
+    for (std::size_t j = i + 1; j < page.freeRects.size();) {
+      if (Contains(page.freeRects[i], page.freeRects[j])) {
+        page.freeRects.erase(page.freeRects.begin() + j);
+      } else if (Contains(page.freeRects[j], page.freeRects[i])) {
+        page.freeRects.erase(page.freeRects.begin() + i);
+        j = i + 1;
+      } else {
+        ++j;
+      }
+    }
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,129 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef TEXTUREATLASPACKER_H
+#define TEXTUREATLASPACKER_H
+#include <cstddef>
+#include <vector>
+
+namespace gd {
+
+/**
+ * \brief Place rectangles (usually images) in pages of a fixed size, so that
+ * they can be stored in texture atlases.
+ *
+ * Rectangles are placed using the "MaxRects" algorithm, choosing the free
+ * space leaving the shortest side (Best Short Side Fit). Bigger rectangles are
+ * placed first.
+ *
+ * Usage example:
+ * \code
+ * gd::TextureAtlasPacker packer(1024);
+ * std::vector<gd::TextureAtlasPacker::Placement> placements =
+ *     packer.Pack({{0, 0, 64, 32}, {0, 0, 300, 120}});
+ * // placements[0].page is 0, placements[0].x and .y are where the first
+ * // rectangle must be copied in the page.
+ * \endcode
+ *
+ * \see gd::ProjectResourcesCopier::PackImagesInAtlases
+ * \ingroup IDE
+ */
+class GD_CORE_API TextureAtlasPacker {
+ public:
+  struct Rect {
+    Rect() : x(0), y(0), width(0), height(0){};
+    Rect(unsigned int x_,
+         unsigned int y_,
+         unsigned int width_,
+         unsigned int height_)
+        : x(x_), y(y_), width(width_), height(height_){};
+
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  /**
+   * \brief The position of a rectangle in the pages.
+   */
+  struct Placement {
+    Placement() : page(noPage), x(0), y(0){};
+
+    std::size_t page;  ///< The page, or noPage if the rectangle is too big.
+    unsigned int x;
+    unsigned int y;
+  };
+
+  /**
+   * \param pageSize The width and height of the pages.
+   * \param padding The space left on the right and below each rectangle, so
+   * that smoothed images don't bleed on their neighbours.
+   */
+  TextureAtlasPacker(unsigned int pageSize = 2048, unsigned int padding = 2);
+
+  /**
+   * \brief Place rectangles in the pages, after the ones already placed.
+   *
+   * \param sizes The rectangles to place (only their width and height are
+   * used).
+   * \return The placement of each rectangle, in the same order.
+   */
+  std::vector<Placement> Pack(const std::vector<Rect>& sizes);
+
+  /**
+   * \brief Return the number of pages used by the rectangles.
+   */
+  std::size_t GetPagesCount() const { return pages.size(); }
+
+  /**
+   * \brief Return the width of the part of a page used by the rectangles.
+   */
+  unsigned int GetPageUsedWidth(std::size_t page) const {
+    return pages[page].usedWidth;
+  }
+
+  /**
+   * \brief Return the height of the part of a page used by the rectangles.
+   */
+  unsigned int GetPageUsedHeight(std::size_t page) const {
+    return pages[page].usedHeight;
+  }
+
+  static const std::size_t noPage;
+
+ private:
+  struct Page {
+    Page() : usedWidth(0), usedHeight(0){};
+
+    std::vector<Rect> freeRects;  ///< Maximal free rectangles of the page.
+    unsigned int usedWidth;
+    unsigned int usedHeight;
+  };
+
+  /**
+   * \brief Find the best free space of a page for a rectangle.
+   * \return true if the rectangle fits in the page.
+   */
+  static bool FindPosition(const Page& page,
+                           unsigned int width,
+                           unsigned int height,
+                           Rect& position,
+                           unsigned int& shortSideFit,
+                           unsigned int& longSideFit);
+
+  /**
+   * \brief Remove \a usedRect from the free rectangles of a page.
+   */
+  static void Place(Page& page, const Rect& usedRect);
+
+  unsigned int pageSize;
+  unsigned int padding;
+  std::vector<Page> pages;
+};
+
+}  // namespace gd
+
+#endif  // TEXTUREATLASPACKER_H
@@ -0,0 +1,30 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Project/CollisionMask.h"
+#include <SFML/Graphics/Image.hpp>
+
+namespace gd {
+
+void CollisionMask::Build(const sf::Image& image, sf::Uint8 alphaLimit) {
+  width = image.getSize().x;
+  height = image.getSize().y;
+  wordsPerRow = (width + 63) / 64;
+  bits.assign(wordsPerRow * height, 0);
+  if (bits.empty()) return;
+
+  // Pixels are stored as RGBA bytes.
+  const sf::Uint8* pixels = image.getPixelsPtr();
+  for (unsigned int y = 0; y < height; ++y) {
+    std::uint64_t* row = &bits[y * wordsPerRow];
+    const sf::Uint8* alpha =
+        pixels + static_cast<std::size_t>(y) * width * 4 + 3;
+    for (unsigned int x = 0; x < width; ++x, alpha += 4) {
+      if (*alpha > alphaLimit) row[x / 64] |= std::uint64_t(1) << (x % 64);
+    }
+  }
+}
+
+}  // namespace gd
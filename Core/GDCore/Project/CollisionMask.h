@@ -0,0 +1,88 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_COLLISIONMASK_H
+#define GDCORE_COLLISIONMASK_H
+
+#include <SFML/Config.hpp>
+#include <cstdint>
+#include <vector>
+namespace sf {
+class Image;
+}
+
+namespace gd {
+
+/**
+ * \brief The opaque pixels of an image, stored as one bit per pixel, used
+ * for pixel perfect collisions.
+ *
+ * Each row of the image is stored in 64 bits words, so that 64 pixels of two
+ * masks can be tested at once.
+ *
+ * \see SFMLTextureWrapper
+ * \ingroup ResourcesManagement
+ */
+class GD_CORE_API CollisionMask {
+ public:
+  CollisionMask() : width(0), height(0), wordsPerRow(0){};
+
+  /**
+   * \brief Compute the mask of an image.
+   *
+   * \param image The image
+   * \param alphaLimit Pixels with an alpha strictly greater than this value are
+   * opaque.
+   */
+  void Build(const sf::Image& image, sf::Uint8 alphaLimit = 1);
+
+  /**
+   * \brief Return the width of the mask, in pixels.
+   */
+  unsigned int GetWidth() const { return width; }
+
+  /**
+   * \brief Return the height of the mask, in pixels.
+   */
+  unsigned int GetHeight() const { return height; }
+
+  /**
+   * \brief Return true if the pixel is opaque.
+   * \warning The pixel must be inside the mask.
+   */
+  bool IsOpaque(unsigned int x, unsigned int y) const {
+    return (bits[y * wordsPerRow + x / 64] >> (x % 64)) & 1;
+  }
+
+  /**
+   * \brief Return the 64 pixels of the row \a y starting at \a x, the first
+   * pixel being the lowest bit. Pixels outside of the mask are transparent.
+   * \warning The row must be inside the mask.
+   */
+  std::uint64_t GetPixels(unsigned int x, unsigned int y) const {
+    std::size_t word = x / 64;
+    if (word >= wordsPerRow) return 0;
+
+    const std::uint64_t* row = &bits[y * wordsPerRow];
+    unsigned int shift = x % 64;
+    if (shift == 0) return row[word];
+
+    std::uint64_t pixels = row[word] >> shift;
+    if (word + 1 < wordsPerRow) pixels |= row[word + 1] << (64 - shift);
+    return pixels;
+  }
+
+ private:
+  unsigned int width;
+  unsigned int height;
+  std::size_t wordsPerRow;
+  std::vector<std::uint64_t> bits;  ///< The rows of the mask. Bits after the
+                                    ///< end of a row are always 0.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_COLLISIONMASK_H
@@ -15,13 +15,20 @@
 
 namespace gd {
 
-ImageManager::ImageManager() : resourcesManager(NULL) {
+const std::size_t ImageManager::defaultTextureCacheBudget = 128 * 1024 * 1024;
+
+ImageManager::ImageManager()
+    : cacheBudget(defaultTextureCacheBudget), resourcesManager(NULL) {
+#if defined(GD_IDE_ONLY)
+  preventUnloading = false;
+#endif
 #if !defined(EMSCRIPTEN)
   badTexture = std::make_shared<SFMLTextureWrapper>();
   badTexture->texture.loadFromMemory(gd::InvalidImageData,
                                      sizeof(gd::InvalidImageData));
   badTexture->texture.setSmooth(false);
   badTexture->image = badTexture->texture.copyToImage();
+  badTexture->collisionMask.Build(badTexture->image);
 #endif
 }
 
@@ -32,9 +39,11 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
     return badTexture;
   }
 
-  if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
-      !alreadyLoadedImages.find(name)->second.expired())
-    return alreadyLoadedImages.find(name)->second.lock();
+  if (CachedTexture* cachedTexture = FindCachedTexture(name)) {
+    cacheStats.hits++;
+    MarkAsUsed(*cachedTexture);
+    return cachedTexture->texture;
+  }
 
   std::cout << "ImageManager: Loading " << name << ".";
 
@@ -43,19 +52,17 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
     ImageResource& image =
         dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
 
+    cacheStats.misses++;
     auto texture = std::make_shared<SFMLTextureWrapper>();
-    ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), texture->image);
-    texture->texture.loadFromImage(texture->image);
-    texture->texture.setSmooth(image.smooth);
-
-    alreadyLoadedImages[name] = texture;
-#if defined(GD_IDE_ONLY)
-    if (preventUnloading)
-      unloadingPreventer.push_back(
-          texture);  // If unload prevention is activated, add the image to the
-                     // list dedicated to prevent images from being unloaded.
-#endif
+    if (image.IsInAtlas()) {
+      LoadFromAtlas(image, *texture);
+    } else {
+      ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), texture->image);
+      texture->UpdateFromImage();
+      texture->texture.setSmooth(image.smooth);
+    }
 
+    AddToCache(name, texture);
     return texture;
   } catch (...) {
   }
@@ -66,24 +73,169 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
 }
 
 bool ImageManager::HasLoadedSFMLTexture(const gd::String& name) const {
-  if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
-      !alreadyLoadedImages.find(name)->second.expired())
-    return true;
-
-  return false;
+  return FindCachedTexture(name) != nullptr;
 }
 
 void ImageManager::SetSFMLTextureAsPermanentlyLoaded(
     const gd::String& name,
     std::shared_ptr<SFMLTextureWrapper>& texture) const {
-  if (alreadyLoadedImages.find(name) == alreadyLoadedImages.end() ||
-      alreadyLoadedImages.find(name)->second.expired())
-    alreadyLoadedImages[name] = texture;
+  if (!FindCachedTexture(name)) AddToCache(name, texture);
 
   if (permanentlyLoadedImages.find(name) == permanentlyLoadedImages.end())
     permanentlyLoadedImages[name] = texture;
 }
 
+std::shared_ptr<SFMLTextureWrapper> ImageManager::AddLoadedSFMLTexture(
+    const gd::String& name,
+    std::shared_ptr<SFMLTextureWrapper> texture) const {
+  if (CachedTexture* cachedTexture = FindCachedTexture(name))
+    return cachedTexture->texture;
+
+  AddToCache(name, texture);
+  return texture;
+}
+
+std::shared_ptr<SFMLTextureWrapper> ImageManager::AddLoadedAtlas(
+    const gd::String& file,
+    std::shared_ptr<SFMLTextureWrapper> atlas) const {
+  auto it = loadedAtlases.find(file);
+  if (it != loadedAtlases.end()) {
+    if (std::shared_ptr<SFMLTextureWrapper> alreadyLoadedAtlas =
+            it->second.atlas.lock())
+      return alreadyLoadedAtlas;
+  }
+
+  AddToLoadedAtlases(file, atlas);
+  return atlas;
+}
+
+void ImageManager::PinSFMLTexture(const gd::String& name) const {
+  GetSFMLTexture(name);
+  if (CachedTexture* cachedTexture = FindCachedTexture(name))
+    cachedTexture->pinsCount++;
+}
+
+void ImageManager::UnpinSFMLTexture(const gd::String& name) const {
+  CachedTexture* cachedTexture = FindCachedTexture(name);
+  if (cachedTexture && cachedTexture->pinsCount > 0)
+    cachedTexture->pinsCount--;
+}
+
+void ImageManager::SetTextureCacheBudget(std::size_t budget) const {
+  cacheBudget = budget;
+  TrimTextureCache();
+}
+
+void ImageManager::TrimTextureCache() const {
+  ReleaseUnloadedAtlases();
+#if defined(GD_IDE_ONLY)
+  if (preventUnloading) return;
+#endif
+
+  // Unload, starting from the least recently used, the textures only
+  // referenced by the cache (and the atlases when their last image is
+  // unloaded).
+  auto it = lruImages.end();
+  while (cacheStats.residentBytes > cacheBudget && it != lruImages.begin()) {
+    --it;
+    CachedTexture& cachedTexture = alreadyLoadedImages.find(*it)->second;
+    if (cachedTexture.pinsCount > 0 || cachedTexture.texture.use_count() > 1)
+      continue;
+
+    cacheStats.residentBytes -= cachedTexture.bytes;
+    cacheStats.texturesCount--;
+    cacheStats.evictions++;
+    bool inAtlas = cachedTexture.texture->atlas != nullptr;
+    alreadyLoadedImages.erase(*it);
+    it = lruImages.erase(it);
+    if (inAtlas) ReleaseUnloadedAtlases();
+  }
+}
+
+void ImageManager::ResetTextureCacheStats() const {
+  cacheStats.hits = 0;
+  cacheStats.misses = 0;
+  cacheStats.evictions = 0;
+}
+
+ImageManager::CachedTexture* ImageManager::FindCachedTexture(
+    const gd::String& name) const {
+  auto it = alreadyLoadedImages.find(name);
+  return it != alreadyLoadedImages.end() ? &it->second : nullptr;
+}
+
+void ImageManager::AddToCache(
+    const gd::String& name,
+    std::shared_ptr<SFMLTextureWrapper> texture) const {
+  CachedTexture& cachedTexture = alreadyLoadedImages[name];
+  cachedTexture.texture = texture;
+  cachedTexture.bytes = EstimateBytes(*texture);
+  cachedTexture.pinsCount = 0;
+  cachedTexture.usage = lruImages.insert(lruImages.begin(), name);
+
+  cacheStats.residentBytes += cachedTexture.bytes;
+  cacheStats.texturesCount++;
+  TrimTextureCache();
+}
+
+void ImageManager::LoadFromAtlas(const gd::ImageResource& image,
+                                 SFMLTextureWrapper& texture) const {
+  std::shared_ptr<SFMLTextureWrapper> atlas;
+  auto it = loadedAtlases.find(image.GetAtlasFile());
+  if (it != loadedAtlases.end()) atlas = it->second.atlas.lock();
+  if (!atlas) {
+    // The image of the atlas is kept to extract the other images it contains.
+    atlas = std::make_shared<SFMLTextureWrapper>();
+    ResourcesLoader::Get()->LoadSFMLImage(image.GetAtlasFile(), atlas->image);
+    atlas->texture.loadFromImage(atlas->image);
+    atlas->texture.setSmooth(image.smooth);
+    AddToLoadedAtlases(image.GetAtlasFile(), atlas);
+  }
+
+  texture.atlasRect = sf::IntRect(image.GetAtlasX(),
+                                  image.GetAtlasY(),
+                                  image.GetAtlasWidth(),
+                                  image.GetAtlasHeight());
+  texture.image.create(image.GetAtlasWidth(), image.GetAtlasHeight());
+  texture.image.copy(atlas->image, 0, 0, texture.atlasRect);
+  texture.collisionMask.Build(texture.image);
+  texture.atlas = atlas;
+}
+
+void ImageManager::AddToLoadedAtlases(
+    const gd::String& file,
+    std::shared_ptr<SFMLTextureWrapper> atlas) const {
+  // An atlas unloaded without being noticed yet is replaced.
+  ReleaseUnloadedAtlases();
+
+  LoadedAtlas& loadedAtlas = loadedAtlases[file];
+  loadedAtlas.atlas = atlas;
+  loadedAtlas.bytes = EstimateBytes(*atlas);
+  cacheStats.residentBytes += loadedAtlas.bytes;
+}
+
+void ImageManager::ReleaseUnloadedAtlases() const {
+  for (auto it = loadedAtlases.begin(); it != loadedAtlases.end();) {
+    if (it->second.atlas.expired()) {
+      cacheStats.residentBytes -= it->second.bytes;
+      it = loadedAtlases.erase(it);
+    } else
+      ++it;
+  }
+}
+
+void ImageManager::MarkAsUsed(CachedTexture& cachedTexture) const {
+  lruImages.splice(lruImages.begin(), lruImages, cachedTexture.usage);
+}
+
+std::size_t ImageManager::EstimateBytes(const SFMLTextureWrapper& texture) {
+  // 4 bytes by pixel in the image, and as much for the texture (unless the
+  // image is in an atlas, whose memory is counted once for all its images).
+  std::size_t imageBytes = static_cast<std::size_t>(texture.image.getSize().x) *
+                           texture.image.getSize().y * 4;
+  return texture.atlas ? imageBytes : imageBytes * 2;
+}
+
 void ImageManager::ReloadImage(const gd::String& name) const {
   if (!resourcesManager) {
     std::cout << "ImageManager has no ResourcesManager associated with.";
@@ -92,13 +244,12 @@ void ImageManager::ReloadImage(const gd::String& name) const {
 
   // Verify if image is in memory. If not, it will be automatically reloaded
   // when necessary.
-  if (alreadyLoadedImages.find(name) == alreadyLoadedImages.end() ||
-      alreadyLoadedImages.find(name)->second.expired())
-    return;
+  CachedTexture* cachedTexture = FindCachedTexture(name);
+  if (!cachedTexture) return;
 
   // Image still in memory, get it and update it.
-  std::shared_ptr<SFMLTextureWrapper> oldTexture =
-      alreadyLoadedImages.find(name)->second.lock();
+  std::shared_ptr<SFMLTextureWrapper> oldTexture = cachedTexture->texture;
+  cacheStats.residentBytes -= cachedTexture->bytes;
 
   try {
     ImageResource& image =
@@ -107,9 +258,12 @@ void ImageManager::ReloadImage(const gd::String& name) const {
     std::cout << "ImageManager: Reload " << name << std::endl;
 
     ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), oldTexture->image);
-    oldTexture->texture.loadFromImage(oldTexture->image);
+    oldTexture->UpdateFromImage();
     oldTexture->texture.setSmooth(image.smooth);
 
+    cachedTexture->bytes = EstimateBytes(*oldTexture);
+    cacheStats.residentBytes += cachedTexture->bytes;
+    ReleaseUnloadedAtlases();  // The image is not in its atlas anymore.
     return;
   } catch (...) { /*The ressource is not an image*/
   }
@@ -118,6 +272,9 @@ void ImageManager::ReloadImage(const gd::String& name) const {
   std::cout << "ImageManager: " << name << " is not available anymore."
             << std::endl;
   *oldTexture = *badTexture;
+  cachedTexture->bytes = EstimateBytes(*oldTexture);
+  cacheStats.residentBytes += cachedTexture->bytes;
+  ReleaseUnloadedAtlases();
 }
 
 std::shared_ptr<OpenGLTextureWrapper> ImageManager::GetOpenGLTexture(
@@ -163,33 +320,31 @@ void ImageManager::LoadPermanentImages() {
 }
 
 #if defined(GD_IDE_ONLY)
-void ImageManager::PreventImagesUnloading() {
-  preventUnloading = true;
-  for (auto it = alreadyLoadedImages.begin(); it != alreadyLoadedImages.end();
-       ++it) {
-    std::shared_ptr<SFMLTextureWrapper> image = (it->second).lock();
-    if (image != std::shared_ptr<SFMLTextureWrapper>())
-      unloadingPreventer.push_back(image);
-  }
-}
+void ImageManager::PreventImagesUnloading() { preventUnloading = true; }
 
 void ImageManager::EnableImagesUnloading() {
   preventUnloading = false;
-  unloadingPreventer
-      .clear();  // Images which are not used anymore will thus be destroyed (As
-                 // no shared pointer will be pointing to them).
+  TrimTextureCache();  // Images which are not used anymore can be unloaded.
 }
 #endif
 
 }  // namespace gd
 
 SFMLTextureWrapper::SFMLTextureWrapper(const sf::Texture& texture_)
-    : texture(texture_), image(texture.copyToImage()) {}
+    : texture(texture_), image(texture.copyToImage()) {
+  collisionMask.Build(image);
+}
 
 SFMLTextureWrapper::SFMLTextureWrapper() {}
 
 SFMLTextureWrapper::~SFMLTextureWrapper() {}
 
+void SFMLTextureWrapper::UpdateFromImage() {
+  atlas.reset();
+  texture.loadFromImage(image);
+  collisionMask.Build(image);
+}
+
 OpenGLTextureWrapper::OpenGLTextureWrapper(
     std::shared_ptr<SFMLTextureWrapper> sfmlTexture_) {
   sfmlTexture = sfmlTexture_;
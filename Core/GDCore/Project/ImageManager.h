@@ -11,10 +11,14 @@
 #include <SFML/OpenGL.hpp>
 #include <SFML/System.hpp>
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
 #include <vector>
+#include "GDCore/Project/CollisionMask.h"
 #include "GDCore/String.h"
 namespace gd {
+class ImageResource;
 class ResourcesManager;
 }
 class OpenGLTextureWrapper;
@@ -23,14 +27,38 @@ class SFMLTextureWrapper;
 
 namespace gd {
 
+/**
+ * \brief Statistics about the textures cached by a gd::ImageManager.
+ *
+ * \see gd::ImageManager::GetTextureCacheStats
+ * \ingroup ResourcesManagement
+ */
+struct GD_CORE_API TextureCacheStats {
+  TextureCacheStats()
+      : residentBytes(0), texturesCount(0), hits(0), misses(0), evictions(0){};
+
+  std::size_t residentBytes;  ///< The estimated memory used by the loaded
+                              ///< textures and their images, including the
+                              ///< texture atlases.
+  std::size_t texturesCount;  ///< The number of loaded textures.
+  std::size_t hits;  ///< The number of textures requested while loaded.
+  std::size_t misses;  ///< The number of textures requested while not loaded.
+  std::size_t evictions;  ///< The number of textures unloaded by the cache.
+};
+
 /**
  * \brief Manage images for the IDE as well as at runtime for GD C++ Platform,
  * providing an easy way to get SFML images or OpenGL textures.
  *
  * Image manager is used by objects to obtain their images from the image name.
  *
- * Images are loaded dynamically when necessary, and are unloaded if there is no
- * more shared_ptr pointing on an image.
+ * Images are loaded dynamically when necessary. Images packed in a texture
+ * atlas (see gd::ImageResource::IsInAtlas) are loaded from their atlas, and
+ * share its texture. Images which are not used
+ * anymore (no shared_ptr outside of the ImageManager is pointing on them) stay
+ * in a cache, so that they are not loaded again if they are used soon after.
+ * When the estimated memory used by the loaded images exceeds the budget of
+ * the cache, the least recently used images are unloaded (see TrimTextureCache).
  *
  * You should in particular be interested by gd::ImageManager::GetOpenGLTexture
  * and gd::ImageManager::GetSFMLTexture.
@@ -93,6 +121,87 @@ class GD_CORE_API ImageManager {
       const gd::String& name,
       std::shared_ptr<SFMLTextureWrapper>& texture) const;
 
+  /**
+   * \brief Add a texture loaded elsewhere (for example by a
+   * ResourcesPreloader) to loaded images, so that it can be accessed thanks to
+   * ImageManager::GetSFMLTexture, unless a texture with the same name is already
+   * loaded.
+   *
+   * Like any other image, the texture can be unloaded by the cache when it is
+   * not used anymore.
+   * \return The texture now used for \a name.
+   */
+  std::shared_ptr<SFMLTextureWrapper> AddLoadedSFMLTexture(
+      const gd::String& name,
+      std::shared_ptr<SFMLTextureWrapper> texture) const;
+
+  /**
+   * \brief Add a texture atlas loaded elsewhere (for example by a
+   * ResourcesPreloader), so that the images it contains are loaded from it,
+   * unless the atlas stored in \a file is already loaded.
+   *
+   * Like the atlases loaded by the ImageManager, the atlas stays loaded as
+   * long as images it contains are loaded.
+   * \return The texture atlas now used for \a file.
+   */
+  std::shared_ptr<SFMLTextureWrapper> AddLoadedAtlas(
+      const gd::String& file,
+      std::shared_ptr<SFMLTextureWrapper> atlas) const;
+
+  /**
+   * \brief Load, if necessary, the texture with the specified name and prevent
+   * the cache from unloading it until UnpinSFMLTexture is called (as many times
+   * as PinSFMLTexture was called).
+   */
+  void PinSFMLTexture(const gd::String& name) const;
+
+  /**
+   * \brief Allow the cache to unload a texture pinned with PinSFMLTexture,
+   * when it is not used anymore.
+   */
+  void UnpinSFMLTexture(const gd::String& name) const;
+
+  /**
+   * \brief Set the memory, in bytes, that the loaded textures should not
+   * exceed. Textures still used or pinned are never unloaded, even if the
+   * budget is exceeded.
+   *
+   * The memory used by a texture is estimated as 4 bytes by pixel for the
+   * texture, and as much for its image. Images in a texture atlas only count
+   * their image, and each atlas is counted once (for its texture and its
+   * image) as long as images it contains are loaded.
+   */
+  void SetTextureCacheBudget(std::size_t budget) const;
+
+  /**
+   * \brief Return the memory, in bytes, that the loaded textures should not
+   * exceed.
+   */
+  std::size_t GetTextureCacheBudget() const { return cacheBudget; }
+
+  /**
+   * \brief Unload the least recently used textures, not used anymore and not
+   * pinned, until the memory they use is in the budget.
+   *
+   * Called automatically when a texture is loaded. Can be called after
+   * releasing a lot of textures (for example, after a scene is destroyed) to
+   * free the memory sooner.
+   */
+  void TrimTextureCache() const;
+
+  /**
+   * \brief Return the statistics of the texture cache.
+   */
+  const TextureCacheStats& GetTextureCacheStats() const { return cacheStats; }
+
+  /**
+   * \brief Reset the hits, misses and evictions counted in the statistics of
+   * the texture cache.
+   */
+  void ResetTextureCacheStats() const;
+
+  static const std::size_t defaultTextureCacheBudget;
+
   /**
    * \brief Reload a single image from the game resources
    */
@@ -113,24 +222,76 @@ class GD_CORE_API ImageManager {
 #endif
 
  private:
-  mutable std::map<gd::String, std::weak_ptr<SFMLTextureWrapper> >
+  /**
+   * \brief A texture loaded in memory.
+   */
+  struct CachedTexture {
+    std::shared_ptr<SFMLTextureWrapper> texture;
+    std::size_t bytes;  ///< The estimated memory used by the texture.
+    std::size_t pinsCount;
+    std::list<gd::String>::iterator usage;  ///< The position in lruImages.
+  };
+
+  /**
+   * \brief Return the loaded texture with the specified name, or nullptr.
+   */
+  CachedTexture* FindCachedTexture(const gd::String& name) const;
+
+  /**
+   * \brief Add a texture to the loaded textures and unload the textures
+   * exceeding the budget.
+   */
+  void AddToCache(const gd::String& name,
+                  std::shared_ptr<SFMLTextureWrapper> texture) const;
+
+  /**
+   * \brief Mark a loaded texture as the most recently used.
+   */
+  void MarkAsUsed(CachedTexture& cachedTexture) const;
+
+  /**
+   * \brief Load an image packed in a texture atlas, from the atlas.
+   */
+  void LoadFromAtlas(const gd::ImageResource& image,
+                     SFMLTextureWrapper& texture) const;
+
+  /**
+   * \brief Add an atlas to the loaded atlases, counting the memory it uses.
+   */
+  void AddToLoadedAtlases(const gd::String& file,
+                          std::shared_ptr<SFMLTextureWrapper> atlas) const;
+
+  /**
+   * \brief Stop counting the memory used by the atlases that were unloaded
+   * (with the last image they contained).
+   */
+  void ReleaseUnloadedAtlases() const;
+
+  static std::size_t EstimateBytes(const SFMLTextureWrapper& texture);
+
+  mutable std::map<gd::String, CachedTexture>
       alreadyLoadedImages;  ///< Reference all images loaded in memory.
+  mutable std::list<gd::String> lruImages;  ///< The names of the loaded
+                                            ///< images, the most recently used
+                                            ///< first.
+  mutable std::size_t cacheBudget;
+  mutable TextureCacheStats cacheStats;
+  /**
+   * \brief A texture atlas, kept loaded by the images it contains.
+   */
+  struct LoadedAtlas {
+    std::weak_ptr<SFMLTextureWrapper> atlas;
+    std::size_t bytes;  ///< The estimated memory used by the atlas.
+  };
+
+  mutable std::map<gd::String, LoadedAtlas>
+      loadedAtlases;  ///< The texture atlases, by file.
   mutable std::map<gd::String, std::shared_ptr<SFMLTextureWrapper> >
       permanentlyLoadedImages;  ///< Contains (smart) pointers to images which
                                 ///< should stay loaded even if they are not
                                 ///< (currently) used.
 
 #if defined(GD_IDE_ONLY)
-
-  /** This list is filled, when PreventImagesUnloading is called, with images
-   * already loaded in memory ( and any image loaded after the call to
-   * PreventImagesUnloading ). It will thus prevent these images from being
-   * unloaded. This list is destroyed when EnableImagesUnloading is called.
-   *
-   * \see PreventImagesUnloading
-   * \see EnableImagesUnloading
-   */
-  mutable std::vector<std::shared_ptr<SFMLTextureWrapper> > unloadingPreventer;
   bool preventUnloading;  ///< True if no images must be currently unloaded.
 #endif
 
@@ -158,10 +319,40 @@ class GD_CORE_API SFMLTextureWrapper {
   SFMLTextureWrapper();
   ~SFMLTextureWrapper();
 
-  sf::Texture texture;
+  /**
+   * \brief Update the texture and the collision mask from the image. Must be
+   * called after the image is changed.
+   *
+   * \note If the image was in a texture atlas, it now has its own texture.
+   */
+  void UpdateFromImage();
+
+  /**
+   * \brief Return the texture to draw: the texture of the atlas containing the
+   * image if the image is in an atlas, the texture of the wrapper otherwise.
+   */
+  const sf::Texture& GetDrawableTexture() const {
+    return atlas ? atlas->texture : texture;
+  }
+
+  /**
+   * \brief Return the area of GetDrawableTexture() covered by the image.
+   */
+  sf::IntRect GetDrawableTextureRect() const {
+    return atlas ? atlasRect
+                 : sf::IntRect(0, 0, texture.getSize().x, texture.getSize().y);
+  }
+
+  sf::Texture texture;  ///< The texture of the image, empty if the image is in
+                        ///< an atlas (see GetDrawableTexture).
   sf::Image image;  ///< Associated sfml image, used for pixel perfect collision
                     ///< for example. If you update the image, call
-                    ///< LoadFromImage on texture to update it also.
+                    ///< UpdateFromImage to update the texture also.
+  gd::CollisionMask collisionMask;  ///< The opaque pixels of the image, used
+                                    ///< for pixel perfect collisions.
+  std::shared_ptr<SFMLTextureWrapper> atlas;  ///< The texture atlas containing
+                                              ///< the image, if any.
+  sf::IntRect atlasRect;  ///< The area of the atlas covered by the image.
 };
 
 /**
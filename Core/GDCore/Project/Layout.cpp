@@ -22,6 +22,7 @@
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/NameIndex.h"
 #include "GDCore/Tools/PolymorphicClone.h"
 
 using namespace std;
@@ -62,6 +63,7 @@ Layout::Layout()
 }
 
 void Layout::SetName(const gd::String& name_) {
+  if (name_ != name) gd::NameIndex::NotifyNameChanged(name);
   name = name_;
   mangledName = gd::SceneNameMangler::Get()->GetMangledSceneName(name);
 };
@@ -394,6 +396,7 @@ void Layout::Init(const Layout& other) {
   variables = other.GetVariables();
 
   initialObjects = gd::Clone(other.initialObjects);
+  objectsIndex.Invalidate();
 
   behaviorsSharedData.clear();
   for (const auto& it : other.behaviorsSharedData) {
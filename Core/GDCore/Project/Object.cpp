@@ -9,6 +9,7 @@
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/Tools/NameIndex.h"
 #if defined(GD_IDE_ONLY)
 #include "GDCore/Project/PropertyDescriptor.h"
 #endif
@@ -19,8 +20,15 @@ Object::~Object() {}
 
 Object::Object(const gd::String& name_) : name(name_) {}
 
+void Object::SetName(const gd::String& name_) {
+  if (name_ == name) return;
+
+  gd::NameIndex::NotifyNameChanged(name);
+  name = name_;
+}
+
 void Object::Init(const gd::Object& object) {
-  name = object.name;
+  SetName(object.name);
   type = object.type;
   objectVariables = object.objectVariables;
   tags = object.tags;
@@ -109,7 +117,7 @@ Object::GetInitialInstanceProperties(const gd::InitialInstance& instance,
 void Object::UnserializeFrom(gd::Project& project,
                              const SerializerElement& element) {
   type = element.GetStringAttribute("type");
-  name = element.GetStringAttribute("name", name, "nom");
+  SetName(element.GetStringAttribute("name", name, "nom"));
   tags = element.GetStringAttribute("tags");
 
   objectVariables.UnserializeFrom(
@@ -28,6 +28,7 @@ void ObjectsContainer::SerializeObjectsTo(SerializerElement& element) const {
 void ObjectsContainer::UnserializeObjectsFrom(
     gd::Project& project, const SerializerElement& element) {
   initialObjects.clear();
+  objectsIndex.Invalidate();
   element.ConsiderAsArrayOf("object", "Objet");
   for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
     const SerializerElement& objectElement = element.GetChild(i);
@@ -46,19 +47,13 @@ void ObjectsContainer::UnserializeObjectsFrom(
 }
 
 bool ObjectsContainer::HasObjectNamed(const gd::String& name) const {
-  return (find_if(initialObjects.begin(),
-                  initialObjects.end(),
-                  bind2nd(gd::ObjectHasName(), name)) != initialObjects.end());
+  return objectsIndex.Find(initialObjects, name) != gd::String::npos;
 }
 gd::Object& ObjectsContainer::GetObject(const gd::String& name) {
-  return *(*find_if(initialObjects.begin(),
-                    initialObjects.end(),
-                    bind2nd(gd::ObjectHasName(), name)));
+  return *initialObjects[objectsIndex.Find(initialObjects, name)];
 }
 const gd::Object& ObjectsContainer::GetObject(const gd::String& name) const {
-  return *(*find_if(initialObjects.begin(),
-                    initialObjects.end(),
-                    bind2nd(gd::ObjectHasName(), name)));
+  return *initialObjects[objectsIndex.Find(initialObjects, name)];
 }
 gd::Object& ObjectsContainer::GetObject(std::size_t index) {
   return *initialObjects[index];
@@ -67,10 +62,7 @@ const gd::Object& ObjectsContainer::GetObject(std::size_t index) const {
   return *initialObjects[index];
 }
 std::size_t ObjectsContainer::GetObjectPosition(const gd::String& name) const {
-  for (std::size_t i = 0; i < initialObjects.size(); ++i) {
-    if (initialObjects[i]->GetName() == name) return i;
-  }
-  return gd::String::npos;
+  return objectsIndex.Find(initialObjects, name);
 }
 std::size_t ObjectsContainer::GetObjectsCount() const {
   return initialObjects.size();
@@ -80,10 +72,12 @@ gd::Object& ObjectsContainer::InsertNewObject(gd::Project& project,
                                               const gd::String& objectType,
                                               const gd::String& name,
                                               std::size_t position) {
+  bool indexUpToDate = objectsIndex.IsUpToDate(initialObjects);
+  if (position > initialObjects.size()) position = initialObjects.size();
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
-      position < initialObjects.size() ? initialObjects.begin() + position
-                                       : initialObjects.end(),
+      initialObjects.begin() + position,
       project.GetCurrentPlatform().CreateObject(objectType, name))));
+  objectsIndex.InsertedAt(initialObjects, position, indexUpToDate);
 
   return newlyCreatedObject;
 }
@@ -91,10 +85,12 @@ gd::Object& ObjectsContainer::InsertNewObject(gd::Project& project,
 
 gd::Object& ObjectsContainer::InsertObject(const gd::Object& object,
                                            std::size_t position) {
+  bool indexUpToDate = objectsIndex.IsUpToDate(initialObjects);
+  if (position > initialObjects.size()) position = initialObjects.size();
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
-      position < initialObjects.size() ? initialObjects.begin() + position
-                                       : initialObjects.end(),
+      initialObjects.begin() + position,
       std::unique_ptr<gd::Object>(object.Clone()))));
+  objectsIndex.InsertedAt(initialObjects, position, indexUpToDate);
 
   return newlyCreatedObject;
 }
@@ -107,6 +103,7 @@ void ObjectsContainer::SwapObjects(std::size_t firstObjectIndex,
 
   std::iter_swap(initialObjects.begin() + firstObjectIndex,
                  initialObjects.begin() + secondObjectIndex);
+  objectsIndex.Invalidate();
 }
 
 void ObjectsContainer::MoveObject(std::size_t oldIndex, std::size_t newIndex) {
@@ -116,36 +113,36 @@ void ObjectsContainer::MoveObject(std::size_t oldIndex, std::size_t newIndex) {
   std::unique_ptr<gd::Object> object = std::move(initialObjects[oldIndex]);
   initialObjects.erase(initialObjects.begin() + oldIndex);
   initialObjects.insert(initialObjects.begin() + newIndex, std::move(object));
+  objectsIndex.Invalidate();
 }
 
 void ObjectsContainer::RemoveObject(const gd::String& name) {
-  std::vector<std::unique_ptr<gd::Object> >::iterator objectIt =
-      find_if(initialObjects.begin(),
-              initialObjects.end(),
-              bind2nd(ObjectHasName(), name));
-  if (objectIt == initialObjects.end()) return;
+  std::size_t position = objectsIndex.Find(initialObjects, name);
+  if (position == gd::String::npos) return;
 
-  initialObjects.erase(objectIt);
+  initialObjects.erase(initialObjects.begin() + position);
+  objectsIndex.RemovedAt(initialObjects, position, name);
 }
 
 void ObjectsContainer::MoveObjectToAnotherContainer(
     const gd::String& name,
     gd::ObjectsContainer& newContainer,
     std::size_t newPosition) {
-  std::vector<std::unique_ptr<gd::Object> >::iterator objectIt =
-      find_if(initialObjects.begin(),
-              initialObjects.end(),
-              bind2nd(ObjectHasName(), name));
-  if (objectIt == initialObjects.end()) return;
+  std::size_t position = objectsIndex.Find(initialObjects, name);
+  if (position == gd::String::npos) return;
 
-  std::unique_ptr<gd::Object> object = std::move(*objectIt);
-  initialObjects.erase(objectIt);
+  std::unique_ptr<gd::Object> object = std::move(initialObjects[position]);
+  initialObjects.erase(initialObjects.begin() + position);
+  objectsIndex.RemovedAt(initialObjects, position, name);
 
+  bool newContainerIndexUpToDate =
+      newContainer.objectsIndex.IsUpToDate(newContainer.initialObjects);
+  if (newPosition > newContainer.initialObjects.size())
+    newPosition = newContainer.initialObjects.size();
   newContainer.initialObjects.insert(
-      newPosition < newContainer.initialObjects.size()
-          ? newContainer.initialObjects.begin() + newPosition
-          : newContainer.initialObjects.end(),
-      std::move(object));
+      newContainer.initialObjects.begin() + newPosition, std::move(object));
+  newContainer.objectsIndex.InsertedAt(
+      newContainer.initialObjects, newPosition, newContainerIndexUpToDate);
 }
 
 }  // namespace gd
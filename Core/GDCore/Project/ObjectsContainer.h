@@ -9,6 +9,7 @@
 #include <vector>
 #include "GDCore/String.h"
 #include "GDCore/Project/ObjectGroupsContainer.h"
+#include "GDCore/Tools/NameIndex.h"
 namespace gd {
 class Object;
 class Project;
@@ -142,6 +143,10 @@ class GD_CORE_API ObjectsContainer {
 
   /**
    * Provide a raw access to the vector containing the objects
+   *
+   * \note Objects can be added, removed or moved in the vector, but an object
+   * must not be replaced by another one having a different name: use
+   * RemoveObject and InsertObject instead.
    */
   std::vector<std::unique_ptr<gd::Object> >& GetObjects() {
     return initialObjects;
@@ -193,6 +198,8 @@ class GD_CORE_API ObjectsContainer {
  protected:
   std::vector<std::unique_ptr<gd::Object> >
       initialObjects;  ///< Objects contained.
+  gd::NameIndex objectsIndex;  ///< Positions of the objects in initialObjects,
+                               ///< by name.
   gd::ObjectGroupsContainer objectGroups;
 };
 
@@ -212,27 +212,20 @@ bool Project::RemovePlatform(const gd::String& platformName) {
 #endif
 
 bool Project::HasLayoutNamed(const gd::String& name) const {
-  return (find_if(scenes.begin(),
-                  scenes.end(),
-                  bind2nd(gd::LayoutHasName(), name)) != scenes.end());
+  return layoutsIndex.Find(scenes, name) != gd::String::npos;
 }
 gd::Layout& Project::GetLayout(const gd::String& name) {
-  return *(*find_if(
-      scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name)));
+  return *scenes[layoutsIndex.Find(scenes, name)];
 }
 const gd::Layout& Project::GetLayout(const gd::String& name) const {
-  return *(*find_if(
-      scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name)));
+  return *scenes[layoutsIndex.Find(scenes, name)];
 }
 gd::Layout& Project::GetLayout(std::size_t index) { return *scenes[index]; }
 const gd::Layout& Project::GetLayout(std::size_t index) const {
   return *scenes[index];
 }
 std::size_t Project::GetLayoutPosition(const gd::String& name) const {
-  for (std::size_t i = 0; i < scenes.size(); ++i) {
-    if (scenes[i]->GetName() == name) return i;
-  }
-  return gd::String::npos;
+  return layoutsIndex.Find(scenes, name);
 }
 std::size_t Project::GetLayoutsCount() const { return scenes.size(); }
 
@@ -241,16 +234,19 @@ void Project::SwapLayouts(std::size_t first, std::size_t second) {
   if (first >= scenes.size() || second >= scenes.size()) return;
 
   std::iter_swap(scenes.begin() + first, scenes.begin() + second);
+  layoutsIndex.Invalidate();
 }
 #endif
 
 gd::Layout& Project::InsertNewLayout(const gd::String& name,
                                      std::size_t position) {
-  gd::Layout& newlyInsertedLayout = *(*(scenes.emplace(
-      position < scenes.size() ? scenes.begin() + position : scenes.end(),
-      new Layout())));
+  bool indexUpToDate = layoutsIndex.IsUpToDate(scenes);
+  if (position > scenes.size()) position = scenes.size();
+  gd::Layout& newlyInsertedLayout =
+      *(*(scenes.emplace(scenes.begin() + position, new Layout())));
 
   newlyInsertedLayout.SetName(name);
+  layoutsIndex.InsertedAt(scenes, position, indexUpToDate);
 #if defined(GD_IDE_ONLY)
   newlyInsertedLayout.UpdateBehaviorsSharedData(*this);
 #endif
@@ -260,9 +256,11 @@ gd::Layout& Project::InsertNewLayout(const gd::String& name,
 
 gd::Layout& Project::InsertLayout(const gd::Layout& layout,
                                   std::size_t position) {
-  gd::Layout& newlyInsertedLayout = *(*(scenes.emplace(
-      position < scenes.size() ? scenes.begin() + position : scenes.end(),
-      new Layout(layout))));
+  bool indexUpToDate = layoutsIndex.IsUpToDate(scenes);
+  if (position > scenes.size()) position = scenes.size();
+  gd::Layout& newlyInsertedLayout =
+      *(*(scenes.emplace(scenes.begin() + position, new Layout(layout))));
+  layoutsIndex.InsertedAt(scenes, position, indexUpToDate);
 
 #if defined(GD_IDE_ONLY)
   newlyInsertedLayout.UpdateBehaviorsSharedData(*this);
@@ -272,11 +270,11 @@ gd::Layout& Project::InsertLayout(const gd::Layout& layout,
 }
 
 void Project::RemoveLayout(const gd::String& name) {
-  std::vector<std::unique_ptr<gd::Layout> >::iterator scene =
-      find_if(scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name));
-  if (scene == scenes.end()) return;
+  std::size_t position = layoutsIndex.Find(scenes, name);
+  if (position == gd::String::npos) return;
 
-  scenes.erase(scene);
+  scenes.erase(scenes.begin() + position);
+  layoutsIndex.RemovedAt(scenes, position, name);
 }
 
 #if defined(GD_IDE_ONLY)
@@ -771,6 +769,7 @@ void Project::UnserializeFrom(const SerializerElement& element) {
   GetVariables().UnserializeFrom(element.GetChild("variables", 0, "Variables"));
 
   scenes.clear();
+  layoutsIndex.Invalidate();
   const SerializerElement& layoutsElement =
       element.GetChild("layouts", 0, "Scenes");
   layoutsElement.ConsiderAsArrayOf("layout", "Scene");
@@ -1093,8 +1092,10 @@ void Project::Init(const gd::Project& game) {
   imageManager->SetResourcesManager(&resourcesManager);
 
   initialObjects = gd::Clone(game.initialObjects);
+  objectsIndex.Invalidate();
 
   scenes = gd::Clone(game.scenes);
+  layoutsIndex.Invalidate();
 
 #if defined(GD_IDE_ONLY)
   externalEvents = gd::Clone(game.externalEvents);
@@ -16,6 +16,7 @@
 #include "GDCore/Project/ResourcesManager.h"
 #include "GDCore/Project/VariablesContainer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/NameIndex.h"
 namespace gd {
 class Platform;
 class Layout;
@@ -944,6 +945,7 @@ class GD_CORE_API Project : public ObjectsContainer {
       sizeOnStartupMode;  ///< How to adapt the game size to the screen. Can be
                           ///< "adaptWidth", "adaptHeight" or empty
   std::vector<std::unique_ptr<gd::Layout> > scenes;  ///< List of all scenes
+  gd::NameIndex layoutsIndex;  ///< Positions of the layouts in scenes, by name
   gd::VariablesContainer variables;  ///< Initial global variables
   std::vector<std::unique_ptr<gd::ExternalLayout> >
       externalLayouts;  ///< List of all externals layouts
@@ -41,6 +41,7 @@ void ResourcesManager::Init(const ResourcesManager& other) {
   for (std::size_t i = 0; i < other.resources.size(); ++i) {
     resources.push_back(std::shared_ptr<Resource>(other.resources[i]->Clone()));
   }
+  resourcesIndex.Invalidate();
 #if defined(GD_IDE_ONLY)
   folders.clear();
   for (std::size_t i = 0; i < other.folders.size(); ++i) {
@@ -49,20 +50,21 @@ void ResourcesManager::Init(const ResourcesManager& other) {
 #endif
 }
 
-Resource& ResourcesManager::GetResource(const gd::String& name) {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return *resources[i];
-  }
+void Resource::SetName(const gd::String& name_) {
+  if (name_ == name) return;
 
-  return badResource;
+  gd::NameIndex::NotifyNameChanged(name);
+  name = name_;
 }
 
-const Resource& ResourcesManager::GetResource(const gd::String& name) const {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return *resources[i];
-  }
+Resource& ResourcesManager::GetResource(const gd::String& name) {
+  std::size_t position = resourcesIndex.Find(resources, name);
+  return position != gd::String::npos ? *resources[position] : badResource;
+}
 
-  return badResource;
+const Resource& ResourcesManager::GetResource(const gd::String& name) const {
+  std::size_t position = resourcesIndex.Find(resources, name);
+  return position != gd::String::npos ? *resources[position] : badResource;
 }
 
 std::shared_ptr<Resource> ResourcesManager::CreateResource(
@@ -83,11 +85,7 @@ std::shared_ptr<Resource> ResourcesManager::CreateResource(
 }
 
 bool ResourcesManager::HasResource(const gd::String& name) const {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return true;
-  }
-
-  return false;
+  return resourcesIndex.Find(resources, name) != gd::String::npos;
 }
 
 std::vector<gd::String> ResourcesManager::GetAllResourceNames() const {
@@ -129,11 +127,13 @@ bool ImageResource::UpdateProperty(const gd::String& name,
 bool ResourcesManager::AddResource(const gd::Resource& resource) {
   if (HasResource(resource.GetName())) return false;
 
+  bool indexUpToDate = resourcesIndex.IsUpToDate(resources);
   std::shared_ptr<Resource> newResource =
       std::shared_ptr<Resource>(resource.Clone());
   if (newResource == std::shared_ptr<Resource>()) return false;
 
   resources.push_back(newResource);
+  resourcesIndex.InsertedAt(resources, resources.size() - 1, indexUpToDate);
   return true;
 }
 
@@ -142,11 +142,13 @@ bool ResourcesManager::AddResource(const gd::String& name,
                                    const gd::String& kind) {
   if (HasResource(name)) return false;
 
+  bool indexUpToDate = resourcesIndex.IsUpToDate(resources);
   std::shared_ptr<Resource> res = CreateResource(kind);
   res->SetFile(filename);
   res->SetName(name);
 
   resources.push_back(res);
+  resourcesIndex.InsertedAt(resources, resources.size() - 1, indexUpToDate);
 
   return true;
 }
@@ -223,19 +225,18 @@ bool ResourceFolder::MoveResourceDownInList(const gd::String& name) {
 }
 
 bool ResourcesManager::MoveResourceUpInList(const gd::String& name) {
+  resourcesIndex.Invalidate();
   return gd::MoveResourceUpInList(resources, name);
 }
 
 bool ResourcesManager::MoveResourceDownInList(const gd::String& name) {
+  resourcesIndex.Invalidate();
   return gd::MoveResourceDownInList(resources, name);
 }
 
 std::size_t ResourcesManager::GetResourcePosition(
     const gd::String& name) const {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return i;
-  }
-  return gd::String::npos;
+  return resourcesIndex.Find(resources, name);
 }
 
 void ResourcesManager::MoveResource(std::size_t oldIndex,
@@ -245,6 +246,7 @@ void ResourcesManager::MoveResource(std::size_t oldIndex,
   auto resource = resources[oldIndex];
   resources.erase(resources.begin() + oldIndex);
   resources.insert(resources.begin() + newIndex, resource);
+  resourcesIndex.Invalidate();
 }
 
 bool ResourcesManager::MoveFolderUpInList(const gd::String& name) {
@@ -271,11 +273,9 @@ bool ResourcesManager::MoveFolderDownInList(const gd::String& name) {
 
 std::shared_ptr<gd::Resource> ResourcesManager::GetResourceSPtr(
     const gd::String& name) {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return resources[i];
-  }
-
-  return std::shared_ptr<gd::Resource>();
+  std::size_t position = resourcesIndex.Find(resources, name);
+  return position != gd::String::npos ? resources[position]
+                                      : std::shared_ptr<gd::Resource>();
 }
 
 bool ResourcesManager::HasFolder(const gd::String& name) const {
@@ -359,12 +359,11 @@ void ResourceFolder::RemoveResource(const gd::String& name) {
 }
 
 void ResourcesManager::RemoveResource(const gd::String& name) {
-  for (std::size_t i = 0; i < resources.size();) {
-    if (resources[i] != std::shared_ptr<Resource>() &&
-        resources[i]->GetName() == name)
-      resources.erase(resources.begin() + i);
-    else
-      ++i;
+  std::size_t position;
+  while ((position = resourcesIndex.Find(resources, name)) !=
+         gd::String::npos) {
+    resources.erase(resources.begin() + position);
+    resourcesIndex.RemovedAt(resources, position, name);
   }
 
   for (std::size_t i = 0; i < folders.size(); ++i)
@@ -401,6 +400,7 @@ void ResourceFolder::SerializeTo(SerializerElement& element) const {
 
 void ResourcesManager::UnserializeFrom(const SerializerElement& element) {
   resources.clear();
+  resourcesIndex.Invalidate();
   const SerializerElement& resourcesElement =
       element.GetChild("resources", 0, "Resources");
   resourcesElement.ConsiderAsArrayOf("resource", "Resource");
@@ -463,11 +463,34 @@ void ImageResource::SetFile(const gd::String& newFile) {
     file.replace(file.find('\\'), 1, "/");
 }
 
+void ImageResource::SetAtlas(const gd::String& atlasFile_,
+                             unsigned int x,
+                             unsigned int y,
+                             unsigned int width,
+                             unsigned int height) {
+  atlasFile = atlasFile_;
+  atlasX = x;
+  atlasY = y;
+  atlasWidth = width;
+  atlasHeight = height;
+}
+
 void ImageResource::UnserializeFrom(const SerializerElement& element) {
   alwaysLoaded = element.GetBoolAttribute("alwaysLoaded");
   smooth = element.GetBoolAttribute("smoothed");
   SetUserAdded(element.GetBoolAttribute("userAdded"));
   SetFile(element.GetStringAttribute("file"));
+
+  if (element.HasChild("atlas")) {
+    const SerializerElement& atlasElement = element.GetChild("atlas");
+    SetAtlas(atlasElement.GetStringAttribute("file"),
+             atlasElement.GetIntAttribute("x"),
+             atlasElement.GetIntAttribute("y"),
+             atlasElement.GetIntAttribute("width"),
+             atlasElement.GetIntAttribute("height"));
+  } else {
+    RemoveFromAtlas();
+  }
 }
 
 #if defined(GD_IDE_ONLY)
@@ -476,6 +499,15 @@ void ImageResource::SerializeTo(SerializerElement& element) const {
   element.SetAttribute("smoothed", smooth);
   element.SetAttribute("userAdded", IsUserAdded());
   element.SetAttribute("file", GetFile());
+
+  if (IsInAtlas()) {
+    SerializerElement& atlasElement = element.AddChild("atlas");
+    atlasElement.SetAttribute("file", atlasFile);
+    atlasElement.SetAttribute("x", static_cast<int>(atlasX));
+    atlasElement.SetAttribute("y", static_cast<int>(atlasY));
+    atlasElement.SetAttribute("width", static_cast<int>(atlasWidth));
+    atlasElement.SetAttribute("height", static_cast<int>(atlasHeight));
+  }
 }
 #endif
 
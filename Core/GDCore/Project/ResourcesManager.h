@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "GDCore/String.h"
+#include "GDCore/Tools/NameIndex.h"
 namespace gd {
 class Project;
 class ResourceFolder;
@@ -32,7 +33,7 @@ class GD_CORE_API Resource {
 
   /** \brief Change the name of the resource with the name passed as parameter.
    */
-  virtual void SetName(const gd::String& name_) { name = name_; }
+  virtual void SetName(const gd::String& name_);
 
   /** \brief Return the name of the resource.
    */
@@ -156,7 +157,14 @@ class GD_CORE_API Resource {
  */
 class GD_CORE_API ImageResource : public Resource {
  public:
-  ImageResource() : Resource(), smooth(true), alwaysLoaded(false) {
+  ImageResource()
+      : Resource(),
+        smooth(true),
+        alwaysLoaded(false),
+        atlasX(0),
+        atlasY(0),
+        atlasWidth(0),
+        atlasHeight(0) {
     SetKind("image");
   };
   virtual ~ImageResource(){};
@@ -202,10 +210,48 @@ class GD_CORE_API ImageResource : public Resource {
    */
   void SetSmooth(bool enable = true) { smooth = enable; }
 
+  /**
+   * \brief Return true if the image was packed in a texture atlas.
+   * \see gd::ProjectResourcesCopier::PackImagesInAtlases
+   */
+  bool IsInAtlas() const { return !atlasFile.empty(); }
+
+  /**
+   * \brief Return the file of the texture atlas containing the image, or an
+   * empty string if the image is not packed in an atlas.
+   */
+  const gd::String& GetAtlasFile() const { return atlasFile; }
+
+  unsigned int GetAtlasX() const { return atlasX; }
+  unsigned int GetAtlasY() const { return atlasY; }
+  unsigned int GetAtlasWidth() const { return atlasWidth; }
+  unsigned int GetAtlasHeight() const { return atlasHeight; }
+
+  /**
+   * \brief Set the texture atlas containing the image, and the area of the
+   * atlas covered by the image. The file of the resource is still used by
+   * platforms not using atlases.
+   */
+  void SetAtlas(const gd::String& atlasFile_,
+                unsigned int x,
+                unsigned int y,
+                unsigned int width,
+                unsigned int height);
+
+  /**
+   * \brief Forget about the texture atlas containing the image.
+   */
+  void RemoveFromAtlas() { atlasFile.clear(); }
+
   bool smooth;        ///< True if smoothing filter is applied
   bool alwaysLoaded;  ///< True if the image must always be loaded in memory.
  private:
   gd::String file;
+  gd::String atlasFile;  ///< The texture atlas containing the image, if any.
+  unsigned int atlasX;
+  unsigned int atlasY;
+  unsigned int atlasWidth;
+  unsigned int atlasHeight;
 };
 
 /**
@@ -479,6 +525,7 @@ class GD_CORE_API ResourcesManager {
   void Init(const ResourcesManager& other);
 
   std::vector<std::shared_ptr<Resource> > resources;
+  gd::NameIndex resourcesIndex;  ///< Positions of the resources, by name.
 #if defined(GD_IDE_ONLY)
   std::vector<ResourceFolder> folders;
 #endif
@@ -0,0 +1,348 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/JSONReader.h"
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+namespace gd {
+
+namespace {
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool IsEndOfLiteral(char c) {
+  return IsWhitespace(c) || c == ',' || c == '}' || c == ']' || c == ':';
+}
+
+bool IsLiteral(const char* str, std::size_t length, const char* literal) {
+  return length == strlen(literal) && strncmp(str, literal, length) == 0;
+}
+
+int HexDigitValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+void AppendUTF8(std::string& str, unsigned int codePoint) {
+  if (codePoint < 0x80) {
+    str.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    str.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    str.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    str.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+/**
+ * Convert a JSON number having at most 15 significant digits and a small
+ * exponent. Such numbers, and the powers of ten used, are exactly represented
+ * by doubles, so a single multiplication or division gives the correctly
+ * rounded result (i.e: the same as std::istream).
+ * \return false if the number is not valid or can't be converted this way.
+ */
+bool ParseSimpleNumber(const char* str, const char* end, double& number) {
+  static const double powersOf10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  const char* p = str;
+  bool negative = p != end && *p == '-';
+  if (negative) ++p;
+
+  std::uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  for (; p != end && IsDigit(*p); ++p) {
+    hasDigits = true;
+    if (mantissa == 0 && *p == '0') continue;
+    mantissa = mantissa * 10 + (*p - '0');
+    significantDigits++;
+  }
+  if (p != end && *p == '.') {
+    ++p;
+    for (; p != end && IsDigit(*p); ++p) {
+      hasDigits = true;
+      exponent--;
+      if (mantissa == 0 && *p == '0') continue;
+      mantissa = mantissa * 10 + (*p - '0');
+      significantDigits++;
+    }
+  }
+  if (!hasDigits) return false;
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negativeExponent = false;
+    if (p != end && (*p == '+' || *p == '-')) negativeExponent = *p++ == '-';
+    if (p == end || !IsDigit(*p)) return false;
+
+    int explicitExponent = 0;
+    for (; p != end && IsDigit(*p); ++p) {
+      if (explicitExponent < 10000)
+        explicitExponent = explicitExponent * 10 + (*p - '0');
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+  if (p != end || significantDigits > 15) return false;
+
+  if (mantissa == 0) {
+    number = negative ? -0.0 : 0.0;
+    return true;
+  }
+  if (exponent < -22 || exponent > 22) return false;
+
+  number = static_cast<double>(mantissa);
+  number = exponent < 0 ? number / powersOf10[-exponent]
+                        : number * powersOf10[exponent];
+  if (negative) number = -number;
+  return true;
+}
+}  // namespace
+
+bool JSONReader::Parse(const char* json,
+                       std::size_t length,
+                       Handler& handler) {
+  begin = json;
+  end = json + length;
+  pos = json;
+  containers.clear();
+  error.clear();
+  errorPosition = 0;
+
+  for (;;) {
+    // Read a value.
+    SkipWhitespaces();
+    if (pos == end) return Fail("Expected a value");
+
+    if (*pos == '{') {
+      ++pos;
+      handler.OnStartObject();
+      containers.push_back('{');
+
+      SkipWhitespaces();
+      if (pos == end || *pos != '}') {
+        if (!ReadKey(handler)) return false;
+        continue;
+      }
+    } else if (*pos == '[') {
+      ++pos;
+      handler.OnStartArray();
+      containers.push_back('[');
+
+      SkipWhitespaces();
+      if (pos == end || *pos != ']') continue;
+    } else if (*pos == '"') {
+      const char* str;
+      std::size_t strLength;
+      if (!ReadString(str, strLength)) return false;
+      handler.OnString(str, strLength);
+    } else if (!ReadLiteral(handler)) {
+      return false;
+    }
+
+    // After a value, end the objects and arrays or go to the next value.
+    for (;;) {
+      if (containers.empty()) return true;
+
+      SkipWhitespaces();
+      if (pos == end) return Fail("Unexpected end of JSON");
+
+      bool inObject = containers.back() == '{';
+      if (*pos == (inObject ? '}' : ']')) {
+        ++pos;
+        containers.pop_back();
+        if (inObject)
+          handler.OnEndObject();
+        else
+          handler.OnEndArray();
+      } else if (*pos == ',') {
+        ++pos;
+        SkipWhitespaces();
+        if (pos != end && *pos == (inObject ? '}' : ']'))
+          continue;  // Trailing comma.
+
+        if (inObject && !ReadKey(handler)) return false;
+        break;
+      } else {
+        return Fail(inObject ? "Expected ',' or '}' after a value in an object"
+                             : "Expected ',' or ']' after a value in an array");
+      }
+    }
+  }
+}
+
+void JSONReader::SkipWhitespaces() {
+  while (pos != end && IsWhitespace(*pos)) ++pos;
+}
+
+bool JSONReader::ReadKey(Handler& handler) {
+  SkipWhitespaces();
+  if (pos == end || *pos != '"') return Fail("Expected the name of a member");
+
+  const char* key;
+  std::size_t keyLength;
+  if (!ReadString(key, keyLength)) return false;
+
+  SkipWhitespaces();
+  if (pos == end || *pos != ':')
+    return Fail("Expected ':' after the name of a member");
+
+  ++pos;
+  handler.OnKey(key, keyLength);
+  return true;
+}
+
+bool JSONReader::ReadString(const char*& str, std::size_t& length) {
+  const char* start = ++pos;  // Skip the opening quote.
+  while (pos != end && *pos != '"' && *pos != '\\') ++pos;
+  if (pos == end) return Fail("Unterminated string");
+
+  if (*pos == '"') {
+    str = start;
+    length = pos - start;
+    ++pos;
+    return true;
+  }
+
+  // The string has escaped characters: decode it in a separate buffer.
+  decodedString.assign(start, pos);
+  while (pos != end && *pos != '"') {
+    if (*pos != '\\') {
+      const char* run = pos;
+      while (pos != end && *pos != '"' && *pos != '\\') ++pos;
+      decodedString.append(run, pos);
+      continue;
+    }
+
+    if (++pos == end) break;
+    char escaped = *pos++;
+    switch (escaped) {
+      case '"':
+      case '\\':
+      case '/':
+        decodedString.push_back(escaped);
+        break;
+      case 'b':
+        decodedString.push_back('\b');
+        break;
+      case 'f':
+        decodedString.push_back('\f');
+        break;
+      case 'n':
+        decodedString.push_back('\n');
+        break;
+      case 'r':
+        decodedString.push_back('\r');
+        break;
+      case 't':
+        decodedString.push_back('\t');
+        break;
+      case 'u': {
+        unsigned int codePoint;
+        if (!ReadUnicodeEscape(codePoint)) return false;
+        AppendUTF8(decodedString, codePoint);
+      } break;
+      default:
+        // Unknown escape sequences are kept as is.
+        decodedString.push_back('\\');
+        decodedString.push_back(escaped);
+        break;
+    }
+  }
+  if (pos == end) return Fail("Unterminated string");
+
+  ++pos;
+  str = decodedString.data();
+  length = decodedString.size();
+  return true;
+}
+
+bool JSONReader::ReadUnicodeEscape(unsigned int& codePoint) {
+  auto readHexDigits = [this](unsigned int& value) {
+    if (end - pos < 4) return false;
+
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+      int digit = HexDigitValue(*pos++);
+      if (digit < 0) return false;
+      value = value * 16 + digit;
+    }
+    return true;
+  };
+
+  if (!readHexDigits(codePoint)) return Fail("Invalid unicode escape");
+  if (codePoint < 0xD800 || codePoint > 0xDFFF) return true;
+
+  // Characters outside the BMP are written as a pair of UTF16 surrogates.
+  unsigned int lowSurrogate;
+  if (codePoint <= 0xDBFF && end - pos >= 2 && pos[0] == '\\' &&
+      pos[1] == 'u') {
+    pos += 2;
+    if (!readHexDigits(lowSurrogate)) return Fail("Invalid unicode escape");
+    if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF) {
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                  (lowSurrogate - 0xDC00);
+      return true;
+    }
+
+    pos -= 6;  // Not a low surrogate: read it again as another character.
+  }
+
+  codePoint = 0xFFFD;  // Invalid lone surrogate.
+  return true;
+}
+
+bool JSONReader::ReadLiteral(Handler& handler) {
+  const char* start = pos;
+  while (pos != end && !IsEndOfLiteral(*pos)) ++pos;
+
+  std::size_t length = pos - start;
+  if (length == 0) return Fail("Expected a value");
+
+  if (IsLiteral(start, length, "true"))
+    handler.OnBool(true);
+  else if (IsLiteral(start, length, "false"))
+    handler.OnBool(false);
+  else if (IsLiteral(start, length, "null"))
+    handler.OnNull();
+  else {
+    double number;
+    if (!ParseSimpleNumber(start, pos, number)) {
+      // Other numbers (and invalid ones) are converted by the standard
+      // library.
+      std::istringstream stream(std::string(start, length));
+      number = 0;
+      stream >> number;
+    }
+    handler.OnNumber(number);
+  }
+
+  return true;
+}
+
+bool JSONReader::Fail(const char* reason) {
+  error = reason;
+  errorPosition = pos - begin;
+  return false;
+}
+
+}  // namespace gd
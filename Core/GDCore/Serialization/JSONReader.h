@@ -0,0 +1,97 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_JSONREADER_H
+#define GDCORE_JSONREADER_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gd {
+
+/**
+ * \brief A streaming JSON parser, calling the methods of a handler for each
+ * value read instead of building a tree.
+ *
+ * Strings without escaped characters are passed to the handler directly from
+ * the parsed buffer. The others are decoded into a buffer reused for all the
+ * strings, so that no memory is allocated for each value.
+ *
+ * For compatibility with the previous JSON parser of GDevelop, trailing commas
+ * are accepted and values that are not valid JSON numbers (like "nan") are
+ * converted to numbers as std::istream would do.
+ *
+ * \see gd::Serializer::FromJSON
+ */
+class GD_CORE_API JSONReader {
+ public:
+  /**
+   * \brief The methods called while parsing. Strings are UTF8 encoded and only
+   * valid during the call.
+   */
+  class GD_CORE_API Handler {
+   public:
+    virtual ~Handler(){};
+
+    virtual void OnStartObject() = 0;
+    /**
+     * \brief Called for the name of each member of an object, before its
+     * value.
+     */
+    virtual void OnKey(const char* key, std::size_t length) = 0;
+    virtual void OnEndObject() = 0;
+    virtual void OnStartArray() = 0;
+    virtual void OnEndArray() = 0;
+    virtual void OnString(const char* str, std::size_t length) = 0;
+    virtual void OnNumber(double number) = 0;
+    virtual void OnBool(bool value) = 0;
+    virtual void OnNull() = 0;
+  };
+
+  JSONReader() : begin(NULL), end(NULL), pos(NULL), errorPosition(0){};
+  virtual ~JSONReader(){};
+
+  /**
+   * \brief Parse the first JSON value of \a json, calling the methods of \a
+   * handler.
+   *
+   * \return true if the value was properly read. Otherwise, the handler was
+   * called for the values read before the error (see GetError).
+   */
+  bool Parse(const char* json, std::size_t length, Handler& handler);
+
+  /**
+   * \brief Return the reason why the last call to Parse failed.
+   */
+  const std::string& GetError() const { return error; }
+
+  /**
+   * \brief Return the position, in the JSON, of the error of the last call to
+   * Parse.
+   */
+  std::size_t GetErrorPosition() const { return errorPosition; }
+
+ private:
+  void SkipWhitespaces();
+  bool ReadKey(Handler& handler);
+  bool ReadString(const char*& str, std::size_t& length);
+  bool ReadLiteral(Handler& handler);
+  bool ReadUnicodeEscape(unsigned int& codePoint);
+  bool Fail(const char* reason);
+
+  const char* begin;  ///< The JSON being parsed.
+  const char* end;
+  const char* pos;                   ///< The current position in the JSON.
+  std::vector<char> containers;      ///< The objects ('{') and arrays ('[')
+                                     ///< being read.
+  std::string decodedString;         ///< Strings with escaped characters.
+  std::string error;
+  std::size_t errorPosition;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_JSONREADER_H
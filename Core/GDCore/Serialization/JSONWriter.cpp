@@ -0,0 +1,171 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/JSONWriter.h"
+#include <cmath>
+#include <locale>
+#include <ostream>
+
+namespace gd {
+
+const std::size_t JSONWriter::flushSize = 64 * 1024;
+
+JSONWriter::JSONWriter() : output(NULL), needsSeparator(false) {
+  numberStream.imbue(std::locale::classic());
+}
+
+JSONWriter::JSONWriter(std::ostream& output_)
+    : output(&output_), needsSeparator(false) {
+  numberStream.imbue(std::locale::classic());
+  buffer.reserve(flushSize * 2);
+}
+
+void JSONWriter::BeforeValue() {
+  if (needsSeparator) buffer.push_back(',');
+}
+
+void JSONWriter::StartObject() {
+  BeforeValue();
+  buffer.push_back('{');
+  needsSeparator = false;
+}
+
+void JSONWriter::EndObject() {
+  buffer.push_back('}');
+  needsSeparator = true;
+  FlushIfFull();
+}
+
+void JSONWriter::StartArray() {
+  BeforeValue();
+  buffer.push_back('[');
+  needsSeparator = false;
+}
+
+void JSONWriter::EndArray() {
+  buffer.push_back(']');
+  needsSeparator = true;
+  FlushIfFull();
+}
+
+void JSONWriter::Key(const char* key, std::size_t length) {
+  BeforeValue();
+  WriteQuotedString(key, length);
+  buffer.append(": ", 2);
+  needsSeparator = false;
+}
+
+void JSONWriter::String(const char* str, std::size_t length) {
+  BeforeValue();
+  WriteQuotedString(str, length);
+  needsSeparator = true;
+  FlushIfFull();
+}
+
+void JSONWriter::Double(double number) {
+  if (number == std::floor(number) && std::abs(number) < 1e6 &&
+      !(number == 0 && std::signbit(number))) {
+    // Integers with 6 digits or less are written as is by std::ostream.
+    Int(static_cast<int>(number));
+    return;
+  }
+
+  BeforeValue();
+  numberStream.str(std::string());
+  numberStream << number;
+  buffer += numberStream.str();
+  needsSeparator = true;
+}
+
+void JSONWriter::Int(int number) {
+  BeforeValue();
+
+  char digits[16];
+  char* digitsEnd = digits + sizeof(digits);
+  char* p = digitsEnd;
+  unsigned int absNumber = number < 0 ? 0u - static_cast<unsigned int>(number)
+                                      : static_cast<unsigned int>(number);
+  do {
+    *--p = static_cast<char>('0' + absNumber % 10);
+    absNumber /= 10;
+  } while (absNumber != 0);
+  if (number < 0) *--p = '-';
+
+  buffer.append(p, digitsEnd);
+  needsSeparator = true;
+}
+
+void JSONWriter::Bool(bool value) {
+  BeforeValue();
+  buffer += value ? "true" : "false";
+  needsSeparator = true;
+}
+
+void JSONWriter::Null() {
+  BeforeValue();
+  buffer += "null";
+  needsSeparator = true;
+}
+
+void JSONWriter::WriteQuotedString(const char* str, std::size_t length) {
+  static const char hexDigits[] = "0123456789ABCDEF";
+
+  buffer.push_back('"');
+  const char* end = str + length;
+  while (str != end) {
+    // Copy the characters that don't need to be escaped at once.
+    const char* run = str;
+    while (str != end && *str != '"' && *str != '\\' &&
+           static_cast<unsigned char>(*str) >= 0x20)
+      ++str;
+    buffer.append(run, str);
+    if (str == end) break;
+
+    char c = *str++;
+    switch (c) {
+      case '"':
+        buffer += "\\\"";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      case '\b':
+        buffer += "\\b";
+        break;
+      case '\f':
+        buffer += "\\f";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      case '\t':
+        buffer += "\\t";
+        break;
+      default:
+        buffer += "\\u00";
+        buffer.push_back(hexDigits[(c >> 4) & 0xF]);
+        buffer.push_back(hexDigits[c & 0xF]);
+        break;
+    }
+  }
+  buffer.push_back('"');
+}
+
+void JSONWriter::FlushIfFull() {
+  if (output && buffer.size() >= flushSize) Flush();
+}
+
+void JSONWriter::Flush() {
+  if (!output) return;
+
+  output->write(buffer.data(), buffer.size());
+  buffer.clear();
+}
+
+}  // namespace gd
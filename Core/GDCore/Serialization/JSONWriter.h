@@ -0,0 +1,92 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_JSONWRITER_H
+#define GDCORE_JSONWRITER_H
+#include <cstddef>
+#include <iosfwd>
+#include <sstream>
+#include <string>
+
+namespace gd {
+
+/**
+ * \brief Write JSON values one after the other, in a buffer or in a stream.
+ *
+ * The separators between the values are added automatically: call Key before
+ * each value of an object. Members are written as `"name": value` and values
+ * are separated by a comma, without any other whitespace.
+ *
+ * When a stream is given, the buffer is written to it each time it is large
+ * enough, so that the whole JSON is never stored in memory.
+ *
+ * \see gd::Serializer::ToJSON
+ */
+class GD_CORE_API JSONWriter {
+ public:
+  /**
+   * \brief Create a writer storing the JSON in a buffer (see GetBuffer).
+   */
+  JSONWriter();
+
+  /**
+   * \brief Create a writer writing the JSON to \a output.
+   * \note Flush must be called once everything is written.
+   */
+  JSONWriter(std::ostream& output);
+
+  virtual ~JSONWriter(){};
+
+  void StartObject();
+  void EndObject();
+  void StartArray();
+  void EndArray();
+
+  /**
+   * \brief Write the name of the next member of the current object.
+   */
+  void Key(const char* key, std::size_t length);
+  void Key(const std::string& key) { Key(key.data(), key.size()); }
+
+  void String(const char* str, std::size_t length);
+  void String(const std::string& str) { String(str.data(), str.size()); }
+
+  /**
+   * \brief Write a number, formatted like std::ostream would do (i.e: with
+   * at most 6 significant digits).
+   */
+  void Double(double number);
+  void Int(int number);
+  void Bool(bool value);
+  void Null();
+
+  /**
+   * \brief Write the buffer to the output stream, if any.
+   */
+  void Flush();
+
+  /**
+   * \brief Return the JSON written, when the writer was not created with an
+   * output stream.
+   */
+  std::string& GetBuffer() { return buffer; }
+
+ private:
+  void BeforeValue();
+  void WriteQuotedString(const char* str, std::size_t length);
+  void FlushIfFull();
+
+  std::string buffer;
+  std::ostream* output;  ///< The stream where the buffer is written, if any.
+  bool needsSeparator;   ///< true if a value was written just before.
+  std::ostringstream numberStream;  ///< Used to format the numbers.
+
+  static const std::size_t flushSize;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_JSONWRITER_H
@@ -5,13 +5,20 @@
  */
 
 #include "GDCore/Serialization/Serializer.h"
-#include <iomanip>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/JSONWriter.h"
 #include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/Utf8/utf8.h"
 #if !defined(EMSCRIPTEN)
 #include "GDCore/TinyXml/tinyxml.h"
 #endif
@@ -23,10 +30,10 @@ void Serializer::ToXML(SerializerElement& element, TiXmlElement* xmlElement) {
   if (!xmlElement) return;
 
   if (element.IsValueUndefined()) {
-    const std::map<gd::String, SerializerValue>& attributes =
+    const std::vector<std::pair<gd::String, SerializerValue> >& attributes =
         element.GetAllAttributes();
-    for (std::map<gd::String, SerializerValue>::const_iterator it =
-             attributes.begin();
+    for (std::vector<std::pair<gd::String, SerializerValue> >::const_iterator
+             it = attributes.begin();
          it != attributes.end();
          ++it) {
       const SerializerValue& attr = it->second;
@@ -44,12 +51,8 @@ void Serializer::ToXML(SerializerElement& element, TiXmlElement* xmlElement) {
         xmlElement->SetAttribute(it->first.c_str(), attr.GetString().c_str());
     }
 
-    const std::vector<
-        std::pair<gd::String, std::shared_ptr<SerializerElement> > >& children =
-        element.GetAllChildren();
+    const auto& children = element.GetAllChildren();
     for (size_t i = 0; i < children.size(); ++i) {
-      if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
       TiXmlElement* xmlChild = new TiXmlElement(children[i].first.c_str());
       xmlElement->LinkEndChild(xmlChild);
       ToXML(*children[i].second, xmlChild);
@@ -104,401 +107,526 @@ gd::String Serializer::ToEscapedXMLString(const gd::String& str) {
 }
 
 namespace {
-
-/**
- * Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-static inline bool isControlCharacter(char ch) { return ch > 0 && ch <= 0x1F; }
-
-/**
- * Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-static bool containsControlCharacter(const char* str) {
-  while (*str) {
-    if (isControlCharacter(*(str++))) return true;
-  }
-  return false;
-}
-
-/**
- * Tool function converting a string to a quoted string that can be inserted
- * into a JSON file. Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-gd::String StringToQuotedJSONString(const char* value) {
-  if (value == NULL) return "";
-  // Not sure how to handle unicode...
-  if (strpbrk(value, "\"\\\b\f\n\r\t") == NULL &&
-      !containsControlCharacter(value))
-    return gd::String("\"") + value + "\"";
-  // We have to walk value and escape any special characters.
-  // Appending to std::string is not efficient, but this should be rare.
-  // (Note: forward slashes are *not* rare, but I am not escaping them.)
-  std::string::size_type maxsize =
-      strlen(value) * 2 + 3;  // allescaped+quotes+NULL
-  std::string result;
-  result.reserve(maxsize);  // to avoid lots of mallocs
-  result += "\"";
-  for (const char* c = value; *c != 0; ++c) {
-    switch (*c) {
-      case '\"':
-        result += "\\\"";
-        break;
-      case '\\':
-        result += "\\\\";
-        break;
-      case '\b':
-        result += "\\b";
-        break;
-      case '\f':
-        result += "\\f";
-        break;
-      case '\n':
-        result += "\\n";
-        break;
-      case '\r':
-        result += "\\r";
-        break;
-      case '\t':
-        result += "\\t";
-        break;
-      // case '/':
-      // Even though \/ is considered a legal escape in JSON, a bare
-      // slash is also legal, so I see no reason to escape it.
-      // (I hope I am not misunderstanding something.
-      // blep notes: actually escaping \/ may be useful in javascript to avoid
-      // </ sequence. Should add a flag to allow this compatibility mode and
-      // prevent this sequence from occurring.
-      default:
-        if (isControlCharacter(*c)) {
-          std::ostringstream oss;
-          oss << "\\u" << std::hex << std::uppercase << std::setfill('0')
-              << std::setw(4) << static_cast<int>(*c);
-          result += oss.str();
-        } else {
-          result += *c;
-        }
-        break;
-    }
-  }
-  result += "\"";
-  return gd::String::FromUTF8(result);
-}
-
-gd::String ValueToJSON(const SerializerValue& val) {
+void ValueToJSON(JSONWriter& writer, const SerializerValue& val) {
   if (val.IsBoolean())
-    return val.GetBool() ? "true" : "false";
+    writer.Bool(val.GetBool());
   else if (val.IsInt())
-    return gd::String::From(val.GetInt());
+    writer.Int(val.GetInt());
   else if (val.IsDouble())
-    return gd::String::From(val.GetDouble());
+    writer.Double(val.GetDouble());
   else
-    return StringToQuotedJSONString(val.GetString().c_str());
+    writer.String(val.GetString().Raw());
 }
-}  // namespace
 
-gd::String Serializer::ToJSON(const SerializerElement& element) {
-  if (element.IsValueUndefined()) {
-    if (element.ConsideredAsArray()) {
-      // Store the element as an array in JSON:
-      gd::String str = "[";
-      bool firstChild = true;
+void ElementToJSON(JSONWriter& writer, const SerializerElement& element) {
+  if (!element.IsValueUndefined()) {
+    ValueToJSON(writer, element.GetValue());
+    return;
+  }
 
-      if (element.GetAllAttributes().size() > 0) {
+  const auto& children = element.GetAllChildren();
+  if (element.ConsideredAsArray()) {
+    // Store the element as an array in JSON:
+    if (element.GetAllAttributes().size() > 0) {
+      std::cout << "ERROR: A SerializerElement is considered as an array of "
+                << (element.ConsideredAsArrayOf().empty()
+                        ? "[unnamed elements]"
+                        : element.ConsideredAsArrayOf())
+                << " but has attributes. These attributes won't be saved!"
+                << std::endl;
+    }
+
+    writer.StartArray();
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (children[i].first != element.ConsideredAsArrayOf()) {
         std::cout << "ERROR: A SerializerElement is considered as an array of "
                   << (element.ConsideredAsArrayOf().empty()
                           ? "[unnamed elements]"
                           : element.ConsideredAsArrayOf())
-                  << " but has attributes. These attributes won't be saved!"
-                  << std::endl;
+                  << " but has a child called \"" << children[i].first
+                  << "\". This child won't be saved!" << std::endl;
+        continue;
       }
 
-      const std::vector<
-          std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
-          children = element.GetAllChildren();
-      for (size_t i = 0; i < children.size(); ++i) {
-        if (children[i].second == std::shared_ptr<SerializerElement>())
-          continue;
-        if (children[i].first != element.ConsideredAsArrayOf()) {
-          std::cout
-              << "ERROR: A SerializerElement is considered as an array of "
-              << (element.ConsideredAsArrayOf().empty()
-                      ? "[unnamed elements]"
-                      : element.ConsideredAsArrayOf())
-              << " but has a child called \"" << children[i].first
-              << "\". This child won't be saved!" << std::endl;
-          continue;
-        }
-
-        if (!firstChild) str += ",";
-        str += ToJSON(*children[i].second);
-
-        firstChild = false;
-      }
-
-      str += "]";
-      return str;
-    } else {
-      gd::String str = "{";
-      bool firstChild = true;
-
-      const std::map<gd::String, SerializerValue>& attributes =
-          element.GetAllAttributes();
-      for (std::map<gd::String, SerializerValue>::const_iterator it =
-               attributes.begin();
-           it != attributes.end();
-           ++it) {
-        if (!firstChild) str += ",";
-        str += StringToQuotedJSONString(it->first.c_str()) + ": " +
-               ValueToJSON(it->second);
-
-        firstChild = false;
-      }
+      ElementToJSON(writer, *children[i].second);
+    }
+    writer.EndArray();
+  } else {
+    writer.StartObject();
+    const std::vector<std::pair<gd::String, SerializerValue> >& attributes =
+        element.GetAllAttributes();
+    for (std::vector<std::pair<gd::String, SerializerValue> >::const_iterator
+             it = attributes.begin();
+         it != attributes.end();
+         ++it) {
+      writer.Key(it->first.Raw());
+      ValueToJSON(writer, it->second);
+    }
 
-      const std::vector<
-          std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
-          children = element.GetAllChildren();
-      for (size_t i = 0; i < children.size(); ++i) {
-        if (children[i].second == std::shared_ptr<SerializerElement>())
-          continue;
-
-        if (attributes.find(children[i].first) != attributes.end()) {
-          std::cout << "ERROR: An attribute and a children called \""
-                    << children[i].first
-                    << "\" both exist. The children will erase the attribute - "
-                       "fix the usage of the attribute or (better) use "
-                       "children methods only."
-                    << std::endl;
-        }
-
-        if (!firstChild) str += ",";
-        str += StringToQuotedJSONString(children[i].first.c_str()) + ": " +
-               ToJSON(*children[i].second);
-
-        firstChild = false;
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (element.HasAttribute(children[i].first)) {
+        std::cout << "ERROR: An attribute and a children called \""
+                  << children[i].first
+                  << "\" both exist. The children will erase the attribute - "
+                     "fix the usage of the attribute or (better) use "
+                     "children methods only."
+                  << std::endl;
       }
 
-      str += "}";
-      return str;
+      writer.Key(children[i].first.Raw());
+      ElementToJSON(writer, *children[i].second);
     }
-  } else {
-    return ValueToJSON(element.GetValue());
+    writer.EndObject();
   }
 }
 
-// Private functions for JSON parsing
-namespace {
-size_t SkipBlankChar(const std::string& str, size_t pos) {
-  const std::string blankChar = " \n";
-  return str.find_first_not_of(blankChar, pos);
-}
-
 /**
- * Adapted from https://github.com/hjiang/jsonxx
+ * \brief Fill a SerializerElement with the values read by a gd::JSONReader.
  */
-std::string DecodeString(const std::string& original) {
-  std::string value;
-  value.reserve(original.size());
-  std::istringstream input("\"" + original + "\"");
-
-  char ch = '\0', delimiter = '"';
-  input.get(ch);
-  if (ch != delimiter) return "";
-
-  while (!input.eof() && input.good()) {
-    input.get(ch);
-    if (ch == delimiter) {
-      break;
-    }
-    if (ch == '\\') {
-      input.get(ch);
-      switch (ch) {
-        case '\\':
-        case '/':
-          value.push_back(ch);
-          break;
-        case 'b':
-          value.push_back('\b');
-          break;
-        case 'f':
-          value.push_back('\f');
-          break;
-        case 'n':
-          value.push_back('\n');
-          break;
-        case 'r':
-          value.push_back('\r');
-          break;
-        case 't':
-          value.push_back('\t');
-          break;
-        case 'u': {
-          int i;
-          std::stringstream ss;
-          for (i = 0; (!input.eof() && input.good()) && i < 4; ++i) {
-            input.get(ch);
-            ss << ch;
-          }
-          if (input.good() && (ss >> i)) value.push_back(i);
-        } break;
-        default:
-          if (ch != delimiter) {
-            value.push_back('\\');
-            value.push_back(ch);
-          } else
-            value.push_back(ch);
-          break;
-      }
-    } else {
-      value.push_back(ch);
-    }
+class SerializerElementBuilder : public JSONReader::Handler {
+ public:
+  SerializerElementBuilder(SerializerElement& root_) : root(root_){};
+  virtual ~SerializerElementBuilder(){};
+
+  virtual void OnStartObject() { elements.push_back(&NextElement()); }
+  virtual void OnKey(const char* key, std::size_t length) {
+    ToString(key, length, childName);
   }
-  if (input && ch == delimiter) {
-    return value;
-  } else {
-    return "";
+  virtual void OnEndObject() { elements.pop_back(); }
+  virtual void OnStartArray() {
+    SerializerElement& element = NextElement();
+    element.ConsiderAsArray();
+    elements.push_back(&element);
   }
-}
+  virtual void OnEndArray() { elements.pop_back(); }
+  virtual void OnString(const char* str, std::size_t length) {
+    ToString(str, length, value);
+    NextElement().SetValue(value);
+  }
+  virtual void OnNumber(double number) { NextElement().SetValue(number); }
+  virtual void OnBool(bool boolean) { NextElement().SetValue(boolean); }
+  virtual void OnNull() { NextElement().SetValue(0.0); }
+
+ private:
+  /**
+   * \brief Return the element for the value being read: the root, a child of
+   * an array or the member of an object named after the last key.
+   */
+  SerializerElement& NextElement() {
+    if (elements.empty()) return root;
+
+    SerializerElement& parent = *elements.back();
+    return parent.AddChild(parent.ConsideredAsArray() ? gd::String()
+                                                      : childName);
+  }
+
+  static void ToString(const char* str, std::size_t length, gd::String& out) {
+    out.Raw().assign(str, length);
+    if (!::utf8::is_valid(str, str + length)) out.ReplaceInvalid();
+  }
+
+  SerializerElement& root;
+  std::vector<SerializerElement*> elements;  ///< The objects and arrays being
+                                             ///< read.
+  gd::String childName;  ///< The name of the next member of the object.
+  gd::String value;
+};
 
 /**
- * Return the position of the end of the string. Blank are skipped if necessary
- * @param str The string to be used
- * @param startPos The start position
- * @param strContent A reference to a string that will be filled with the string
- * content.
+ * The binary format is:
+ * - the header: binaryMagic followed by binaryVersion,
+ * - the string table: the number of strings, then each string (its length in
+ *   bytes followed by its UTF8 characters),
+ * - the root element.
+ *
+ * An element is a byte of flags (binaryHasValue, binaryIsArray), followed by
+ * its value (if any), the name of its array elements (if it's an array), the
+ * number of attributes and the attributes (name and value), then the number
+ * of children and the children (name and element).
+ *
+ * Numbers (lengths, counts, indices in the string table and integers) are
+ * written 7 bits per byte, the high bit being set if more bytes follow.
+ * Integers are zigzag encoded so that small negative numbers stay short.
+ * Names and strings are written as their index in the string table.
  */
-size_t SkipString(const std::string& str,
-                  size_t startPos,
-                  std::string& strContent) {
-  startPos = SkipBlankChar(str, startPos);
-  if (startPos >= str.length()) return std::string::npos;
+const char binaryMagic[] = {'G', 'D', 'B', 'N'};
+const unsigned char binaryVersion = 1;
+const std::size_t binaryHeaderSize = sizeof(binaryMagic) + 1;
+
+const unsigned char binaryHasValue = 1;
+const unsigned char binaryIsArray = 2;
+
+enum BinaryValueType {
+  BinaryUnknown = 0,  ///< Untyped string, as read from XML.
+  BinaryFalse = 1,
+  BinaryTrue = 2,
+  BinaryInt = 3,
+  BinaryDouble = 4,
+  BinaryString = 5
+};
 
-  size_t endPos = startPos;
+/**
+ * \brief Write a SerializerElement in the binary format.
+ */
+class BinaryWriter {
+ public:
+  BinaryWriter(){};
+
+  void WriteElement(const SerializerElement& element) {
+    unsigned char flags = 0;
+    if (!element.IsValueUndefined()) flags |= binaryHasValue;
+    if (element.ConsideredAsArray()) flags |= binaryIsArray;
+    tree.push_back(static_cast<char>(flags));
+
+    if (flags & binaryHasValue) WriteValue(element.GetValue());
+    if (flags & binaryIsArray) WriteString(element.ConsideredAsArrayOf());
+
+    const auto& attributes = element.GetAllAttributes();
+    WriteVarUInt(tree, attributes.size());
+    for (const auto& attribute : attributes) {
+      WriteString(attribute.first);
+      WriteValue(attribute.second);
+    }
 
-  if (str[startPos] == '"') {
-    if (startPos + 1 >= str.length()) return std::string::npos;
+    const auto& children = element.GetAllChildren();
+    WriteVarUInt(tree, children.size());
+    for (const auto& child : children) {
+      WriteString(child.first);
+      WriteElement(*child.second);
+    }
+  }
 
-    while (endPos == startPos || (str[endPos - 1] == '\\')) {
-      endPos = str.find_first_of('\"', endPos + 1);
-      if (endPos == std::string::npos)
-        return std::string::npos;  // Invalid string
+  /**
+   * \brief Write the header, the string table and the elements written so
+   * far.
+   */
+  void Finish(std::ostream& output) {
+    std::string header(binaryMagic, sizeof(binaryMagic));
+    header.push_back(static_cast<char>(binaryVersion));
+    WriteVarUInt(header, strings.size());
+    output.write(header.data(), header.size());
+
+    std::string stringsTable;
+    for (const gd::String* str : strings) {
+      WriteVarUInt(stringsTable, str->Raw().size());
+      stringsTable += str->Raw();
     }
+    output.write(stringsTable.data(), stringsTable.size());
+    output.write(tree.data(), tree.size());
+  }
 
-    strContent = DecodeString(str.substr(startPos + 1, endPos - 1 - startPos));
-    return endPos;
+ private:
+  static void WriteVarUInt(std::string& buffer, std::uint64_t number) {
+    while (number >= 0x80) {
+      buffer.push_back(static_cast<char>((number & 0x7F) | 0x80));
+      number >>= 7;
+    }
+    buffer.push_back(static_cast<char>(number));
   }
 
-  endPos = str.find_first_of(" \n,:");
-  if (endPos >= str.length()) return std::string::npos;  // Invalid string
+  void WriteString(const gd::String& str) {
+    auto inserted = stringsIndex.insert(std::make_pair(str, strings.size()));
+    if (inserted.second) strings.push_back(&inserted.first->first);
 
-  strContent = DecodeString(str.substr(startPos, endPos - 1 - startPos));
-  return endPos - 1;
-}
+    WriteVarUInt(tree, inserted.first->second);
+  }
+
+  void WriteValue(const SerializerValue& value) {
+    if (value.IsBoolean()) {
+      tree.push_back(value.GetBool() ? BinaryTrue : BinaryFalse);
+    } else if (value.IsInt()) {
+      tree.push_back(BinaryInt);
+      std::int32_t number = value.GetInt();
+      WriteVarUInt(tree,
+                   (static_cast<std::uint32_t>(number) << 1) ^
+                       static_cast<std::uint32_t>(number >> 31));
+    } else if (value.IsDouble()) {
+      tree.push_back(BinaryDouble);
+      double number = value.GetDouble();
+      std::uint64_t bits;
+      std::memcpy(&bits, &number, sizeof(bits));
+      for (std::size_t i = 0; i < sizeof(bits); ++i)
+        tree.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+    } else {
+      tree.push_back(value.IsString() ? BinaryString : BinaryUnknown);
+      WriteString(value.GetString());
+    }
+  }
+
+  std::string tree;  ///< The elements, written after the string table.
+  std::vector<const gd::String*> strings;  ///< The string table, pointing to
+                                           ///< the keys of stringsIndex.
+  std::unordered_map<gd::String, std::size_t> stringsIndex;
+};
 
 /**
- * Parse a JSON string, starting from pos, and storing the result into the
- * specified element. Note that the parsing is stopped as soon as a valid object
- * is parsed. \return The position at the end of the valid object stored into
- * the element.
+ * \brief Read a SerializerElement written by a BinaryWriter.
  */
-size_t ParseJSONObject(const std::string& jsonStr,
-                       size_t startPos,
-                       gd::SerializerElement& element) {
-  size_t pos = SkipBlankChar(jsonStr, startPos);
-  if (pos >= jsonStr.length()) return std::string::npos;
-
-  if (jsonStr[pos] == '{')  // Object
-  {
-    bool firstChild = true;
-    while (firstChild || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == '}') break;
-
-      std::string childName;
-      pos = SkipString(jsonStr, pos, childName);
-
-      pos++;
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length() || jsonStr[pos] != ':')
-        return std::string::npos;
-
-      pos++;
-      pos = ParseJSONObject(
-          jsonStr,
-          pos,
-          element.AddChild(gd::String::FromUTF8(childName).ReplaceInvalid()));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) return std::string::npos;
-      firstChild = false;
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, std::size_t length)
+      : current(data), end(data + length), error(NULL){};
+
+  /**
+   * \brief Read the data into the element.
+   * \return false if the data is invalid (see GetError). In this case, the
+   * element contains what was read before the error.
+   */
+  bool Read(SerializerElement& element) {
+    if (static_cast<std::size_t>(end - current) < binaryHeaderSize ||
+        std::memcmp(current, binaryMagic, sizeof(binaryMagic)) != 0)
+      return SetError("Not in the binary format");
+    if (static_cast<unsigned char>(current[sizeof(binaryMagic)]) !=
+        binaryVersion)
+      return SetError("Unsupported version of the binary format");
+    current += binaryHeaderSize;
+
+    std::size_t stringsCount;
+    if (!ReadVarUInt(stringsCount)) return false;
+    if (stringsCount > static_cast<std::size_t>(end - current))
+      return SetError("Invalid string table");
+
+    strings.resize(stringsCount);
+    for (std::size_t i = 0; i < stringsCount; ++i) {
+      std::size_t length;
+      if (!ReadVarUInt(length)) return false;
+      if (length > static_cast<std::size_t>(end - current))
+        return SetError("Unexpected end of data");
+
+      strings[i].Raw().assign(current, length);
+      if (!::utf8::is_valid(current, current + length))
+        strings[i].ReplaceInvalid();
+      current += length;
     }
 
-    if (jsonStr[pos] != '}') {
-      std::cout << "Parsing error: Object not properly formed.";
-      return std::string::npos;
-    }
-    return pos + 1;
-  } else if (jsonStr[pos] == '[')  // Array
-  {
-    element.ConsiderAsArray();
-    unsigned int index = 0;
-    while (index == 0 || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == ']') break;
-      pos = ParseJSONObject(jsonStr, pos, element.AddChild(""));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) {
-        std::cout << "Parsing error: element of array not properly formed.";
-        return std::string::npos;
+    return ReadElement(element, 0);
+  }
+
+  const char* GetError() const { return error; }
+
+ private:
+  bool SetError(const char* error_) {
+    error = error_;
+    return false;
+  }
+
+  bool ReadVarUInt(std::size_t& number) {
+    std::uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+      if (current == end) return SetError("Unexpected end of data");
+
+      unsigned char byte = static_cast<unsigned char>(*current++);
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        if (value > std::numeric_limits<std::size_t>::max()) break;
+
+        number = static_cast<std::size_t>(value);
+        return true;
       }
-      index++;
     }
 
-    if (jsonStr[pos] != ']') {
-      std::cout << "Parsing error: array not properly ended";
-      return std::string::npos;
+    return SetError("Invalid number");
+  }
+
+  bool ReadString(const gd::String*& str) {
+    std::size_t index;
+    if (!ReadVarUInt(index)) return false;
+    if (index >= strings.size()) return SetError("Invalid string index");
+
+    str = &strings[index];
+    return true;
+  }
+
+  bool ReadByte(unsigned char& byte) {
+    if (current == end) return SetError("Unexpected end of data");
+
+    byte = static_cast<unsigned char>(*current++);
+    return true;
+  }
+
+  bool ReadValue(SerializerValue& value) {
+    unsigned char type;
+    if (!ReadByte(type)) return false;
+
+    if (type == BinaryFalse || type == BinaryTrue) {
+      value.SetBool(type == BinaryTrue);
+    } else if (type == BinaryInt) {
+      std::size_t zigzag;
+      if (!ReadVarUInt(zigzag)) return false;
+      std::uint32_t number = static_cast<std::uint32_t>(zigzag);
+      value.SetInt(
+          static_cast<std::int32_t>((number >> 1) ^ (0u - (number & 1))));
+    } else if (type == BinaryDouble) {
+      if (static_cast<std::size_t>(end - current) < sizeof(std::uint64_t))
+        return SetError("Unexpected end of data");
+
+      std::uint64_t bits = 0;
+      for (std::size_t i = 0; i < sizeof(bits); ++i)
+        bits |= static_cast<std::uint64_t>(
+                    static_cast<unsigned char>(current[i]))
+                << (8 * i);
+      current += sizeof(bits);
+
+      double number;
+      std::memcpy(&number, &bits, sizeof(number));
+      value.SetDouble(number);
+    } else if (type == BinaryString || type == BinaryUnknown) {
+      const gd::String* str;
+      if (!ReadString(str)) return false;
+      if (type == BinaryString)
+        value.SetString(*str);
+      else
+        value.Set(*str);
+    } else {
+      return SetError("Invalid value type");
+    }
+
+    return true;
+  }
+
+  bool ReadElement(SerializerElement& element, std::size_t depth) {
+    if (depth > maxDepth) return SetError("Elements are nested too deeply");
+
+    unsigned char flags;
+    if (!ReadByte(flags)) return false;
+
+    if (flags & binaryHasValue) {
+      SerializerValue value;
+      if (!ReadValue(value)) return false;
+      element.SetValue(value);
     }
-    return pos + 1;
-  } else if (jsonStr[pos] == '"')  // String
-  {
-    std::string str;
-    pos = SkipString(jsonStr, pos, str);
-    if (pos >= jsonStr.length()) {
-      std::cout << "Parsing error: Invalid string";
-      return std::string::npos;
+
+    const gd::String* arrayOf = NULL;
+    if (flags & binaryIsArray) {
+      if (!ReadString(arrayOf)) return false;
+      element.ConsiderAsArrayOf(*arrayOf);
     }
 
-    element.SetValue(gd::String::FromUTF8(str).ReplaceInvalid());
-    return pos + 1;
-  } else  // Number or boolean
-  {
-    std::string str;
-    size_t endPos = pos;
-    const std::string separators = " \n,}]";
-    while (endPos < jsonStr.length() &&
-           separators.find_first_of(jsonStr[endPos]) == std::string::npos) {
-      endPos++;
+    std::size_t attributesCount;
+    if (!ReadVarUInt(attributesCount)) return false;
+    for (std::size_t i = 0; i < attributesCount; ++i) {
+      const gd::String* name;
+      SerializerValue value;
+      if (!ReadString(name) || !ReadValue(value)) return false;
+
+      if (value.IsBoolean())
+        element.SetAttribute(*name, value.GetBool());
+      else if (value.IsInt())
+        element.SetAttribute(*name, value.GetInt());
+      else if (value.IsDouble())
+        element.SetAttribute(*name, value.GetDouble());
+      else
+        element.SetAttribute(*name, value.GetString());
     }
 
-    str = jsonStr.substr(pos, endPos - pos);
-    if (str == "true")
-      element.SetValue(true);
-    else if (str == "false")
-      element.SetValue(false);
-    else
-      element.SetValue(gd::String::FromUTF8(str).To<double>());
-    return endPos;
+    std::size_t childrenCount;
+    if (!ReadVarUInt(childrenCount)) return false;
+    for (std::size_t i = 0; i < childrenCount; ++i) {
+      const gd::String* name;
+      if (!ReadString(name)) return false;
+
+      // Children of an array can have a name different from the one of the
+      // array elements (if it was changed after they were added).
+      bool renamedArrayOf = arrayOf && *name != element.ConsideredAsArrayOf();
+      if (renamedArrayOf) element.ConsiderAsArrayOf(*name);
+      SerializerElement& child = element.AddChild(*name);
+      if (renamedArrayOf) element.ConsiderAsArrayOf(*arrayOf);
+
+      if (!ReadElement(child, depth + 1)) return false;
+    }
+
+    return true;
   }
-}
+
+  const char* current;
+  const char* end;
+  std::vector<gd::String> strings;  ///< The string table.
+  const char* error;
+
+  static const std::size_t maxDepth = 1024;  ///< Avoid overflowing the stack
+                                             ///< with invalid data.
+};
 }  // namespace
 
-SerializerElement Serializer::FromJSON(const std::string& jsonStr) {
+gd::String Serializer::ToJSON(const SerializerElement& element) {
+  JSONWriter writer;
+  ElementToJSON(writer, element);
+
+  gd::String json;
+  json.Raw().swap(writer.GetBuffer());
+  return json;
+}
+
+void Serializer::ToJSON(const SerializerElement& element,
+                        std::ostream& output) {
+  JSONWriter writer(output);
+  ElementToJSON(writer, element);
+  writer.Flush();
+}
+
+SerializerElement Serializer::FromJSON(const char* json, std::size_t length) {
+  gd::String error;
+  SerializerElement element = FromJSON(json, length, error);
+  if (!error.empty()) std::cout << "Parsing error: " << error << std::endl;
+
+  return element;
+}
+
+SerializerElement Serializer::FromJSON(const char* json,
+                                       std::size_t length,
+                                       gd::String& error) {
+  error.clear();
   SerializerElement element;
-  if (!jsonStr.empty()) gd::ParseJSONObject(jsonStr, 0, element);
+  if (length == 0) return element;
+
+  element.AllocateChildrenInArena();
+  SerializerElementBuilder builder(element);
+  JSONReader reader;
+  if (!reader.Parse(json, length, builder)) {
+    error = gd::String::FromUTF8(reader.GetError()) + " (at position " +
+            gd::String::From(reader.GetErrorPosition()) + ").";
+  }
+
   return element;
 }
 
+std::string Serializer::ToBinary(const SerializerElement& element) {
+  std::ostringstream output;
+  ToBinary(element, output);
+  return output.str();
+}
+
+void Serializer::ToBinary(const SerializerElement& element,
+                          std::ostream& output) {
+  BinaryWriter writer;
+  writer.WriteElement(element);
+  writer.Finish(output);
+}
+
+SerializerElement Serializer::FromBinary(const char* data, std::size_t length) {
+  gd::String error;
+  SerializerElement element = FromBinary(data, length, error);
+  if (!error.empty())
+    std::cout << "Error while reading binary data: " << error << std::endl;
+
+  return element;
+}
+
+SerializerElement Serializer::FromBinary(const char* data,
+                                         std::size_t length,
+                                         gd::String& error) {
+  error.clear();
+  SerializerElement element;
+  element.AllocateChildrenInArena();
+  BinaryReader reader(data, length);
+  if (!reader.Read(element)) error = gd::String::FromUTF8(reader.GetError());
+
+  return element;
+}
+
+bool Serializer::IsBinary(const char* data, std::size_t length) {
+  return length >= binaryHeaderSize &&
+         std::memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
 }  // namespace gd
@@ -6,6 +6,8 @@
 
 #ifndef GDCORE_SERIALIZER_H
 #define GDCORE_SERIALIZER_H
+#include <cstddef>
+#include <iosfwd>
 #include <string>
 #include "GDCore/Serialization/SerializerElement.h"
 class TiXmlElement;
@@ -14,7 +16,7 @@ namespace gd {
 
 /**
  * \brief The class used to save/load projects and GDCore classes
- * from/to XML or JSON.
+ * from/to XML, JSON or a binary format.
  */
 class GD_CORE_API Serializer {
  public:
@@ -42,7 +44,35 @@ class GD_CORE_API Serializer {
    */
   static gd::String ToJSON(const SerializerElement& element);
 
-  static SerializerElement FromJSON(const std::string& json);
+  /**
+   * \brief Serialize a gd::SerializerElement to a stream (for example, a
+   * file), without storing the whole JSON in memory.
+   */
+  static void ToJSON(const SerializerElement& element, std::ostream& output);
+
+  /**
+   * \brief Parse a JSON string (UTF8 encoded) and returns a
+   * gd::SerializerElement for it.
+   *
+   * Values are read by a gd::JSONReader and stored directly in the tree,
+   * without intermediate copies of the JSON.
+   */
+  static SerializerElement FromJSON(const char* json, std::size_t length);
+
+  /**
+   * \brief Parse a JSON string (UTF8 encoded) and returns a
+   * gd::SerializerElement for it, setting \a error to a description of the
+   * error if the JSON is invalid (or to an empty string otherwise).
+   *
+   * In case of error, the element contains what was read before the error.
+   */
+  static SerializerElement FromJSON(const char* json,
+                                    std::size_t length,
+                                    gd::String& error);
+
+  static SerializerElement FromJSON(const std::string& json) {
+    return FromJSON(json.data(), json.size());
+  }
 
   /**
    * \brief Parse a JSON string and returns a gd::SerializerElement for it.
@@ -52,6 +82,58 @@ class GD_CORE_API Serializer {
   }
   ///@}
 
+  /** \name Binary serialization.
+   * Serialize a SerializerElement from/to a compact binary format, faster to
+   * read and write than JSON or XML.
+   */
+  ///@{
+  /**
+   * \brief Serialize a gd::SerializerElement to the binary format.
+   *
+   * The names and the string values are stored once, in a table at the
+   * beginning of the data, and the tree refers to them by their index. Values
+   * keep their type, so that the element read back is the same as \a element
+   * (which is not the case with JSON).
+   */
+  static std::string ToBinary(const SerializerElement& element);
+
+  /**
+   * \brief Serialize a gd::SerializerElement to a stream (for example, a
+   * file), in the binary format.
+   */
+  static void ToBinary(const SerializerElement& element, std::ostream& output);
+
+  /**
+   * \brief Read a gd::SerializerElement from data in the binary format.
+   *
+   * The data is only used during the call and can be, for example, a memory
+   * mapped file. Each string of the table is decoded once, even if used by a
+   * lot of elements.
+   */
+  static SerializerElement FromBinary(const char* data, std::size_t length);
+
+  /**
+   * \brief Read a gd::SerializerElement from data in the binary format,
+   * setting \a error to a description of the error if the data is invalid or
+   * truncated (or to an empty string otherwise).
+   *
+   * In case of error, the element contains what was read before the error.
+   */
+  static SerializerElement FromBinary(const char* data,
+                                      std::size_t length,
+                                      gd::String& error);
+
+  static SerializerElement FromBinary(const std::string& data) {
+    return FromBinary(data.data(), data.size());
+  }
+
+  /**
+   * \brief Return true if the data starts with the header of the binary
+   * format (i.e: it is not JSON or XML).
+   */
+  static bool IsBinary(const char* data, std::size_t length);
+  ///@}
+
   virtual ~Serializer(){};
 
  private:
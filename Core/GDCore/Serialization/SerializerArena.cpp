@@ -0,0 +1,66 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/SerializerArena.h"
+#include <new>
+
+namespace gd {
+
+namespace {
+/**
+ * Sizes are rounded to this, so that all the allocations keep the alignment of
+ * the blocks (given by operator new).
+ */
+const std::size_t alignment = 16;
+
+std::size_t AlignSize(std::size_t size) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+const std::size_t SerializerArena::blockSize = 64 * 1024;
+
+SerializerArena::SerializerArena()
+    : current(NULL), end(NULL), allocatedSize(0) {}
+
+SerializerArena::~SerializerArena() {
+  for (char* block : blocks) ::operator delete(block);
+}
+
+void* SerializerArena::Allocate(std::size_t size) {
+  size = AlignSize(size);
+  if (static_cast<std::size_t>(end - current) < size) {
+    if (size > blockSize / 4) {
+      // Large objects get their own block, so that the space left in the
+      // current block is not lost.
+      return AllocateBlock(size);
+    }
+
+    current = AllocateBlock(blockSize);
+    end = current + blockSize;
+  }
+
+  void* memory = current;
+  current += size;
+  return memory;
+}
+
+void SerializerArena::Clear() {
+  for (char* block : blocks) ::operator delete(block);
+  blocks.clear();
+  current = NULL;
+  end = NULL;
+  allocatedSize = 0;
+}
+
+char* SerializerArena::AllocateBlock(std::size_t size) {
+  char* block = static_cast<char*>(::operator new(size));
+  blocks.push_back(block);
+  allocatedSize += size;
+  return block;
+}
+
+}  // namespace gd
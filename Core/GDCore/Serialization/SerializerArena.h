@@ -0,0 +1,63 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_SERIALIZERARENA_H
+#define GDCORE_SERIALIZERARENA_H
+#include <cstddef>
+#include <vector>
+
+namespace gd {
+
+/**
+ * \brief A bump allocator, giving memory from large blocks that are all freed
+ * at once when the arena is destroyed (or cleared).
+ *
+ * Used to allocate the elements of a whole tree of gd::SerializerElement
+ * (like a project being loaded or saved) without an allocation per element.
+ *
+ * \note Objects constructed in the arena must be destroyed by calling their
+ * destructor, but their memory must not be freed.
+ *
+ * \see gd::SerializerElement::AllocateChildrenInArena
+ */
+class GD_CORE_API SerializerArena {
+ public:
+  SerializerArena();
+  virtual ~SerializerArena();
+
+  /**
+   * \brief Return memory for an object of the given size, suitably aligned for
+   * any type.
+   */
+  void* Allocate(std::size_t size);
+
+  /**
+   * \brief Free all the memory given by the arena.
+   */
+  void Clear();
+
+  /**
+   * \brief Return the total size of the blocks allocated by the arena.
+   */
+  std::size_t GetAllocatedSize() const { return allocatedSize; }
+
+ private:
+  SerializerArena(const SerializerArena&) = delete;
+  SerializerArena& operator=(const SerializerArena&) = delete;
+
+  char* AllocateBlock(std::size_t size);
+
+  std::vector<char*> blocks;
+  char* current;  ///< The next free byte in the last block.
+  char* end;      ///< The end of the last block.
+  std::size_t allocatedSize;
+
+  static const std::size_t blockSize;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_SERIALIZERARENA_H
@@ -1,21 +1,89 @@
 #include "GDCore/Serialization/SerializerElement.h"
 
+#include <algorithm>
 #include <iostream>
+#include <new>
+#include "GDCore/Serialization/SerializerArena.h"
 
 namespace gd {
 
+namespace {
+/**
+ * The number of children from which an index of their names is built.
+ */
+const std::size_t minimumChildrenCountForIndex = 16;
+
+const gd::String unnamedChildName;
+
+void RemoveDuplicatedNames(const gd::String*& name1,
+                           const gd::String*& name2,
+                           const gd::String*& name3) {
+  if (name2 && name1 && *name2 == *name1) name2 = NULL;
+  if (name3 && ((name1 && *name3 == *name1) || (name2 && *name3 == *name2)))
+    name3 = NULL;
+}
+
+bool IsAttributeNameLess(
+    const std::pair<gd::String, SerializerValue>& attribute,
+    const gd::String& name) {
+  return attribute.first < name;
+}
+}  // namespace
+
 SerializerElement SerializerElement::nullElement;
 
-SerializerElement::SerializerElement() : valueUndefined(true), isArray(false) {}
+SerializerElement::SerializerElement()
+    : valueUndefined(true), ownsArena(false), arena(NULL), isArray(false) {}
 
 SerializerElement::SerializerElement(const SerializerValue& value)
-    : valueUndefined(false), elementValue(value), isArray(false) {}
+    : valueUndefined(false),
+      ownsArena(false),
+      elementValue(value),
+      arena(NULL),
+      isArray(false) {}
+
+SerializerElement::SerializerElement(SerializerElement&& other)
+    : ownsArena(false), arena(NULL) {
+  if (other.arena && !other.ownsArena) {
+    // The children are owned by the arena of another element: copy them.
+    Init(other);
+    return;
+  }
+
+  valueUndefined = other.valueUndefined;
+  elementValue = std::move(other.elementValue);
+  attributes = std::move(other.attributes);
+  children = std::move(other.children);
+  childrenIndex = std::move(other.childrenIndex);
+  isArray = other.isArray;
+  arrayOf = std::move(other.arrayOf);
+  deprecatedArrayOf = std::move(other.deprecatedArrayOf);
+  arena = other.arena;
+  ownsArena = other.ownsArena;
+
+  other.attributes.clear();
+  other.children.clear();
+  other.arena = NULL;
+  other.ownsArena = false;
+}
 
-SerializerElement::~SerializerElement() {}
+SerializerElement::~SerializerElement() {
+  // The children must be destroyed before the arena where they are allocated.
+  children.clear();
+  if (ownsArena) delete arena;
+}
+
+void SerializerElement::ChildDeleter::operator()(
+    SerializerElement* element) const {
+  if (element->arena && !element->ownsArena)
+    element->~SerializerElement();  // The memory is freed with the arena.
+  else
+    delete element;
+}
 
 const SerializerValue& SerializerElement::GetValue() const {
-  if (valueUndefined && attributes.find("value") != attributes.end())
-    return attributes.find("value")->second;
+  if (valueUndefined && FindAttribute("value"))
+    return *FindAttribute("value");
 
   return elementValue;
 }
@@ -26,7 +94,7 @@ SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                       // support code using attributes. Make sure that any
                       // existing child with this name is removed (otherwise it
                       // would erase the attribute at serialization).
-  attributes[name].SetBool(value);
+  GetOrAddAttribute(name).SetBool(value);
   return *this;
 }
 
@@ -36,7 +104,7 @@ SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                       // support code using attributes. Make sure that any
                       // existing child with this name is removed (otherwise it
                       // would erase the attribute at serialization).
-  attributes[name].SetString(value);
+  GetOrAddAttribute(name).SetString(value);
   return *this;
 }
 
@@ -46,7 +114,7 @@ SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                       // support code using attributes. Make sure that any
                       // existing child with this name is removed (otherwise it
                       // would erase the attribute at serialization).
-  attributes[name].SetInt(value);
+  GetOrAddAttribute(name).SetInt(value);
   return *this;
 }
 
@@ -56,18 +124,18 @@ SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                       // support code using attributes. Make sure that any
                       // existing child with this name is removed (otherwise it
                       // would erase the attribute at serialization).
-  attributes[name].SetDouble(value);
+  GetOrAddAttribute(name).SetDouble(value);
   return *this;
 }
 
 bool SerializerElement::GetBoolAttribute(const gd::String& name,
                                          bool defaultValue,
                                          gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end()) {
-    return attributes.find(name)->second.GetBool();
+  if (FindAttribute(name)) {
+    return FindAttribute(name)->GetBool();
   } else if (!deprecatedName.empty() &&
-             attributes.find(deprecatedName) != attributes.end()) {
-    return attributes.find(deprecatedName)->second.GetBool();
+             FindAttribute(deprecatedName)) {
+    return FindAttribute(deprecatedName)->GetBool();
   } else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -86,11 +154,11 @@ gd::String SerializerElement::GetStringAttribute(  // TODO: Use const ref?
     const gd::String& name,
     gd::String defaultValue,
     gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end())
-    return attributes.find(name)->second.GetString();
+  if (FindAttribute(name))
+    return FindAttribute(name)->GetString();
   else if (!deprecatedName.empty() &&
-           attributes.find(deprecatedName) != attributes.end())
-    return attributes.find(deprecatedName)->second.GetString();
+           FindAttribute(deprecatedName))
+    return FindAttribute(deprecatedName)->GetString();
   else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -104,11 +172,11 @@ gd::String SerializerElement::GetStringAttribute(  // TODO: Use const ref?
 int SerializerElement::GetIntAttribute(const gd::String& name,
                                        int defaultValue,
                                        gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end())
-    return attributes.find(name)->second.GetInt();
+  if (FindAttribute(name))
+    return FindAttribute(name)->GetInt();
   else if (!deprecatedName.empty() &&
-           attributes.find(deprecatedName) != attributes.end())
-    return attributes.find(deprecatedName)->second.GetInt();
+           FindAttribute(deprecatedName))
+    return FindAttribute(deprecatedName)->GetInt();
   else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -122,11 +190,11 @@ int SerializerElement::GetIntAttribute(const gd::String& name,
 double SerializerElement::GetDoubleAttribute(const gd::String& name,
                                              double defaultValue,
                                              gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end())
-    return attributes.find(name)->second.GetDouble();
+  if (FindAttribute(name))
+    return FindAttribute(name)->GetDouble();
   else if (!deprecatedName.empty() &&
-           attributes.find(deprecatedName) != attributes.end())
-    return attributes.find(deprecatedName)->second.GetDouble();
+           FindAttribute(deprecatedName))
+    return FindAttribute(deprecatedName)->GetDouble();
   else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -138,7 +206,25 @@ double SerializerElement::GetDoubleAttribute(const gd::String& name,
 }
 
 bool SerializerElement::HasAttribute(const gd::String& name) const {
-  return attributes.find(name) != attributes.end();
+  return FindAttribute(name) != NULL;
+}
+
+const SerializerValue* SerializerElement::FindAttribute(
+    const gd::String& name) const {
+  auto it = std::lower_bound(
+      attributes.begin(), attributes.end(), name, IsAttributeNameLess);
+  if (it == attributes.end() || it->first != name) return NULL;
+
+  return &it->second;
+}
+
+SerializerValue& SerializerElement::GetOrAddAttribute(const gd::String& name) {
+  auto it = std::lower_bound(
+      attributes.begin(), attributes.end(), name, IsAttributeNameLess);
+  if (it == attributes.end() || it->first != name)
+    it = attributes.insert(it, std::make_pair(name, SerializerValue()));
+
+  return it->second;
 }
 
 SerializerElement& SerializerElement::AddChild(gd::String name) {
@@ -154,17 +240,15 @@ SerializerElement& SerializerElement::AddChild(gd::String name) {
 
   // In case of children of objects, there can be only one child with
   // a given name.
-  // Note: searching for the existing children is O(number of children). This
-  // could be improved, but in practice has no visible impact on saving
-  // large projects.
-  if (!isArray && HasChild(name)) {
-    return GetChild(name);
+  if (!isArray) {
+    std::size_t position = FindChildPosition(&name, NULL, NULL, 0);
+    if (position < children.size()) return *children[position].second;
   }
 
-  std::shared_ptr<SerializerElement> newElement(new SerializerElement);
-  children.push_back(std::make_pair(name, newElement));
+  children.push_back(std::make_pair(name, CreateChild()));
+  if (childrenIndex) (*childrenIndex)[name].push_back(children.size() - 1);
 
-  return *newElement;
+  return *children.back().second;
 }
 
 SerializerElement& SerializerElement::GetChild(std::size_t index) const {
@@ -175,19 +259,12 @@ SerializerElement& SerializerElement::GetChild(std::size_t index) const {
     return nullElement;
   }
 
-  std::size_t currentIndex = 0;
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == arrayOf || children[i].first.empty() ||
-        (!deprecatedArrayOf.empty() &&
-         children[i].first == deprecatedArrayOf)) {
-      if (index == currentIndex)
-        return *children[i].second;
-      else
-        currentIndex++;
-    }
-  }
+  std::size_t position = FindChildPosition(
+      &arrayOf,
+      &unnamedChildName,
+      deprecatedArrayOf.empty() ? NULL : &deprecatedArrayOf,
+      index);
+  if (position < children.size()) return *children[position].second;
 
   std::cout << "ERROR: Requested out of bound child at index " << index
             << std::endl;
@@ -206,19 +283,12 @@ SerializerElement& SerializerElement::GetChild(
     }
   }
 
-  std::size_t currentIndex = 0;
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == name ||
-        (isArray && children[i].first.empty()) ||
-        (!deprecatedName.empty() && children[i].first == deprecatedName)) {
-      if (index == currentIndex)
-        return *children[i].second;
-      else
-        currentIndex++;
-    }
-  }
+  std::size_t position =
+      FindChildPosition(&name,
+                        isArray ? &unnamedChildName : NULL,
+                        deprecatedName.empty() ? NULL : &deprecatedName,
+                        index);
+  if (position < children.size()) return *children[position].second;
 
   std::cout << "Child " << name << " not found in SerializerElement::GetChild"
             << std::endl;
@@ -240,39 +310,146 @@ std::size_t SerializerElement::GetChildrenCount(
     deprecatedName = deprecatedArrayOf;
   }
 
+  return CountChildren(&name,
+                       isArray ? &unnamedChildName : NULL,
+                       deprecatedName.empty() ? NULL : &deprecatedName);
+}
+
+bool SerializerElement::HasChild(const gd::String& name,
+                                 gd::String deprecatedName) const {
+  return FindChildPosition(&name,
+                           NULL,
+                           deprecatedName.empty() ? NULL : &deprecatedName,
+                           0) < children.size();
+}
+
+void SerializerElement::RemoveChild(const gd::String& name) {
+  if (UpdateChildrenIndex() &&
+      childrenIndex->find(name) == childrenIndex->end())
+    return;
+
+  bool removed = false;
+  for (size_t i = 0; i < children.size();) {
+    if (children[i].first == name) {
+      children.erase(children.begin() + i);
+      removed = true;
+    } else
+      ++i;
+  }
+
+  if (removed) {
+    // The positions of the next children have changed.
+    childrenIndex.reset();
+  }
+}
+
+std::size_t SerializerElement::FindChildPosition(const gd::String* name1,
+                                                 const gd::String* name2,
+                                                 const gd::String* name3,
+                                                 std::size_t index) const {
+  RemoveDuplicatedNames(name1, name2, name3);
+
+  if (UpdateChildrenIndex()) {
+    const std::vector<std::size_t>* positions = NULL;
+    std::size_t foundNamesCount = 0;
+    for (const gd::String* name : {name1, name2, name3}) {
+      if (!name) continue;
+
+      auto it = childrenIndex->find(*name);
+      if (it != childrenIndex->end()) {
+        positions = &it->second;
+        foundNamesCount++;
+      }
+    }
+
+    if (foundNamesCount == 0) return children.size();
+    if (foundNamesCount == 1)
+      return index < positions->size() ? (*positions)[index] : children.size();
+
+    // Children with different names are matching (for example, named and
+    // unnamed elements of an array): search them in order below.
+  }
+
   std::size_t currentIndex = 0;
   for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == name ||
-        (isArray && children[i].first.empty()) ||
-        (!deprecatedName.empty() && children[i].first == deprecatedName))
-      currentIndex++;
+    const gd::String& childName = children[i].first;
+    if ((name1 && childName == *name1) || (name2 && childName == *name2) ||
+        (name3 && childName == *name3)) {
+      if (index == currentIndex)
+        return i;
+      else
+        currentIndex++;
+    }
   }
 
-  return currentIndex;
+  return children.size();
 }
 
-bool SerializerElement::HasChild(const gd::String& name,
-                                 gd::String deprecatedName) const {
+std::size_t SerializerElement::CountChildren(const gd::String* name1,
+                                             const gd::String* name2,
+                                             const gd::String* name3) const {
+  RemoveDuplicatedNames(name1, name2, name3);
+
+  std::size_t count = 0;
+  if (UpdateChildrenIndex()) {
+    for (const gd::String* name : {name1, name2, name3}) {
+      if (!name) continue;
+
+      auto it = childrenIndex->find(*name);
+      if (it != childrenIndex->end()) count += it->second.size();
+    }
+
+    return count;
+  }
+
   for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
+    const gd::String& childName = children[i].first;
+    if ((name1 && childName == *name1) || (name2 && childName == *name2) ||
+        (name3 && childName == *name3))
+      count++;
+  }
 
-    if (children[i].first == name ||
-        (!deprecatedName.empty() && children[i].first == deprecatedName))
-      return true;
+  return count;
+}
+
+void SerializerElement::AllocateChildrenInArena() {
+  if (arena) return;
+  if (!children.empty()) {
+    std::cout << "ERROR: Trying to allocate the children of a "
+                 "SerializerElement in an arena whereas it already has "
+                 "children."
+              << std::endl;
+    return;
   }
 
-  return false;
+  arena = new SerializerArena;
+  ownsArena = true;
 }
 
-void SerializerElement::RemoveChild(const gd::String& name) {
-  for (size_t i = 0; i < children.size();) {
-    if (children[i].first == name)
-      children.erase(children.begin() + i);
-    else
-      ++i;
+std::unique_ptr<SerializerElement, SerializerElement::ChildDeleter>
+SerializerElement::CreateChild() const {
+  if (!arena)
+    return std::unique_ptr<SerializerElement, ChildDeleter>(
+        new SerializerElement);
+
+  SerializerElement* child =
+      new (arena->Allocate(sizeof(SerializerElement))) SerializerElement;
+  child->arena = arena;
+  return std::unique_ptr<SerializerElement, ChildDeleter>(child);
+}
+
+bool SerializerElement::UpdateChildrenIndex() const {
+  // Searching in a few children is faster than maintaining an index.
+  if (children.size() < minimumChildrenCountForIndex) return false;
+
+  if (!childrenIndex) {
+    childrenIndex.reset(
+        new std::unordered_map<gd::String, std::vector<std::size_t> >);
+    for (std::size_t i = 0; i < children.size(); ++i)
+      (*childrenIndex)[children[i].first].push_back(i);
   }
+
+  return true;
 }
 
 void SerializerElement::Init(const gd::SerializerElement& other) {
@@ -281,12 +458,14 @@ void SerializerElement::Init(const gd::SerializerElement& other) {
   attributes = other.attributes;
 
   children.clear();
+  if (ownsArena) arena->Clear();  // Only the children were in the arena.
+
+  children.reserve(other.children.size());
   for (const auto& child : other.children) {
-    children.push_back(
-        std::make_pair(child.first,
-                       std::shared_ptr<SerializerElement>(
-                           new SerializerElement(*child.second))));
+    children.push_back(std::make_pair(child.first, CreateChild()));
+    *children.back().second = *child.second;
   }
+  childrenIndex.reset();
 
   isArray = other.isArray;
   arrayOf = other.arrayOf;
@@ -9,10 +9,15 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "GDCore/Serialization/SerializerValue.h"
 #include "GDCore/String.h"
 
+namespace gd {
+class SerializerArena;
+}
+
 namespace gd {
 
 /**
@@ -27,9 +32,11 @@ namespace gd {
  * It also has specialized methods in GDevelop.js (see postjs.js) to be
  * converted to a JavaScript object.
  *
- * \note Children are stored with their order preserved, but this also
- * means that their access/removal is O(number of children). This class
- * is not appropriated for a use in game where fast access is required.
+ * \note Children are stored with their order preserved. When an element has a
+ * lot of children, an index of their names is built the first time a child is
+ * searched by name, so that the access is O(1) even for large arrays or
+ * objects (like the instances of a large layout). Removing a child is still
+ * O(number of children).
  *
  * \see gd::Serializer
  */
@@ -49,7 +56,16 @@ class GD_CORE_API SerializerElement {
   /**
    * Copy constructor.
    */
-  SerializerElement(const gd::SerializerElement &object) { Init(object); };
+  SerializerElement(const gd::SerializerElement &object)
+      : ownsArena(false), arena(NULL) {
+    Init(object);
+  };
+
+  /**
+   * Move constructor. The children are moved, unless \a object is allocated in
+   * the arena of another element (in which case they are copied).
+   */
+  SerializerElement(gd::SerializerElement &&object);
 
   /**
    * Assignment operator.
@@ -316,9 +332,10 @@ class GD_CORE_API SerializerElement {
   bool HasAttribute(const gd::String &name) const;
 
   /**
-   * \brief Return all the attributes of the element.
+   * \brief Return all the attributes of the element, sorted by name.
    */
-  const std::map<gd::String, SerializerValue> &GetAllAttributes() const {
+  const std::vector<std::pair<gd::String, SerializerValue> >
+      &GetAllAttributes() const {
     return attributes;
   };
   ///@}
@@ -412,7 +429,6 @@ class GD_CORE_API SerializerElement {
 
   /**
    * \brief Return true if the specified child exists.
-   * \note Complexity is O(number of children).
    * \param name The name of the child to find.
    */
   bool HasChild(const gd::String &name, gd::String deprecatedName = "") const;
@@ -424,13 +440,35 @@ class GD_CORE_API SerializerElement {
    */
   void RemoveChild(const gd::String &name);
 
+  /**
+   * \brief Destroy a child, freeing its memory unless it was allocated in an
+   * arena.
+   */
+  struct GD_CORE_API ChildDeleter {
+    void operator()(SerializerElement *element) const;
+  };
+
   /**
    * \brief Return all the children of the element.
    */
-  const std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement> > >
+  const std::vector<
+      std::pair<gd::String, std::unique_ptr<SerializerElement, ChildDeleter> > >
       &GetAllChildren() const {
     return children;
   };
+
+  /**
+   * \brief Allocate the descendants of the element in an arena owned by the
+   * element.
+   *
+   * This avoids an allocation for each element of a large tree (like a whole
+   * project being loaded or saved), and all the memory is freed at once when
+   * the element is destroyed. Children that are removed are only freed at this
+   * moment.
+   *
+   * \note Must be called before adding children to the element.
+   */
+  void AllocateChildrenInArena();
   ///@}
 
   static SerializerElement nullElement;
@@ -442,12 +480,61 @@ class GD_CORE_API SerializerElement {
    */
   void Init(const gd::SerializerElement& other);
 
+  /**
+   * Return the position, in children, of the index-th child having one of the
+   * given names (null names are ignored), or children.size() if not found.
+   */
+  std::size_t FindChildPosition(const gd::String *name1,
+                                const gd::String *name2,
+                                const gd::String *name3,
+                                std::size_t index) const;
+
+  /**
+   * Return the number of children having one of the given names (null names
+   * are ignored).
+   */
+  std::size_t CountChildren(const gd::String *name1,
+                            const gd::String *name2,
+                            const gd::String *name3) const;
+
+  /**
+   * Build the index of the children names if the element has enough children
+   * for it to be useful.
+   * \return true if the index can be used.
+   */
+  bool UpdateChildrenIndex() const;
+
+  /**
+   * Create a new element, in the arena if any, to be added as a child.
+   */
+  std::unique_ptr<SerializerElement, ChildDeleter> CreateChild() const;
+
+  /**
+   * Return the attribute with the given name, or NULL if not found.
+   */
+  const SerializerValue *FindAttribute(const gd::String &name) const;
+
+  /**
+   * Return the attribute with the given name, adding it if necessary.
+   */
+  SerializerValue &GetOrAddAttribute(const gd::String &name);
+
   bool valueUndefined;  ///< If true, the element does not have a value.
+  bool ownsArena;       ///< If true, arena was created for this element.
   SerializerValue elementValue;
 
-  std::map<gd::String, SerializerValue> attributes;
-  std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement> > >
+  SerializerArena *arena;  ///< The arena where the children are allocated, if
+                           ///< any. Unless ownsArena is true, the element is
+                           ///< also allocated in it.
+  std::vector<std::pair<gd::String, SerializerValue> >
+      attributes;  ///< Sorted by name.
+  std::vector<
+      std::pair<gd::String, std::unique_ptr<SerializerElement, ChildDeleter> > >
       children;
+  mutable std::unique_ptr<
+      std::unordered_map<gd::String, std::vector<std::size_t> > >
+      childrenIndex;  ///< The positions of the children, for each name. Built
+                      ///< lazily, see UpdateChildrenIndex.
   mutable bool isArray;        ///< true if element is considered as an array
   mutable gd::String arrayOf;  ///< The name of the children (was useful for XML
                                ///< parsed elements).
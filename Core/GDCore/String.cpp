@@ -6,6 +6,10 @@
 
 #include "GDCore/String.h"
 
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
 #include <SFML/System/String.hpp>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Utf8/utf8proc.h"
@@ -15,35 +19,71 @@ namespace gd
 
 constexpr String::size_type String::npos;
 
-String::String() : m_string()
+String::String() : m_string(), m_size(0)
 {
 
 }
 
-String::String(const char *characters) : m_string()
+String::String(const char *characters) : m_string(), m_size(0)
 {
     *this = characters;
 }
 
-String::String(const sf::String &string) : m_string()
+String::String(const sf::String &string) : m_string(), m_size(0)
 {
     *this = string;
 }
 
-String::String(const std::u32string &string) : m_string()
+String::String(const std::u32string &string) : m_string(), m_size(0)
 {
     *this = string;
 }
 
+String::String(const String &other) : m_string(other.m_string), m_size(other.GetCachedSize())
+{
+
+}
+
+String::String(String &&other) noexcept : m_string(std::move(other.m_string)), m_size(other.GetCachedSize())
+{
+    other.m_string.clear();
+    other.SetCachedSize(0);
+}
+
 String& String::operator=(const char *characters)
 {
     m_string = std::string(characters);
+    SetCachedSize(npos);
+    return *this;
+}
+
+String& String::operator=(const String &other)
+{
+    if(this != &other)
+    {
+        m_string = other.m_string;
+        SetCachedSize(other.GetCachedSize());
+    }
+
+    return *this;
+}
+
+String& String::operator=(String &&other) noexcept
+{
+    if(this != &other)
+    {
+        m_string = std::move(other.m_string);
+        SetCachedSize(other.GetCachedSize());
+        other.m_string.clear();
+        other.SetCachedSize(0);
+    }
+
     return *this;
 }
 
 String& String::operator=(const sf::String &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -63,7 +103,7 @@ String& String::operator=(const sf::String &string)
 
 String& String::operator=(const std::u32string &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -83,7 +123,20 @@ String& String::operator=(const std::u32string &string)
 
 String::size_type String::size() const
 {
-    return std::distance(begin(), end());
+    size_type cachedSize = GetCachedSize();
+    if(cachedSize == npos)
+    {
+        //Most strings are pure ASCII: there is no need to decode them
+        //as every character is one byte long.
+        bool isAscii = std::all_of(m_string.begin(), m_string.end(),
+            [](char byte) { return (static_cast<unsigned char>(byte) & 0x80) == 0; });
+
+        //Threads computing it at the same time store the same value.
+        cachedSize = isAscii ? m_string.size() : std::distance(begin(), end());
+        SetCachedSize(cachedSize);
+    }
+
+    return cachedSize;
 }
 
 String::iterator String::begin()
@@ -158,6 +211,243 @@ String String::FromWide( const std::wstring &wstr )
     return str;
 }
 
+namespace
+{
+    /**
+     * Write the digits of **value** just before **end**.
+     * \return a pointer to the first digit.
+     */
+    char* WriteDigitsBackward( unsigned long long value, char *end )
+    {
+        do
+        {
+            *--end = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while(value != 0);
+
+        return end;
+    }
+
+    /**
+     * Skip the whitespaces and read the sign of a number, like a stream does.
+     * \return a pointer to the first character after the sign.
+     */
+    const char* ReadSign( const char *str, bool &negative )
+    {
+        while(*str == ' ' || (*str >= '\t' && *str <= '\r'))
+            ++str;
+
+        negative = (*str == '-');
+        if(*str == '-' || *str == '+')
+            ++str;
+
+        return str;
+    }
+
+    bool IsDigit( char character )
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    /**
+     * Read the decimal number in **str** as (-1)^negative * mantissa * 10^exponent.
+     * \return false if the number is not valid for a stream (which then
+     * returns 0), or if the mantissa has too many digits.
+     */
+    bool ReadDecimal( const char *str, bool &negative, unsigned long long &mantissa, int &exponent )
+    {
+        const int maxMantissaDigits = 19; //Ensure that the mantissa fits in 64 bits.
+
+        str = ReadSign(str, negative);
+        mantissa = 0;
+        exponent = 0;
+        int mantissaDigits = 0;
+        bool hasDigits = false;
+        for(; IsDigit(*str); ++str)
+        {
+            hasDigits = true;
+            if(mantissa == 0 && *str == '0') continue;
+            if(++mantissaDigits > maxMantissaDigits) return false;
+            mantissa = mantissa * 10 + (*str - '0');
+        }
+        if(*str == '.')
+        {
+            for(++str; IsDigit(*str); ++str)
+            {
+                hasDigits = true;
+                --exponent;
+                if(mantissa == 0 && *str == '0') continue;
+                if(++mantissaDigits > maxMantissaDigits) return false;
+                mantissa = mantissa * 10 + (*str - '0');
+            }
+        }
+        if(!hasDigits)
+            return false;
+
+        if(*str == 'e' || *str == 'E')
+        {
+            ++str;
+            bool negativeExponent = (*str == '-');
+            if(*str == '-' || *str == '+')
+                ++str;
+            if(!IsDigit(*str))
+                return false;
+
+            int writtenExponent = 0;
+            for(; IsDigit(*str); ++str)
+            {
+                if(writtenExponent < 10000)
+                    writtenExponent = writtenExponent * 10 + (*str - '0');
+            }
+            exponent += negativeExponent ? -writtenExponent : writtenExponent;
+        }
+
+        return true;
+    }
+}
+
+String String::FromSignedInteger( long long value )
+{
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    unsigned long long magnitude = value < 0 ?
+        0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+
+    char *begin = WriteDigitsBackward(magnitude, end);
+    if(value < 0)
+        *--begin = '-';
+
+    String str;
+    str.m_string.assign(begin, end);
+    str.SetCachedSize(str.m_string.size());
+    return str;
+}
+
+String String::FromUnsignedInteger( unsigned long long value )
+{
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *begin = WriteDigitsBackward(value, end);
+
+    String str;
+    str.m_string.assign(begin, end);
+    str.SetCachedSize(str.m_string.size());
+    return str;
+}
+
+String String::FromDouble( double value )
+{
+    //Streams output at most 6 significant digits, so integers below 10^6
+    //are written as is.
+    if(std::fabs(value) < 1e6 && value == std::floor(value) && !(value == 0 && std::signbit(value)))
+        return FromSignedInteger(static_cast<long long>(value));
+
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+
+    //Streams use the "C" locale, whatever the locale of the C library is.
+    char decimalPoint = *std::localeconv()->decimal_point;
+    if(decimalPoint != '.')
+        std::replace(buffer, buffer + length, decimalPoint, '.');
+
+    String str;
+    str.m_string.assign(buffer, length);
+    str.SetCachedSize(str.m_string.size());
+    return str;
+}
+
+bool String::ToSignedInteger( long long &value ) const
+{
+    bool negative;
+    unsigned long long magnitude;
+    const char *str = ReadSign(m_string.c_str(), negative);
+    if(!IsDigit(*str))
+        return false;
+
+    const unsigned long long maxMagnitude = negative ?
+        static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + 1 :
+        static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+    for(magnitude = 0; IsDigit(*str); ++str)
+    {
+        unsigned long long digit = *str - '0';
+        if(magnitude > (maxMagnitude - digit) / 10)
+            return false;
+        magnitude = magnitude * 10 + digit;
+    }
+
+    value = negative ? static_cast<long long>(0ull - magnitude) : static_cast<long long>(magnitude);
+    return true;
+}
+
+bool String::ToUnsignedInteger( unsigned long long &value ) const
+{
+    bool negative;
+    const char *str = ReadSign(m_string.c_str(), negative);
+    if(negative || !IsDigit(*str))
+        return false;
+
+    for(value = 0; IsDigit(*str); ++str)
+    {
+        unsigned long long digit = *str - '0';
+        if(value > (std::numeric_limits<unsigned long long>::max() - digit) / 10)
+            return false;
+        value = value * 10 + digit;
+    }
+
+    return true;
+}
+
+bool String::ToFloatingPoint( double &value ) const
+{
+    //Powers of ten that are exactly represented by a double.
+    static const double powersOf10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    bool negative;
+    unsigned long long mantissa;
+    int exponent;
+    if(!ReadDecimal(m_string.c_str(), negative, mantissa, exponent))
+        return false;
+
+    //When both the mantissa and the power of ten are exactly represented,
+    //a single multiplication or division gives the correctly rounded result.
+    if(mantissa == 0)
+        value = 0;
+    else if(mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+        value = exponent >= 0 ? static_cast<double>(mantissa) * powersOf10[exponent] :
+            static_cast<double>(mantissa) / powersOf10[-exponent];
+    else
+        return false;
+
+    if(negative) value = -value;
+    return true;
+}
+
+bool String::ToFloatingPoint( float &value ) const
+{
+    //Powers of ten that are exactly represented by a float.
+    static const float powersOf10[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+    bool negative;
+    unsigned long long mantissa;
+    int exponent;
+    if(!ReadDecimal(m_string.c_str(), negative, mantissa, exponent))
+        return false;
+
+    if(mantissa == 0)
+        value = 0;
+    else if(mantissa <= (1ull << 24) && exponent >= -10 && exponent <= 10)
+        value = exponent >= 0 ? static_cast<float>(mantissa) * powersOf10[exponent] :
+            static_cast<float>(mantissa) / powersOf10[-exponent];
+    else
+        return false;
+
+    if(negative) value = -value;
+    return true;
+}
+
 std::string String::ToLocale() const
 {
 #if defined(WINDOWS)
@@ -231,12 +521,16 @@ String& String::ReplaceInvalid( value_type replacement )
     ::utf8::replace_invalid(m_string.begin(), m_string.end(), std::back_inserter(validStr), replacement);
 
     m_string = validStr;
+    SetCachedSize(npos);
 
     return *this;
 }
 
 String::value_type String::operator[]( const String::size_type position ) const
 {
+    if(HasOnlySingleByteCharacters())
+        return static_cast<unsigned char>(m_string[position]);
+
     const_iterator it = begin();
     std::advance(it, position);
     return *it;
@@ -244,6 +538,9 @@ String::value_type String::operator[]( const String::size_type position ) const
 
 String& String::operator+=( const String &other )
 {
+    size_type currentSize = GetCachedSize();
+    size_type otherSize = other.GetCachedSize();
+    SetCachedSize((currentSize != npos && otherSize != npos) ? currentSize + otherSize : npos);
     m_string += other.m_string;
     return *this;
 }
@@ -263,27 +560,41 @@ String& String::operator+=( value_type character )
 void String::push_back( String::value_type character )
 {
     ::utf8::unchecked::append(character, std::back_inserter(m_string));
+    if(GetCachedSize() != npos)
+        SetCachedSize(GetCachedSize() + 1);
 }
 
 void String::pop_back()
 {
     m_string.erase((--end()).base(), end().base());
+    if(GetCachedSize() != npos)
+        SetCachedSize(GetCachedSize() - 1);
 }
 
 String& String::insert( size_type pos, const String &str )
 {
-    iterator it = begin();
-    std::advance(it, pos);
+    size_type newSize = (GetCachedSize() != npos && str.GetCachedSize() != npos) ? GetCachedSize() + str.GetCachedSize() : npos;
+    if(HasOnlySingleByteCharacters())
+    {
+        m_string.insert( pos, str.m_string );
+    }
+    else
+    {
+        iterator it = begin();
+        std::advance(it, pos);
 
-    //Use the real position as bytes using the std::string::iterators
-    m_string.insert( std::distance(m_string.begin(), it.base()), str.m_string );
+        //Use the real position as bytes using the std::string::iterators
+        m_string.insert( std::distance(m_string.begin(), it.base()), str.m_string );
+    }
 
+    SetCachedSize(newSize);
     return *this;
 }
 
 String& String::replace( iterator i1, iterator i2, const String &str )
 {
     m_string.replace(i1.base(), i2.base(), str.m_string);
+    SetCachedSize(npos);
 
     return *this;
 }
@@ -293,6 +604,16 @@ String& String::replace( String::size_type pos, String::size_type len, const Str
     if(pos > size())
         throw std::out_of_range("[gd::String::replace] starting pos greater than size");
 
+    if(HasOnlySingleByteCharacters())
+    {
+        size_type newSize = str.GetCachedSize() != npos ?
+            GetCachedSize() - std::min(len, GetCachedSize() - pos) + str.GetCachedSize() : npos;
+        m_string.replace(pos, len, str.m_string);
+        SetCachedSize(newSize);
+
+        return *this;
+    }
+
     iterator i1 = begin();
     std::advance( i1, pos );
 
@@ -308,11 +629,13 @@ String& String::replace( String::size_type pos, String::size_type len, const Str
 
 String::iterator String::erase( String::iterator first, String::iterator last )
 {
+    SetCachedSize(npos);
     return iterator( m_string.erase( first.base(), last.base() ) );
 }
 
 String::iterator String::erase( String::iterator p )
 {
+    SetCachedSize(npos);
     return iterator( m_string.erase( p.base() ) );
 }
 
@@ -321,6 +644,13 @@ void String::erase( String::size_type pos, String::size_type len )
     if(pos > size())
         throw std::out_of_range("[gd::String::erase] starting pos greater than size");
 
+    if(HasOnlySingleByteCharacters())
+    {
+        SetCachedSize(GetCachedSize() - std::min(len, GetCachedSize() - pos));
+        m_string.erase(pos, len);
+        return;
+    }
+
     iterator i1 = begin();
     std::advance(i1, pos);
 
@@ -417,6 +747,7 @@ String& String::Normalize(String::NormForm form)
         newStr = utf8proc_NFKC((unsigned char*)m_string.c_str());
 
     m_string = (char*)newStr;
+    SetCachedSize(npos);
 
     free(newStr);
 
@@ -427,6 +758,16 @@ String String::substr( String::size_type start, String::size_type length ) const
 {
     String str;
 
+    if(HasOnlySingleByteCharacters())
+    {
+        if(start > m_string.size())
+            throw std::out_of_range("[gd::String::substr] starting pos greater than size");
+
+        str.m_string = m_string.substr(start, length);
+        str.SetCachedSize(str.m_string.size());
+        return str;
+    }
+
     const_iterator startIt = begin();
     while(start > 0 && startIt != end())
     {
@@ -444,12 +785,16 @@ String String::substr( String::size_type start, String::size_type length ) const
     }
 
     str.m_string = std::string( startIt.base(), endIt.base() );
+    str.SetCachedSize(npos);
 
     return str;
 }
 
 String::size_type String::find( const String &search, String::size_type pos ) const
 {
+    if(HasOnlySingleByteCharacters())
+        return pos < GetCachedSize() ? m_string.find( search.m_string, pos ) : npos;
+
     const_iterator it = begin();
 
     //Move to pos
@@ -488,6 +833,9 @@ String::size_type String::find( const String::value_type search, String::size_ty
 
 String::size_type String::rfind( const String &search, String::size_type pos ) const
 {
+    if(HasOnlySingleByteCharacters())
+        return m_string.rfind( search.m_string, pos < GetCachedSize() ? pos : std::string::npos );
+
     //Move to pos + 1 (we will then get the last byte of the character at pos)
     const_iterator it = begin();
     std::string::const_iterator baseIt;
@@ -553,11 +901,17 @@ namespace priv
 
 String::size_type String::find_first_of( const String &match, size_type startPos ) const
 {
+    if(HasOnlySingleByteCharacters() && match.HasOnlySingleByteCharacters())
+        return m_string.find_first_of( match.m_string, startPos );
+
     return priv::find_first_of(*this, match, startPos, false);
 }
 
 String::size_type String::find_first_not_of( const String &match, size_type startPos ) const
 {
+    if(HasOnlySingleByteCharacters() && match.HasOnlySingleByteCharacters())
+        return m_string.find_first_not_of( match.m_string, startPos );
+
     return priv::find_first_of(*this, match, startPos, true);
 }
 
@@ -587,11 +941,17 @@ namespace priv
 
 String::size_type String::find_last_of( const String &match, size_type endPos ) const
 {
+    if(HasOnlySingleByteCharacters() && match.HasOnlySingleByteCharacters())
+        return m_string.find_last_of( match.m_string, endPos );
+
     return priv::find_last_of( *this, match, endPos, false );
 }
 
 String::size_type String::find_last_not_of( const String &match, size_type endPos ) const
 {
+    if(HasOnlySingleByteCharacters() && match.HasOnlySingleByteCharacters())
+        return m_string.find_last_not_of( match.m_string, endPos );
+
     return priv::find_last_of( *this, match, endPos, true );
 }
 
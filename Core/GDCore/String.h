@@ -7,11 +7,14 @@
 #ifndef GDCORE_UTF8_STRING_H
 #define GDCORE_UTF8_STRING_H
 
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <SFML/System/String.hpp>
 
@@ -126,6 +129,14 @@ public:
      */
     String(const sf::String &string);
 
+    String(const String &other);
+
+    /**
+     * Constructs a String by moving the content of **other**, which is left
+     * empty.
+     */
+    String(String &&other) noexcept;
+
 /**
  * \}
  */
@@ -150,6 +161,10 @@ public:
 
     String& operator=(const std::u32string &string);
 
+    String& operator=(const String &other);
+
+    String& operator=(String &&other) noexcept;
+
 /**
  * \}
  */
@@ -166,6 +181,13 @@ public:
 
     /**
      * \brief Returns the string's length.
+     *
+     * The length is computed the first time it's needed and cached until the
+     * string is modified. Computing it is fast for pure ASCII strings and
+     * linear on the string size otherwise.
+     *
+     * \note Like other const methods, it can be called by several threads at
+     * the same time: the cache is atomic.
      */
     size_type size() const;
 
@@ -179,7 +201,7 @@ public:
      *
      * **Iterators :** Obviously, all iterators are invalidated.
      */
-    void clear() { m_string.clear(); }
+    void clear() { m_string.clear(); SetCachedSize(0); }
 
 /**
  * \}
@@ -222,6 +244,10 @@ public:
     /**
      * \brief Method to create a gd::String from a number (float, double, int, ...)
      * \return a gd::String created from **value**.
+     *
+     * \note The result is the same as when using a std::ostringstream (with
+     * the "C" locale), but integers, float and double are converted without
+     * any stream.
      */
     template<typename T>
     static String From(T value)
@@ -229,14 +255,16 @@ public:
         static_assert(!std::is_same<T, std::string>::value, "Can't use gd::String::From with std::string.");
         static_assert(!std::is_same<T, sf::String>::value, "Can't use gd::String::From with sf::String.");
 
-        std::ostringstream oss;
-        oss << value;
-        return gd::String(oss.str().c_str());
+        return FromNumber(value);
     }
 
     /**
      * \brief Method to convert the string to a number
      * \return the string converted to the type **T**
+     *
+     * \note The result is the same as when using a std::istringstream (with
+     * the "C" locale), but most of the integers, float and double are parsed
+     * without any stream.
      */
     template<typename T>
     T To() const
@@ -244,10 +272,7 @@ public:
         static_assert(!std::is_same<T, std::string>::value, "Can't use gd::String::To with std::string.");
         static_assert(!std::is_same<T, sf::String>::value, "Can't use gd::String::To with sf::String.");
 
-        T value;
-        std::istringstream oss(m_string);
-        oss >> value;
-        return value;
+        return ToNumber<T>();
     }
 
 /**
@@ -366,16 +391,20 @@ public:
 
     /**
      * \brief Returns the code point at the specified position
-     * \warning This operator has a linear complexity on the character's
-     * position. You should avoid to use it in a loop and use the iterators
-     * provided by this class instead.
+     * \warning Unless the string only contains ASCII characters, this operator
+     * has a linear complexity on the character's position. You should avoid to
+     * use it in a loop and use the iterators provided by this class instead.
      */
     value_type operator[]( const size_type position ) const;
 
     /**
      * \brief Get the raw UTF8-encoded std::string
+     *
+     * \warning The reference must only be used to modify the string before
+     * calling any other method of the String (the cached length is reset when
+     * calling this method).
      */
-    std::string& Raw() { return m_string; }
+    std::string& Raw() { SetCachedSize(npos); return m_string; }
 
     /**
      * \brief Get the raw UTF8-encoded std::string
@@ -633,7 +662,135 @@ public:
  */
 
 private:
+    /**
+     * \brief Tell if numbers of type T are converted without streams by From
+     * and To.
+     *
+     * Characters and booleans are not numbers for streams, so they are still
+     * converted using them.
+     */
+    template<typename T>
+    struct NumberKind
+    {
+        static constexpr bool isCharacter =
+            std::is_same<T, bool>::value || std::is_same<T, char>::value ||
+            std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value ||
+            std::is_same<T, wchar_t>::value || std::is_same<T, char16_t>::value ||
+            std::is_same<T, char32_t>::value;
+        static constexpr bool isSignedInteger = std::is_integral<T>::value && std::is_signed<T>::value && !isCharacter;
+        static constexpr bool isUnsignedInteger = std::is_integral<T>::value && std::is_unsigned<T>::value && !isCharacter;
+        static constexpr bool isFloatingPoint = std::is_same<T, float>::value || std::is_same<T, double>::value;
+        static constexpr bool isOther = !isSignedInteger && !isUnsignedInteger && !isFloatingPoint;
+    };
+
+    template<typename T>
+    static typename std::enable_if<NumberKind<T>::isSignedInteger, String>::type FromNumber(T value)
+    {
+        return FromSignedInteger(value);
+    }
+
+    template<typename T>
+    static typename std::enable_if<NumberKind<T>::isUnsignedInteger, String>::type FromNumber(T value)
+    {
+        return FromUnsignedInteger(value);
+    }
+
+    template<typename T>
+    static typename std::enable_if<NumberKind<T>::isFloatingPoint, String>::type FromNumber(T value)
+    {
+        return FromDouble(value); //Streams also output floats as doubles.
+    }
+
+    template<typename T>
+    static typename std::enable_if<NumberKind<T>::isOther, String>::type FromNumber(T value)
+    {
+        std::ostringstream oss;
+        oss << value;
+        return gd::String(oss.str().c_str());
+    }
+
+    template<typename T>
+    typename std::enable_if<NumberKind<T>::isSignedInteger, T>::type ToNumber() const
+    {
+        long long value;
+        if(ToSignedInteger(value) &&
+           value >= std::numeric_limits<T>::min() && value <= std::numeric_limits<T>::max())
+            return static_cast<T>(value);
+
+        return ToNumberUsingStream<T>();
+    }
+
+    template<typename T>
+    typename std::enable_if<NumberKind<T>::isUnsignedInteger, T>::type ToNumber() const
+    {
+        unsigned long long value;
+        if(ToUnsignedInteger(value) && value <= std::numeric_limits<T>::max())
+            return static_cast<T>(value);
+
+        return ToNumberUsingStream<T>();
+    }
+
+    template<typename T>
+    typename std::enable_if<NumberKind<T>::isFloatingPoint, T>::type ToNumber() const
+    {
+        T value;
+        if(ToFloatingPoint(value))
+            return value;
+
+        return ToNumberUsingStream<T>();
+    }
+
+    template<typename T>
+    typename std::enable_if<NumberKind<T>::isOther, T>::type ToNumber() const
+    {
+        return ToNumberUsingStream<T>();
+    }
+
+    template<typename T>
+    T ToNumberUsingStream() const
+    {
+        T value = T(); //Streams don't set the value if the string is empty.
+        std::istringstream oss(m_string);
+        oss >> value;
+        return value;
+    }
+
+    static String FromSignedInteger(long long value);
+    static String FromUnsignedInteger(unsigned long long value);
+    static String FromDouble(double value);
+
+    /**
+     * \brief Parse the string as an integer, without streams.
+     * \return false if the string can't be parsed this way (in which case
+     * a stream must be used to get the same result).
+     */
+    bool ToSignedInteger(long long &value) const;
+    bool ToUnsignedInteger(unsigned long long &value) const;
+
+    /**
+     * \brief Parse the string as a floating point number, without streams.
+     * \return false if the string can't be parsed exactly this way (in which
+     * case a stream must be used to get a correctly rounded result).
+     */
+    bool ToFloatingPoint(double &value) const;
+    bool ToFloatingPoint(float &value) const;
+
+    /**
+     * \return true if all the characters are one byte long (i.e: the string
+     * only contains ASCII characters), in which case positions in characters
+     * are the same as positions in bytes.
+     */
+    bool HasOnlySingleByteCharacters() const { return size() == m_string.size(); }
+
+    /**
+     * \return The cached number of characters, or npos if not computed yet.
+     */
+    size_type GetCachedSize() const { return m_size.load(std::memory_order_relaxed); }
+
+    void SetCachedSize(size_type size) const { m_size.store(size, std::memory_order_relaxed); }
+
     std::string m_string; ///< Internal std::string container
+    mutable std::atomic<size_type> m_size; ///< Cached number of characters, or npos if not computed yet. Atomic as it can be computed by size() while other threads read the string.
 
 };
 
@@ -812,7 +969,10 @@ namespace std
  * The UTF8 encoding has the advantage to reduce the RAM consumption compared to UTF16 or UTF32 for strings using a lot
  * of latin characters. But the characters variable length brings some performance issues compared to fixed size encoding.
  * That's why the complexity of each methods is written in their documentation. For instance, the size() method is linear
- * on the string size and so is the operator[]().
+ * on the string size (its result is then cached until the string is modified) and so is the operator[]().
+ *
+ * As most strings only contain ASCII characters, the methods taking positions (operator[](), substr(), find(), insert(),
+ * erase()...) directly use the positions as bytes offsets when this is the case, avoiding to iterate over the string.
  *
  * \section Conversion Conversions from/to other string types
  * The String handles implicit conversion with sf::String (implicit constructor and implicit conversion
@@ -0,0 +1,13 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/NameIndex.h"
+
+namespace gd {
+
+std::size_t NameIndex::namesVersion = 0;
+std::size_t NameIndex::unnamedVersion = 0;
+
+}  // namespace gd
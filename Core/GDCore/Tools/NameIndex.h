@@ -0,0 +1,202 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_NAMEINDEX_H
+#define GDCORE_NAMEINDEX_H
+#include <unordered_map>
+#include <vector>
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief Index of the positions of named elements stored in a vector, so that
+ * an element can be found by its name without iterating over the vector.
+ *
+ * The vector is owned by the container (gd::ObjectsContainer, gd::Project,
+ * gd::ResourcesManager...), which passes it to the methods of the index. The
+ * elements are pointers to objects having a `GetName` method. When several
+ * elements have the same name, the first one is found.
+ *
+ * The container must tell the index about the elements it inserts and removes
+ * (or invalidate the index for any other change). Elements can also be renamed
+ * directly, so their classes call gd::NameIndex::NotifyNameChanged when their
+ * name is changed: the indexes are then rebuilt the next time they are used.
+ * Giving a name to a new (unnamed) element only invalidates the indexes
+ * containing unnamed elements, so that creating elements doesn't invalidate
+ * the indexes of the other containers.
+ *
+ * \ingroup PlatformDefinition
+ */
+class GD_CORE_API NameIndex {
+ public:
+  NameIndex()
+      : upToDate(false),
+        hasUnnamedElements(false),
+        indexedCount(0),
+        indexedNamesVersion(0),
+        indexedUnnamedVersion(0){};
+  virtual ~NameIndex(){};
+
+  /**
+   * \brief Return the position of the first element having the specified
+   * name, or gd::String::npos if there is no such element.
+   */
+  template <class T>
+  std::size_t Find(const std::vector<T>& elements,
+                   const gd::String& name) const {
+    if (!IsUpToDate(elements)) Rebuild(elements);
+
+    auto it = positions.find(name);
+    if (it == positions.end()) return gd::String::npos;
+    if (it->second < elements.size() &&
+        elements[it->second]->GetName() == name)
+      return it->second;
+
+    // The elements were moved in the vector without the index being told.
+    Rebuild(elements);
+    it = positions.find(name);
+    return it != positions.end() ? it->second : gd::String::npos;
+  }
+
+  /**
+   * \brief Return true if the index is in sync with the elements.
+   *
+   * Check this before inserting an element, to know if the index can be
+   * updated with InsertedAt after the insertion.
+   */
+  template <class T>
+  bool IsUpToDate(const std::vector<T>& elements) const {
+    return upToDate && indexedCount == elements.size() &&
+           indexedNamesVersion == namesVersion &&
+           (!hasUnnamedElements || indexedUnnamedVersion == unnamedVersion);
+  }
+
+  /**
+   * \brief Update the index after an element was inserted in the vector.
+   *
+   * \param wasUpToDate The result of IsUpToDate before the element was created
+   * and inserted. If false, the index will be rebuilt when used.
+   */
+  template <class T>
+  void InsertedAt(const std::vector<T>& elements,
+                  std::size_t position,
+                  bool wasUpToDate) {
+    if (!wasUpToDate || position >= elements.size()) {
+      Invalidate();
+      return;
+    }
+
+    if (position + 1 < elements.size()) {
+      for (auto& it : positions)
+        if (it.second >= position) ++it.second;
+    }
+
+    auto inserted = positions.emplace(elements[position]->GetName(), position);
+    if (!inserted.second && inserted.first->second > position)
+      inserted.first->second = position;
+
+    MarkAsUpToDate(elements);
+  }
+
+  /**
+   * \brief Update the index after the element at the specified position was
+   * removed from the vector.
+   *
+   * \param removedName The name of the removed element.
+   */
+  template <class T>
+  void RemovedAt(const std::vector<T>& elements,
+                 std::size_t position,
+                 const gd::String& removedName) {
+    if (!upToDate || indexedCount != elements.size() + 1 ||
+        indexedNamesVersion != namesVersion ||
+        (hasUnnamedElements && indexedUnnamedVersion != unnamedVersion)) {
+      Invalidate();
+      return;
+    }
+
+    auto removed = positions.find(removedName);
+    bool wasFirst = removed != positions.end() && removed->second == position;
+    if (wasFirst) positions.erase(removed);
+
+    if (position < elements.size()) {
+      for (auto& it : positions)
+        if (it.second > position) --it.second;
+    }
+
+    // Another element with the same name may now be the first one.
+    if (wasFirst) {
+      for (std::size_t i = position; i < elements.size(); ++i) {
+        if (elements[i]->GetName() == removedName) {
+          positions.emplace(removedName, i);
+          break;
+        }
+      }
+    }
+
+    MarkAsUpToDate(elements);
+  }
+
+  /**
+   * \brief Mark the index as outdated, so that it is rebuilt the next time
+   * it's used.
+   */
+  void Invalidate() {
+    upToDate = false;
+    positions.clear();
+  }
+
+  /**
+   * \brief Must be called when the name of an element that can be stored in a
+   * container using an index is changed.
+   *
+   * \param oldName The name of the element before the change.
+   */
+  static void NotifyNameChanged(const gd::String& oldName) {
+    if (oldName.empty())
+      ++unnamedVersion;
+    else
+      ++namesVersion;
+  }
+
+ private:
+  template <class T>
+  void Rebuild(const std::vector<T>& elements) const {
+    positions.clear();
+    positions.reserve(elements.size());
+    for (std::size_t i = 0; i < elements.size(); ++i)
+      positions.emplace(elements[i]->GetName(), i);
+
+    MarkAsUpToDate(elements);
+  }
+
+  template <class T>
+  void MarkAsUpToDate(const std::vector<T>& elements) const {
+    upToDate = true;
+    hasUnnamedElements = positions.count("") != 0;
+    indexedCount = elements.size();
+    indexedNamesVersion = namesVersion;
+    indexedUnnamedVersion = unnamedVersion;
+  }
+
+  mutable std::unordered_map<gd::String, std::size_t>
+      positions;  ///< The position of the first element having each name.
+  mutable bool upToDate;
+  mutable bool hasUnnamedElements;
+  mutable std::size_t indexedCount;  ///< The number of elements when the index
+                                     ///< was last updated.
+  mutable std::size_t indexedNamesVersion;
+  mutable std::size_t indexedUnnamedVersion;
+
+  static std::size_t namesVersion;  ///< Incremented each time an element is
+                                    ///< renamed.
+  static std::size_t unnamedVersion;  ///< Incremented each time an unnamed
+                                      ///< element is given a name.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_NAMEINDEX_H
@@ -0,0 +1,105 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Object.h"
+#include "catch.hpp"
+
+namespace {
+std::shared_ptr<gd::PlatformExtension> MakeExtension(const gd::String &name) {
+  auto extension = std::make_shared<gd::PlatformExtension>();
+  extension->SetExtensionInformation(name, name, "", "", "");
+  return extension;
+}
+}  // namespace
+
+TEST_CASE("MetadataProvider", "[common]") {
+  gd::Platform platform;
+  platform.EnableExtensionLoadingLogs(false);
+
+  // Extensions are given names of builtin extensions so that their
+  // instructions are not namespaced and can be declared by more than one.
+  auto baseObjectExtension = MakeExtension("BuiltinObject");
+  auto &baseObject =
+      baseObjectExtension->AddObject<gd::Object>("", "Base object", "", "");
+  baseObject.AddAction("BaseAction", "Base action", "", "", "", "", "");
+  baseObject.AddExpression("BaseExpression", "Base expression", "", "", "");
+  platform.AddExtension(baseObjectExtension);
+
+  auto firstExtension = MakeExtension("BuiltinTime");
+  firstExtension->AddAction("Action", "First action", "", "", "", "", "");
+  auto &firstObject =
+      firstExtension->AddObject<gd::Object>("Object", "Object", "", "");
+  firstObject.AddAction(
+      "ObjectAction", "First object action", "", "", "", "", "");
+  firstObject.AddExpression("BaseExpression", "Overridden", "", "", "");
+  platform.AddExtension(firstExtension);
+
+  auto secondExtension = MakeExtension("BuiltinAdvanced");
+  secondExtension->AddAction("Action", "Second action", "", "", "", "", "");
+  secondExtension->AddAction(
+      "ObjectAction", "Second free action", "", "", "", "", "");
+  platform.AddExtension(secondExtension);
+
+  SECTION("Metadata of the first loaded extension are found") {
+    auto action =
+        gd::MetadataProvider::GetExtensionAndActionMetadata(platform, "Action");
+    REQUIRE(action.GetExtension().GetName() == "BuiltinTime");
+    REQUIRE(action.GetMetadata().GetFullName() == "First action");
+
+    // An object action of a previously loaded extension is found before a free
+    // action of a later one.
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(platform, "ObjectAction")
+                .GetFullName() == "First object action");
+
+    // Only free actions are considered by HasAction.
+    REQUIRE(gd::MetadataProvider::HasAction(platform, "Action"));
+    REQUIRE(gd::MetadataProvider::HasAction(platform, "ObjectAction"));
+    REQUIRE_FALSE(gd::MetadataProvider::HasAction(platform, "BaseAction"));
+  }
+
+  SECTION("Functions of the base object are found for all objects") {
+    REQUIRE(
+        gd::MetadataProvider::HasObjectAction(platform, "Object", "BaseAction"));
+    REQUIRE(gd::MetadataProvider::HasObjectAction(
+        platform, "UnknownObject", "BaseAction"));
+    REQUIRE_FALSE(gd::MetadataProvider::HasObjectAction(
+        platform, "UnknownObject", "ObjectAction"));
+
+    REQUIRE(gd::MetadataProvider::GetObjectExpressionMetadata(
+                platform, "Object", "BaseExpression")
+                .GetFullName() == "Overridden");
+    REQUIRE(gd::MetadataProvider::GetObjectExpressionMetadata(
+                platform, "UnknownObject", "BaseExpression")
+                .GetFullName() == "Base expression");
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "UnknownObject", "UnknownExpression")));
+  }
+
+  SECTION("Index is updated when extensions are added or removed") {
+    REQUIRE(gd::MetadataProvider::GetObjectMetadata(platform, "Object")
+                .GetFullName() == "Object");
+
+    platform.RemoveExtension("BuiltinTime");
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(platform, "Action")
+                .GetFullName() == "Second action");
+    REQUIRE(gd::MetadataProvider::GetObjectMetadata(platform, "Object")
+                .GetFullName() != "Object");
+
+    auto thirdExtension = MakeExtension("BuiltinWindow");
+    thirdExtension->AddCondition(
+        "Condition", "Third condition", "", "", "", "", "");
+    platform.AddExtension(thirdExtension);
+    REQUIRE(gd::MetadataProvider::HasCondition(platform, "Condition"));
+    REQUIRE(gd::MetadataProvider::GetConditionMetadata(platform, "Condition")
+                .GetFullName() == "Third condition");
+  }
+}
@@ -0,0 +1,143 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Behavior.h"
+#include "GDCore/Project/BehaviorsSharedData.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Tools/MakeUnique.h"
+#include "catch.hpp"
+
+TEST_CASE("MetadataProvider - Benchmarks", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  // Add extensions like the ones of a real platform, each with an object and
+  // a behavior.
+  for (std::size_t i = 0; i < 40; ++i) {
+    auto extension = std::make_shared<gd::PlatformExtension>();
+    gd::String name = "Extension" + gd::String::From(i);
+    extension->SetExtensionInformation(name, name, "", "", "");
+
+    auto &object = extension->AddObject<gd::Object>("Object", "", "", "");
+    auto &behavior =
+        extension->AddBehavior("Behavior",
+                               "",
+                               "",
+                               "",
+                               "",
+                               "",
+                               "",
+                               gd::make_unique<gd::Behavior>(),
+                               gd::make_unique<gd::BehaviorsSharedData>());
+    for (std::size_t j = 0; j < 20; ++j) {
+      gd::String suffix = gd::String::From(j);
+      extension->AddAction("Action" + suffix, "", "", "", "", "", "");
+      extension->AddCondition("Condition" + suffix, "", "", "", "", "", "");
+      extension->AddExpression("Expression" + suffix, "", "", "", "");
+      object.AddAction("ObjectAction" + suffix, "", "", "", "", "", "");
+      object.AddCondition("ObjectCondition" + suffix, "", "", "", "", "", "");
+      object.AddExpression(name + "ObjectExpression" + suffix, "", "", "", "");
+      behavior.AddAction("BehaviorAction" + suffix, "", "", "", "", "", "");
+      behavior.AddCondition(
+          "BehaviorCondition" + suffix, "", "", "", "", "", "");
+    }
+    platform.AddExtension(extension);
+  }
+
+  // Look up everything that was declared, as code generation does.
+  std::vector<gd::String> actions;
+  std::vector<gd::String> conditions;
+  std::vector<std::pair<gd::String, gd::String>> objectExpressions;
+  std::vector<gd::String> behaviors;
+  for (auto &extension : platform.GetAllPlatformExtensions()) {
+    for (auto &it : extension->GetAllActions()) actions.push_back(it.first);
+    for (auto &it : extension->GetAllConditions())
+      conditions.push_back(it.first);
+    for (auto &objectType : extension->GetExtensionObjectsTypes()) {
+      for (auto &it : extension->GetAllActionsForObject(objectType))
+        actions.push_back(it.first);
+      for (auto &it : extension->GetAllConditionsForObject(objectType))
+        conditions.push_back(it.first);
+      for (auto &it : extension->GetAllExpressionsForObject(objectType))
+        objectExpressions.push_back(std::make_pair(objectType, it.first));
+    }
+    for (auto &behaviorType : extension->GetBehaviorsTypes()) {
+      behaviors.push_back(behaviorType);
+      for (auto &it : extension->GetAllActionsForBehavior(behaviorType))
+        actions.push_back(it.first);
+      for (auto &it : extension->GetAllConditionsForBehavior(behaviorType))
+        conditions.push_back(it.first);
+    }
+  }
+
+  auto doBenchmark = [](const gd::String &benchmarkName,
+                        std::size_t lookupsCount,
+                        std::function<void()> func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << benchmarkName << " benchmark (" << lookupsCount
+              << " lookups): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  const gd::InstructionMetadata *badInstructionMetadata =
+      &gd::MetadataProvider::GetActionMetadata(platform, "Unknown");
+  const gd::BehaviorMetadata *badBehaviorMetadata =
+      &gd::MetadataProvider::GetBehaviorMetadata(platform, "Unknown");
+
+  doBenchmark("MetadataProvider::GetActionMetadata", actions.size(), [&]() {
+    std::size_t found = 0;
+    for (auto &type : actions)
+      if (&gd::MetadataProvider::GetActionMetadata(platform, type) !=
+          badInstructionMetadata)
+        ++found;
+    REQUIRE(found == actions.size());
+  });
+  doBenchmark(
+      "MetadataProvider::GetConditionMetadata", conditions.size(), [&]() {
+        std::size_t found = 0;
+        for (auto &type : conditions)
+          if (&gd::MetadataProvider::GetConditionMetadata(platform, type) !=
+              badInstructionMetadata)
+            ++found;
+        REQUIRE(found == conditions.size());
+      });
+  doBenchmark("MetadataProvider::GetObjectExpressionMetadata",
+              objectExpressions.size(),
+              [&]() {
+                std::size_t found = 0;
+                for (auto &it : objectExpressions)
+                  if (!gd::MetadataProvider::IsBadExpressionMetadata(
+                          gd::MetadataProvider::GetObjectExpressionMetadata(
+                              platform, it.first, it.second)))
+                    ++found;
+                REQUIRE(found == objectExpressions.size());
+              });
+  doBenchmark(
+      "MetadataProvider::GetBehaviorMetadata", behaviors.size() * 100, [&]() {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < 100; ++i)
+          for (auto &type : behaviors)
+            if (&gd::MetadataProvider::GetBehaviorMetadata(platform, type) !=
+                badBehaviorMetadata)
+              ++found;
+        REQUIRE(found == behaviors.size() * 100);
+      });
+}
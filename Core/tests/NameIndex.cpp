@@ -0,0 +1,130 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/NameIndex.h"
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/ObjectsContainer.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/ResourcesManager.h"
+#include "catch.hpp"
+
+TEST_CASE("NameIndex", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  SECTION("ObjectsContainer") {
+    gd::ObjectsContainer container;
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object1", 0);
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object2", 1);
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object3", 2);
+    REQUIRE(container.GetObjectPosition("Object1") == 0);
+    REQUIRE(container.GetObjectPosition("Object3") == 2);
+    REQUIRE(container.HasObjectNamed("Object4") == false);
+
+    // Insertion in the middle.
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object4", 1);
+    REQUIRE(container.GetObjectPosition("Object4") == 1);
+    REQUIRE(container.GetObjectPosition("Object2") == 2);
+    REQUIRE(container.GetObject("Object3").GetName() == "Object3");
+
+    // Renaming an object directly.
+    container.GetObject("Object2").SetName("Renamed");
+    REQUIRE(container.HasObjectNamed("Object2") == false);
+    REQUIRE(container.GetObjectPosition("Renamed") == 2);
+
+    // Moves and swaps.
+    container.MoveObject(0, 3);
+    REQUIRE(container.GetObjectPosition("Object1") == 3);
+    REQUIRE(container.GetObjectPosition("Object4") == 0);
+    container.SwapObjects(0, 3);
+    REQUIRE(container.GetObjectPosition("Object1") == 0);
+    REQUIRE(container.GetObjectPosition("Object4") == 3);
+
+    // Removal.
+    container.RemoveObject("Renamed");
+    REQUIRE(container.HasObjectNamed("Renamed") == false);
+    REQUIRE(container.GetObjectPosition("Object3") == 1);
+    REQUIRE(container.GetObjectPosition("Object4") == 2);
+
+    // Objects moved to another container.
+    gd::ObjectsContainer otherContainer;
+    otherContainer.InsertNewObject(project, "MyExtension::Sprite", "Other", 0);
+    container.MoveObjectToAnotherContainer("Object1", otherContainer, 0);
+    REQUIRE(container.HasObjectNamed("Object1") == false);
+    REQUIRE(container.GetObjectPosition("Object3") == 0);
+    REQUIRE(otherContainer.GetObjectPosition("Object1") == 0);
+    REQUIRE(otherContainer.GetObjectPosition("Other") == 1);
+
+    // Changes made directly to the vector of objects.
+    container.GetObjects().clear();
+    REQUIRE(container.HasObjectNamed("Object3") == false);
+  }
+
+  SECTION("ObjectsContainer with objects having the same name") {
+    gd::ObjectsContainer container;
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object", 0);
+    container.InsertNewObject(project, "MyExtension::Sprite", "Other", 1);
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object", 2);
+    REQUIRE(container.GetObjectPosition("Object") == 0);
+
+    container.RemoveObject("Object");
+    REQUIRE(container.GetObjectPosition("Object") == 1);
+    container.InsertNewObject(project, "MyExtension::Sprite", "Object", 0);
+    REQUIRE(container.GetObjectPosition("Object") == 0);
+  }
+
+  SECTION("Layouts") {
+    project.InsertNewLayout("Layout1", 0);
+    project.InsertNewLayout("Layout2", 1);
+    project.InsertNewLayout("Layout3", 0);
+    REQUIRE(project.GetLayoutPosition("Layout3") == 0);
+    REQUIRE(project.GetLayoutPosition("Layout2") == 2);
+
+    project.GetLayout("Layout1").SetName("Renamed");
+    REQUIRE(project.HasLayoutNamed("Layout1") == false);
+    REQUIRE(project.GetLayout("Renamed").GetName() == "Renamed");
+
+    project.SwapLayouts(0, 2);
+    REQUIRE(project.GetLayoutPosition("Layout2") == 0);
+    REQUIRE(project.GetLayoutPosition("Layout3") == 2);
+
+    project.RemoveLayout("Renamed");
+    REQUIRE(project.HasLayoutNamed("Renamed") == false);
+    REQUIRE(project.GetLayoutPosition("Layout3") == 1);
+
+    gd::Project copy = project;
+    REQUIRE(copy.GetLayoutPosition("Layout3") == 1);
+    REQUIRE(&copy.GetLayout("Layout3") != &project.GetLayout("Layout3"));
+  }
+
+  SECTION("Resources") {
+    gd::ResourcesManager &resourcesManager = project.GetResourcesManager();
+    resourcesManager.AddResource("Resource1", "file1.png", "image");
+    resourcesManager.AddResource("Resource2", "file2.png", "image");
+    resourcesManager.AddResource("Resource3", "file3.png", "image");
+    REQUIRE(resourcesManager.AddResource("Resource2", "other.png", "image") ==
+            false);
+    REQUIRE(resourcesManager.GetResource("Resource2").GetFile() ==
+            "file2.png");
+
+    resourcesManager.RenameResource("Resource2", "Renamed");
+    REQUIRE(resourcesManager.HasResource("Resource2") == false);
+    REQUIRE(resourcesManager.GetResource("Renamed").GetFile() == "file2.png");
+
+    resourcesManager.MoveResourceUpInList("Resource3");
+    REQUIRE(resourcesManager.GetResourcePosition("Resource3") == 1);
+    resourcesManager.MoveResource(2, 0);
+    REQUIRE(resourcesManager.GetResourcePosition("Renamed") == 0);
+    REQUIRE(resourcesManager.GetResourcePosition("Resource1") == 1);
+
+    resourcesManager.RemoveResource("Resource1");
+    REQUIRE(resourcesManager.HasResource("Resource1") == false);
+    REQUIRE(resourcesManager.GetResourcePosition("Resource3") == 1);
+  }
+}
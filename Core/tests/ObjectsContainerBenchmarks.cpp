@@ -0,0 +1,137 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/ResourcesManager.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * Find the object of each instance, first in the layout then in the global
+ * objects, like the objects are created when a scene is loaded.
+ */
+class InstanceObjectFinder : public gd::InitialInstanceFunctor {
+ public:
+  InstanceObjectFinder(gd::Project &project_, gd::Layout &layout_)
+      : project(project_), layout(layout_), found(0){};
+  virtual ~InstanceObjectFinder(){};
+
+  virtual void operator()(gd::InitialInstance &instance) {
+    const gd::String &name = instance.GetObjectName();
+    if (layout.HasObjectNamed(name) &&
+        layout.GetObject(name).GetName() == name)
+      ++found;
+    else if (project.HasObjectNamed(name) &&
+             project.GetObject(name).GetName() == name)
+      ++found;
+  }
+
+  gd::Project &project;
+  gd::Layout &layout;
+  std::size_t found;
+};
+}  // namespace
+
+TEST_CASE("ObjectsContainer - Benchmarks", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  auto doBenchmark = [](const gd::String &benchmarkName,
+                        std::function<void()> func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << benchmarkName << " benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  // A scene with 2000 objects (half of them being global objects) and 50000
+  // instances.
+  const std::size_t objectsCount = 2000;
+  const std::size_t instancesCount = 50000;
+  auto getObjectName = [](std::size_t i) {
+    return (i % 2 ? "GlobalObject" : "Object") + gd::String::From(i);
+  };
+
+  gd::Layout &layout = project.InsertNewLayout("Scene", 0);
+  doBenchmark("Insert objects with unique names", [&]() {
+    for (std::size_t i = 0; i < objectsCount; ++i) {
+      gd::ObjectsContainer &container =
+          i % 2 ? static_cast<gd::ObjectsContainer &>(project) : layout;
+      gd::String name = getObjectName(i);
+      REQUIRE(!container.HasObjectNamed(name));
+      container.InsertNewObject(
+          project, "MyExtension::Sprite", name, container.GetObjectsCount());
+    }
+  });
+  for (std::size_t i = 0; i < instancesCount; ++i) {
+    gd::InitialInstance &instance =
+        layout.GetInitialInstances().InsertNewInitialInstance();
+    instance.SetObjectName(getObjectName((i * 7919) % objectsCount));
+  }
+
+  gd::SerializerElement layoutElement;
+  layout.SerializeTo(layoutElement);
+
+  doBenchmark("Load a scene with 2000 objects and 50000 instances", [&]() {
+    gd::Layout &loadedLayout = project.InsertNewLayout("Loaded scene", 1);
+    loadedLayout.UnserializeFrom(project, layoutElement);
+
+    InstanceObjectFinder finder(project, loadedLayout);
+    loadedLayout.GetInitialInstances().IterateOverInstances(finder);
+    REQUIRE(finder.found == instancesCount);
+  });
+
+  doBenchmark("Find the objects of 50000 instances", [&]() {
+    InstanceObjectFinder finder(project, layout);
+    layout.GetInitialInstances().IterateOverInstances(finder);
+    REQUIRE(finder.found == instancesCount);
+  });
+
+  for (std::size_t i = 0; i < 200; ++i)
+    project.InsertNewLayout("Layout" + gd::String::From(i),
+                            project.GetLayoutsCount());
+  doBenchmark("Project::GetLayout (100000 lookups)", [&]() {
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < 100000; ++i) {
+      gd::String name = "Layout" + gd::String::From(i % 200);
+      if (project.HasLayoutNamed(name) &&
+          project.GetLayout(name).GetName() == name)
+        ++found;
+    }
+    REQUIRE(found == 100000);
+  });
+
+  gd::ResourcesManager &resourcesManager = project.GetResourcesManager();
+  doBenchmark("ResourcesManager::AddResource (5000 resources)", [&]() {
+    for (std::size_t i = 0; i < 5000; ++i) {
+      gd::String name = "Resource" + gd::String::From(i);
+      REQUIRE(resourcesManager.AddResource(name, name + ".png", "image"));
+    }
+  });
+  doBenchmark("ResourcesManager::GetResource (100000 lookups)", [&]() {
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < 100000; ++i) {
+      gd::String name = "Resource" + gd::String::From((i * 7919) % 5000);
+      if (resourcesManager.GetResource(name).GetName() == name) ++found;
+    }
+    REQUIRE(found == 100000);
+  });
+}
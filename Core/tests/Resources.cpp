@@ -6,13 +6,23 @@
 /**
  * @file Tests covering common features of GDevelop Core.
  */
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
+#include <vector>
+#include "DummyPlatform.h"
 #include "GDCore/CommonTools.h"
+#include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/IDE/AbstractFileSystem.h"
 #include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
 #include "GDCore/IDE/Project/ProjectResourcesAdder.h"
+#include "GDCore/IDE/Project/ProjectResourcesCopier.h"
+#include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Tools/FileStream.h"
 #include "GDCore/Tools/SystemStats.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
@@ -28,6 +38,69 @@ class ArbitraryResourceWorkerTest : public gd::ArbitraryResourceWorker {
   std::vector<gd::String> images;
 };
 
+/**
+ * A file system only able to find files and make filenames absolute, for
+ * files in the working directory or in the temporary directory of the system.
+ */
+class WorkingDirectoryFileSystem : public gd::AbstractFileSystem {
+ public:
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) {
+    gd::FileStream file(path, std::ios_base::in);
+    return file.is_open();
+  };
+  virtual gd::String FileNameFrom(const gd::String& file) { return file; };
+  virtual gd::String DirNameFrom(const gd::String& file) { return "."; };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    filename = baseDirectory + "/" + filename;
+    return true;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) { return false; }
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    return false;
+  }
+  virtual bool ClearDir(const gd::String& directory) { return false; }
+  virtual bool WriteToFile(const gd::String& file, const gd::String& content) {
+    return false;
+  }
+  virtual gd::String ReadFile(const gd::String& file) { return ""; }
+  virtual gd::String GetTempDir() {
+    for (const char* variable : {"TMPDIR", "TEMP", "TMP"}) {
+      if (const char* directory = std::getenv(variable)) return directory;
+    }
+    return "/tmp";
+  }
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  }
+};
+
+/**
+ * Remove files created by a test when destroyed, so that they are removed even
+ * if the test fails.
+ */
+class TemporaryFiles {
+ public:
+  ~TemporaryFiles() {
+    for (const gd::String& file : files) std::remove(file.ToLocale().c_str());
+  }
+
+  const gd::String& Add(const gd::String& file) {
+    files.push_back(file);
+    return file;
+  }
+
+ private:
+  std::vector<gd::String> files;
+};
+
 TEST_CASE("Resources", "[common][resources]") {
   SECTION("Basics") {
     gd::ImageResource image;
@@ -46,6 +119,31 @@ TEST_CASE("Resources", "[common][resources]") {
     image.SetFile("Lots\\\\Of\\\\\\..\\Backslashs");
     REQUIRE(image.GetFile() == "Lots//Of///../Backslashs");
   }
+  SECTION("Texture atlas") {
+    gd::ImageResource image;
+    image.SetFile("MyResourceFile");
+    REQUIRE(image.IsInAtlas() == false);
+
+    image.SetAtlas("MyAtlas.png", 10, 20, 30, 40);
+    gd::SerializerElement element;
+    image.SerializeTo(element);
+
+    gd::ImageResource unserializedImage;
+    unserializedImage.UnserializeFrom(element);
+    REQUIRE(unserializedImage.IsInAtlas() == true);
+    REQUIRE(unserializedImage.GetFile() == "MyResourceFile");
+    REQUIRE(unserializedImage.GetAtlasFile() == "MyAtlas.png");
+    REQUIRE(unserializedImage.GetAtlasX() == 10);
+    REQUIRE(unserializedImage.GetAtlasY() == 20);
+    REQUIRE(unserializedImage.GetAtlasWidth() == 30);
+    REQUIRE(unserializedImage.GetAtlasHeight() == 40);
+
+    image.RemoveFromAtlas();
+    gd::SerializerElement otherElement;
+    image.SerializeTo(otherElement);
+    unserializedImage.UnserializeFrom(otherElement);
+    REQUIRE(unserializedImage.IsInAtlas() == false);
+  }
   SECTION("ArbitraryResourceWorker") {
     gd::Project project;
     project.GetResourcesManager().AddResource(
@@ -101,3 +199,84 @@ TEST_CASE("Resources", "[common][resources]") {
     }
   }
 }
+
+TEST_CASE("PackImagesInAtlases", "[common][resources]") {
+  WorkingDirectoryFileSystem fs;
+  const gd::String directory = fs.GetTempDir();
+  TemporaryFiles temporaryFiles;
+  sf::Image image;
+  image.create(16, 16, sf::Color(255, 0, 0));
+  image.saveToFile(
+      temporaryFiles.Add(directory + "/PackImagesInAtlasesTest1.png")
+          .ToLocale());
+  image.create(8, 4, sf::Color(0, 255, 0));
+  image.saveToFile(
+      temporaryFiles.Add(directory + "/PackImagesInAtlasesTest2.png")
+          .ToLocale());
+
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+  gd::ResourcesManager& resourcesManager = project.GetResourcesManager();
+  resourcesManager.AddResource("res1", "PackImagesInAtlasesTest1.png", "image");
+  resourcesManager.AddResource("res2", "PackImagesInAtlasesTest2.png", "image");
+  resourcesManager.AddResource("res3", "PackImagesInAtlasesTest1.png", "image");
+  resourcesManager.AddResource("res4", "PackImagesInAtlasesTest2.png", "image");
+  resourcesManager.AddResource("res5", "PackImagesInAtlasesTest2.png", "image");
+  dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("res4"))
+      .SetSmooth(false);
+
+  // res1 and res4 are used by a global sprite object, res2 by a sprite object
+  // of a layout. res5 is not used.
+  gd::SpriteObject globalObject("GlobalObject");
+  gd::Animation animation;
+  animation.SetDirectionsCount(1);
+  gd::Sprite sprite;
+  sprite.SetImageName("res1");
+  animation.GetDirection(0).AddSprite(sprite);
+  sprite.SetImageName("res4");
+  animation.GetDirection(0).AddSprite(sprite);
+  globalObject.AddAnimation(animation);
+  project.InsertObject(globalObject, 0);
+
+  gd::SpriteObject layoutObject("LayoutObject");
+  gd::Animation otherAnimation;
+  otherAnimation.SetDirectionsCount(1);
+  sprite.SetImageName("res2");
+  otherAnimation.GetDirection(0).AddSprite(sprite);
+  layoutObject.AddAnimation(otherAnimation);
+  project.InsertNewLayout("Scene", 0).InsertObject(layoutObject, 0);
+
+  bool packed =
+      gd::ProjectResourcesCopier::PackImagesInAtlases(project, fs, directory);
+
+  const gd::ImageResource& image1 =
+      dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("res1"));
+  const gd::ImageResource& image2 =
+      dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("res2"));
+  const gd::ImageResource& image3 =
+      dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("res3"));
+  const gd::ImageResource& image4 =
+      dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("res4"));
+  for (const gd::ImageResource* packedImage : {&image1, &image4}) {
+    if (packedImage->IsInAtlas())
+      temporaryFiles.Add(directory + "/" + packedImage->GetAtlasFile());
+  }
+
+  REQUIRE(packed == true);
+  REQUIRE(image1.IsInAtlas() == true);
+  REQUIRE(image1.GetFile() == "PackImagesInAtlasesTest1.png");
+  REQUIRE(image1.GetAtlasWidth() == 16);
+  REQUIRE(image1.GetAtlasHeight() == 16);
+  REQUIRE(image2.IsInAtlas() == true);
+  REQUIRE(image2.GetAtlasFile() == image1.GetAtlasFile());
+  REQUIRE(image2.GetAtlasWidth() == 8);
+  REQUIRE(image2.GetAtlasHeight() == 4);
+  REQUIRE(image3.IsInAtlas() == false);
+
+  // Not smoothed images are in another atlas.
+  REQUIRE(image4.IsInAtlas() == true);
+  REQUIRE(image4.GetAtlasFile() != image1.GetAtlasFile());
+  REQUIRE(fs.FileExists(directory + "/" + image1.GetAtlasFile()) == true);
+  REQUIRE(fs.FileExists(directory + "/" + image4.GetAtlasFile()) == true);
+}
@@ -7,14 +7,19 @@
  * @file Tests covering serialization to JSON.
  */
 #include "GDCore/Serialization/Serializer.h"
+#include <sstream>
+#include <utility>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Events/Serialization.h"
+#include "GDCore/Extensions/Platform.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/Variable.h"
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/JSONWriter.h"
 #include "GDCore/Tools/SystemStats.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
@@ -99,6 +104,245 @@ TEST_CASE("SerializerElement", "[common]") {
     REQUIRE(element.GetStringAttribute("attr1") == "attr123");
     REQUIRE(element.GetStringAttribute("child1") == "value456");
   }
+
+  SECTION("Elements with a lot of children") {
+    SerializerElement element;
+    for (std::size_t i = 0; i < 100; ++i)
+      element.AddChild("child" + gd::String::From(i)).SetIntValue(i);
+
+    REQUIRE(element.GetAllChildren().size() == 100);
+    REQUIRE(element.HasChild("child42"));
+    REQUIRE(!element.HasChild("child100"));
+    REQUIRE(element.HasChild("child100", "child99"));
+    REQUIRE(element.GetChild("child42").GetIntValue() == 42);
+    REQUIRE(element.GetChild("child100", 0, "child99").GetIntValue() == 99);
+
+    // Existing children are returned, and children added later are found.
+    element.AddChild("child42").SetIntValue(-42);
+    element.AddChild("child100").SetIntValue(100);
+    REQUIRE(element.GetAllChildren().size() == 101);
+    REQUIRE(element.GetChild("child42").GetIntValue() == -42);
+    REQUIRE(element.GetChild("child100").GetIntValue() == 100);
+
+    // Removing children moves the next ones.
+    element.RemoveChild("child0");
+    element.SetStringAttribute("child1", "attribute");
+    REQUIRE(!element.HasChild("child0"));
+    REQUIRE(!element.HasChild("child1"));
+    REQUIRE(element.GetChild("child2").GetIntValue() == 2);
+    REQUIRE(element.GetChild("child100").GetIntValue() == 100);
+    REQUIRE(element.GetAllChildren()[0].first == "child2");
+
+    SerializerElement copiedElement = element;
+    REQUIRE(copiedElement.GetChild("child50").GetIntValue() == 50);
+    copiedElement.GetChild("child50").SetIntValue(-50);
+    REQUIRE(element.GetChild("child50").GetIntValue() == 50);
+  }
+
+  SECTION("Arrays with a lot of children") {
+    SerializerElement element;
+    element.ConsiderAsArrayOf("namedElement", "deprecatedElement");
+    for (std::size_t i = 0; i < 100; ++i)
+      element.AddChild("namedElement").SetIntValue(i);
+
+    REQUIRE(element.GetChildrenCount() == 100);
+    REQUIRE(element.GetChild(0).GetIntValue() == 0);
+    REQUIRE(element.GetChild(99).GetIntValue() == 99);
+    REQUIRE(element.GetChild("namedElement", 42).GetIntValue() == 42);
+    REQUIRE(&element.GetChild(100) == &SerializerElement::nullElement);
+
+    // Unnamed elements (like the ones read from JSON) are part of the array.
+    SerializerElement unnamedElements = Serializer::FromJSON(
+        Serializer::ToJSON(element));
+    unnamedElements.ConsiderAsArrayOf("namedElement");
+    REQUIRE(unnamedElements.GetChildrenCount() == 100);
+    REQUIRE(unnamedElements.GetChild(42).GetIntValue() == 42);
+    REQUIRE(unnamedElements.GetChild("namedElement", 99).GetIntValue() == 99);
+
+    // Named and unnamed elements are kept in order.
+    unnamedElements.AddChild("namedElement").SetIntValue(100);
+    REQUIRE(unnamedElements.GetChildrenCount() == 101);
+    REQUIRE(unnamedElements.GetChild(99).GetIntValue() == 99);
+    REQUIRE(unnamedElements.GetChild(100).GetIntValue() == 100);
+  }
+
+  SECTION("Elements allocated in an arena") {
+    SerializerElement element;
+    element.AllocateChildrenInArena();
+    for (std::size_t i = 0; i < 100; ++i) {
+      SerializerElement &child =
+          element.AddChild("child" + gd::String::From(i));
+      child.SetAttribute("z", static_cast<int>(i));
+      child.SetAttribute("a", "value" + gd::String::From(i));
+      child.AddChild("grandChild").SetIntValue(i);
+    }
+    REQUIRE(element.GetChild("child42").GetIntAttribute("z") == 42);
+    REQUIRE(element.GetChild("child42").GetStringAttribute("a") == "value42");
+    REQUIRE(element.GetChild("child42").GetChild("grandChild").GetIntValue() ==
+            42);
+
+    // Attributes are sorted by name.
+    REQUIRE(element.GetChild("child0").GetAllAttributes().size() == 2);
+    REQUIRE(element.GetChild("child0").GetAllAttributes()[0].first == "a");
+    REQUIRE(element.GetChild("child0").GetAllAttributes()[1].first == "z");
+
+    element.RemoveChild("child0");
+    REQUIRE(!element.HasChild("child0"));
+    REQUIRE(element.GetAllChildren().size() == 99);
+
+    // Copies (from or to elements in the arena) are independent.
+    SerializerElement copiedElement = element;
+    copiedElement.GetChild("child50").SetIntAttribute("z", -50);
+    REQUIRE(element.GetChild("child50").GetIntAttribute("z") == 50);
+
+    SerializerElement copiedChild = element.GetChild("child50");
+    copiedChild.GetChild("grandChild").SetIntValue(-50);
+    REQUIRE(element.GetChild("child50").GetChild("grandChild").GetIntValue() ==
+            50);
+
+    element.GetChild("child60") = copiedChild;
+    REQUIRE(element.GetChild("child60").GetChild("grandChild").GetIntValue() ==
+            -50);
+
+    // Moving an element allocated in an arena copies it.
+    SerializerElement movedChild = std::move(element.GetChild("child70"));
+    REQUIRE(movedChild.GetChild("grandChild").GetIntValue() == 70);
+    REQUIRE(element.GetChild("child70").GetChild("grandChild").GetIntValue() ==
+            70);
+
+    // The element owning the arena can be moved or assigned.
+    SerializerElement movedElement = std::move(element);
+    REQUIRE(movedElement.GetAllChildren().size() == 99);
+    REQUIRE(movedElement.GetChild("child99").GetIntAttribute("z") == 99);
+
+    movedElement = copiedChild;
+    REQUIRE(movedElement.GetAllChildren().size() == 1);
+    REQUIRE(movedElement.GetChild("grandChild").GetIntValue() == -50);
+  }
+}
+
+namespace {
+/**
+ * Record the events sent by gd::JSONReader as a string.
+ */
+class JSONEventsRecorder : public gd::JSONReader::Handler {
+ public:
+  void OnStartObject() override { events += "{"; }
+  void OnKey(const char* key, std::size_t length) override {
+    events += "k(" + std::string(key, length) + ")";
+  }
+  void OnEndObject() override { events += "}"; }
+  void OnStartArray() override { events += "["; }
+  void OnEndArray() override { events += "]"; }
+  void OnString(const char* str, std::size_t length) override {
+    events += "s(" + std::string(str, length) + ")";
+  }
+  void OnNumber(double number) override {
+    events += "n(" + gd::String::From(number).Raw() + ")";
+  }
+  void OnBool(bool value) override { events += value ? "true" : "false"; }
+  void OnNull() override { events += "null"; }
+
+  std::string events;
+};
+}  // namespace
+
+TEST_CASE("JSONReader", "[common]") {
+  gd::JSONReader reader;
+  JSONEventsRecorder recorder;
+  auto parse = [&](const std::string& json) {
+    recorder.events.clear();
+    return reader.Parse(json.data(), json.size(), recorder);
+  };
+
+  SECTION("Events") {
+    REQUIRE(parse(" { \"a\" : [1, -2.5e1, \"x\", true, false, null, {}], "
+                  "\"b\":{\"c\":[]} } "));
+    REQUIRE(recorder.events ==
+            "{k(a)[n(1)n(-25)s(x)truefalsenull{}]k(b){k(c)[]}}");
+
+    // Trailing commas are accepted, as they were by the previous parser.
+    REQUIRE(parse("[1,2,]"));
+    REQUIRE(recorder.events == "[n(1)n(2)]");
+    REQUIRE(parse("{\"a\": 1,}"));
+    REQUIRE(recorder.events == "{k(a)n(1)}");
+  }
+
+  SECTION("Escaped and unicode characters") {
+    REQUIRE(parse("\"\\\"\\\\\\/\\n\\t\""));
+    REQUIRE(recorder.events == "s(\"\\/\n\t)");
+    REQUIRE(parse("\"\\u00e9\\u5b98\\ud83d\\ude00\""));
+    REQUIRE(recorder.events == u8"s(é官😀)");
+    REQUIRE(parse("\"a\\ud83dz\""));
+    REQUIRE(recorder.events == u8"s(a\uFFFDz)");
+    REQUIRE(parse(u8"\"Hello 官话 world\""));
+    REQUIRE(recorder.events == u8"s(Hello 官话 world)");
+  }
+
+  SECTION("Numbers") {
+    double numbers[] = {0, -0.0, 1, 0.1, 123.456, 1e-5, 1e22, 1e23,
+                        3.141592653589793, 2.2250738585072014e-308};
+    for (double number : numbers) {
+      std::ostringstream json;
+      json.precision(17);
+      json << number;
+
+      gd::SerializerElement element = gd::Serializer::FromJSON(json.str());
+      REQUIRE(element.GetValue().GetDouble() == number);
+    }
+  }
+
+  SECTION("Invalid JSON") {
+    REQUIRE(!parse(""));
+    REQUIRE(!parse("{\"a\" 1}"));
+    REQUIRE(reader.GetErrorPosition() == 5);
+    REQUIRE(!parse("[1 2]"));
+    REQUIRE(reader.GetErrorPosition() == 3);
+    REQUIRE(!parse("{\"a\": \"unterminated"));
+    REQUIRE(!parse("[1,"));
+    REQUIRE(!parse("\"\\u12\""));
+    REQUIRE(!reader.GetError().empty());
+  }
+}
+
+TEST_CASE("JSONWriter", "[common]") {
+  SECTION("Values and separators") {
+    gd::JSONWriter writer;
+    writer.StartObject();
+    writer.Key("a");
+    writer.StartArray();
+    writer.Int(-12);
+    writer.Double(0.5);
+    writer.Double(1e21);
+    writer.Double(-0.0);
+    writer.Bool(true);
+    writer.Null();
+    writer.StartObject();
+    writer.EndObject();
+    writer.EndArray();
+    writer.Key("b\n");
+    writer.String(std::string("\"\x01\x1f", 3));
+    writer.EndObject();
+    REQUIRE(writer.GetBuffer() ==
+            "{\"a\": [-12,0.5,1e+21,-0,true,null,{}],\"b\\n\": "
+            "\"\\\"\\u0001\\u001F\"}");
+  }
+
+  SECTION("Writing to a stream") {
+    SerializerElement element;
+    SerializerElement& array = element.AddChild("array");
+    array.ConsiderAsArray();
+    for (std::size_t i = 0; i < 20000; ++i) {
+      SerializerElement& child = array.AddChild("");
+      child.AddChild("name").SetStringValue("Child " + gd::String::From(i));
+      child.AddChild("x").SetDoubleValue(i * 1.5);
+    }
+
+    // The stream receives exactly the same JSON as the one built in memory.
+    std::ostringstream stream;
+    Serializer::ToJSON(element, stream);
+    REQUIRE(stream.str() == Serializer::ToJSON(element).Raw());
+  }
 }
 
 TEST_CASE("Serializer", "[common]") {
@@ -182,6 +426,34 @@ TEST_CASE("Serializer", "[common]") {
     }
   }
 
+  SECTION("Unicode escapes and invalid JSON") {
+    gd::String originalJSON = "{\"a\\u00e9\": \"\\u5b98\\u8bdd\"}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+    REQUIRE(element.GetChild(u8"aé").GetStringValue() == u8"官话");
+
+    // The values read before an error are kept.
+    gd::String invalidJSON = "{\"a\": 1, \"b\": [2, \"c\": 3}";
+    SerializerElement invalidElement = Serializer::FromJSON(invalidJSON);
+    REQUIRE(invalidElement.GetChild("a").GetIntValue() == 1);
+    REQUIRE(invalidElement.GetChild("b").GetChild(0).GetIntValue() == 2);
+  }
+
+  SECTION("Errors reported when reading JSON") {
+    gd::String error = "Previous error";
+    std::string json = "{\"a\": 1, \"b\": [1,2]}";
+    Serializer::FromJSON(json.data(), json.size(), error);
+    REQUIRE(error.empty());
+
+    std::string truncatedJSON = "{\"a\": 1, \"b\": [1,2";
+    SerializerElement truncatedElement =
+        Serializer::FromJSON(truncatedJSON.data(), truncatedJSON.size(), error);
+    REQUIRE(!error.empty());
+    REQUIRE(truncatedElement.GetChild("a").GetIntValue() == 1);
+
+    Serializer::FromJSON("{\"a\": }", 7, error);
+    REQUIRE(!error.empty());
+  }
+
   SECTION("(Deprecated) attributes") {
     gd::String originalJSON = "{\"ok\": true,\"hello\": \"world\"}";
     SerializerElement element = Serializer::FromJSON(originalJSON);
@@ -203,4 +475,107 @@ TEST_CASE("Serializer", "[common]") {
     gd::String json = Serializer::ToJSON(element);
     REQUIRE(json == "{\"hello\": \"world1\",\"ok\": true,\"hello2\": \"world2\"}");
   }
+  SECTION("Binary format") {
+    SerializerElement element;
+    element.SetAttribute("bool", true);
+    element.SetAttribute("int", -42);
+    element.SetAttribute("double", 0.1);
+    element.SetAttribute("string", u8"Hello été 官话");
+    element.AddChild("unknown").SetValue(SerializerValue());
+    SerializerValue untypedValue;
+    untypedValue.Set("123");
+    element.AddChild("untyped").SetValue(untypedValue);
+    element.AddChild("bigInt").SetIntValue(-2147483647 - 1);
+    element.AddChild("hugeDouble").SetDoubleValue(-1.5e300);
+    element.AddChild("false").SetBoolValue(false);
+    element.AddChild("empty");
+
+    SerializerElement& array = element.AddChild("array");
+    array.ConsiderAsArrayOf("item");
+    for (std::size_t i = 0; i < 20; ++i)
+      array.AddChild("item").SetAttribute("index", static_cast<int>(i));
+    array.ConsiderAsArrayOf("renamedItem");
+    array.AddChild("renamedItem").SetStringValue("last");
+
+    std::string binary = Serializer::ToBinary(element);
+    REQUIRE(Serializer::IsBinary(binary.data(), binary.size()));
+    REQUIRE(!Serializer::IsBinary("{}", 2));
+
+    // The element read back is the same, including the types of the values.
+    SerializerElement readElement = Serializer::FromBinary(binary);
+    REQUIRE(Serializer::ToBinary(readElement) == binary);
+    REQUIRE(readElement.GetBoolAttribute("bool") == true);
+    REQUIRE(readElement.GetIntAttribute("int") == -42);
+    REQUIRE(readElement.GetDoubleAttribute("double") == 0.1);
+    REQUIRE(readElement.GetStringAttribute("string") == u8"Hello été 官话");
+    REQUIRE(readElement.GetChild("untyped").GetValue().IsString() == false);
+    REQUIRE(readElement.GetChild("untyped").GetValue().IsInt() == false);
+    REQUIRE(readElement.GetChild("untyped").GetIntValue() == 123);
+    REQUIRE(readElement.GetChild("bigInt").GetValue().IsInt());
+    REQUIRE(readElement.GetChild("bigInt").GetIntValue() == -2147483647 - 1);
+    REQUIRE(readElement.GetChild("hugeDouble").GetDoubleValue() == -1.5e300);
+    REQUIRE(readElement.GetChild("false").GetValue().IsBoolean());
+    REQUIRE(readElement.GetChild("empty").IsValueUndefined());
+
+    SerializerElement& readArray = readElement.GetChild("array");
+    REQUIRE(readArray.ConsideredAsArrayOf() == "renamedItem");
+    REQUIRE(readArray.GetAllChildren().size() == 21);
+    REQUIRE(readArray.GetAllChildren()[15].first == "item");
+    REQUIRE(readArray.GetAllChildren()[15].second->GetIntAttribute("index") ==
+            15);
+    REQUIRE(readArray.GetChild(0).GetStringValue() == "last");
+
+    // Streams receive the same data.
+    std::ostringstream stream;
+    Serializer::ToBinary(element, stream);
+    REQUIRE(stream.str() == binary);
+
+    // Invalid or truncated data is reported, and what was read is kept.
+    SerializerElement truncatedElement =
+        Serializer::FromBinary(binary.data(), binary.size() - 10);
+    REQUIRE(truncatedElement.GetIntAttribute("int") == -42);
+    REQUIRE(Serializer::ToJSON(Serializer::FromBinary("GDBN", 4)) == "{}");
+    REQUIRE(Serializer::ToJSON(Serializer::FromBinary("{}", 2)) == "{}");
+    std::string invalidBinary = binary;
+    for (std::size_t i = 5; i < invalidBinary.size(); i += 7)
+      invalidBinary[i] = static_cast<char>(0xFF);
+    Serializer::FromBinary(invalidBinary);
+
+    // Errors are given to the caller asking for them.
+    gd::String error = "Previous error";
+    Serializer::FromBinary(binary.data(), binary.size(), error);
+    REQUIRE(error.empty());
+    for (std::size_t length = 0; length < binary.size(); ++length) {
+      Serializer::FromBinary(binary.data(), length, error);
+      REQUIRE(!error.empty());
+    }
+    std::string unsupportedVersion = binary;
+    unsupportedVersion[4] = static_cast<char>(0xFF);
+    Serializer::FromBinary(
+        unsupportedVersion.data(), unsupportedVersion.size(), error);
+    REQUIRE(!error.empty());
+  }
+
+  SECTION("Binary format, with a project") {
+    gd::Platform platform;
+    gd::Project project;
+    project.AddPlatform(platform);
+    project.SetName(u8"Project with été");
+    gd::Layout& layout = project.InsertNewLayout("Scene", 0);
+    layout.GetVariables().InsertNew("Variable", 0).SetValue(42.5);
+    layout.GetInitialInstances().InsertNewInitialInstance().SetX(-12);
+
+    SerializerElement element;
+    project.SerializeTo(element);
+    SerializerElement readElement =
+        Serializer::FromBinary(Serializer::ToBinary(element));
+    REQUIRE(Serializer::ToJSON(readElement) == Serializer::ToJSON(element));
+
+    gd::Project readProject;
+    readProject.AddPlatform(platform);
+    readProject.UnserializeFrom(readElement);
+    REQUIRE(readProject.GetName() == u8"Project with été");
+    REQUIRE(readProject.GetLayout("Scene").GetVariables().Get("Variable")
+                .GetValue() == 42.5);
+  }
 }
@@ -0,0 +1,474 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/String.h"
+#include "GDCore/TinyXml/tinyxml.h"
+#include "catch.hpp"
+
+// Track the memory allocated, to report the peak memory used by each
+// benchmark. The size of each allocation is stored just before it.
+namespace {
+const std::size_t headerSize = 16;
+std::size_t allocatedBytes = 0;
+std::size_t peakAllocatedBytes = 0;
+}  // namespace
+
+void *operator new(std::size_t size) {
+  char *ptr = static_cast<char *>(std::malloc(size + headerSize));
+  if (!ptr) throw std::bad_alloc();
+
+  *reinterpret_cast<std::size_t *>(ptr) = size;
+  allocatedBytes += size;
+  if (allocatedBytes > peakAllocatedBytes) peakAllocatedBytes = allocatedBytes;
+  return ptr + headerSize;
+}
+
+void operator delete(void *ptr) noexcept {
+  if (!ptr) return;
+
+  char *header = static_cast<char *>(ptr) - headerSize;
+  allocatedBytes -= *reinterpret_cast<std::size_t *>(header);
+  std::free(header);
+}
+
+// The implementation of gd::Serializer::ToJSON and FromJSON before they used
+// gd::JSONWriter and gd::JSONReader, adapted to the current
+// gd::SerializerElement, to compare both implementations in the benchmarks.
+namespace previous {
+namespace {
+inline bool isControlCharacter(char ch) { return ch > 0 && ch <= 0x1F; }
+
+bool containsControlCharacter(const char *str) {
+  while (*str) {
+    if (isControlCharacter(*(str++))) return true;
+  }
+  return false;
+}
+
+gd::String StringToQuotedJSONString(const char *value) {
+  if (value == NULL) return "";
+  if (strpbrk(value, "\"\\\b\f\n\r\t") == NULL &&
+      !containsControlCharacter(value))
+    return gd::String("\"") + value + "\"";
+
+  std::string::size_type maxsize = strlen(value) * 2 + 3;
+  std::string result;
+  result.reserve(maxsize);
+  result += "\"";
+  for (const char *c = value; *c != 0; ++c) {
+    switch (*c) {
+      case '\"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\b':
+        result += "\\b";
+        break;
+      case '\f':
+        result += "\\f";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (isControlCharacter(*c)) {
+          std::ostringstream oss;
+          oss << "\\u" << std::hex << std::uppercase << std::setfill('0')
+              << std::setw(4) << static_cast<int>(*c);
+          result += oss.str();
+        } else {
+          result += *c;
+        }
+        break;
+    }
+  }
+  result += "\"";
+  return gd::String::FromUTF8(result);
+}
+
+gd::String ValueToJSON(const gd::SerializerValue &val) {
+  if (val.IsBoolean())
+    return val.GetBool() ? "true" : "false";
+  else if (val.IsInt())
+    return gd::String::From(val.GetInt());
+  else if (val.IsDouble())
+    return gd::String::From(val.GetDouble());
+  else
+    return StringToQuotedJSONString(val.GetString().c_str());
+}
+
+gd::String ToJSON(const gd::SerializerElement &element) {
+  if (!element.IsValueUndefined()) return ValueToJSON(element.GetValue());
+
+  const auto &children = element.GetAllChildren();
+  if (element.ConsideredAsArray()) {
+    gd::String str = "[";
+    bool firstChild = true;
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (!children[i].second ||
+          children[i].first != element.ConsideredAsArrayOf())
+        continue;
+
+      if (!firstChild) str += ",";
+      str += ToJSON(*children[i].second);
+      firstChild = false;
+    }
+
+    str += "]";
+    return str;
+  }
+
+  gd::String str = "{";
+  bool firstChild = true;
+  for (const auto &attribute : element.GetAllAttributes()) {
+    if (!firstChild) str += ",";
+    str += StringToQuotedJSONString(attribute.first.c_str()) + ": " +
+           ValueToJSON(attribute.second);
+    firstChild = false;
+  }
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (!children[i].second) continue;
+
+    if (!firstChild) str += ",";
+    str += StringToQuotedJSONString(children[i].first.c_str()) + ": " +
+           ToJSON(*children[i].second);
+    firstChild = false;
+  }
+
+  str += "}";
+  return str;
+}
+
+size_t SkipBlankChar(const std::string &str, size_t pos) {
+  const std::string blankChar = " \n";
+  return str.find_first_not_of(blankChar, pos);
+}
+
+std::string DecodeString(const std::string &original) {
+  std::string value;
+  value.reserve(original.size());
+  std::istringstream input("\"" + original + "\"");
+
+  char ch = '\0', delimiter = '"';
+  input.get(ch);
+  if (ch != delimiter) return "";
+
+  while (!input.eof() && input.good()) {
+    input.get(ch);
+    if (ch == delimiter) {
+      break;
+    }
+    if (ch == '\\') {
+      input.get(ch);
+      switch (ch) {
+        case '\\':
+        case '/':
+          value.push_back(ch);
+          break;
+        case 'b':
+          value.push_back('\b');
+          break;
+        case 'f':
+          value.push_back('\f');
+          break;
+        case 'n':
+          value.push_back('\n');
+          break;
+        case 'r':
+          value.push_back('\r');
+          break;
+        case 't':
+          value.push_back('\t');
+          break;
+        case 'u': {
+          int i;
+          std::stringstream ss;
+          for (i = 0; (!input.eof() && input.good()) && i < 4; ++i) {
+            input.get(ch);
+            ss << ch;
+          }
+          if (input.good() && (ss >> i)) value.push_back(i);
+        } break;
+        default:
+          if (ch != delimiter) {
+            value.push_back('\\');
+            value.push_back(ch);
+          } else
+            value.push_back(ch);
+          break;
+      }
+    } else {
+      value.push_back(ch);
+    }
+  }
+  if (input && ch == delimiter) {
+    return value;
+  } else {
+    return "";
+  }
+}
+
+size_t SkipString(const std::string &str,
+                  size_t startPos,
+                  std::string &strContent) {
+  startPos = SkipBlankChar(str, startPos);
+  if (startPos >= str.length()) return std::string::npos;
+
+  size_t endPos = startPos;
+
+  if (str[startPos] == '"') {
+    if (startPos + 1 >= str.length()) return std::string::npos;
+
+    while (endPos == startPos || (str[endPos - 1] == '\\')) {
+      endPos = str.find_first_of('\"', endPos + 1);
+      if (endPos == std::string::npos) return std::string::npos;
+    }
+
+    strContent = DecodeString(str.substr(startPos + 1, endPos - 1 - startPos));
+    return endPos;
+  }
+
+  endPos = str.find_first_of(" \n,:");
+  if (endPos >= str.length()) return std::string::npos;
+
+  strContent = DecodeString(str.substr(startPos, endPos - 1 - startPos));
+  return endPos - 1;
+}
+
+size_t ParseJSONObject(const std::string &jsonStr,
+                       size_t startPos,
+                       gd::SerializerElement &element) {
+  size_t pos = SkipBlankChar(jsonStr, startPos);
+  if (pos >= jsonStr.length()) return std::string::npos;
+
+  if (jsonStr[pos] == '{') {
+    bool firstChild = true;
+    while (firstChild || jsonStr[pos] == ',') {
+      pos++;
+      if (pos < jsonStr.length() && jsonStr[pos] == '}') break;
+
+      std::string childName;
+      pos = SkipString(jsonStr, pos, childName);
+
+      pos++;
+      pos = SkipBlankChar(jsonStr, pos);
+      if (pos >= jsonStr.length() || jsonStr[pos] != ':')
+        return std::string::npos;
+
+      pos++;
+      pos = ParseJSONObject(
+          jsonStr,
+          pos,
+          element.AddChild(gd::String::FromUTF8(childName).ReplaceInvalid()));
+
+      pos = SkipBlankChar(jsonStr, pos);
+      if (pos >= jsonStr.length()) return std::string::npos;
+      firstChild = false;
+    }
+
+    if (jsonStr[pos] != '}') return std::string::npos;
+    return pos + 1;
+  } else if (jsonStr[pos] == '[') {
+    element.ConsiderAsArray();
+    unsigned int index = 0;
+    while (index == 0 || jsonStr[pos] == ',') {
+      pos++;
+      if (pos < jsonStr.length() && jsonStr[pos] == ']') break;
+      pos = ParseJSONObject(jsonStr, pos, element.AddChild(""));
+
+      pos = SkipBlankChar(jsonStr, pos);
+      if (pos >= jsonStr.length()) return std::string::npos;
+      index++;
+    }
+
+    if (jsonStr[pos] != ']') return std::string::npos;
+    return pos + 1;
+  } else if (jsonStr[pos] == '"') {
+    std::string str;
+    pos = SkipString(jsonStr, pos, str);
+    if (pos >= jsonStr.length()) return std::string::npos;
+
+    element.SetValue(gd::String::FromUTF8(str).ReplaceInvalid());
+    return pos + 1;
+  } else {
+    std::string str;
+    size_t endPos = pos;
+    const std::string separators = " \n,}]";
+    while (endPos < jsonStr.length() &&
+           separators.find_first_of(jsonStr[endPos]) == std::string::npos) {
+      endPos++;
+    }
+
+    str = jsonStr.substr(pos, endPos - pos);
+    if (str == "true")
+      element.SetValue(true);
+    else if (str == "false")
+      element.SetValue(false);
+    else
+      element.SetValue(gd::String::FromUTF8(str).To<double>());
+    return endPos;
+  }
+}
+
+gd::SerializerElement FromJSON(const std::string &jsonStr) {
+  gd::SerializerElement element;
+  if (!jsonStr.empty()) ParseJSONObject(jsonStr, 0, element);
+  return element;
+}
+}  // namespace
+}  // namespace previous
+
+TEST_CASE("Serializer - Benchmarks", "[common]") {
+  // A project-like tree: layouts with a lot of instances.
+  gd::SerializerElement project;
+  gd::SerializerElement &layouts = project.AddChild("layouts");
+  layouts.ConsiderAsArrayOf("layout");
+  for (std::size_t i = 0; i < 10; ++i) {
+    gd::SerializerElement &layout = layouts.AddChild("layout");
+    layout.SetAttribute("name", "Layout " + gd::String::From(i));
+    gd::SerializerElement &instances = layout.AddChild("instances");
+    instances.ConsiderAsArrayOf("instance");
+    for (std::size_t j = 0; j < 2000; ++j) {
+      gd::SerializerElement &instance = instances.AddChild("instance");
+      instance.SetAttribute("name",
+                            u8"Object été " + gd::String::From(j % 50));
+      instance.SetAttribute("x", j * 32.5);
+      instance.SetAttribute("y", j * 0.125);
+      instance.SetAttribute("layer", "");
+      instance.SetAttribute("locked", false);
+      instance.SetAttribute("zOrder", static_cast<int>(j));
+      instance.AddChild("numberProperties").ConsiderAsArrayOf("property");
+      instance.AddChild("stringProperties").ConsiderAsArrayOf("property");
+    }
+  }
+  gd::String json = gd::Serializer::ToJSON(project);
+  double megabytes = json.size() / 1000000.0;
+
+  auto doBenchmark = [megabytes](const gd::String &benchmarkName,
+                                 std::function<void()> func) {
+    std::size_t initialAllocatedBytes = allocatedBytes;
+    peakAllocatedBytes = allocatedBytes;
+
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << benchmarkName << " benchmark (" << megabytes
+              << " MB): " << megabytes / seconds << " MB/s, peak memory: "
+              << (peakAllocatedBytes - initialAllocatedBytes) / 1000000.0
+              << " MB" << std::endl;
+  };
+
+  doBenchmark("Serializer::FromJSON", [&]() {
+    gd::SerializerElement element = gd::Serializer::FromJSON(json);
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 10);
+  });
+  doBenchmark("Serializer::FromJSON (previous implementation)", [&]() {
+    gd::SerializerElement element = previous::FromJSON(json.ToUTF8());
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 10);
+  });
+  doBenchmark("SerializerElement copy", [&]() {
+    gd::SerializerElement element = project;
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 10);
+  });
+  doBenchmark("SerializerElement copy (in an arena)", [&]() {
+    gd::SerializerElement element;
+    element.AllocateChildrenInArena();
+    element = project;
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 10);
+  });
+  doBenchmark("Serializer::ToJSON", [&]() {
+    gd::String result = gd::Serializer::ToJSON(project);
+    REQUIRE(result.size() == json.size());
+  });
+  doBenchmark("Serializer::ToJSON (previous implementation)", [&]() {
+    gd::String result = previous::ToJSON(project);
+    REQUIRE(result == json);
+  });
+  doBenchmark("Serializer::ToJSON (to a stream)", [&]() {
+    // Measure only the serialization: nothing is stored in the stream.
+    std::ostringstream stream;
+    stream.setstate(std::ios::badbit);
+    gd::Serializer::ToJSON(project, stream);
+  });
+
+  // The rates of the other formats are also given for the size of the JSON,
+  // so that they can be compared.
+  std::string binary = gd::Serializer::ToBinary(project);
+  std::cout << "Binary format size: " << binary.size() / 1000000.0
+            << " MB (JSON: " << megabytes << " MB)" << std::endl;
+  doBenchmark("Serializer::FromBinary", [&]() {
+    gd::SerializerElement element = gd::Serializer::FromBinary(binary);
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 10);
+  });
+  doBenchmark("Serializer::ToBinary", [&]() {
+    std::string result = gd::Serializer::ToBinary(project);
+    REQUIRE(result.size() == binary.size());
+  });
+
+  TiXmlDocument xmlDocument;
+  TiXmlElement *xmlRoot = new TiXmlElement("project");
+  xmlDocument.LinkEndChild(xmlRoot);
+  gd::Serializer::ToXML(project, xmlRoot);
+  TiXmlPrinter xmlPrinter;
+  xmlDocument.Accept(&xmlPrinter);
+  std::string xml = xmlPrinter.CStr();
+  doBenchmark("Serializer::FromXML", [&]() {
+    TiXmlDocument document;
+    document.Parse(xml.c_str());
+    gd::SerializerElement element;
+    element.AllocateChildrenInArena();
+    gd::Serializer::FromXML(element, document.FirstChildElement());
+    REQUIRE(element.HasChild("layouts"));
+  });
+
+  // Read the instances like InitialInstance::UnserializeFrom does, from a
+  // tree loaded from JSON (where attributes are stored as children).
+  gd::SerializerElement loadedProject = gd::Serializer::FromJSON(json);
+  gd::SerializerElement &loadedLayouts = loadedProject.GetChild("layouts");
+  loadedLayouts.ConsiderAsArrayOf("layout");
+  auto start = std::chrono::steady_clock::now();
+  double xSum = 0;
+  for (std::size_t i = 0; i < loadedLayouts.GetChildrenCount(); ++i) {
+    gd::SerializerElement &instances =
+        loadedLayouts.GetChild("layout", i).GetChild("instances");
+    instances.ConsiderAsArrayOf("instance");
+    for (std::size_t j = 0; j < instances.GetChildrenCount(); ++j) {
+      const gd::SerializerElement &instance = instances.GetChild("instance", j);
+      xSum += instance.GetDoubleAttribute("x");
+      instance.GetStringAttribute("name");
+      instance.GetIntAttribute("zOrder");
+      instance.GetBoolAttribute("locked");
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  REQUIRE(xSum > 0);
+  std::cout << "SerializerElement::GetChild (reading 20000 instances) "
+               "benchmark: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                     start)
+                   .count()
+            << " microseconds" << std::endl;
+}
@@ -0,0 +1,104 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the packing of images in texture atlases.
+ */
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include <cstdlib>
+#include "catch.hpp"
+
+namespace {
+
+bool Overlaps(const gd::TextureAtlasPacker::Rect &a,
+              const gd::TextureAtlasPacker::Placement &placementA,
+              const gd::TextureAtlasPacker::Rect &b,
+              const gd::TextureAtlasPacker::Placement &placementB,
+              unsigned int padding) {
+  if (placementA.page != placementB.page) return false;
+
+  return placementA.x < placementB.x + b.width + padding &&
+         placementB.x < placementA.x + a.width + padding &&
+         placementA.y < placementB.y + b.height + padding &&
+         placementB.y < placementA.y + a.height + padding;
+}
+
+}  // namespace
+
+TEST_CASE("TextureAtlasPacker", "[common]") {
+  SECTION("Rectangles are placed without overlapping") {
+    std::vector<gd::TextureAtlasPacker::Rect> sizes;
+    std::srand(42);
+    for (std::size_t i = 0; i < 300; ++i)
+      sizes.push_back(gd::TextureAtlasPacker::Rect(
+          0, 0, 1 + std::rand() % 100, 1 + std::rand() % 100));
+
+    gd::TextureAtlasPacker packer(512, 2);
+    std::vector<gd::TextureAtlasPacker::Placement> placements =
+        packer.Pack(sizes);
+    REQUIRE(placements.size() == sizes.size());
+    REQUIRE(packer.GetPagesCount() > 1);
+
+    bool allPlaced = true;
+    bool allInPages = true;
+    bool overlapping = false;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+      const auto &placement = placements[i];
+      if (placement.page >= packer.GetPagesCount()) {
+        allPlaced = false;
+        continue;
+      }
+      if (placement.x + sizes[i].width >
+              packer.GetPageUsedWidth(placement.page) ||
+          placement.y + sizes[i].height >
+              packer.GetPageUsedHeight(placement.page) ||
+          packer.GetPageUsedWidth(placement.page) > 512 ||
+          packer.GetPageUsedHeight(placement.page) > 512)
+        allInPages = false;
+
+      for (std::size_t j = i + 1; j < sizes.size(); ++j)
+        if (Overlaps(sizes[i], placement, sizes[j], placements[j], 2))
+          overlapping = true;
+    }
+    REQUIRE(allPlaced == true);
+    REQUIRE(allInPages == true);
+    REQUIRE(overlapping == false);
+  }
+
+  SECTION("Rectangles fill the pages") {
+    // 16 squares of 64x64 fill exactly a page of 256x256.
+    std::vector<gd::TextureAtlasPacker::Rect> sizes(
+        16, gd::TextureAtlasPacker::Rect(0, 0, 64, 64));
+
+    gd::TextureAtlasPacker packer(256, 0);
+    std::vector<gd::TextureAtlasPacker::Placement> placements =
+        packer.Pack(sizes);
+    REQUIRE(packer.GetPagesCount() == 1);
+    REQUIRE(packer.GetPageUsedWidth(0) == 256);
+    REQUIRE(packer.GetPageUsedHeight(0) == 256);
+
+    // Another square needs a new page.
+    placements = packer.Pack({gd::TextureAtlasPacker::Rect(0, 0, 64, 64)});
+    REQUIRE(placements[0].page == 1);
+    REQUIRE(placements[0].x == 0);
+    REQUIRE(placements[0].y == 0);
+    REQUIRE(packer.GetPageUsedWidth(1) == 64);
+  }
+
+  SECTION("Rectangles too big for a page") {
+    gd::TextureAtlasPacker packer(256, 2);
+    std::vector<gd::TextureAtlasPacker::Placement> placements =
+        packer.Pack({gd::TextureAtlasPacker::Rect(0, 0, 300, 10),
+                     gd::TextureAtlasPacker::Rect(0, 0, 255, 10),
+                     gd::TextureAtlasPacker::Rect(0, 0, 0, 0),
+                     gd::TextureAtlasPacker::Rect(0, 0, 254, 254)});
+
+    REQUIRE(placements[0].page == gd::TextureAtlasPacker::noPage);
+    REQUIRE(placements[1].page == gd::TextureAtlasPacker::noPage);
+    REQUIRE(placements[2].page == gd::TextureAtlasPacker::noPage);
+    REQUIRE(placements[3].page == 0);
+    REQUIRE(packer.GetPagesCount() == 1);
+  }
+}
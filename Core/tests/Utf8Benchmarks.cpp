@@ -0,0 +1,66 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+TEST_CASE("Utf8 String - Benchmarks", "[common][utf8]") {
+  // Long strings made of the sentences used in Utf8Tests.cpp, with and
+  // without non ASCII characters.
+  gd::String asciiStr;
+  gd::String utf8Str;
+  for (std::size_t i = 0; i < 500; ++i) {
+    asciiStr += "UTF8 a ete teste ! ";
+    utf8Str += u8"UTF8 a été testé ! ";
+  }
+
+  auto doBenchmark = [](const gd::String &benchmarkName,
+                        std::function<void()> func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << benchmarkName << " benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  // Iterate on the characters using their positions, like a parser would do.
+  auto benchmarkString = [&doBenchmark](const gd::String &name,
+                                        const gd::String &str) {
+    doBenchmark(name + " size()", [&]() {
+      std::size_t total = 0;
+      for (std::size_t i = 0; i < 10000; ++i) total += str.size();
+      REQUIRE(total == 10000 * str.size());
+    });
+    doBenchmark(name + " operator[]", [&]() {
+      std::size_t spaces = 0;
+      for (std::size_t i = 0; i < str.size(); ++i)
+        if (str[i] == U' ') ++spaces;
+      REQUIRE(spaces == 2500);
+    });
+    doBenchmark(name + " substr", [&]() {
+      std::size_t total = 0;
+      for (std::size_t i = 0; i < str.size(); ++i)
+        total += str.substr(i, 1).size();
+      REQUIRE(total == str.size());
+    });
+    doBenchmark(name + " find", [&]() {
+      std::size_t count = 0;
+      for (std::size_t pos = str.find("! "); pos != gd::String::npos;
+           pos = str.find("! ", pos + 1))
+        ++count;
+      REQUIRE(count == 500);
+    });
+  };
+
+  benchmarkString("ASCII string", asciiStr);
+  benchmarkString("UTF8 string", utf8Str);
+}
@@ -10,7 +10,11 @@
 #include <SFML/System/String.hpp>
 #include <exception>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include "GDCore/String.h"
 #include "catch.hpp"
@@ -37,6 +41,83 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
     REQUIRE(str.size() == 18);
   }
 
+  SECTION("size after modifications") {
+    gd::String str = u8"UTF8 a été testé !";
+    REQUIRE(str.size() == 18);
+
+    str += u8" Oui";
+    REQUIRE(str.size() == 22);
+    str.push_back(U'é');
+    REQUIRE(str.size() == 23);
+    str.pop_back();
+    REQUIRE(str.size() == 22);
+    str.insert(4, u8"-é");
+    REQUIRE(str.size() == 24);
+    str.erase(4, 2);
+    REQUIRE(str.size() == 22);
+    str.replace(0, 4, "A");
+    REQUIRE(str.size() == 19);
+    str.Raw() += "\xC3\xA9t\xC3\xA9";
+    REQUIRE(str.size() == 22);
+    str.clear();
+    REQUIRE(str.size() == 0);
+
+    gd::String ascii = "ASCII";
+    REQUIRE(ascii.size() == 5);
+    ascii += u8"é";
+    REQUIRE(ascii.size() == 6);
+    ascii.erase(0, 5);
+    REQUIRE(ascii.size() == 1);
+    REQUIRE(ascii[0] == U'é');
+
+    gd::String moved = std::move(str);
+    gd::String copied = ascii;
+    REQUIRE(moved.size() == 0);
+    REQUIRE(copied.size() == 1);
+    REQUIRE(str.empty());
+    REQUIRE(str.size() == 0);
+  }
+
+  SECTION("size called by several threads") {
+    std::string utf8;
+    for (std::size_t i = 0; i < 1000; ++i) utf8 += u8"UTF8 a été testé !";
+    gd::String str = gd::String::FromUTF8(utf8);  // Size not computed yet.
+
+    std::vector<std::size_t> sizes(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+      threads.push_back(std::thread([&str, &sizes, i]() {
+        sizes[i] = str.size();
+      }));
+    for (std::thread &thread : threads) thread.join();
+
+    for (std::size_t size : sizes) REQUIRE(size == 18000);
+  }
+
+  SECTION("ASCII strings") {
+    gd::String str = "UTF8 a ete teste !";
+
+    REQUIRE(str.size() == 18);
+    REQUIRE(str[7] == U'e');
+    REQUIRE(str.substr(5, 7) == "a ete t");
+    REQUIRE(str.substr(5).size() == 13);
+    REQUIRE_THROWS_AS(str.substr(50, 5), std::out_of_range);
+    REQUIRE(str.find("te", 9) == 11);
+    REQUIRE(str.find("te", 18) == gd::String::npos);
+    REQUIRE(str.rfind("te", 13) == 11);
+    REQUIRE(str.rfind("te", 10) == 8);
+    REQUIRE(str.find_first_of("ae", 6) == 7);
+    REQUIRE(str.find_first_of(u8"àe", 6) == 7);
+    REQUIRE(str.find_first_not_of("UTF8 ") == 5);
+    REQUIRE(str.find_last_of("e", 15) == 15);
+    REQUIRE(str.find_last_not_of(" !") == 15);
+
+    str.insert(5, u8"é ");
+    REQUIRE(str == u8"UTF8 é a ete teste !");
+    REQUIRE(str.size() == 20);
+    REQUIRE(str.find("te") == 10);
+  }
+
   SECTION("substr") {
     gd::String str = u8"UTF8 a été testé !";
 
@@ -196,6 +277,59 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
     REQUIRE(gd::String("15").To<unsigned int>() == 15);
     REQUIRE(gd::String("15.6").To<float>() == 15.6f);
     REQUIRE(gd::String("15.6").To<double>() == 15.6);
+
+    // The results must be the same as the ones of streams.
+    for (double value : {0.0, -0.0, 1.0, -15.0, 0.1, 0.1 + 0.2, 1.0 / 3.0,
+                         999999.0, 1000000.0, -1234567.0, 123456.5, 1e-7,
+                         1e21, 3.14159265358979, -2.5e-300, 1.7e308}) {
+      std::ostringstream oss;
+      oss << value;
+      REQUIRE(gd::String::From(value) == oss.str().c_str());
+      REQUIRE(gd::String::From(static_cast<float>(value)) ==
+              gd::String::From(static_cast<double>(static_cast<float>(value))));
+    }
+    for (long long value : {0LL, 7LL, -7LL, 1234567890123LL,
+                            std::numeric_limits<long long>::min(),
+                            std::numeric_limits<long long>::max()}) {
+      std::ostringstream oss;
+      oss << value;
+      REQUIRE(gd::String::From(value) == oss.str().c_str());
+    }
+    REQUIRE(gd::String::From(std::numeric_limits<unsigned long long>::max()) ==
+            "18446744073709551615");
+    REQUIRE(gd::String::From('a') == "a");
+
+    for (const char *str :
+         {"0", "-0", "  42", "+42", "42abc", "abc", "", "-", ".", ".5", "5.",
+          "1e5", "1E-5", "1e", "1e+", "2.5e-3x", "0.1", "123456.5",
+          "0.30000000000000004", "3.14159265358979323846", "1e400", "1e-400",
+          "0x10", "inf", "2147483647", "2147483648", "-2147483649",
+          "99999999999999999999", "-1", "12.5e2", "00012", "\t\n7"}) {
+      std::istringstream doubleStream(str);
+      double doubleValue = 0;
+      doubleStream >> doubleValue;
+      REQUIRE(gd::String(str).To<double>() == doubleValue);
+
+      std::istringstream floatStream(str);
+      float floatValue = 0;
+      floatStream >> floatValue;
+      REQUIRE(gd::String(str).To<float>() == floatValue);
+
+      std::istringstream intStream(str);
+      int intValue = 0;
+      intStream >> intValue;
+      REQUIRE(gd::String(str).To<int>() == intValue);
+
+      std::istringstream unsignedStream(str);
+      unsigned int unsignedValue = 0;
+      unsignedStream >> unsignedValue;
+      REQUIRE(gd::String(str).To<unsigned int>() == unsignedValue);
+
+      std::istringstream longLongStream(str);
+      long long longLongValue = 0;
+      longLongStream >> longLongValue;
+      REQUIRE(gd::String(str).To<long long>() == longLongValue);
+    }
   }
 
   SECTION("operator+=") {
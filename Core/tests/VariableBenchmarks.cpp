@@ -0,0 +1,37 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <iostream>
+#include "GDCore/Project/Variable.h"
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+TEST_CASE("Variable - Benchmarks", "[common][variables]") {
+  // Variables used alternatively as numbers and strings, like in events
+  // updating a score and displaying it in a text every frame.
+  auto doBenchmark = [](const gd::String &benchmarkName, double step) {
+    gd::Variable variable;
+    double sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100000; ++i) {
+      variable.SetValue(variable.GetValue() + step);
+      sum += variable.GetString().size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    REQUIRE(sum > 0);
+    std::cout << benchmarkName << " benchmark (100000 conversions): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  doBenchmark("Variable string <-> integer", 1);
+  doBenchmark("Variable string <-> decimal", 0.25);
+  doBenchmark("Variable string <-> large decimal", 12345.678);
+}
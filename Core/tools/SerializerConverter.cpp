@@ -0,0 +1,142 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Command line tool converting a project (or anything saved with
+ * gd::Serializer) between the JSON, XML and binary formats.
+ *
+ * Usage: GDCore_SerializerConverter input output
+ *
+ * The format of the input is detected from its content, and the format of the
+ * output is given by its extension (.json, .xml or .gdbin).
+ *
+ * \note Conversions between JSON and the binary format are lossless. XML is
+ * only supported for old projects: it can't store the (unnamed) elements of
+ * arrays read from JSON, and elements having the same name are merged when
+ * reading it.
+ */
+#include <iostream>
+#include <iterator>
+#include <string>
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/String.h"
+#include "GDCore/TinyXml/tinyxml.h"
+#include "GDCore/Tools/FileStream.h"
+
+namespace {
+enum Format { FormatUnknown, FormatJSON, FormatXML, FormatBinary };
+
+Format GetFormatFromExtension(const gd::String& path) {
+  std::size_t dot = path.find_last_of(".");
+  if (dot == gd::String::npos) return FormatUnknown;
+
+  gd::String extension = path.substr(dot).LowerCase();
+  if (extension == ".json") return FormatJSON;
+  if (extension == ".xml") return FormatXML;
+  if (extension == ".gdbin") return FormatBinary;
+
+  return FormatUnknown;
+}
+
+bool ReadFile(const gd::String& path, std::string& data) {
+  gd::FileStream file(path, std::ios_base::in | std::ios_base::binary);
+  if (!file.is_open()) return false;
+
+  data.assign(std::istreambuf_iterator<char>(file),
+              std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+/**
+ * \brief Read the data, setting \a error if it is invalid or truncated.
+ */
+gd::SerializerElement Unserialize(const std::string& data, gd::String& error) {
+  if (gd::Serializer::IsBinary(data.data(), data.size()))
+    return gd::Serializer::FromBinary(data.data(), data.size(), error);
+
+  std::size_t firstCharacter = data.find_first_not_of(" \t\r\n");
+  if (firstCharacter == std::string::npos || data[firstCharacter] != '<')
+    return gd::Serializer::FromJSON(data.data(), data.size(), error);
+
+  gd::SerializerElement element;
+  TiXmlDocument document;
+  document.Parse(data.c_str());
+  if (document.Error()) {
+    error = gd::String::FromUTF8(document.ErrorDesc());
+    return element;
+  }
+
+  element.AllocateChildrenInArena();
+  gd::Serializer::FromXML(element, document.FirstChildElement());
+  return element;
+}
+
+bool Save(const gd::String& path,
+          Format format,
+          gd::SerializerElement& element) {
+  gd::FileStream file(path, std::ios_base::out | std::ios_base::binary);
+  if (!file.is_open()) return false;
+
+  if (format == FormatJSON) {
+    gd::Serializer::ToJSON(element, file);
+  } else if (format == FormatBinary) {
+    gd::Serializer::ToBinary(element, file);
+  } else {
+    TiXmlDocument document;
+    document.LinkEndChild(new TiXmlDeclaration("1.0", "UTF-8", ""));
+    TiXmlElement* root = new TiXmlElement("Project");
+    document.LinkEndChild(root);
+    gd::Serializer::ToXML(element, root);
+
+    TiXmlPrinter printer;
+    document.Accept(&printer);
+    file << printer.CStr();
+  }
+
+  return !file.fail();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cout << "Usage: " << argv[0] << " input output" << std::endl
+              << "Convert a file saved by GDevelop between the JSON, XML and "
+                 "binary formats. The format of the output is chosen from "
+                 "its extension (.json, .xml or .gdbin)."
+              << std::endl;
+    return 1;
+  }
+
+  gd::String inputPath = gd::String::FromLocale(argv[1]);
+  gd::String outputPath = gd::String::FromLocale(argv[2]);
+  Format outputFormat = GetFormatFromExtension(outputPath);
+  if (outputFormat == FormatUnknown) {
+    std::cout << "Unknown format for \"" << outputPath
+              << "\": use .json, .xml or .gdbin as extension." << std::endl;
+    return 1;
+  }
+
+  std::string data;
+  if (!ReadFile(inputPath, data)) {
+    std::cout << "Unable to read \"" << inputPath << "\"." << std::endl;
+    return 1;
+  }
+
+  gd::String error;
+  gd::SerializerElement element = Unserialize(data, error);
+  if (!error.empty()) {
+    std::cout << "Unable to read \"" << inputPath << "\": " << error
+              << std::endl;
+    return 1;
+  }
+
+  if (!Save(outputPath, outputFormat, element)) {
+    std::cout << "Unable to write \"" << outputPath << "\"." << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -136,6 +136,16 @@ class LinkedObjectsCppExtension : public ExtensionBase {
         .RemoveAllLinksOf(object);
   }
 
+  /**
+   * Remove the links of all objects deleted during a frame
+   */
+  virtual void ObjectsDeletedFromScene(
+      RuntimeScene& scene, const std::vector<RuntimeObject*>& objects) {
+    GDpriv::LinkedObjects::ObjectsLinksManager& manager =
+        GDpriv::LinkedObjects::ObjectsLinksManager::managers[&scene];
+    for (RuntimeObject* object : objects) manager.RemoveAllLinksOf(object);
+  }
+
   /**
    * Initialize manager of linked objects of scene
    */
@@ -105,19 +105,24 @@ class GD_EXTENSION_API RuntimePanelSpriteObject : public RuntimeObject {
   virtual inline void SetWidth(float newWidth) {
     width = newWidth >= (leftMargin + rightMargin) ? newWidth
                                                    : (leftMargin + rightMargin);
+    NotifyBoundsChanged();
   };
   virtual inline void SetHeight(float newHeight) {
     height = newHeight >= (topMargin + bottomMargin)
                  ? newHeight
                  : (topMargin + bottomMargin);
+    NotifyBoundsChanged();
   };
 
   virtual bool SetAngle(float newAngle) {
     angle = newAngle;
+    NotifyBoundsChanged();
     return true;
   };
   virtual float GetAngle() const { return angle; };
 
+  virtual bool CanBeCulled() const { return true; };
+
   float GetLeftMargin() const { return leftMargin; };
   void SetLeftMargin(float newMargin) { leftMargin = newMargin; };
 
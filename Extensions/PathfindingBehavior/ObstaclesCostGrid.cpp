@@ -0,0 +1,172 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "ObstaclesCostGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "PathfindingObstacleRuntimeBehavior.h"
+
+namespace {
+int CellCoordinate(double value) {
+  // Coordinates are clamped so that the areas of obstacles that are far away
+  // (or not positioned) can still be computed.
+  if (!(value > std::numeric_limits<int>::min() / 2))
+    return std::numeric_limits<int>::min() / 2;
+  if (value > std::numeric_limits<int>::max() / 2)
+    return std::numeric_limits<int>::max() / 2;
+
+  return static_cast<int>(value);
+}
+
+std::int64_t CellKey(int x, int y) {
+  return static_cast<std::int64_t>(
+      (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+      static_cast<std::uint32_t>(y));
+}
+}
+
+const std::int64_t ObstaclesCostGrid::maxCellsPerObstacle = 4096;
+
+ObstaclesCostGrid::Area ObstaclesCostGrid::ComputeArea(
+    const PathfindingObstacleRuntimeBehavior& obstacle) const {
+  // A cell is covered by an obstacle if it's strictly inside the obstacle
+  // enlarged by the borders of the object.
+  RuntimeObject* obj = obstacle.GetObject();
+  Area area;
+  area.left = CellCoordinate(
+                  floor((obj->GetDrawableX() - settings.rightBorder) /
+                        settings.cellWidth)) +
+              1;
+  area.top = CellCoordinate(
+                 floor((obj->GetDrawableY() - settings.bottomBorder) /
+                       settings.cellHeight)) +
+             1;
+  area.right = CellCoordinate(ceil(
+      (obj->GetDrawableX() + obj->GetWidth() + settings.leftBorder) /
+      settings.cellWidth));
+  area.bottom = CellCoordinate(ceil(
+      (obj->GetDrawableY() + obj->GetHeight() + settings.topBorder) /
+      settings.cellHeight));
+  area.impassable = obstacle.IsImpassable();
+  area.cost = obstacle.GetCost();
+
+  return area;
+}
+
+bool ObstaclesCostGrid::IsLarge(const Area& area) const {
+  return area.left < area.right && area.top < area.bottom &&
+         static_cast<std::int64_t>(area.right - area.left) *
+                 (area.bottom - area.top) >
+             maxCellsPerObstacle;
+}
+
+void ObstaclesCostGrid::AddArea(const Area& area, int sign) {
+  for (int y = area.top; y < area.bottom; ++y) {
+    for (int x = area.left; x < area.right; ++x) {
+      Cell& cell = cells[CellKey(x, y)];
+      cell.obstaclesCount += sign;
+      if (area.impassable)
+        cell.impassableObstaclesCount += sign;
+      else
+        cell.cost += sign * area.cost;
+
+      // Avoid accumulating rounding errors when all obstacles are removed.
+      if (cell.obstaclesCount == cell.impassableObstaclesCount) cell.cost = 0;
+      if (cell.obstaclesCount == 0) cells.erase(CellKey(x, y));
+    }
+  }
+}
+
+void ObstaclesCostGrid::Update() {
+  for (const PathfindingObstacleRuntimeBehavior* obstacle : changedObstacles) {
+    Area area = ComputeArea(*obstacle);
+    auto it = areas.find(obstacle);
+    if (it != areas.end()) {
+      if (it->second == area) continue;
+      RemoveFromCells(obstacle);
+    }
+
+    areas[obstacle] = area;
+    if (!area.impassable) passableObstaclesCount++;
+    if (IsLarge(area))
+      largeAreas.push_back(std::make_pair(obstacle, area));
+    else
+      AddArea(area, 1);
+  }
+
+  changedObstacles.clear();
+}
+
+void ObstaclesCostGrid::RemoveObstacle(
+    const PathfindingObstacleRuntimeBehavior* obstacle) {
+  changedObstacles.erase(obstacle);
+  RemoveFromCells(obstacle);
+}
+
+void ObstaclesCostGrid::RemoveFromCells(
+    const PathfindingObstacleRuntimeBehavior* obstacle) {
+  auto it = areas.find(obstacle);
+  if (it == areas.end()) return;
+
+  if (IsLarge(it->second)) {
+    largeAreas.erase(
+        std::find_if(largeAreas.begin(),
+                     largeAreas.end(),
+                     [obstacle](const std::pair<
+                                const PathfindingObstacleRuntimeBehavior*,
+                                Area>& largeArea) {
+                       return largeArea.first == obstacle;
+                     }));
+  } else
+    AddArea(it->second, -1);
+
+  if (!it->second.impassable) passableObstaclesCount--;
+  areas.erase(it);
+}
+
+bool ObstaclesCostGrid::GetObstaclesBounds(int& left,
+                                           int& top,
+                                           int& right,
+                                           int& bottom) const {
+  bool found = false;
+  for (const auto& it : areas) {
+    const Area& area = it.second;
+    if (area.left >= area.right || area.top >= area.bottom) continue;
+
+    left = found ? std::min(left, area.left) : area.left;
+    top = found ? std::min(top, area.top) : area.top;
+    right = found ? std::max(right, area.right) : area.right;
+    bottom = found ? std::max(bottom, area.bottom) : area.bottom;
+    found = true;
+  }
+
+  return found;
+}
+
+float ObstaclesCostGrid::GetCost(int x, int y) const {
+  Cell cell;
+  auto it = cells.find(CellKey(x, y));
+  if (it != cells.end()) cell = it->second;
+
+  for (const auto& largeArea : largeAreas) {
+    const Area& area = largeArea.second;
+    if (area.left <= x && x < area.right && area.top <= y && y < area.bottom) {
+      cell.obstaclesCount++;
+      if (area.impassable)
+        cell.impassableObstaclesCount++;
+      else
+        cell.cost += area.cost;
+    }
+  }
+
+  if (cell.impassableObstaclesCount > 0) return -1;
+  if (cell.obstaclesCount == 0)
+    return 1;  // Default cost when no objects put on the cell.
+
+  return cell.cost;
+}
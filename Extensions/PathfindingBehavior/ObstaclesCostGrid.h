@@ -0,0 +1,166 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef OBSTACLESCOSTGRID_H
+#define OBSTACLESCOSTGRID_H
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+class PathfindingObstacleRuntimeBehavior;
+
+/**
+ * \brief The cost of moving on the cells of a grid, computed from the
+ * obstacles covering each cell.
+ *
+ * The obstacles are enlarged by the borders of the object looking for a path,
+ * so a grid is only valid for a cell size and an object size (see
+ * ObstaclesCostGrid::Settings).
+ *
+ * Each obstacle is added to the cells it covers. Obstacles are marked as
+ * changed when they are added, moved, resized or changed, and Update only
+ * adds again these obstacles: neither updating the grid nor getting the cost
+ * of a cell depend on the number of obstacles.
+ *
+ * \see ScenePathfindingObstaclesManager::GetCostGrid
+ */
+class ObstaclesCostGrid {
+ public:
+  /**
+   * \brief The size of the cells and of the object looking for a path.
+   */
+  struct Settings {
+    Settings()
+        : cellWidth(20),
+          cellHeight(20),
+          leftBorder(0),
+          topBorder(0),
+          rightBorder(0),
+          bottomBorder(0){};
+
+    bool operator==(const Settings& other) const {
+      return cellWidth == other.cellWidth && cellHeight == other.cellHeight &&
+             leftBorder == other.leftBorder && topBorder == other.topBorder &&
+             rightBorder == other.rightBorder &&
+             bottomBorder == other.bottomBorder;
+    }
+
+    float cellWidth;
+    float cellHeight;
+    float leftBorder;
+    float topBorder;
+    float rightBorder;
+    float bottomBorder;
+  };
+
+  ObstaclesCostGrid(const Settings& settings_)
+      : settings(settings_), passableObstaclesCount(0){};
+
+  /**
+   * \brief Return the settings used to compute the grid.
+   */
+  const Settings& GetSettings() const { return settings; }
+
+  /**
+   * \brief Mark an obstacle as added, moved, resized or changed, so that it's
+   * added again to the cells by the next call to Update.
+   */
+  void InvalidateObstacle(const PathfindingObstacleRuntimeBehavior* obstacle) {
+    changedObstacles.insert(obstacle);
+  }
+
+  /**
+   * \brief Update the cells covered by the obstacles marked as changed since
+   * the last call.
+   */
+  void Update();
+
+  /**
+   * \brief Remove an obstacle from the cells it covers.
+   * \note The obstacle is not used, so it can be called while the obstacle is
+   * being destroyed.
+   */
+  void RemoveObstacle(const PathfindingObstacleRuntimeBehavior* obstacle);
+
+  /**
+   * \brief Return the cost of moving on a cell: 1 if no obstacles are on the
+   * cell, -1 if an impassable obstacle is on the cell, or the sum of the
+   * costs of the obstacles on the cell.
+   */
+  float GetCost(int x, int y) const;
+
+  /**
+   * \brief Return true if there are no passable obstacles, so that the cost of
+   * all the cells is either 1 or -1.
+   */
+  bool HasOnlyImpassableObstacles() const {
+    return passableObstaclesCount == 0;
+  }
+
+  /**
+   * \brief Get the cells covered by the obstacles (from left to right - 1 and
+   * top to bottom - 1).
+   * \return false if no cells are covered by obstacles.
+   * \note Complexity is linear in the number of obstacles.
+   */
+  bool GetObstaclesBounds(int& left, int& top, int& right, int& bottom) const;
+
+ private:
+  /**
+   * \brief The cells covered by an obstacle (from left to right - 1 and top to
+   * bottom - 1), and its cost.
+   */
+  struct Area {
+    bool operator==(const Area& other) const {
+      return left == other.left && top == other.top && right == other.right &&
+             bottom == other.bottom && impassable == other.impassable &&
+             cost == other.cost;
+    }
+    bool operator!=(const Area& other) const { return !(*this == other); }
+
+    int left;
+    int top;
+    int right;
+    int bottom;
+    bool impassable;
+    float cost;
+  };
+
+  struct Cell {
+    Cell() : obstaclesCount(0), impassableObstaclesCount(0), cost(0){};
+
+    int obstaclesCount;
+    int impassableObstaclesCount;
+    float cost;  ///< The sum of the costs of the passable obstacles.
+  };
+
+  Area ComputeArea(const PathfindingObstacleRuntimeBehavior& obstacle) const;
+  /**
+   * \brief Add (sign = 1) or remove (sign = -1) an area from the cells.
+   */
+  void AddArea(const Area& area, int sign);
+  /**
+   * \brief Remove the area of an obstacle from the cells, if it was added.
+   */
+  void RemoveFromCells(const PathfindingObstacleRuntimeBehavior* obstacle);
+  bool IsLarge(const Area& area) const;
+
+  Settings settings;
+  std::unordered_map<std::int64_t, Cell> cells;
+  std::unordered_map<const PathfindingObstacleRuntimeBehavior*, Area>
+      areas;  ///< The area of each obstacle, as it was added to the cells.
+  std::vector<std::pair<const PathfindingObstacleRuntimeBehavior*, Area>>
+      largeAreas;  ///< The areas covering too many cells to be added to the
+                   ///< cells, tested for each cell instead.
+  std::unordered_set<const PathfindingObstacleRuntimeBehavior*>
+      changedObstacles;  ///< The obstacles to add again by Update.
+  std::size_t passableObstaclesCount;
+
+  static const std::int64_t maxCellsPerObstacle;
+};
+
+#endif  // OBSTACLESCOSTGRID_H
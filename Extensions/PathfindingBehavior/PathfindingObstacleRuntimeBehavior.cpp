@@ -26,7 +26,11 @@ PathfindingObstacleRuntimeBehavior::PathfindingObstacleRuntimeBehavior(
       sceneManager(NULL),
       registeredInManager(false),
       impassable(true),
-      cost(2) {
+      cost(2),
+      oldX(0),
+      oldY(0),
+      oldWidth(0),
+      oldHeight(0) {
   impassable = behaviorContent.GetBoolAttribute("impassable");
   cost = behaviorContent.GetDoubleAttribute("cost");
 }
@@ -57,11 +61,33 @@ void PathfindingObstacleRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       registeredInManager = true;
     }
   }
+
+  // Obstacles moved or resized since the last frame are added again to the
+  // grids of costs.
+  if (registeredInManager &&
+      (oldX != object->GetDrawableX() || oldY != object->GetDrawableY() ||
+       oldWidth != object->GetWidth() || oldHeight != object->GetHeight())) {
+    sceneManager->InvalidateObstacle(this);
+    oldX = object->GetDrawableX();
+    oldY = object->GetDrawableY();
+    oldWidth = object->GetWidth();
+    oldHeight = object->GetHeight();
+  }
 }
 
 void PathfindingObstacleRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
 }
 
+void PathfindingObstacleRuntimeBehavior::SetImpassable(bool impassable_) {
+  impassable = impassable_;
+  if (sceneManager) sceneManager->InvalidateObstacle(this);
+}
+
+void PathfindingObstacleRuntimeBehavior::SetCost(float newCost) {
+  cost = newCost;
+  if (sceneManager) sceneManager->InvalidateObstacle(this);
+}
+
 void PathfindingObstacleRuntimeBehavior::OnActivate() {
   if (sceneManager) {
     sceneManager->AddObstacle(this);
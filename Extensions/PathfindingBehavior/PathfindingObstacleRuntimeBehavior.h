@@ -40,7 +40,7 @@ class GD_EXTENSION_API PathfindingObstacleRuntimeBehavior : public RuntimeBehavi
   /**
    * \brief Set the object as impassable or not.
    */
-  void SetImpassable(bool impassable_ = true) { impassable = impassable_; }
+  void SetImpassable(bool impassable_ = true);
 
   /**
    * \brief Return the cost of moving on the object.
@@ -50,7 +50,7 @@ class GD_EXTENSION_API PathfindingObstacleRuntimeBehavior : public RuntimeBehavi
   /**
    * \brief Change the cost of moving on the object.
    */
-  void SetCost(float newCost) { cost = newCost; }
+  void SetCost(float newCost);
 
  private:
   virtual void OnActivate();
@@ -67,6 +67,11 @@ class GD_EXTENSION_API PathfindingObstacleRuntimeBehavior : public RuntimeBehavi
   bool impassable;
   float cost;  ///< The cost of moving on the obstacle (for when impassable ==
                ///< false)
+  float oldX;  ///< The position and size of the object when its changes were
+               ///< last checked.
+  float oldY;
+  float oldWidth;
+  float oldHeight;
 };
 
 #endif  // PATHFINDINGOBSTACLERUNTIMEBEHAVIOR_H
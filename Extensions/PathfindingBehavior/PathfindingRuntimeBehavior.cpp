@@ -8,10 +8,11 @@ This project is released under the MIT License.
 #include "PathfindingRuntimeBehavior.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
-#include <set>
-#include <unordered_map>
+#include <vector>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Runtime/CommonTools.h"
@@ -43,46 +44,22 @@ bool operator==(const NodePosition& a, const NodePosition& b) {
   return ((a.x == b.x) && (a.y == b.y));
 }
 
-namespace std {
-/**
- * \brief Tool function used to store a NodePosition as key in
- * std::unordered_set.
- */
-template <>
-struct hash<NodePosition> {
-  std::size_t operator()(NodePosition const& n) const {
-    return (std::hash<int>()(n.x)) ^ (std::hash<int>()(n.y) << 1);
-  }
-};
-
-}  // namespace std
-
 namespace {
+const std::size_t noNode = std::numeric_limits<std::size_t>::max();
+
 /**
  * \brief Internal tool class representing a node when looking for a path
  */
 class Node {
  public:
-  Node()
-      : pos(0, 0),
-        cost(0),
-        smallestCost(-1),
-        estimateCost(-1),
-        parent(NULL),
-        open(true){};
-  Node(int x, int y)
-      : pos(x, y),
-        cost(0),
-        smallestCost(-1),
-        estimateCost(-1),
-        parent(NULL),
-        open(true){};
   Node(const NodePosition& pos_)
       : pos(pos_),
         cost(0),
         smallestCost(-1),
         estimateCost(-1),
-        parent(NULL),
+        parent(noNode),
+        openOrder(0),
+        heapIndex(noNode),
         open(true){};
 
   NodePosition pos;
@@ -92,43 +69,159 @@ class Node {
   float estimateCost;  ///< the estimate cost total to go to the destination
                        ///< through this node (when considering the shortest
                        ///< path).
-  const Node* parent;  ///< The previous node to be visited to go to this node
-                       ///< (when considering the shortest path).
+  std::size_t parent;  ///< The index of the previous node to be visited to go
+                       ///< to this node (when considering the shortest path).
+  std::size_t openOrder;  ///< When the node was last added to the open nodes:
+                          ///< the oldest of the nodes with the same estimate
+                          ///< cost is explored first.
+  std::size_t heapIndex;  ///< The position of the node in the open nodes heap.
   bool open;  ///< true if the node is "open" (must be explored), false if
               ///< "close" (already explored)
+};
+
+/**
+ * \brief Internal tool class associating the position of the nodes to their
+ * index, using open addressing.
+ *
+ * The table is kept between searches: clearing it only changes the
+ * generation of the valid slots, and it is only reallocated when a search
+ * needs more nodes than all the previous ones.
+ */
+class NodesIndex {
+ public:
+  NodesIndex() : generation(1), size(0), bits(0){};
 
   /**
-   * \brief Tool function used to store a Node in a priority_queue.
+   * \brief Remove all the positions.
    */
-  class NodeComparator {
-   public:
-    bool operator()(const Node* n1, const Node* n2) {
-      return n1->estimateCost < n2->estimateCost;
+  void Clear() {
+    size = 0;
+    if (++generation == 0) {
+      for (Slot& slot : slots) slot.generation = 0;
+      generation = 1;
+    }
+  }
+
+  /**
+   * \brief Return the index of the node at the given position, or associate
+   * \a newIndex to the position and return it if there is no node yet.
+   */
+  std::size_t FindOrInsert(const NodePosition& pos, std::size_t newIndex) {
+    if ((size + 1) * 2 > slots.size()) Grow();
+
+    std::uint64_t key = Key(pos);
+    for (std::size_t i = Hash(key);; i = (i + 1) & (slots.size() - 1)) {
+      Slot& slot = slots[i];
+      if (slot.generation != generation) {
+        slot.key = key;
+        slot.generation = generation;
+        slot.index = newIndex;
+        size++;
+        return newIndex;
+      }
+      if (slot.key == key) return slot.index;
     }
+  }
+
+ private:
+  struct Slot {
+    Slot() : key(0), generation(0), index(0){};
+
+    std::uint64_t key;
+    std::uint32_t generation;  ///< The slot is used only if it's the same as
+                               ///< NodesIndex::generation.
+    std::size_t index;
   };
-};
 
-bool operator==(Node const& n1, Node const& n2) {
-  return n1.pos.x == n2.pos.x && n1.pos.y == n2.pos.y;
+  static std::uint64_t Key(const NodePosition& pos) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.x))
+            << 32) |
+           static_cast<std::uint32_t>(pos.y);
+  }
+
+  /**
+   * \brief Fibonacci hashing, so that close positions are spread on the table.
+   */
+  std::size_t Hash(std::uint64_t key) const {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >>
+                                    (64 - bits));
+  }
+
+  void Grow() {
+    std::vector<Slot> oldSlots(bits == 0 ? 1024 : slots.size() * 2);
+    oldSlots.swap(slots);
+    bits = 0;
+    while ((std::size_t(1) << bits) < slots.size()) bits++;
+
+    for (const Slot& oldSlot : oldSlots) {
+      if (oldSlot.generation != generation) continue;
+
+      std::size_t i = Hash(oldSlot.key);
+      while (slots[i].generation == generation)
+        i = (i + 1) & (slots.size() - 1);
+      slots[i] = oldSlot;
+    }
+  }
+
+  std::vector<Slot> slots;
+  std::uint32_t generation;
+  std::size_t size;
+  unsigned int bits;  ///< slots.size() == 2^bits
 };
 
 typedef float (*DistanceFunPtr)(const NodePosition&, const NodePosition&);
+}  // namespace
+
+/**
+ * \brief The structures used by A*, kept by ScenePathfindingObstaclesManager
+ * so that their memory is reused by the searches of a scene.
+ */
+class PathfindingSearchStorage {
+ public:
+  std::vector<Node> nodes;  ///< All the nodes
+  NodesIndex nodesIndex;    ///< The index of the nodes, by position.
+  std::vector<std::size_t>
+      openNodes;  ///< Only the open nodes (Such that Node::open == true),
+                  ///< stored as a binary heap.
+  std::vector<std::uint8_t>
+      walkableCells;  ///< The cells already read by jump point search (see
+                      ///< SearchContext::IsWalkable).
+};
+
+namespace {
 
 /**
  * \brief Internal tool class containing the structures used by A* and members
  * functions related to them.
+ *
+ * The nodes are stored in a vector and the open nodes in a binary heap
+ * (ordered by estimate cost, then by insertion order). They are stored in a
+ * PathfindingSearchStorage shared by the searches of the scene, so that their
+ * memory is reused.
  */
 class SearchContext {
  public:
   SearchContext(ScenePathfindingObstaclesManager& obstacles_,
+                PathfindingSearchStorage& storage,
                 bool allowsDiagonal_ = true)
-      : obstacles(obstacles_),
-        finalNode(NULL),
+      : nodes(storage.nodes),
+        nodesIndex(storage.nodesIndex),
+        openNodes(storage.openNodes),
+        walkableCells(storage.walkableCells),
+        obstacles(obstacles_),
+        costGrid(NULL),
+        finalNode(noNode),
         destination(0, 0),
         startX(0),
         startY(0),
         allowsDiagonal(allowsDiagonal_),
+        useJumpPointSearch(false),
+        jumpLeft(0),
+        jumpTop(0),
+        jumpRight(0),
+        jumpBottom(0),
         maxComplexityFactor(50),
+        openOrderCount(0),
         cellWidth(20),
         cellHeight(20),
         leftBorder(0),
@@ -176,11 +269,24 @@ class SearchContext {
     return *this;
   }
 
+  /**
+   * \brief Use jump point search instead of exploring all the neighbors of
+   * the nodes.
+   *
+   * Jump point search is only used if diagonals are allowed and if all the
+   * obstacles are impassable (so that all the cells have the same cost).
+   * The path then only contains the nodes where the direction changes.
+   */
+  SearchContext& SetUseJumpPointSearch(bool useJumpPointSearch_) {
+    useJumpPointSearch = useJumpPointSearch_;
+    return *this;
+  }
+
   /**
    * \brief Compute a path to the specified position, considering the obstacles
    * and the start position passed in the constructor.
    * \return true if computation found a path, in which case you can call
-   * GetFinalNode method to construct the path. \param x The coordinate on X
+   * GetPath method to get the path. \param x The coordinate on X
    * axis of the target position, in "world" coordinates. \param y The
    * coordinate on Y axis of the target position, in "world" coordinates.
    */
@@ -190,47 +296,74 @@ class SearchContext {
     NodePosition start(GDRound(startX / cellWidth),
                        GDRound(startY / cellHeight));
 
+    ObstaclesCostGrid::Settings settings;
+    settings.cellWidth = cellWidth;
+    settings.cellHeight = cellHeight;
+    settings.leftBorder = leftBorder;
+    settings.topBorder = topBorder;
+    settings.rightBorder = rightBorder;
+    settings.bottomBorder = bottomBorder;
+    costGrid = &obstacles.GetCostGrid(settings);
+
     // Initialize the algorithm
-    allNodes.clear();
-    Node& startNode = GetNode(start);
-    startNode.smallestCost = 0;
-    startNode.estimateCost = 0 + distanceFunction(start, destination);
+    nodes.clear();
+    nodesIndex.Clear();
     openNodes.clear();
-    openNodes.insert(&startNode);
+    openOrderCount = 0;
+    std::size_t startNode = GetNode(start);
+    nodes[startNode].smallestCost = 0;
+    nodes[startNode].estimateCost = 0 + distanceFunction(start, destination);
+    PushOpenNode(startNode);
 
-    // A* algorithm main loop
     std::size_t iterationCount = 0;
     std::size_t maxIterationCount =
-        startNode.estimateCost * maxComplexityFactor;
+        nodes[startNode].estimateCost * maxComplexityFactor;
+    bool jumpPointSearch = useJumpPointSearch && allowsDiagonal &&
+                           costGrid->HasOnlyImpassableObstacles();
+    if (jumpPointSearch) {
+      // The start cell can be inside an obstacle: consider it as a normal
+      // cell so that the cost of the first jump is its length.
+      nodes[startNode].cost = 1;
+      SetJumpBounds(start, maxIterationCount);
+    }
+
+    // A* algorithm main loop
     while (!openNodes.empty()) {
       if (iterationCount++ > maxIterationCount)
         return false;  // Make sure we do not search forever.
 
-      Node* n = *openNodes.begin();  // Get the most promising node...
-      n->open = false;               //...and flag it as explored
-      openNodes.erase(
-          openNodes.begin());  // Be sure to remove ONLY the first element!
+      std::size_t n = PopOpenNode();  // Get the most promising node...
+      nodes[n].open = false;          //...and flag it as explored
 
       // Check if we reached destination?
-      if (n->pos.x == destination.x && n->pos.y == destination.y) {
+      if (nodes[n].pos == destination) {
         finalNode = n;
         return true;
       }
 
       // No, so add neighbors to the nodes to explore.
-      InsertNeighbors(*n);
+      if (jumpPointSearch)
+        InsertJumpPoints(n);
+      else
+        InsertNeighbors(n);
     }
 
     return false;
   }
 
   /**
-   * @return The final node of the computed path.
-   * Iterate on the parent member to create the path. Beware, the coordinates of
-   * the node must be multiplied by the cell size to get the "world" coordinates
-   * of the path.
+   * \brief Fill \a path with the positions of the nodes of the computed path,
+   * in "world" coordinates, from the start to the destination.
    */
-  Node* GetFinalNode() const { return finalNode; }
+  void GetPath(std::vector<sf::Vector2f>& path) const {
+    path.clear();
+    for (std::size_t n = finalNode; n != noNode; n = nodes[n].parent) {
+      path.push_back(sf::Vector2f(nodes[n].pos.x * cellWidth,
+                                  nodes[n].pos.y * cellHeight));
+    }
+
+    std::reverse(path.begin(), path.end());
+  }
 
  private:
   /**
@@ -238,80 +371,170 @@ class SearchContext {
    * (Only if they are not closed, and if the cost is better than the already
    * existing smallest cost).
    */
-  void InsertNeighbors(const Node& currentNode) {
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x + 1, currentNode.pos.y), currentNode, 1);
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x - 1, currentNode.pos.y), currentNode, 1);
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x, currentNode.pos.y + 1), currentNode, 1);
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x, currentNode.pos.y - 1), currentNode, 1);
+  void InsertNeighbors(std::size_t currentNode) {
+    NodePosition pos = nodes[currentNode].pos;
+    AddOrUpdateNode(NodePosition(pos.x + 1, pos.y), currentNode, 1);
+    AddOrUpdateNode(NodePosition(pos.x - 1, pos.y), currentNode, 1);
+    AddOrUpdateNode(NodePosition(pos.x, pos.y + 1), currentNode, 1);
+    AddOrUpdateNode(NodePosition(pos.x, pos.y - 1), currentNode, 1);
     if (allowsDiagonal) {
-      AddOrUpdateNode(
-          NodePosition(currentNode.pos.x + 1, currentNode.pos.y + 1),
-          currentNode,
-          sqrt2);
-      AddOrUpdateNode(
-          NodePosition(currentNode.pos.x + 1, currentNode.pos.y - 1),
-          currentNode,
-          sqrt2);
-      AddOrUpdateNode(
-          NodePosition(currentNode.pos.x - 1, currentNode.pos.y - 1),
-          currentNode,
-          sqrt2);
-      AddOrUpdateNode(
-          NodePosition(currentNode.pos.x - 1, currentNode.pos.y + 1),
-          currentNode,
-          sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x + 1, pos.y + 1), currentNode, sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x + 1, pos.y - 1), currentNode, sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x - 1, pos.y - 1), currentNode, sqrt2);
+      AddOrUpdateNode(NodePosition(pos.x - 1, pos.y + 1), currentNode, sqrt2);
     }
   }
 
   /**
-   * \brief Get (or dynamically construct) a node.
+   * Insert the jump points reachable from the current node in the open list.
    *
-   * *All* nodes should be created using this method: The cost of the node is
-   * computed thanks to the objects flagged as obstacles.
+   * Only the directions that can't be reached at the same cost without going
+   * through the current node are explored (see Jump).
    */
-  Node& GetNode(const NodePosition& pos) {
-    if (allNodes.find(pos) != allNodes.end()) return allNodes.find(pos)->second;
-
-    Node newNode(pos);
-
-    bool objectsOnCell = false;
-    const std::set<PathfindingObstacleRuntimeBehavior*>& allObstacles =
-        obstacles.GetAllObstacles();
-    for (std::set<PathfindingObstacleRuntimeBehavior*>::const_iterator it =
-             allObstacles.begin();
-         it != allObstacles.end();
-         ++it) {
-      RuntimeObject* obj = (*it)->GetObject();
-      int topLeftCellX =
-          floor((obj->GetDrawableX() - rightBorder) / (float)cellWidth);
-      int topLeftCellY =
-          floor((obj->GetDrawableY() - bottomBorder) / (float)cellHeight);
-      int bottomRightCellX =
-          ceil((obj->GetDrawableX() + obj->GetWidth() + leftBorder) /
-               (float)cellWidth);
-      int bottomRightCellY =
-          ceil((obj->GetDrawableY() + obj->GetHeight() + topBorder) /
-               (float)cellHeight);
-      if (topLeftCellX < pos.x && pos.x < bottomRightCellX &&
-          topLeftCellY < pos.y && pos.y < bottomRightCellY) {
-        objectsOnCell = true;
-        if ((*it)->IsImpassable()) {
-          newNode.cost = -1;
-          break;  // The cell is impassable, stop here.
-        } else    // Superimpose obstacles
-          newNode.cost += (*it)->GetCost();
+  void InsertJumpPoints(std::size_t currentNode) {
+    NodePosition pos = nodes[currentNode].pos;
+    std::size_t parent = nodes[currentNode].parent;
+    if (parent == noNode) {
+      for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx)
+          if (dx != 0 || dy != 0) InsertJumpPoint(currentNode, dx, dy);
+      return;
+    }
+
+    const NodePosition& parentPos = nodes[parent].pos;
+    int dx = (pos.x > parentPos.x) - (pos.x < parentPos.x);
+    int dy = (pos.y > parentPos.y) - (pos.y < parentPos.y);
+    if (dx != 0 && dy != 0) {
+      InsertJumpPoint(currentNode, dx, 0);
+      InsertJumpPoint(currentNode, 0, dy);
+      InsertJumpPoint(currentNode, dx, dy);
+      if (!IsWalkable(pos.x - dx, pos.y)) InsertJumpPoint(currentNode, -dx, dy);
+      if (!IsWalkable(pos.x, pos.y - dy)) InsertJumpPoint(currentNode, dx, -dy);
+    } else if (dx != 0) {
+      InsertJumpPoint(currentNode, dx, 0);
+      if (!IsWalkable(pos.x, pos.y + 1)) InsertJumpPoint(currentNode, dx, 1);
+      if (!IsWalkable(pos.x, pos.y - 1)) InsertJumpPoint(currentNode, dx, -1);
+    } else {
+      InsertJumpPoint(currentNode, 0, dy);
+      if (!IsWalkable(pos.x + 1, pos.y)) InsertJumpPoint(currentNode, 1, dy);
+      if (!IsWalkable(pos.x - 1, pos.y)) InsertJumpPoint(currentNode, -1, dy);
+    }
+  }
+
+  /**
+   * Look for a jump point from the current node in the given direction and
+   * insert it in the open list.
+   */
+  void InsertJumpPoint(std::size_t currentNode, int dx, int dy) {
+    NodePosition jumpPoint = nodes[currentNode].pos;
+    if (!Jump(jumpPoint, dx, dy)) return;
+
+    int distance = std::max(std::abs(jumpPoint.x - nodes[currentNode].pos.x),
+                            std::abs(jumpPoint.y - nodes[currentNode].pos.y));
+    AddOrUpdateNode(
+        jumpPoint, currentNode, dx != 0 && dy != 0 ? distance * sqrt2 : distance);
+  }
+
+  /**
+   * \brief Move from \a pos in the given direction until reaching the
+   * destination or a cell having a neighbor that can only be reached (at the
+   * smallest cost) through this cell.
+   *
+   * \return true if such a cell (a "jump point") was found, in which case
+   * \a pos is updated to its position.
+   */
+  bool Jump(NodePosition& pos, int dx, int dy) const {
+    int x = pos.x + dx;
+    int y = pos.y + dy;
+    for (; IsWalkable(x, y); x += dx, y += dy) {
+      bool isJumpPoint = x == destination.x && y == destination.y;
+      if (!isJumpPoint && dx != 0 && dy != 0) {
+        NodePosition horizontal(x, y), vertical(x, y);
+        isJumpPoint =
+            (IsWalkable(x - dx, y + dy) && !IsWalkable(x - dx, y)) ||
+            (IsWalkable(x + dx, y - dy) && !IsWalkable(x, y - dy)) ||
+            Jump(horizontal, dx, 0) || Jump(vertical, 0, dy);
+      } else if (!isJumpPoint && dx != 0) {
+        isJumpPoint = (IsWalkable(x + dx, y + 1) && !IsWalkable(x, y + 1)) ||
+                      (IsWalkable(x + dx, y - 1) && !IsWalkable(x, y - 1));
+      } else if (!isJumpPoint) {
+        isJumpPoint = (IsWalkable(x + 1, y + dy) && !IsWalkable(x + 1, y)) ||
+                      (IsWalkable(x - 1, y + dy) && !IsWalkable(x - 1, y));
+      }
+
+      if (isJumpPoint) {
+        pos = NodePosition(x, y);
+        return true;
       }
     }
 
-    if (!objectsOnCell)
-      newNode.cost = 1;  // Default cost when no objects put on the cell.
+    return false;
+  }
+
+  /**
+   * \brief Compute the cells that can be visited by jump point search.
+   *
+   * Outside of the obstacles, all the cells have the same cost, so a path
+   * never needs to go further than one cell around the obstacles, the start
+   * and the destination. Cells further than the maximum number of iterations
+   * from the start would not be visited by A* either.
+   */
+  void SetJumpBounds(const NodePosition& start, std::size_t maxIterationCount) {
+    jumpLeft = std::min(start.x, destination.x);
+    jumpTop = std::min(start.y, destination.y);
+    jumpRight = std::max(start.x, destination.x) + 1;
+    jumpBottom = std::max(start.y, destination.y) + 1;
+
+    int left, top, right, bottom;
+    if (costGrid->GetObstaclesBounds(left, top, right, bottom)) {
+      jumpLeft = std::min(jumpLeft, left);
+      jumpTop = std::min(jumpTop, top);
+      jumpRight = std::max(jumpRight, right);
+      jumpBottom = std::max(jumpBottom, bottom);
+    }
+
+    int maxDistance = static_cast<int>(std::min<std::size_t>(
+        maxIterationCount, std::numeric_limits<int>::max() / 4));
+    jumpLeft = std::max(jumpLeft - 1, start.x - maxDistance);
+    jumpTop = std::max(jumpTop - 1, start.y - maxDistance);
+    jumpRight = std::min(jumpRight + 1, start.x + maxDistance);
+    jumpBottom = std::min(jumpBottom + 1, start.y + maxDistance);
+
+    // Cells are read many times while jumping, so remember if they are
+    // walkable (if the bounds are not too large).
+    std::int64_t cellsCount = static_cast<std::int64_t>(jumpRight - jumpLeft) *
+                              (jumpBottom - jumpTop);
+    walkableCells.assign(cellsCount <= maxWalkableCellsCount ? cellsCount : 0,
+                         unknownCell);
+  }
+
+  bool IsWalkable(int x, int y) const {
+    if (x < jumpLeft || x >= jumpRight || y < jumpTop || y >= jumpBottom)
+      return false;
+    if (walkableCells.empty()) return costGrid->GetCost(x, y) >= 0;
+
+    std::uint8_t& cell =
+        walkableCells[static_cast<std::size_t>(y - jumpTop) *
+                          (jumpRight - jumpLeft) +
+                      (x - jumpLeft)];
+    if (cell == unknownCell)
+      cell = costGrid->GetCost(x, y) >= 0 ? walkableCell : notWalkableCell;
+    return cell == walkableCell;
+  }
+
+  /**
+   * \brief Get (or dynamically construct) a node and return its index.
+   *
+   * *All* nodes should be created using this method: The cost of the node is
+   * read from the grid of the costs of the obstacles.
+   */
+  std::size_t GetNode(const NodePosition& pos) {
+    std::size_t index = nodesIndex.FindOrInsert(pos, nodes.size());
+    if (index != nodes.size()) return index;
 
-    allNodes[pos] = newNode;
-    return allNodes[pos];
+    nodes.push_back(Node(pos));
+    nodes.back().cost = costGrid->GetCost(pos.x, pos.y);
+    return index;
   }
 
   /**
@@ -333,45 +556,120 @@ class SearchContext {
    * existing cost, if any).
    */
   void AddOrUpdateNode(const NodePosition& newNodePosition,
-                       const Node& currentNode,
+                       std::size_t currentNode,
                        float factor) {
-    Node& neighbor = GetNode(newNodePosition);
+    std::size_t neighborIndex = GetNode(newNodePosition);
+    Node& neighbor = nodes[neighborIndex];
     if (!neighbor.open ||
         neighbor.cost < 0)  // cost < 0 means impassable obstacle
       return;
 
     // Update the node costs and parent if the path coming from currentNode is
     // better:
-    if (neighbor.smallestCost == -1 ||
-        neighbor.smallestCost >
-            currentNode.smallestCost +
-                (currentNode.cost + neighbor.cost) / 2.0 * factor) {
-      if (neighbor.smallestCost != -1)  // The node is already in the open list:
-      {
-        // remove it as its estimate cost will be updated.
-        auto it = openNodes.find(&neighbor);
-        if (it !=
-            openNodes.end())  // /!\ ALWAYS use an iterator with multiset::erase
-          openNodes.erase(it);  // otherwise, other nodes which are equivalent
-                                // get removed too.
-      }
-
-      neighbor.smallestCost = currentNode.smallestCost +
-                              (currentNode.cost + neighbor.cost) / 2.0 * factor;
-      neighbor.parent = &currentNode;
+    double smallestCost =
+        nodes[currentNode].smallestCost +
+        (nodes[currentNode].cost + neighbor.cost) / 2.0 * factor;
+    if (neighbor.smallestCost == -1 || neighbor.smallestCost > smallestCost) {
+      neighbor.smallestCost = smallestCost;
+      neighbor.parent = currentNode;
       neighbor.estimateCost =
           neighbor.smallestCost + distanceFunction(neighbor.pos, destination);
 
-      openNodes.insert(&neighbor);
+      if (neighbor.heapIndex == noNode)
+        PushOpenNode(neighborIndex);
+      else
+        UpdateOpenNode(neighborIndex);
     }
   }
 
-  std::unordered_map<NodePosition, Node> allNodes;  ///< All the nodes
-  std::multiset<Node*, Node::NodeComparator>
-      openNodes;  ///< Only the open nodes (Such that Node::open == true)
-  const ScenePathfindingObstaclesManager&
-      obstacles;    ///< A reference to all the obstacles of the scene
-  Node* finalNode;  // If computation succeeded, the final node is stored here.
+  /**
+   * \brief Return true if the node \a a must be explored before the node \a b.
+   */
+  bool IsExploredBefore(std::size_t a, std::size_t b) const {
+    return nodes[a].estimateCost < nodes[b].estimateCost ||
+           (nodes[a].estimateCost == nodes[b].estimateCost &&
+            nodes[a].openOrder < nodes[b].openOrder);
+  }
+
+  void PushOpenNode(std::size_t node) {
+    nodes[node].openOrder = openOrderCount++;
+    nodes[node].heapIndex = openNodes.size();
+    openNodes.push_back(node);
+    SiftUp(nodes[node].heapIndex);
+  }
+
+  /**
+   * \brief Move a node in the open nodes after its estimate cost was changed.
+   */
+  void UpdateOpenNode(std::size_t node) {
+    nodes[node].openOrder = openOrderCount++;
+    SiftUp(nodes[node].heapIndex);
+    SiftDown(nodes[node].heapIndex);
+  }
+
+  std::size_t PopOpenNode() {
+    std::size_t node = openNodes.front();
+    nodes[node].heapIndex = noNode;
+    if (openNodes.size() > 1) {
+      openNodes.front() = openNodes.back();
+      nodes[openNodes.front()].heapIndex = 0;
+      openNodes.pop_back();
+      SiftDown(0);
+    } else {
+      openNodes.pop_back();
+    }
+
+    return node;
+  }
+
+  void SiftUp(std::size_t i) {
+    std::size_t node = openNodes[i];
+    while (i > 0) {
+      std::size_t parent = (i - 1) / 2;
+      if (!IsExploredBefore(node, openNodes[parent])) break;
+
+      openNodes[i] = openNodes[parent];
+      nodes[openNodes[i]].heapIndex = i;
+      i = parent;
+    }
+
+    openNodes[i] = node;
+    nodes[node].heapIndex = i;
+  }
+
+  void SiftDown(std::size_t i) {
+    std::size_t node = openNodes[i];
+    while (true) {
+      std::size_t child = 2 * i + 1;
+      if (child >= openNodes.size()) break;
+      if (child + 1 < openNodes.size() &&
+          IsExploredBefore(openNodes[child + 1], openNodes[child]))
+        child++;
+      if (!IsExploredBefore(openNodes[child], node)) break;
+
+      openNodes[i] = openNodes[child];
+      nodes[openNodes[i]].heapIndex = i;
+      i = child;
+    }
+
+    openNodes[i] = node;
+    nodes[node].heapIndex = i;
+  }
+
+  std::vector<Node>& nodes;  ///< All the nodes
+  NodesIndex& nodesIndex;    ///< The index of the nodes, by position.
+  std::vector<std::size_t>&
+      openNodes;  ///< Only the open nodes (Such that Node::open == true),
+                  ///< stored as a binary heap.
+  std::vector<std::uint8_t>&
+      walkableCells;  ///< The cells already read by jump point search (see
+                      ///< IsWalkable).
+  ScenePathfindingObstaclesManager&
+      obstacles;  ///< A reference to all the obstacles of the scene
+  const ObstaclesCostGrid*
+      costGrid;  ///< The costs of the cells, for the current search.
+  std::size_t finalNode;  ///< If computation succeeded, the index of the final
+                          ///< node is stored here.
   NodePosition destination;
   int startX;  ///< The start X position, in "world" coordinates (not in "node"
                ///< coordinates!).
@@ -379,7 +677,13 @@ class SearchContext {
                ///< coordinates!).
   DistanceFunPtr distanceFunction;
   bool allowsDiagonal;  ///< True to allow diagonals when planning the path.
+  bool useJumpPointSearch;
+  int jumpLeft;    ///< The cells visited by jump point search, from jumpLeft
+  int jumpTop;     ///< to jumpRight - 1 and jumpTop to jumpBottom - 1.
+  int jumpRight;
+  int jumpBottom;
   std::size_t maxComplexityFactor;
+  std::size_t openOrderCount;
   float cellWidth;
   float cellHeight;
   float leftBorder;
@@ -388,9 +692,12 @@ class SearchContext {
   float bottomBorder;
 
   static const float sqrt2;
+  static const std::int64_t maxWalkableCellsCount;
+  enum { unknownCell = 0, walkableCell, notWalkableCell };
 };
 
 const float SearchContext::sqrt2 = 1.414213562;
+const std::int64_t SearchContext::maxWalkableCellsCount = 4 * 1024 * 1024;
 
 }  // namespace
 
@@ -409,6 +716,7 @@ PathfindingRuntimeBehavior::PathfindingRuntimeBehavior(
       cellWidth(20),
       cellHeight(20),
       extraBorder(0),
+      useJumpPointSearch(false),
       speed(0),
       angularSpeed(0),
       timeOnSegment(0),
@@ -458,7 +766,12 @@ void PathfindingRuntimeBehavior::MoveTo(RuntimeScene& scene, float x, float y) {
 
   // Start searching for a path
   // TODO: Customizable heuristic.
-  ::SearchContext ctx(*sceneManager, allowDiagonals);
+  std::shared_ptr<PathfindingSearchStorage>& searchStorage =
+      sceneManager->GetSearchStorage();
+  if (!searchStorage)
+    searchStorage = std::make_shared<PathfindingSearchStorage>();
+
+  ::SearchContext ctx(*sceneManager, *searchStorage, allowDiagonals);
   ctx.SetCellSize(cellWidth, cellHeight)
       .SetStartPosition(object->GetX(), object->GetY());
   ctx.SetObjectSize(object->GetX() - object->GetDrawableX() + extraBorder,
@@ -468,16 +781,10 @@ void PathfindingRuntimeBehavior::MoveTo(RuntimeScene& scene, float x, float y) {
                     object->GetHeight() -
                         (object->GetY() - object->GetDrawableY()) +
                         extraBorder);
+  ctx.SetUseJumpPointSearch(useJumpPointSearch);
   if (ctx.ComputePathTo(x, y)) {
     // Path found: memorize it
-    const ::Node* node = ctx.GetFinalNode();
-    while (node) {
-      path.push_back(sf::Vector2f(node->pos.x * (float)cellWidth,
-                                  node->pos.y * (float)cellHeight));
-      node = node->parent;
-    }
-
-    std::reverse(path.begin(), path.end());
+    ctx.GetPath(path);
     path[0] = sf::Vector2f(object->GetX(), object->GetY());
     EnterSegment(0);
     pathFound = true;
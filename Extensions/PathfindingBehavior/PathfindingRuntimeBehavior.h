@@ -68,6 +68,7 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   unsigned int GetCellWidth() { return cellWidth; };
   unsigned int GetCellHeight() { return cellHeight; };
   float GetExtraBorder() { return extraBorder; };
+  bool IsJumpPointSearchUsed() { return useJumpPointSearch; };
 
   void SetAllowDiagonals(bool allowDiagonals_) {
     allowDiagonals = allowDiagonals_;
@@ -83,6 +84,17 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   void SetCellHeight(unsigned int cellHeight_) { cellHeight = cellHeight_; };
   void SetExtraBorder(float extraBorder_) { extraBorder = extraBorder_; };
 
+  /**
+   * \brief Use jump point search to compute the paths, when diagonals are
+   * allowed and all the obstacles are impassable.
+   *
+   * Paths have the same length as with the default search, but only contain
+   * the nodes where the direction changes.
+   */
+  void SetUseJumpPointSearch(bool useJumpPointSearch_) {
+    useJumpPointSearch = useJumpPointSearch_;
+  };
+
   float GetSpeed() { return speed; };
   void SetSpeed(float speed_) { speed = speed_; };
 
@@ -109,6 +121,7 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   unsigned int cellWidth;
   unsigned int cellHeight;
   float extraBorder;
+  bool useJumpPointSearch;
 
   // Attributes used for traveling on the path:
   float speed;
@@ -5,11 +5,13 @@ Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
 This project is released under the MIT License.
 */
 #include "ScenePathfindingObstaclesManager.h"
+#include <algorithm>
 #include <iostream>
 #include "PathfindingObstacleRuntimeBehavior.h"
 
 std::map<RuntimeScene*, ScenePathfindingObstaclesManager>
     ScenePathfindingObstaclesManager::managers;
+const std::size_t ScenePathfindingObstaclesManager::maxCostGridsCount = 8;
 
 ScenePathfindingObstaclesManager::~ScenePathfindingObstaclesManager() {
   for (std::set<PathfindingObstacleRuntimeBehavior*>::iterator it =
@@ -23,8 +25,38 @@ ScenePathfindingObstaclesManager::~ScenePathfindingObstaclesManager() {
 void ScenePathfindingObstaclesManager::AddObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
   allObstacles.insert(obstacle);
+  for (auto& costGrid : costGrids) costGrid->InvalidateObstacle(obstacle);
 }
 void ScenePathfindingObstaclesManager::RemoveObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
   allObstacles.erase(obstacle);
+  for (auto& costGrid : costGrids) costGrid->RemoveObstacle(obstacle);
+}
+void ScenePathfindingObstaclesManager::InvalidateObstacle(
+    PathfindingObstacleRuntimeBehavior* obstacle) {
+  if (allObstacles.find(obstacle) == allObstacles.end()) return;
+  for (auto& costGrid : costGrids) costGrid->InvalidateObstacle(obstacle);
+}
+
+const ObstaclesCostGrid& ScenePathfindingObstaclesManager::GetCostGrid(
+    const ObstaclesCostGrid::Settings& settings) {
+  auto it = std::find_if(costGrids.begin(),
+                         costGrids.end(),
+                         [&settings](const std::unique_ptr<ObstaclesCostGrid>&
+                                         costGrid) {
+                           return costGrid->GetSettings() == settings;
+                         });
+  if (it != costGrids.end()) {
+    std::rotate(costGrids.begin(), it, it + 1);
+  } else {
+    if (costGrids.size() >= maxCostGridsCount) costGrids.pop_back();
+    costGrids.insert(costGrids.begin(),
+                     std::unique_ptr<ObstaclesCostGrid>(
+                         new ObstaclesCostGrid(settings)));
+    for (PathfindingObstacleRuntimeBehavior* obstacle : allObstacles)
+      costGrids.front()->InvalidateObstacle(obstacle);
+  }
+
+  costGrids.front()->Update();
+  return *costGrids.front();
 }
@@ -7,15 +7,19 @@ This project is released under the MIT License.
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
 #include <map>
+#include <memory>
 #include <set>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "ObstaclesCostGrid.h"
 class PathfindingObstacleRuntimeBehavior;
+class PathfindingSearchStorage;
 
 /**
  * \brief Contains lists of all obstacle related objects of a scene.
  *
- * \note Could be drastically improved by using spatial hashing (see JS
- * implementation).
+ * The obstacles are also added to the grids of costs used by the last path
+ * searches (see GetCostGrid).
  */
 class ScenePathfindingObstaclesManager {
  public:
@@ -40,6 +44,13 @@ class ScenePathfindingObstaclesManager {
    */
   void RemoveObstacle(PathfindingObstacleRuntimeBehavior* obstacle);
 
+  /**
+   * \brief Notify the manager that an obstacle was moved, resized or changed,
+   * so that it's added again to the grids of costs.
+   * \param obstacle The changed obstacle
+   */
+  void InvalidateObstacle(PathfindingObstacleRuntimeBehavior* obstacle);
+
   /**
    * \brief Get a read only access to the list of all obstacles
    */
@@ -47,9 +58,37 @@ class ScenePathfindingObstaclesManager {
     return allObstacles;
   }
 
+  /**
+   * \brief Get the grid of the costs of moving on the cells, for the given
+   * cell size and object size.
+   *
+   * The grid is kept so that only the obstacles that were added or changed
+   * since the last call (see InvalidateObstacle) are added again to the
+   * grid.
+   */
+  const ObstaclesCostGrid& GetCostGrid(
+      const ObstaclesCostGrid::Settings& settings);
+
+  /**
+   * \brief Get the memory used by the path searches of the scene (nodes and
+   * open nodes), kept so that it's reused by the next searches.
+   *
+   * It's created by PathfindingRuntimeBehavior on its first search.
+   */
+  std::shared_ptr<PathfindingSearchStorage>& GetSearchStorage() {
+    return searchStorage;
+  }
+
  private:
   std::set<PathfindingObstacleRuntimeBehavior*>
       allObstacles;  ///< The list of all obstacles of the scene.
+  std::vector<std::unique_ptr<ObstaclesCostGrid>>
+      costGrids;  ///< The grids used by the last searches, the most recently
+                  ///< used first.
+  std::shared_ptr<PathfindingSearchStorage>
+      searchStorage;  ///< The memory used by the path searches.
+
+  static const std::size_t maxCostGridsCount;
 };
 
 #endif
@@ -8,6 +8,9 @@ This project is released under the MIT License.
  * @file Tests for the Pathfinding extension.
  */
 #define CATCH_CONFIG_MAIN
+#include <chrono>
+#include <iostream>
+#include <random>
 #include "../PathfindingBehavior.h"
 #include "../PathfindingObstacleBehavior.h"
 #include "../PathfindingObstacleRuntimeBehavior.h"
@@ -46,6 +49,17 @@ std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
   behavior.InitializeContent(behaviorContent);
   return std::move(gd::make_unique<TRuntimeBehavior>(behaviorContent));
 };
+
+float GetPathLength(const PathfindingRuntimeBehavior &behavior) {
+  float length = 0;
+  for (std::size_t i = 1; i < behavior.GetNodeCount(); ++i) {
+    float dx = behavior.GetNodeX(i) - behavior.GetNodeX(i - 1);
+    float dy = behavior.GetNodeY(i) - behavior.GetNodeY(i - 1);
+    length += sqrt(dx * dx + dy * dy);
+  }
+
+  return length;
+}
 }  // namespace
 
 TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
@@ -233,4 +247,207 @@ TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
     REQUIRE(runtimeBehavior->GetNodeX(4) == 20);
     REQUIRE(runtimeBehavior->GetNodeY(4) == 80);
   }
+  SECTION("Obstacles moved, changed or removed") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    PathfindingObstacleRuntimeBehavior *obstacleBehavior =
+        static_cast<PathfindingObstacleRuntimeBehavior *>(
+            obstacle->GetBehaviorRawPointer("PathfindingObstacle"));
+
+    // The destination is inside the obstacle.
+    obstacle->SetX(1100);
+    obstacle->SetY(1200);
+    obstacle->SetWidth(200);
+    obstacle->SetHeight(200);
+    scene.RenderAndStep();
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    // Moving the obstacle is taken into account from the next frame.
+    obstacle->SetX(1400);
+    scene.RenderAndStep();
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 66);
+
+    obstacle->SetX(1100);
+    scene.RenderAndStep();
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    // Changing the obstacle is taken into account, even without a new frame.
+    obstacleBehavior->SetImpassable(false);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+
+    // Obstacles covering a lot of cells are also taken into account.
+    obstacleBehavior->SetImpassable(true);
+    obstacle->SetX(1000);
+    obstacle->SetY(1000);
+    obstacle->SetWidth(2000);
+    obstacle->SetHeight(2000);
+    scene.RenderAndStep();
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+    runtimeBehavior->MoveTo(scene, 900, 900);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+
+    // Removed obstacles are not taken into account anymore.
+    obstacle->DeleteFromScene(scene);
+    scene.RenderAndStep();
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+  }
+  SECTION("Jump point search") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    PathfindingObstacleRuntimeBehavior *obstacleBehavior =
+        static_cast<PathfindingObstacleRuntimeBehavior *>(
+            obstacle->GetBehaviorRawPointer("PathfindingObstacle"));
+
+    obstacle->SetX(300);
+    obstacle->SetY(600);
+    obstacle->SetWidth(600);
+    obstacle->SetHeight(32);
+    scene.RenderAndStep();
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 77);
+    float pathLength = GetPathLength(*runtimeBehavior);
+
+    // The path has the same length, but only the nodes where the direction
+    // changes are kept.
+    runtimeBehavior->SetUseJumpPointSearch(true);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 6);
+    REQUIRE(runtimeBehavior->GetNodeX(5) == 1200);
+    REQUIRE(runtimeBehavior->GetNodeY(5) == 1300);
+    REQUIRE(GetPathLength(*runtimeBehavior) == Approx(pathLength));
+
+    // The destination is inside the obstacle.
+    runtimeBehavior->MoveTo(scene, 600, 620);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    // Obstacles with a cost are not supported by jump point search: the
+    // usual search is done.
+    obstacleBehavior->SetImpassable(false);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 66);
+  }
+}
+
+TEST_CASE("PathfindingRuntimeBehavior - Benchmarks",
+          "[game-engine][pathfinding]") {
+  auto benchmark = [](std::size_t obstaclesCount,
+                      std::size_t searchesCount,
+                      bool useJumpPointSearch) {
+    RuntimeGame game;
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+    RuntimeScene scene(NULL, &game);
+
+    // Obstacles are spread so that the density stays the same whatever the
+    // number of obstacles.
+    std::mt19937 generator(42);
+    float mapSize = 120 * sqrt(obstaclesCount);
+    std::uniform_real_distribution<float> position(0, mapSize);
+    for (std::size_t i = 0; i < obstaclesCount; ++i) {
+      auto *obstacle =
+          scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+              new ResizableRuntimeObject(scene, obstacleObj)));
+      obstacle->AddBehavior(
+          "PathfindingObstacle",
+          CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                   PathfindingObstacleBehavior>());
+      obstacle->SetX(position(generator));
+      obstacle->SetY(position(generator));
+      obstacle->SetWidth(40);
+      obstacle->SetHeight(40);
+    }
+
+    std::vector<PathfindingRuntimeBehavior *> agents;
+    for (std::size_t i = 0; i < searchesCount; ++i) {
+      auto *player = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+      player->AddBehavior("Pathfinding",
+                          CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                   PathfindingBehavior>());
+      player->SetX(position(generator));
+      player->SetY(position(generator));
+      agents.push_back(static_cast<PathfindingRuntimeBehavior *>(
+          player->GetBehaviorRawPointer("Pathfinding")));
+      agents.back()->SetUseJumpPointSearch(useJumpPointSearch);
+    }
+    scene.RenderAndStep();
+
+    std::size_t pathsFound = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (PathfindingRuntimeBehavior *agent : agents) {
+      agent->MoveTo(scene, position(generator), position(generator));
+      if (agent->PathFound()) pathsFound++;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << searchesCount << " path searches among " << obstaclesCount
+              << " obstacles (" << pathsFound << " paths found"
+              << (useJumpPointSearch ? ", jump point search" : "")
+              << ") benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  benchmark(100, 40, false);
+  benchmark(1000, 40, false);
+  benchmark(3000, 40, false);
+  benchmark(100, 40, true);
+  benchmark(1000, 40, true);
+  benchmark(3000, 40, true);
 }
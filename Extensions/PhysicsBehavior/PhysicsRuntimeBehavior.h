@@ -139,9 +139,8 @@ class GD_EXTENSION_API PhysicsRuntimeBehavior : public RuntimeBehavior {
       char32_t coordsSep = U'\n',
       char32_t composantSep = U';');
 
-  bool CollisionWith(
-      std::map<gd::String, std::vector<RuntimeObject *> *> otherObjectsLists,
-      RuntimeScene &scene);
+  bool CollisionWith(const RuntimeObjectsLists &otherObjectsLists,
+                     RuntimeScene &scene);
 
  private:
   virtual void DoStepPreEvents(RuntimeScene &scene);
@@ -23,7 +23,11 @@ PlatformRuntimeBehavior::PlatformRuntimeBehavior(
       registeredInManager(false),
       platformType(NormalPlatform),
       canBeGrabbed(true),
-      yGrabOffset(0) {
+      yGrabOffset(0),
+      oldCenterX(0),
+      oldCenterY(0),
+      oldWidth(0),
+      oldHeight(0) {
   gd::String platformTypeStr =
       behaviorContent.GetStringAttribute("platformType");
   platformType =
@@ -59,9 +63,33 @@ void PlatformRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       registeredInManager = true;
     }
   }
+
+  UpdateInManager();
+}
+
+void PlatformRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
+  // The object can have been moved by the events: update it now so that the
+  // platformer objects find it at its new position in the next frame.
+  UpdateInManager();
 }
 
-void PlatformRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {}
+void PlatformRuntimeBehavior::UpdateInManager() {
+  if (!sceneManager || !registeredInManager) return;
+
+  float centerX = object->GetDrawableX() + object->GetCenterX();
+  float centerY = object->GetDrawableY() + object->GetCenterY();
+  float width = object->GetWidth();
+  float height = object->GetHeight();
+  if (centerX == oldCenterX && centerY == oldCenterY && width == oldWidth &&
+      height == oldHeight)
+    return;
+
+  oldCenterX = centerX;
+  oldCenterY = centerY;
+  oldWidth = width;
+  oldHeight = height;
+  sceneManager->UpdatePlatform(this);
+}
 
 void PlatformRuntimeBehavior::ChangePlatformType(
     const gd::String& platformType_) {
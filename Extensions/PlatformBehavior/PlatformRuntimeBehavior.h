@@ -65,6 +65,12 @@ class GD_EXTENSION_API PlatformRuntimeBehavior : public RuntimeBehavior {
   virtual void DoStepPreEvents(RuntimeScene& scene);
   virtual void DoStepPostEvents(RuntimeScene& scene);
 
+  /**
+   * \brief Notify the scene manager if the object was moved or resized since
+   * the last call.
+   */
+  void UpdateInManager();
+
   RuntimeScene* parentScene;  ///< The scene the object belongs to.
   ScenePlatformObjectsManager*
       sceneManager;  ///< The platform objects manager associated to the scene.
@@ -74,6 +80,12 @@ class GD_EXTENSION_API PlatformRuntimeBehavior : public RuntimeBehavior {
   bool canBeGrabbed;  ///< True if the platform ledges can be grabbed by
                       ///< platformer objects.
   double yGrabOffset;
+
+  // Object position and size tracking:
+  float oldCenterX;  ///< The center of the object, when last updated in
+  float oldCenterY;  ///< the scene manager.
+  float oldWidth;
+  float oldHeight;
 };
 
 #endif  // PLATFORMRUNTIMEBEHAVIOR_H
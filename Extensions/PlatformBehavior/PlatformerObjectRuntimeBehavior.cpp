@@ -108,6 +108,9 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
 
   if (!sceneManager) return;
 
+  // Done by the first platformer object of the frame only.
+  sceneManager->UpdateAllPlatforms();
+
   double timeDelta =
       static_cast<double>(object->GetElapsedTime(scene)) / 1000000.0;
 
@@ -139,21 +142,22 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   requestedDeltaX += currentSpeed * timeDelta;
 
   // Compute the list of the objects that will be used
-  std::set<PlatformRuntimeBehavior*> potentialObjects =
-      GetPotentialCollidingObjects(std::max(requestedDeltaX, maxFallingSpeed));
-  std::set<PlatformRuntimeBehavior*> overlappedJumpThru =
-      GetJumpthruCollidingWith(potentialObjects);
+  GetPotentialCollidingObjects(std::max(requestedDeltaX, maxFallingSpeed),
+                               potentialObjects);
+  GetJumpthruCollidingWith(potentialObjects, overlappedJumpThru);
 
   // Check that the floor object still exists and is near the object.
-  if (isOnFloor &&
-      potentialObjects.find(floorPlatform) == potentialObjects.end()) {
+  if (isOnFloor && !std::binary_search(potentialObjects.begin(),
+                                       potentialObjects.end(),
+                                       floorPlatform)) {
     isOnFloor = false;
     floorPlatform = NULL;
   }
 
   // Check that the grabbed platform object still exists and is near the object.
-  if (isGrabbingPlatform &&
-      potentialObjects.find(grabbedPlatform) == potentialObjects.end()) {
+  if (isGrabbingPlatform && !std::binary_search(potentialObjects.begin(),
+                                                potentialObjects.end(),
+                                                grabbedPlatform)) {
     ReleaseGrabbedPlatform();
   }
 
@@ -271,10 +275,9 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
 
     object->SetX(object->GetX() +
                  (requestedDeltaX > 0 ? xGrabTolerance : -xGrabTolerance));
-    auto collidingObjects =
-        GetPlatformsCollidingWith(potentialObjects, overlappedJumpThru);
-    if (!collidingObjects.empty() &&
-        CanGrab(*collidingObjects.begin(), requestedDeltaY)) {
+    PlatformRuntimeBehavior* collidingPlatform =
+        GetFirstPlatformCollidingWith(potentialObjects, overlappedJumpThru);
+    if (collidingPlatform && CanGrab(collidingPlatform, requestedDeltaY)) {
       tryGrabbingPlatform = true;
     }
     object->SetX(object->GetX() +
@@ -283,7 +286,6 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
     // Check if we can grab the collided platform
     if (tryGrabbingPlatform) {
       double oldY = object->GetY();
-      PlatformRuntimeBehavior* collidingPlatform = *collidingObjects.begin();
       object->SetY(collidingPlatform->GetObject()->GetY() +
                    collidingPlatform->GetYGrabOffset() - yGrabOffset);
       if (!IsCollidingWith(potentialObjects, NULL, /*excludeJumpthrus=*/true)) {
@@ -433,7 +435,7 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   }
 
   // 3) Update the current floor data for the next tick:
-  overlappedJumpThru = GetJumpthruCollidingWith(potentialObjects);
+  GetJumpthruCollidingWith(potentialObjects, overlappedJumpThru);
   if (!isOnLadder) {
     // Check if the object is on a floor:
     // In priority, check if the last floor platform is still the floor.
@@ -452,16 +454,18 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       bool canLand = requestedDeltaY >= 0;
 
       // Check if landing on a new floor: (Exclude already overlapped jump thru)
-      std::set<PlatformRuntimeBehavior*> collidingObjects =
-          GetPlatformsCollidingWith(potentialObjects, overlappedJumpThru);
-      if (canLand && !collidingObjects.empty()) {  // Just landed on floor
+      PlatformRuntimeBehavior* collidingPlatform =
+          canLand ? GetFirstPlatformCollidingWith(potentialObjects,
+                                                  overlappedJumpThru)
+                  : NULL;
+      if (collidingPlatform) {  // Just landed on floor
         isOnFloor = true;
         canJump = true;
         jumping = false;
         currentJumpSpeed = 0;
         currentFallSpeed = 0;
 
-        floorPlatform = *collidingObjects.begin();
+        floorPlatform = collidingPlatform;
         floorLastX = floorPlatform->GetObject()->GetX();
         floorLastY = floorPlatform->GetObject()->GetY();
 
@@ -509,57 +513,53 @@ void PlatformerObjectRuntimeBehavior::ReleaseGrabbedPlatform() {
 }
 
 bool PlatformerObjectRuntimeBehavior::SeparateFromPlatforms(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
     bool excludeJumpThrus) {
-  std::vector<RuntimeObject*> objects;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
-       it != candidates.end();
-       ++it) {
-    if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
+  platformsObjects.clear();
+  for (PlatformRuntimeBehavior* platform : candidates) {
+    if (platform->GetPlatformType() == PlatformRuntimeBehavior::Ladder)
+      continue;
     if (excludeJumpThrus &&
-        (*it)->GetPlatformType() == PlatformRuntimeBehavior::Jumpthru)
+        platform->GetPlatformType() == PlatformRuntimeBehavior::Jumpthru)
       continue;
 
-    objects.push_back((*it)->GetObject());
+    platformsObjects.push_back(platform->GetObject());
   }
 
-  return object->SeparateFromObjects(objects, ignoreTouchingEdges);
+  return object->SeparateFromObjects(platformsObjects, ignoreTouchingEdges);
 }
 
-std::set<PlatformRuntimeBehavior*>
-PlatformerObjectRuntimeBehavior::GetPlatformsCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
-    const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes) {
-  // TODO: This function could be refactored to return only the first colliding
-  // platform.
-  std::set<PlatformRuntimeBehavior*> result;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
-       it != candidates.end();
-       ++it) {
-    if (exceptTheseOnes.find(*it) != exceptTheseOnes.end()) continue;
-    if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
-
-    if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
-      result.insert(*it);
+PlatformRuntimeBehavior*
+PlatformerObjectRuntimeBehavior::GetFirstPlatformCollidingWith(
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes) {
+  for (PlatformRuntimeBehavior* platform : candidates) {
+    if (std::binary_search(
+            exceptTheseOnes.begin(), exceptTheseOnes.end(), platform))
+      continue;
+    if (platform->GetPlatformType() == PlatformRuntimeBehavior::Ladder)
+      continue;
+
+    if (object->IsCollidingWith(platform->GetObject(), ignoreTouchingEdges))
+      return platform;
   }
 
-  return result;
+  return NULL;
 }
 
 bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
     PlatformRuntimeBehavior* exceptThisOne,
     bool excludeJumpThrus) {
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
-       it != candidates.end();
-       ++it) {
-    if (*it == exceptThisOne) continue;
-    if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
+  for (PlatformRuntimeBehavior* platform : candidates) {
+    if (platform == exceptThisOne) continue;
+    if (platform->GetPlatformType() == PlatformRuntimeBehavior::Ladder)
+      continue;
     if (excludeJumpThrus &&
-        (*it)->GetPlatformType() == PlatformRuntimeBehavior::Jumpthru)
+        platform->GetPlatformType() == PlatformRuntimeBehavior::Jumpthru)
       continue;
 
-    if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
+    if (object->IsCollidingWith(platform->GetObject(), ignoreTouchingEdges))
       return true;
   }
 
@@ -567,53 +567,38 @@ bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
 }
 
 bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
-    const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes) {
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
-       it != candidates.end();
-       ++it) {
-    if (exceptTheseOnes.find(*it) != exceptTheseOnes.end()) continue;
-    if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
-
-    if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
-      return true;
-  }
-
-  return false;
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes) {
+  return GetFirstPlatformCollidingWith(candidates, exceptTheseOnes) != NULL;
 }
 
-std::set<PlatformRuntimeBehavior*>
-PlatformerObjectRuntimeBehavior::GetJumpthruCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates) {
-  std::set<PlatformRuntimeBehavior*> result;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
-       it != candidates.end();
-       ++it) {
-    if ((*it)->GetPlatformType() != PlatformRuntimeBehavior::Jumpthru) continue;
-
-    if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
-      result.insert(*it);
-  }
+void PlatformerObjectRuntimeBehavior::GetJumpthruCollidingWith(
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    std::vector<PlatformRuntimeBehavior*>& result) {
+  result.clear();
+  for (PlatformRuntimeBehavior* platform : candidates) {
+    if (platform->GetPlatformType() != PlatformRuntimeBehavior::Jumpthru)
+      continue;
 
-  return result;
+    if (object->IsCollidingWith(platform->GetObject(), ignoreTouchingEdges))
+      result.push_back(platform);
+  }
 }
 
 bool PlatformerObjectRuntimeBehavior::IsOverlappingLadder(
-    const std::set<PlatformRuntimeBehavior*>& candidates) {
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
-       it != candidates.end();
-       ++it) {
-    if ((*it)->GetPlatformType() != PlatformRuntimeBehavior::Ladder) continue;
-    if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
+    const std::vector<PlatformRuntimeBehavior*>& candidates) {
+  for (PlatformRuntimeBehavior* platform : candidates) {
+    if (platform->GetPlatformType() != PlatformRuntimeBehavior::Ladder)
+      continue;
+    if (object->IsCollidingWith(platform->GetObject(), ignoreTouchingEdges))
       return true;
   }
 
   return false;
 }
 
-std::set<PlatformRuntimeBehavior*>
-PlatformerObjectRuntimeBehavior::GetPotentialCollidingObjects(
-    double maxMovementLength) {
+void PlatformerObjectRuntimeBehavior::GetPotentialCollidingObjects(
+    double maxMovementLength, std::vector<PlatformRuntimeBehavior*>& result) {
   // Compute the "bounding circle" radius of the object.
   float o1w = object->GetWidth();
   float o1h = object->GetHeight();
@@ -621,28 +606,31 @@ PlatformerObjectRuntimeBehavior::GetPotentialCollidingObjects(
       sqrt(o1w * o1w + o1h * o1h) / 2.0 +
       maxMovementLength / 2.0;  // Add to it the maximum magnitude of movement.
 
-  std::set<PlatformRuntimeBehavior*> potentialObjects;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it =
-           sceneManager->GetAllPlatforms().begin();
-       it != sceneManager->GetAllPlatforms().end();
-       ++it) {
+  // Only test the platforms which bounding circles could be overlapping.
+  float obj1X = object->GetDrawableX() + object->GetCenterX();
+  float obj1Y = object->GetDrawableY() + object->GetCenterY();
+  sceneManager->GetPlatformsNear(obj1X - obj1BoundingRadius,
+                                 obj1Y - obj1BoundingRadius,
+                                 obj1X + obj1BoundingRadius,
+                                 obj1Y + obj1BoundingRadius,
+                                 result);
+
+  // Removing the platforms that are too far keeps the others sorted.
+  auto isTooFar = [obj1X, obj1Y, obj1BoundingRadius](
+      PlatformRuntimeBehavior* platform) {
     // First check if bounding circle are too far.
-    RuntimeObject* obj2 = (*it)->GetObject();
+    RuntimeObject* obj2 = platform->GetObject();
     float o2w = obj2->GetWidth();
     float o2h = obj2->GetHeight();
 
-    float x = object->GetDrawableX() + object->GetCenterX() -
-              (obj2->GetDrawableX() + obj2->GetCenterX());
-    float y = object->GetDrawableY() + object->GetCenterY() -
-              (obj2->GetDrawableY() + obj2->GetCenterY());
+    float x = obj1X - (obj2->GetDrawableX() + obj2->GetCenterX());
+    float y = obj1Y - (obj2->GetDrawableY() + obj2->GetCenterY());
     float obj2BoundingRadius = sqrt(o2w * o2w + o2h * o2h) / 2.0;
 
-    if (sqrt(x * x + y * y) <= obj1BoundingRadius + obj2BoundingRadius) {
-      potentialObjects.insert(*it);
-    }
-  }
-
-  return potentialObjects;
+    return !(sqrt(x * x + y * y) <= obj1BoundingRadius + obj2BoundingRadius);
+  };
+  result.erase(std::remove_if(result.begin(), result.end(), isTooFar),
+               result.end());
 }
 
 void PlatformerObjectRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
@@ -653,6 +641,9 @@ void PlatformerObjectRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
         parentScene ? &ScenePlatformObjectsManager::managers[&scene] : NULL;
     floorPlatform = NULL;
   }
+
+  // Platforms can be moved until the platformer objects are stepped again.
+  if (sceneManager) sceneManager->InvalidatePlatforms();
 }
 
 void PlatformerObjectRuntimeBehavior::SimulateControl(const gd::String& input) {
@@ -9,7 +9,7 @@ This project is released under the MIT License.
 #define PLATFORMEROBJECTRUNTIMEBEHAVIOR_H
 #include <SFML/System/Vector2.hpp>
 #include <map>
-#include <set>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 namespace gd {
@@ -90,13 +90,13 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
   virtual void DoStepPostEvents(RuntimeScene& scene);
 
   /**
-   * \brief Return a list of all the platforms that could be colliding with the
-   * object if it is moved. \param maxMovementLength The maximum length of any
-   * movement that could be done by the object, in pixels. \warning sceneManager
-   * must be valid and not NULL.
+   * \brief Fill \a result with all the platforms that could be colliding with
+   * the object if it is moved, sorted by address. \param maxMovementLength The
+   * maximum length of any movement that could be done by the object, in
+   * pixels. \warning sceneManager must be valid and not NULL.
    */
-  std::set<PlatformRuntimeBehavior*> GetPotentialCollidingObjects(
-      double maxMovementLength);
+  void GetPotentialCollidingObjects(
+      double maxMovementLength, std::vector<PlatformRuntimeBehavior*>& result);
 
   /**
    * \brief Separate the object from all platforms passed as parameter, except
@@ -104,18 +104,19 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * excludeJumpThrus If set to true, the jump thru platform will be excluded.
    */
   bool SeparateFromPlatforms(
-      const std::set<PlatformRuntimeBehavior*>& candidates,
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
       bool excludeJumpThrus);
 
   /**
-   * \brief Among the platforms passed in parameter, return a list of the
-   * platforms colliding with the object. \note Ladders are *always* excluded
-   * from the test. \param candidates The platform to be tested for collision
-   * \param exceptTheseOnes The platforms to be excluded from the test
+   * \brief Among the platforms passed in parameter, return the first platform
+   * (in the order of \a candidates) colliding with the object, or NULL if
+   * there is none. \note Ladders are *always* excluded from the test. \param
+   * candidates The platform to be tested for collision \param exceptTheseOnes
+   * The platforms to be excluded from the test, sorted by address.
    */
-  std::set<PlatformRuntimeBehavior*> GetPlatformsCollidingWith(
-      const std::set<PlatformRuntimeBehavior*>& candidates,
-      const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes);
+  PlatformRuntimeBehavior* GetFirstPlatformCollidingWith(
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes);
 
   /**
    * \brief Among the platforms passed in parameter, return true if there is a
@@ -125,7 +126,7 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * collision. \param excludeJumpThrus If set to true, the jump thru platform
    * will be excluded.
    */
-  bool IsCollidingWith(const std::set<PlatformRuntimeBehavior*>& candidates,
+  bool IsCollidingWith(const std::vector<PlatformRuntimeBehavior*>& candidates,
                        PlatformRuntimeBehavior* exceptThisOne = NULL,
                        bool excludeJumpThrus = false);
 
@@ -133,11 +134,12 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * \brief Among the platforms passed in parameter, return true if there is a
    * platform colliding with the object. \note Ladders are *always* excluded
    * from the test. \param candidates The platforms to be tested for collision
-   * \param exceptTheseOnes The platforms to be excluded from the test
+   * \param exceptTheseOnes The platforms to be excluded from the test, sorted
+   * by address.
    */
   bool IsCollidingWith(
-      const std::set<PlatformRuntimeBehavior*>& candidates,
-      const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes);
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes);
 
   /**
    * \brief Among the platforms passed in parameter, return true if the object
@@ -145,15 +147,16 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * collision
    */
   bool IsOverlappingLadder(
-      const std::set<PlatformRuntimeBehavior*>& candidates);
+      const std::vector<PlatformRuntimeBehavior*>& candidates);
 
   /**
-   * \brief Among the platforms passed in parameter, return a list of the jump
-   * thru platforms colliding with the object. \param candidates The platform to
-   * be tested for collision
+   * \brief Among the platforms passed in parameter, fill \a result with the
+   * jump thru platforms colliding with the object (keeping the order of \a
+   * candidates). \param candidates The platform to be tested for collision
    */
-  std::set<PlatformRuntimeBehavior*> GetJumpthruCollidingWith(
-      const std::set<PlatformRuntimeBehavior*>& candidates);
+  void GetJumpthruCollidingWith(
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      std::vector<PlatformRuntimeBehavior*>& result);
 
   /**
    * \brief Return true if the object owning the behavior can grab the specified
@@ -202,6 +205,16 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
   RuntimeScene* parentScene;  ///< The scene the object belongs to.
   ScenePlatformObjectsManager*
       sceneManager;  ///< The platform objects manager associated to the scene.
+  // The lists used during a step are kept between steps so that their storage
+  // is reused. They are sorted by address.
+  std::vector<PlatformRuntimeBehavior*>
+      potentialObjects;  ///< The platforms that could be colliding with the
+                         ///< object during the step.
+  std::vector<PlatformRuntimeBehavior*>
+      overlappedJumpThru;  ///< The jump thru platforms overlapped by the
+                           ///< object.
+  std::vector<RuntimeObject*>
+      platformsObjects;  ///< Used by SeparateFromPlatforms.
   bool isOnFloor;    ///< True if the object is on a floor.
   bool isOnLadder;   ///< True if the object is on a ladder.
   PlatformRuntimeBehavior* floorPlatform;  ///< The platform the object is on,
@@ -1,8 +1,32 @@
 #include "ScenePlatformObjectsManager.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "PlatformRuntimeBehavior.h"
 
+namespace {
+int CellCoordinate(float value) {
+  // Coordinates are clamped so that platforms that are far away (or not
+  // positioned) can still be stored.
+  if (!(value > std::numeric_limits<int>::min() / 2))
+    return std::numeric_limits<int>::min() / 2;
+  if (value > std::numeric_limits<int>::max() / 2)
+    return std::numeric_limits<int>::max() / 2;
+
+  return static_cast<int>(std::floor(value));
+}
+
+std::int64_t CellKey(int x, int y) {
+  return static_cast<std::int64_t>(
+      (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+      static_cast<std::uint32_t>(y));
+}
+}
+
 std::map<RuntimeScene*, ScenePlatformObjectsManager>
     ScenePlatformObjectsManager::managers;
+const float ScenePlatformObjectsManager::cellSize = 128;
+const std::int64_t ScenePlatformObjectsManager::maxCellsPerPlatform = 1024;
 
 ScenePlatformObjectsManager::~ScenePlatformObjectsManager() {
   for (std::set<PlatformRuntimeBehavior*>::iterator it = allPlatforms.begin();
@@ -12,8 +36,142 @@ ScenePlatformObjectsManager::~ScenePlatformObjectsManager() {
 }
 
 void ScenePlatformObjectsManager::AddPlatform(PlatformRuntimeBehavior* platform) {
-  allPlatforms.insert(platform);
+  if (!allPlatforms.insert(platform).second) {
+    UpdatePlatform(platform);
+    return;
+  }
+
+  CellsArea area = ComputeCellsArea(*platform);
+  platformsAreas[platform] = area;
+  AddToCells(platform, area);
 }
+
 void ScenePlatformObjectsManager::RemovePlatform(PlatformRuntimeBehavior* platform) {
   allPlatforms.erase(platform);
+
+  auto it = platformsAreas.find(platform);
+  if (it == platformsAreas.end()) return;
+
+  RemoveFromCells(platform, it->second);
+  platformsAreas.erase(it);
+}
+
+void ScenePlatformObjectsManager::UpdatePlatform(
+    PlatformRuntimeBehavior* platform) {
+  auto it = platformsAreas.find(platform);
+  if (it == platformsAreas.end()) return;
+
+  CellsArea area = ComputeCellsArea(*platform);
+  if (area == it->second) return;
+
+  RemoveFromCells(platform, it->second);
+  it->second = area;
+  AddToCells(platform, area);
+}
+
+void ScenePlatformObjectsManager::UpdateAllPlatforms() {
+  if (platformsUpToDate) return;
+
+  for (PlatformRuntimeBehavior* platform : allPlatforms)
+    UpdatePlatform(platform);
+  platformsUpToDate = true;
+}
+
+void ScenePlatformObjectsManager::GetPlatformsNear(
+    float left,
+    float top,
+    float right,
+    float bottom,
+    std::vector<PlatformRuntimeBehavior*>& result) const {
+  CellsArea area = ComputeCellsArea(left, top, right, bottom);
+  if (IsLarge(area)) {
+    // Faster to return all the platforms than to read all the cells.
+    result.assign(allPlatforms.begin(), allPlatforms.end());
+    return;
+  }
+
+  result.assign(largePlatforms.begin(), largePlatforms.end());
+
+  for (int y = area.top; y <= area.bottom; ++y) {
+    for (int x = area.left; x <= area.right; ++x) {
+      auto it = cells.find(CellKey(x, y));
+      if (it != cells.end())
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+  }
+
+  // Platforms covering several cells are found several times.
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+ScenePlatformObjectsManager::CellsArea
+ScenePlatformObjectsManager::ComputeCellsArea(float left,
+                                              float top,
+                                              float right,
+                                              float bottom) const {
+  CellsArea area;
+  area.left = CellCoordinate(left / cellSize);
+  area.top = CellCoordinate(top / cellSize);
+  area.right = CellCoordinate(right / cellSize);
+  area.bottom = CellCoordinate(bottom / cellSize);
+  return area;
+}
+
+ScenePlatformObjectsManager::CellsArea
+ScenePlatformObjectsManager::ComputeCellsArea(
+    const PlatformRuntimeBehavior& platform) const {
+  // Use the same bounding circle as the platformer objects (see
+  // PlatformerObjectRuntimeBehavior::GetPotentialCollidingObjects).
+  RuntimeObject* object = platform.GetObject();
+  float width = object->GetWidth();
+  float height = object->GetHeight();
+  float centerX = object->GetDrawableX() + object->GetCenterX();
+  float centerY = object->GetDrawableY() + object->GetCenterY();
+  float radius = sqrt(width * width + height * height) / 2.0;
+
+  return ComputeCellsArea(
+      centerX - radius, centerY - radius, centerX + radius, centerY + radius);
+}
+
+bool ScenePlatformObjectsManager::IsLarge(const CellsArea& area) const {
+  return static_cast<std::int64_t>(area.right - area.left + 1) *
+             (area.bottom - area.top + 1) >
+         maxCellsPerPlatform;
+}
+
+void ScenePlatformObjectsManager::AddToCells(PlatformRuntimeBehavior* platform,
+                                             const CellsArea& area) {
+  if (IsLarge(area)) {
+    largePlatforms.push_back(platform);
+    return;
+  }
+
+  for (int y = area.top; y <= area.bottom; ++y)
+    for (int x = area.left; x <= area.right; ++x)
+      cells[CellKey(x, y)].push_back(platform);
+}
+
+void ScenePlatformObjectsManager::RemoveFromCells(
+    PlatformRuntimeBehavior* platform, const CellsArea& area) {
+  if (IsLarge(area)) {
+    largePlatforms.erase(
+        std::find(largePlatforms.begin(), largePlatforms.end(), platform));
+    return;
+  }
+
+  for (int y = area.top; y <= area.bottom; ++y) {
+    for (int x = area.left; x <= area.right; ++x) {
+      auto it = cells.find(CellKey(x, y));
+      if (it == cells.end()) continue;
+
+      std::vector<PlatformRuntimeBehavior*>& cell = it->second;
+      auto platformIt = std::find(cell.begin(), cell.end(), platform);
+      if (platformIt != cell.end()) {
+        *platformIt = cell.back();
+        cell.pop_back();
+      }
+      if (cell.empty()) cells.erase(it);
+    }
+  }
 }
@@ -6,16 +6,20 @@ This project is released under the MIT License.
 */
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
+#include <cstdint>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeScene.h"
 class PlatformRuntimeBehavior;
 
 /**
  * \brief Contains lists of all platform related objects of a scene.
  *
- * \note Could be drastically improved by using spatial hashing (see JS
- * implementation).
+ * The platforms are also stored in a spatial hash, so that the platforms near
+ * an object can be found without testing all the platforms (see
+ * GetPlatformsNear).
  */
 class ScenePlatformObjectsManager {
  public:
@@ -25,7 +29,7 @@ class ScenePlatformObjectsManager {
    */
   static std::map<RuntimeScene*, ScenePlatformObjectsManager> managers;
 
-  ScenePlatformObjectsManager(){};
+  ScenePlatformObjectsManager() : platformsUpToDate(false){};
   virtual ~ScenePlatformObjectsManager();
 
   /**
@@ -40,6 +44,30 @@ class ScenePlatformObjectsManager {
    */
   void RemovePlatform(PlatformRuntimeBehavior* platform);
 
+  /**
+   * \brief Notify the manager that a platform was moved or resized, so that
+   * it's moved in the spatial hash.
+   * \param platform The platform, that must have been added before.
+   */
+  void UpdatePlatform(PlatformRuntimeBehavior* platform);
+
+  /**
+   * \brief Update all the platforms in the spatial hash, unless it was already
+   * done since the last call to InvalidatePlatforms.
+   *
+   * Platforms update themselves during their own behavior steps, but they can
+   * be moved afterwards (for example by the behaviors of the objects stepped
+   * after them): platformer objects call this before moving, so that they
+   * find the platforms at their current position.
+   */
+  void UpdateAllPlatforms();
+
+  /**
+   * \brief Notify the manager that the platforms can have been moved since the
+   * last call to UpdateAllPlatforms.
+   */
+  void InvalidatePlatforms() { platformsUpToDate = false; }
+
   /**
    * \brief Get a read only access to the list of all platforms
    */
@@ -47,9 +75,65 @@ class ScenePlatformObjectsManager {
     return allPlatforms;
   }
 
+  /**
+   * \brief Fill \a result with the platforms that can be in the given area.
+   *
+   * A platform is found if the bounding box of its bounding circle (centered
+   * on the center of the object, with a radius of half its diagonal) was
+   * overlapping the area when it was last added or updated. Other platforms
+   * can be returned too.
+   *
+   * \param result The vector to be filled, sorted and without duplicates. It
+   * is cleared first, so the same vector can be reused for each query.
+   */
+  void GetPlatformsNear(float left,
+                        float top,
+                        float right,
+                        float bottom,
+                        std::vector<PlatformRuntimeBehavior*>& result) const;
+
  private:
+  /**
+   * \brief The cells covered by a platform (from left to right and top to
+   * bottom, included).
+   */
+  struct CellsArea {
+    bool operator==(const CellsArea& other) const {
+      return left == other.left && top == other.top && right == other.right &&
+             bottom == other.bottom;
+    }
+    bool operator!=(const CellsArea& other) const { return !(*this == other); }
+
+    int left;
+    int top;
+    int right;
+    int bottom;
+  };
+
+  CellsArea ComputeCellsArea(float left,
+                             float top,
+                             float right,
+                             float bottom) const;
+  CellsArea ComputeCellsArea(const PlatformRuntimeBehavior& platform) const;
+  bool IsLarge(const CellsArea& area) const;
+  void AddToCells(PlatformRuntimeBehavior* platform, const CellsArea& area);
+  void RemoveFromCells(PlatformRuntimeBehavior* platform,
+                       const CellsArea& area);
+
   std::set<PlatformRuntimeBehavior*>
       allPlatforms;  ///< The list of all platforms of the scene.
+  std::unordered_map<PlatformRuntimeBehavior*, CellsArea>
+      platformsAreas;  ///< The cells each platform was added to.
+  std::unordered_map<std::int64_t, std::vector<PlatformRuntimeBehavior*>>
+      cells;  ///< The platforms covering each cell.
+  std::vector<PlatformRuntimeBehavior*>
+      largePlatforms;  ///< The platforms covering too many cells to be added
+                       ///< to the cells, always returned by GetPlatformsNear.
+  bool platformsUpToDate;  ///< false if the platforms must be updated by
+                           ///< UpdateAllPlatforms.
+
+  static const float cellSize;
+  static const std::int64_t maxCellsPerPlatform;
 };
 
 #endif
@@ -0,0 +1,278 @@
+/**
+
+GDevelop - Platform Behavior Extension
+Copyright (c) 2013-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Tests for the Platform extension.
+ */
+#define CATCH_CONFIG_MAIN
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "../PlatformBehavior.h"
+#include "../PlatformRuntimeBehavior.h"
+#include "../PlatformerObjectBehavior.h"
+#include "../PlatformerObjectRuntimeBehavior.h"
+#include "../ScenePlatformObjectsManager.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+// Count the allocations, to check that some operations don't allocate memory.
+namespace {
+std::size_t allocationsCount = 0;
+}
+
+void *operator new(std::size_t size) {
+  allocationsCount++;
+  if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+// Mock objects that can have a specific size
+class ResizableRuntimeObject : public RuntimeObject {
+ public:
+  ResizableRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
+      : RuntimeObject(scene, obj), width(0), height(0) {}
+
+  float GetWidth() const override { return width; }
+  float GetHeight() const override { return height; }
+  void SetWidth(float newWidth) override { width = newWidth; }
+  void SetHeight(float newHeight) override { height = newHeight; }
+
+ private:
+  float width;
+  float height;
+};
+
+namespace {
+template <class TRuntimeBehavior, class TBehavior>
+std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
+  gd::SerializerElement behaviorContent;
+  TBehavior behavior;
+  behavior.InitializeContent(behaviorContent);
+  return std::move(gd::make_unique<TRuntimeBehavior>(behaviorContent));
+};
+
+RuntimeObject *AddPlatform(RuntimeScene &scene,
+                           const gd::Object &platformObj,
+                           float x,
+                           float y,
+                           float width,
+                           float height) {
+  auto *platform =
+      scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+          new ResizableRuntimeObject(scene, platformObj)));
+  platform->AddBehavior(
+      "Platform",
+      CreateNewRuntimeBehavior<PlatformRuntimeBehavior, PlatformBehavior>());
+  platform->SetX(x);
+  platform->SetY(y);
+  platform->SetWidth(width);
+  platform->SetHeight(height);
+  return platform;
+}
+
+PlatformRuntimeBehavior *GetPlatformBehavior(RuntimeObject *platform) {
+  return static_cast<PlatformRuntimeBehavior *>(
+      platform->GetBehaviorRawPointer("Platform"));
+}
+
+bool Contains(const std::vector<PlatformRuntimeBehavior *> &platforms,
+              RuntimeObject *platform) {
+  return std::find(platforms.begin(),
+                   platforms.end(),
+                   GetPlatformBehavior(platform)) != platforms.end();
+}
+}  // namespace
+
+TEST_CASE("ScenePlatformObjectsManager", "[game-engine][platformer]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object platformObj("platform");
+
+  // A grid of tiles, from (0;0) to (3200;320).
+  std::vector<RuntimeObject *> tiles;
+  for (std::size_t y = 0; y < 10; ++y) {
+    for (std::size_t x = 0; x < 100; ++x)
+      tiles.push_back(AddPlatform(scene, platformObj, x * 32, y * 32, 32, 32));
+  }
+  scene.RenderAndStep();
+
+  ScenePlatformObjectsManager &manager =
+      ScenePlatformObjectsManager::managers[&scene];
+  REQUIRE(manager.GetAllPlatforms().size() == 1000);
+
+  SECTION("Platforms near an area") {
+    std::vector<PlatformRuntimeBehavior *> platforms;
+    manager.GetPlatformsNear(500, 100, 510, 110, platforms);
+    REQUIRE(std::is_sorted(platforms.begin(), platforms.end()));
+    REQUIRE(std::adjacent_find(platforms.begin(), platforms.end()) ==
+            platforms.end());
+    REQUIRE(platforms.size() < 100);
+
+    // All the tiles whose bounding circle is overlapping the area are found.
+    for (RuntimeObject *tile : tiles) {
+      float radius = sqrt(32 * 32 * 2) / 2;
+      float centerX = tile->GetX() + 16;
+      float centerY = tile->GetY() + 16;
+      if (centerX + radius >= 500 && centerX - radius <= 510 &&
+          centerY + radius >= 100 && centerY - radius <= 110) {
+        REQUIRE(Contains(platforms, tile));
+      }
+    }
+
+    manager.GetPlatformsNear(-1000, -1000, -900, -900, platforms);
+    REQUIRE(platforms.empty());
+  }
+  SECTION("Platforms moved, resized or removed") {
+    std::vector<PlatformRuntimeBehavior *> platforms;
+    tiles[0]->SetX(5000);
+    scene.RenderAndStep();
+    manager.GetPlatformsNear(4990, 0, 5010, 10, platforms);
+    REQUIRE(platforms.size() == 1);
+    REQUIRE(Contains(platforms, tiles[0]));
+    manager.GetPlatformsNear(0, 0, 10, 10, platforms);
+    REQUIRE(!Contains(platforms, tiles[0]));
+
+    // Platforms covering a lot of cells are always found.
+    tiles[0]->SetWidth(1000000);
+    scene.RenderAndStep();
+    manager.GetPlatformsNear(-1000, -1000, -900, -900, platforms);
+    REQUIRE(platforms.size() == 1);
+    REQUIRE(Contains(platforms, tiles[0]));
+
+    tiles[0]->DeleteFromScene(scene);
+    scene.RenderAndStep();
+    REQUIRE(manager.GetAllPlatforms().size() == 999);
+    manager.GetPlatformsNear(-1000, -1000, -900, -900, platforms);
+    REQUIRE(platforms.empty());
+    manager.GetPlatformsNear(4990, 0, 5010, 10, platforms);
+    REQUIRE(platforms.empty());
+  }
+}
+
+TEST_CASE("PlatformerObjectRuntimeBehavior", "[game-engine][platformer]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object platformObj("platform");
+  gd::Object playerObj("player");
+
+  // A floor, with jump thru platforms and ladders above it.
+  for (std::size_t x = 0; x < 100; ++x)
+    AddPlatform(scene, platformObj, x * 32, 0, 32, 32);
+  for (std::size_t x = 0; x < 12; ++x) {
+    GetPlatformBehavior(
+        AddPlatform(scene, platformObj, 128 + x * 256, -100, 96, 16))
+        ->ChangePlatformType("Jumpthru");
+  }
+  for (std::size_t x = 0; x < 6; ++x) {
+    GetPlatformBehavior(
+        AddPlatform(scene, platformObj, 448 + x * 512, -200, 32, 200))
+        ->ChangePlatformType("Ladder");
+  }
+
+  auto *player =
+      scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+          new ResizableRuntimeObject(scene, playerObj)));
+  player->AddBehavior("PlatformerObject",
+                      CreateNewRuntimeBehavior<PlatformerObjectRuntimeBehavior,
+                                               PlatformerObjectBehavior>());
+  player->SetWidth(16);
+  player->SetHeight(32);
+  player->SetY(-40);
+  scene.RenderAndStep();
+
+  auto *behavior = static_cast<PlatformerObjectRuntimeBehavior *>(
+      player->GetBehaviorRawPointer("PlatformerObject"));
+  const gd::String right = "Right";
+  const gd::String jump = "Jump";
+  auto step = [&](std::size_t frame) {
+    scene.GetTimeManager().Update(16000, 0);
+    behavior->SimulateControl(right);
+    if (frame % 40 == 0) behavior->SimulateControl(jump);
+    behavior->StepPreEvents(scene);
+    behavior->StepPostEvents(scene);
+  };
+
+  SECTION("No allocations once the step is warmed up") {
+    // The first steps fill the storage reused by the next ones. The hitboxes
+    // of the platforms reached later are filled once, the first time they
+    // are used.
+    for (std::size_t frame = 0; frame < 200; ++frame) step(frame);
+    for (RuntimeObject *object : scene.objectsInstances.GetAllObjects())
+      object->GetHitBoxes();
+
+    float oldX = player->GetX();
+    std::size_t oldAllocationsCount = allocationsCount;
+    for (std::size_t frame = 0; frame < 200; ++frame) step(frame);
+    std::size_t stepsAllocationsCount = allocationsCount - oldAllocationsCount;
+
+    REQUIRE(stepsAllocationsCount == 0);
+    REQUIRE(player->GetX() > oldX + 500);
+    REQUIRE(player->GetY() < 0);
+  }
+
+  SECTION("Platforms moved after their own update") {
+    RuntimeObject *wall = AddPlatform(scene, platformObj, 3000, -1000, 32, 32);
+    scene.RenderAndStep();
+    for (std::size_t frame = 1; frame < 10; ++frame) step(frame);
+
+    // Moved as if by an object stepped after the wall, which is not stepped
+    // again by the next steps.
+    wall->SetX(player->GetX() + player->GetWidth() + 20);
+    wall->SetY(player->GetY());
+    for (std::size_t frame = 10; frame < 40; ++frame) step(frame);
+
+    float playerRight = player->GetX() + player->GetWidth();
+    REQUIRE(playerRight <= wall->GetX());
+    REQUIRE(playerRight > wall->GetX() - 1);
+  }
+}
+
+TEST_CASE("PlatformerObjectRuntimeBehavior - Benchmarks",
+          "[game-engine][platformer]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object platformObj("platform");
+  gd::Object playerObj("player");
+
+  // 5000 tiles making floors, with 100 platformer objects falling on them.
+  for (std::size_t y = 0; y < 10; ++y) {
+    for (std::size_t x = 0; x < 500; ++x)
+      AddPlatform(scene, platformObj, x * 32, y * 320, 32, 32);
+  }
+  for (std::size_t i = 0; i < 100; ++i) {
+    auto *player =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, playerObj)));
+    player->AddBehavior("PlatformerObject",
+                        CreateNewRuntimeBehavior<PlatformerObjectRuntimeBehavior,
+                                                 PlatformerObjectBehavior>());
+    player->SetX(i * 160 + 8);
+    player->SetY((i % 10) * 320 - 100);
+    player->SetWidth(16);
+    player->SetHeight(32);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < 60; ++i) scene.RenderAndStep();
+  auto end = std::chrono::steady_clock::now();
+  std::cout << "60 frames with 100 platformer objects and 5000 platforms "
+               "benchmark: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                     start)
+                   .count()
+            << " microseconds" << std::endl;
+}
@@ -38,7 +38,7 @@ void GD_EXTENSION_API CopyImageOnAnother(const gd::String& destName,
                    destY,
                    sf::IntRect(0, 0, 0, 0),
                    useTransparency);
-  dest->texture.loadFromImage(dest->image);
+  dest->UpdateFromImage();
 }
 
 void GD_EXTENSION_API CaptureScreen(RuntimeScene& scene,
@@ -53,8 +53,8 @@ void GD_EXTENSION_API CaptureScreen(RuntimeScene& scene,
     std::shared_ptr<SFMLTextureWrapper> sfmlTexture =
         scene.GetImageManager()->GetSFMLTexture(destImageName);
     sfmlTexture->image = capture;
-    sfmlTexture->texture.loadFromImage(
-        sfmlTexture->image);  // Do not forget to update the associated texture
+    sfmlTexture->UpdateFromImage();  // Do not forget to update the associated
+                                     // texture
   }
 }
 
@@ -86,8 +86,8 @@ void GD_EXTENSION_API CreateSFMLTexture(RuntimeScene& scene,
   if (width != 0 && height != 0 && colorIsOk)
     newTexture->image.create(width, height, color);
 
-  newTexture->texture.loadFromImage(
-      newTexture->image);  // Do not forget to update the associated texture
+  newTexture->UpdateFromImage();  // Do not forget to update the associated
+                                  // texture
 
   scene.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(
       imageName, newTexture);  // Otherwise
@@ -105,8 +105,8 @@ void GD_EXTENSION_API OpenSFMLTextureFromFile(RuntimeScene& scene,
 
   // Open the SFML image and the SFML texture
   newTexture->image.loadFromFile(fileName.ToLocale());
-  newTexture->texture.loadFromImage(
-      newTexture->image);  // Do not forget to update the associated texture
+  newTexture->UpdateFromImage();  // Do not forget to update the associated
+                                  // texture
 
   scene.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(imageName,
                                                              newTexture);
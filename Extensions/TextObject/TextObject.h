@@ -160,8 +160,6 @@ class GD_EXTENSION_API RuntimeTextObject : public RuntimeObject {
   unsigned int GetColorG() const { return text.getFillColor().g; };
   unsigned int GetColorB() const { return text.getFillColor().b; };
 
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
-
 #if defined(GD_IDE_ONLY)
   virtual void GetPropertyForDebugger(std::size_t propertyNb,
                                       gd::String& name,
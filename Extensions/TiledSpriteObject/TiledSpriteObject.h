@@ -80,11 +80,20 @@ class GD_EXTENSION_API RuntimeTiledSpriteObject : public RuntimeObject {
   virtual float GetAngle() const { return angle; };
   virtual bool SetAngle(float ang) {
     angle = ang;
+    NotifyBoundsChanged();
     return true;
   };
 
-  virtual void SetWidth(float newWidth) { width = newWidth; };
-  virtual void SetHeight(float newHeight) { height = newHeight; };
+  virtual void SetWidth(float newWidth) {
+    width = newWidth;
+    NotifyBoundsChanged();
+  };
+  virtual void SetHeight(float newHeight) {
+    height = newHeight;
+    NotifyBoundsChanged();
+  };
+
+  virtual bool CanBeCulled() const { return true; };
 
   void SetXOffset(float xOffset_) { xOffset = xOffset_; };
   float GetXOffset() const { return xOffset; };
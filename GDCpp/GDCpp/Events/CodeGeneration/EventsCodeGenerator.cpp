@@ -5,6 +5,7 @@
  */
 
 #if defined(GD_IDE_ONLY)
+#include <algorithm>
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
@@ -382,33 +383,47 @@ gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
   }
 }
 
+gd::String EventsCodeGenerator::GenerateAllInstancesGetterCode(
+    const gd::String& objectName) {
+  gd::String objectNameIdVariable = ManObjListName(objectName) + "NameId";
+  AddGlobalDeclaration("static const std::size_t " + objectNameIdVariable +
+                       " = RuntimeContext::GetObjectNameId(\"" +
+                       ConvertToString(objectName) + "\");");
+
+  return "runtimeContext->GetObjectsRawPointers(" + objectNameIdVariable + ")";
+}
+
 gd::String EventsCodeGenerator::GenerateObject(
     const gd::String& objectName,
     const gd::String& type,
     gd::EventsCodeGenerationContext& context) {
   gd::String output;
-  if (type == "objectList") {
+  if (type == "objectList" || type == "objectListWithoutPicking") {
     std::vector<gd::String> realObjects =
         ExpandObjectsName(objectName, context);
 
-    output += "runtimeContext->ClearObjectListsMap()";
-    for (std::size_t i = 0; i < realObjects.size(); ++i) {
-      context.ObjectsListNeeded(realObjects[i]);
-      output += ".AddObjectListToMap(\"" + ConvertToString(realObjects[i]) +
-                "\", " + ManObjListName(realObjects[i]) + ")";
-    }
-    output += ".ReturnObjectListsMap()";
-  } else if (type == "objectListWithoutPicking") {
-    std::vector<gd::String> realObjects =
-        ExpandObjectsName(objectName, context);
+    // Lists are sorted by name so that functions get them in the same order
+    // whatever the order of the objects in the groups.
+    std::sort(realObjects.begin(), realObjects.end());
+    realObjects.erase(std::unique(realObjects.begin(), realObjects.end()),
+                      realObjects.end());
 
-    output += "runtimeContext->ClearObjectListsMap()";
+    output += "RuntimeObjectsLists({";
     for (std::size_t i = 0; i < realObjects.size(); ++i) {
-      context.ObjectsListWithoutPickingNeeded(realObjects[i]);
-      output += ".AddObjectListToMap(\"" + ConvertToString(realObjects[i]) +
-                "\", " + ManObjListName(realObjects[i]) + ")";
+      if (type == "objectList")
+        context.ObjectsListNeeded(realObjects[i]);
+      else
+        context.ObjectsListWithoutPickingNeeded(realObjects[i]);
+
+      gd::String objectNameVariable = ManObjListName(realObjects[i]) + "Name";
+      AddGlobalDeclaration("static const gd::String " + objectNameVariable +
+                           " = \"" + ConvertToString(realObjects[i]) + "\";");
+
+      if (i != 0) output += ", ";
+      output += "{&" + objectNameVariable + ", &" +
+                ManObjListName(realObjects[i]) + "}";
     }
-    output += ".ReturnObjectListsMap()";
+    output += "}, runtimeContext->GetObjectsPickingScratch())";
   } else if (type == "objectPtr") {
     std::vector<gd::String> realObjects =
         ExpandObjectsName(objectName, context);
@@ -156,6 +156,13 @@ class GD_API EventsCodeGenerator : public gd::EventsCodeGenerator {
 
   virtual gd::String GenerateGetBehaviorNameCode(const gd::String& behaviorName);
 
+  /**
+   * \brief Get the instances of an object using the identifier of its name,
+   * resolved only once in a global declaration.
+   */
+  virtual gd::String GenerateAllInstancesGetterCode(
+      const gd::String& objectName);
+
   /**
    * \brief Construct a code generator for the specified project and layout.
    */
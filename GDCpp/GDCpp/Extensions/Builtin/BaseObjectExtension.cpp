@@ -159,6 +159,7 @@ BaseObjectExtension::BaseObjectExtension() {
       .SetFunctionName("MovesToward")
       .SetIncludeFile("GDCpp/Extensions/Builtin/ObjectTools.h");
   GetAllConditions()["Distance"]
+      .AddCodeOnlyParameter("currentScene", "")  // For the broad-phase.
       .SetFunctionName("DistanceBetweenObjects")
       .SetIncludeFile("GDCpp/Extensions/Builtin/ObjectTools.h");
   GetAllConditions()["AjoutObjConcern"]
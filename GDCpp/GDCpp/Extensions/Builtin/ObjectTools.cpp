@@ -7,18 +7,18 @@
 #include <cmath>
 #include <iostream>
 #include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
 #include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
 #include "MathematicalTools.h"
 
 using namespace std;
 
-double GD_API PickedObjectsCount(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists) {
+double GD_API PickedObjectsCount(const RuntimeObjectsLists &objectsLists) {
   std::size_t size = 0;
-  std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-      objectsLists.begin();
+  RuntimeObjectsLists::const_iterator it = objectsLists.begin();
   for (; it != objectsLists.end(); ++it) {
     if (it->second == NULL) continue;
 
@@ -28,26 +28,32 @@ double GD_API PickedObjectsCount(
   return size;
 }
 
-bool GD_API HitBoxesCollision(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted,
-    RuntimeScene & /*scene*/,
-    bool ignoreTouchingEdges) {
-  return TwoObjectListsTest(
+bool GD_API HitBoxesCollision(const RuntimeObjectsLists &objectsLists1,
+                              const RuntimeObjectsLists &objectsLists2,
+                              bool conditionInverted,
+                              RuntimeScene &scene,
+                              bool ignoreTouchingEdges) {
+  // Objects can only be in collision if their bounding circles are
+  // overlapping: use them to only test the objects that are near.
+  auto getBoundingCircleAABB = [](RuntimeObject *obj) {
+    return ObjectsBroadPhase::GetBoundingCircleAABB(*obj);
+  };
+  return TwoObjectListsTestWithBroadPhase(
       objectsLists1,
       objectsLists2,
       conditionInverted,
+      scene.GetObjectsBroadPhase(),
+      getBoundingCircleAABB,
+      getBoundingCircleAABB,
       [ignoreTouchingEdges](RuntimeObject *obj1, RuntimeObject *obj2) {
         return obj1->IsCollidingWith(obj2, ignoreTouchingEdges);
       });
 }
 
-bool GD_API ObjectsTurnedToward(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    float tolerance,
-    bool conditionInverted) {
+bool GD_API ObjectsTurnedToward(const RuntimeObjectsLists &objectsLists1,
+                                const RuntimeObjectsLists &objectsLists2,
+                                float tolerance,
+                                bool conditionInverted) {
   return TwoObjectListsTest(
       objectsLists1,
       objectsLists2,
@@ -65,16 +71,37 @@ bool GD_API ObjectsTurnedToward(
       });
 }
 
-float GD_API DistanceBetweenObjects(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    float length,
-    bool conditionInverted) {
+float GD_API DistanceBetweenObjects(const RuntimeObjectsLists &objectsLists1,
+                                   const RuntimeObjectsLists &objectsLists2,
+                                   float length,
+                                   bool conditionInverted,
+                                   RuntimeScene &scene) {
+  // Only the objects having their center in the square around the center of
+  // the first object can be near enough (a small margin is kept for rounding
+  // errors).
+  float queryHalfSize = abs(length) + 1;
+  auto getCenter = [](RuntimeObject *obj) {
+    return sf::FloatRect(obj->GetDrawableX() + obj->GetCenterX(),
+                         obj->GetDrawableY() + obj->GetCenterY(),
+                         0,
+                         0);
+  };
+  auto getQueryRect = [queryHalfSize](RuntimeObject *obj) {
+    return sf::FloatRect(
+        obj->GetDrawableX() + obj->GetCenterX() - queryHalfSize,
+        obj->GetDrawableY() + obj->GetCenterY() - queryHalfSize,
+        queryHalfSize * 2,
+        queryHalfSize * 2);
+  };
+
   length *= length;
-  return TwoObjectListsTest(
+  return TwoObjectListsTestWithBroadPhase(
       objectsLists1,
       objectsLists2,
       conditionInverted,
+      scene.GetObjectsBroadPhase(),
+      getCenter,
+      getQueryRect,
       [length](RuntimeObject *obj1, RuntimeObject *obj2) {
         float X = obj1->GetDrawableX() + obj1->GetCenterX() -
                   (obj2->GetDrawableX() + obj2->GetCenterX());
@@ -85,11 +112,10 @@ float GD_API DistanceBetweenObjects(
       });
 }
 
-bool GD_API
-MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-            std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-            float tolerance,
-            bool conditionInverted) {
+bool GD_API MovesToward(const RuntimeObjectsLists &objectsLists1,
+                        const RuntimeObjectsLists &objectsLists2,
+                        float tolerance,
+                        bool conditionInverted) {
   return TwoObjectListsTest(
       objectsLists1,
       objectsLists2,
@@ -109,11 +135,10 @@ MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
       });
 }
 
-bool GD_API CursorOnObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists,
-    RuntimeScene &scene,
-    bool precise,
-    bool conditionInverted) {
+bool GD_API CursorOnObject(const RuntimeObjectsLists &objectsLists,
+                           RuntimeScene &scene,
+                           bool precise,
+                           bool conditionInverted) {
   return PickObjectsIf(
       objectsLists, conditionInverted, [&scene, precise](RuntimeObject *obj) {
         return obj->CursorOnObject(scene, precise);
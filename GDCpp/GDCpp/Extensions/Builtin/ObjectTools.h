@@ -6,9 +6,9 @@
 #ifndef OBJECTTOOLS_H
 #define OBJECTTOOLS_H
 
-#include <map>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
 #include "GDCpp/Runtime/String.h"
 
 class RuntimeScene;
@@ -17,53 +17,48 @@ class RuntimeObject;
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API ObjectsTurnedToward(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    float tolerance,
-    bool conditionInverted);
+bool GD_API ObjectsTurnedToward(const RuntimeObjectsLists &objectsLists1,
+                                const RuntimeObjectsLists &objectsLists2,
+                                float tolerance,
+                                bool conditionInverted);
 
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API HitBoxesCollision(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted,
-    RuntimeScene &scene,
-    bool ignoreTouchingEdges = false);
+bool GD_API HitBoxesCollision(const RuntimeObjectsLists &objectsLists1,
+                              const RuntimeObjectsLists &objectsLists2,
+                              bool conditionInverted,
+                              RuntimeScene &scene,
+                              bool ignoreTouchingEdges = false);
 
 /**
  * Only used internally by GD events generated code.
  */
-double GD_API PickedObjectsCount(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists);
+double GD_API PickedObjectsCount(const RuntimeObjectsLists &objectsLists);
 
 /**
  * Only used internally by GD events generated code.
  */
-float GD_API DistanceBetweenObjects(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    float length,
-    bool conditionInverted);
+float GD_API DistanceBetweenObjects(const RuntimeObjectsLists &objectsLists1,
+                                   const RuntimeObjectsLists &objectsLists2,
+                                   float length,
+                                   bool conditionInverted,
+                                   RuntimeScene &scene);
 
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API
-MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-            std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-            float tolerance,
-            bool conditionInverted);
+bool GD_API MovesToward(const RuntimeObjectsLists &objectsLists1,
+                        const RuntimeObjectsLists &objectsLists2,
+                        float tolerance,
+                        bool conditionInverted);
 
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API CursorOnObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists,
-    RuntimeScene &scene,
-    bool precise,
-    bool conditionInverted);
+bool GD_API CursorOnObject(const RuntimeObjectsLists &objectsLists,
+                           RuntimeScene &scene,
+                           bool precise,
+                           bool conditionInverted);
 
 #endif  // OBJECTTOOLS_H
@@ -3,6 +3,8 @@
  * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
  * reserved. This project is released under the MIT License.
  */
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include "GDCore/Tools/Log.h"
@@ -11,6 +13,7 @@
 #include "GDCpp/Extensions/CppPlatform.h"
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
 #include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/Project/Variable.h"
@@ -91,13 +94,12 @@ void GD_API MoveObjects(RuntimeScene &scene) {
 
 namespace {
 
-void DoCreateObjectOnScene(
-    RuntimeScene &scene,
-    gd::String objectName,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    float positionX,
-    float positionY,
-    const gd::String &layer) {
+void DoCreateObjectOnScene(RuntimeScene &scene,
+                           const gd::String &objectName,
+                           const RuntimeObjectsLists &pickedObjectLists,
+                           float positionX,
+                           float positionY,
+                           const gd::String &layer) {
   if (pickedObjectLists.empty()) return;
 
   // Find the object to be created
@@ -128,22 +130,21 @@ void DoCreateObjectOnScene(
   newObject->SetLayer(layer);
 
   // Add object to scene and let it be concerned by futures actions
-  pickedObjectLists[objectName]->push_back(
+  pickedObjectLists.Get(objectName)->push_back(
       scene.objectsInstances.AddObject(std::move(newObject)));
 }
 
 }  // namespace
 
-void GD_API CreateObjectOnScene(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    float positionX,
-    float positionY,
-    const gd::String &layer) {
+void GD_API CreateObjectOnScene(RuntimeScene &scene,
+                                const RuntimeObjectsLists &pickedObjectLists,
+                                float positionX,
+                                float positionY,
+                                const gd::String &layer) {
   if (pickedObjectLists.empty()) return;
 
   ::DoCreateObjectOnScene(scene,
-                          pickedObjectLists.begin()->first,
+                          *pickedObjectLists.begin()->first,
                           pickedObjectLists,
                           positionX,
                           positionY,
@@ -152,26 +153,25 @@ void GD_API CreateObjectOnScene(
 
 void GD_API CreateObjectFromGroupOnScene(
     RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const RuntimeObjectsLists &pickedObjectLists,
     const gd::String &objectWanted,
     float positionX,
     float positionY,
     const gd::String &layer) {
-  if (pickedObjectLists[objectWanted] == nullptr)
+  if (pickedObjectLists.Get(objectWanted) == nullptr)
     return;  // Bail out if the object is not present in the specified group
 
   ::DoCreateObjectOnScene(
       scene, objectWanted, pickedObjectLists, positionX, positionY, layer);
 }
 
-bool GD_API PickAllObjects(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+bool GD_API PickAllObjects(RuntimeScene &scene,
+                           const RuntimeObjectsLists &pickedObjectLists) {
   for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end();
        ++it) {
     if (it->second != nullptr) {
       std::vector<RuntimeObject *> objectsOnScene =
-          scene.objectsInstances.GetObjectsRawPointers(it->first);
+          scene.objectsInstances.GetObjectsRawPointers(*it->first);
 
       for (std::size_t j = 0; j < objectsOnScene.size(); ++j) {
         if (find(it->second->begin(), it->second->end(), objectsOnScene[j]) ==
@@ -184,38 +184,43 @@ bool GD_API PickAllObjects(
   return true;
 }
 
-bool GD_API PickRandomObject(
-    RuntimeScene &,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
-  // Create a list with all objects
-  std::vector<RuntimeObject *> allObjects;
+bool GD_API PickRandomObject(RuntimeScene &,
+                             const RuntimeObjectsLists &pickedObjectLists) {
+  // Count all objects, then find the one at the random position
+  std::size_t objectsCount = 0;
   for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end();
        ++it) {
-    if (it->second != nullptr)
-      std::copy(it->second->begin(),
-                it->second->end(),
-                std::back_inserter(allObjects));
+    if (it->second != nullptr) objectsCount += it->second->size();
   }
 
-  if (allObjects.empty()) return false;
+  if (objectsCount == 0) return false;
 
-  std::size_t id = GDpriv::CommonInstructions::Random(allObjects.size() - 1);
-  PickOnly(pickedObjectLists, allObjects[id]);
-  return true;
+  std::size_t id = GDpriv::CommonInstructions::Random(objectsCount - 1);
+  for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end();
+       ++it) {
+    if (it->second == nullptr) continue;
+    if (id < it->second->size()) {
+      PickOnly(pickedObjectLists, (*it->second)[id]);
+      return true;
+    }
+
+    id -= it->second->size();
+  }
+
+  return false;
 }
 
-bool GD_API PickNearestObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    double x,
-    double y,
-    bool inverted) {
+bool GD_API PickNearestObject(const RuntimeObjectsLists &pickedObjectLists,
+                              double x,
+                              double y,
+                              bool inverted) {
   double best = 0;
   bool first = true;
   RuntimeObject *bestObject = NULL;
   for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end();
        ++it) {
     if (it->second == NULL) continue;
-    auto list = *it->second;
+    const std::vector<RuntimeObject *> &list = *it->second;
 
     for (std::size_t i = 0; i < list.size(); ++i) {
       double value = list[i]->GetSqDistanceTo(x, y);
@@ -234,15 +239,14 @@ bool GD_API PickNearestObject(
   return true;
 }
 
-bool GD_API RaycastObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    float x,
-    float y,
-    float angle,
-    float dist,
-    gd::Variable &varX,
-    gd::Variable &varY,
-    bool inverted) {
+bool GD_API RaycastObject(const RuntimeObjectsLists &pickedObjectLists,
+                          float x,
+                          float y,
+                          float angle,
+                          float dist,
+                          gd::Variable &varX,
+                          gd::Variable &varY,
+                          bool inverted) {
   return RaycastObjectToPosition(pickedObjectLists,
                                  x, y,
                                  x + dist*cos(angle*3.14159/180.0),
@@ -251,7 +255,7 @@ bool GD_API RaycastObject(
 }
 
 bool GD_API RaycastObjectToPosition(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const RuntimeObjectsLists &pickedObjectLists,
     float x,
     float y,
     float endX,
@@ -263,22 +267,38 @@ bool GD_API RaycastObjectToPosition(
   float testSqDist = inverted ? 0 : (endX - x)*(endX - x) + (endY - y)*(endY - y);
   float resultX = 0.0f;
   float resultY = 0.0f;
+
+  // An object can only be hit if its bounding circle is overlapping the ray:
+  // only test the objects with their bounding circle AABB overlapping the
+  // AABB of the ray. Objects are tested in the same order as the lists, as
+  // the last object found at the same distance is the one picked.
+  sf::FloatRect rayBounds(std::min(x, endX),
+                          std::min(y, endY),
+                          std::abs(endX - x),
+                          std::abs(endY - y));
   for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end(); ++it) {
     if (it->second == NULL) continue;
-    auto list = *it->second;
 
-    for (std::size_t i = 0; i < list.size(); ++i) {
-      RaycastResult result = list[i]->RaycastTest(x, y, endX, endY, !inverted);
+    for (RuntimeObject *object : *it->second) {
+      sf::FloatRect objectBounds =
+          ObjectsBroadPhase::GetBoundingCircleAABB(*object);
+      if (objectBounds.left > rayBounds.left + rayBounds.width ||
+          rayBounds.left > objectBounds.left + objectBounds.width ||
+          objectBounds.top > rayBounds.top + rayBounds.height ||
+          rayBounds.top > objectBounds.top + objectBounds.height)
+        continue;
+
+      RaycastResult result = object->RaycastTest(x, y, endX, endY, !inverted);
 
       if (result.collision) {
         if (!inverted && (result.closeSqDist <= testSqDist)) {
           testSqDist = result.closeSqDist;
-          matchObject = list[i];
+          matchObject = object;
           resultX = result.closePoint.x;
           resultY = result.closePoint.y;
         } else if (inverted && (result.farSqDist >= testSqDist)) {
           testSqDist = result.farSqDist;
-          matchObject = list[i];
+          matchObject = object;
           resultX = result.farPoint.x;
           resultY = result.farPoint.y;
         }
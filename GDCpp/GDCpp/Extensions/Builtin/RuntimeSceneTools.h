@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
 class RuntimeScene;
 namespace gd {
 class Variable;
@@ -70,19 +71,18 @@ void GD_API DisableInputWhenFocusIsLost(RuntimeScene &scene, bool disable);
 /**
  * Only used internally by GD events generated code.
  */
-void GD_API CreateObjectOnScene(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    float positionX,
-    float positionY,
-    const gd::String &layer);
+void GD_API CreateObjectOnScene(RuntimeScene &scene,
+                                const RuntimeObjectsLists &pickedObjectLists,
+                                float positionX,
+                                float positionY,
+                                const gd::String &layer);
 
 /**
  * Only used internally by GD events generated code.
  */
 void GD_API CreateObjectFromGroupOnScene(
     RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const RuntimeObjectsLists &pickedObjectLists,
     const gd::String &objectWanted,
     float positionX,
     float positionY,
@@ -93,48 +93,44 @@ void GD_API CreateObjectFromGroupOnScene(
  *
  * \return true ( always )
  */
-bool GD_API PickAllObjects(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists);
+bool GD_API PickAllObjects(RuntimeScene &scene,
+                           const RuntimeObjectsLists &pickedObjectLists);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true if an object was picked, false otherwise
  */
-bool GD_API PickRandomObject(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists);
+bool GD_API PickRandomObject(RuntimeScene &scene,
+                             const RuntimeObjectsLists &pickedObjectLists);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true if an object was picked, false otherwise
  */
-bool GD_API PickNearestObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    double x,
-    double y,
-    bool inverted);
+bool GD_API PickNearestObject(const RuntimeObjectsLists &pickedObjectLists,
+                              double x,
+                              double y,
+                              bool inverted);
 
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API RaycastObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    float x,
-    float y,
-    float angle,
-    float dist,
-    gd::Variable &varX,
-    gd::Variable &varY,
-    bool inverted);
+bool GD_API RaycastObject(const RuntimeObjectsLists &pickedObjectLists,
+                          float x,
+                          float y,
+                          float angle,
+                          float dist,
+                          gd::Variable &varX,
+                          gd::Variable &varY,
+                          bool inverted);
 
 /**
  * Only used internally by GD events generated code.
  */
 bool GD_API RaycastObjectToPosition(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const RuntimeObjectsLists &pickedObjectLists,
     float x,
     float y,
     float targetX,
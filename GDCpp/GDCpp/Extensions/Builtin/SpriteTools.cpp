@@ -18,10 +18,9 @@ using namespace std;
 /**
  * Test a collision between two sprites objects
  */
-bool GD_API SpriteCollision(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted) {
+bool GD_API SpriteCollision(const RuntimeObjectsLists &objectsLists1,
+                            const RuntimeObjectsLists &objectsLists2,
+                            bool conditionInverted) {
   return TwoObjectListsTest(objectsLists1,
                             objectsLists2,
                             conditionInverted,
@@ -1,18 +1,17 @@
 #ifndef SPRITETOOLS_H
 #define SPRITETOOLS_H
 
-#include <map>
 #include <string>
 #include <vector>
 
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
 #include "GDCpp/Runtime/String.h"
 
 class RuntimeScene;
 class RuntimeObject;
 
-bool GD_API SpriteCollision(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted);
+bool GD_API SpriteCollision(const RuntimeObjectsLists &objectsLists1,
+                            const RuntimeObjectsLists &objectsLists2,
+                            bool conditionInverted);
 
 #endif  // SPRITETOOLS_H
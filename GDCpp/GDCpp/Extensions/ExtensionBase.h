@@ -157,6 +157,22 @@ class GD_API ExtensionBase : public gd::PlatformExtension {
   virtual void ObjectDeletedFromScene(RuntimeScene& scene,
                                       RuntimeObject* objectDeleted){};
 
+  /**
+   * \brief Called by RuntimeScene, if ToBeNotifiedOnObjectDeletion() returns
+   * true, with all the objects deleted during a frame, before they are
+   * destroyed.
+   *
+   * Default implementation calls ObjectDeletedFromScene for each object.
+   * Redefine it if the objects can be handled more efficiently at once.
+   *
+   * \see ExtensionBase::ObjectDeletedFromScene
+   */
+  virtual void ObjectsDeletedFromScene(
+      RuntimeScene& scene, const std::vector<RuntimeObject*>& objectsDeleted) {
+    for (RuntimeObject* objectDeleted : objectsDeleted)
+      ObjectDeletedFromScene(scene, objectDeleted);
+  };
+
 #if defined(GD_IDE_ONLY)
 
   /**
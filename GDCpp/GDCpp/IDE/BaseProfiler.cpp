@@ -23,6 +23,9 @@ BaseProfiler::BaseProfiler()
       lastRenderingTime(0),
       totalSceneTime(0),
       totalEventsTime(0),
+      lastDrawnObjectsCount(0),
+      lastCulledObjectsCount(0),
+      lastDrawCallsCount(0),
       stepTime(50) {
   // ctor
 }
@@ -39,6 +42,10 @@ void BaseProfiler::Reset() {
   lastRenderingTime = 0;
   totalSceneTime = 0;
   totalEventsTime = 0;
+  lastDrawnObjectsCount = 0;
+  lastCulledObjectsCount = 0;
+  lastDrawCallsCount = 0;
+  lastTextureCacheStats = gd::TextureCacheStats();
 
   for (std::size_t i = 0; i < profileEventsInformation.size(); ++i) {
     profileEventsInformation[i].time = 0;
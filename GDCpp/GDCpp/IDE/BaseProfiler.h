@@ -12,6 +12,7 @@
 #include <vector>
 #include <SFML/System.hpp>
 #include "GDCpp/Runtime/profile.h"
+#include "GDCore/Project/ImageManager.h"
 namespace gd { class BaseEvent; }
 
 /**
@@ -46,6 +47,10 @@ public:
     unsigned long int lastRenderingTime; ///< Time used by rendering during the last frame
     unsigned long int totalSceneTime; ///< Total time used by events and rendering since the beginning.
     unsigned long int totalEventsTime; ///< Total time used by events since the beginning.
+    std::size_t lastDrawnObjectsCount; ///< Number of objects drawn during the last frame
+    std::size_t lastCulledObjectsCount; ///< Number of objects not drawn during the last frame because they were outside of the cameras
+    std::size_t lastDrawCallsCount; ///< Number of draw calls done to render the objects during the last frame
+    gd::TextureCacheStats lastTextureCacheStats; ///< Statistics of the textures cache of the game at the last frame
 
     btClock eventsClock; ///< Used to compute time used by events during the frame
     btClock renderingClock; ///< Used to compute time used by rendering during the frame
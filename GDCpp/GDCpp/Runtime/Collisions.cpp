@@ -5,74 +5,127 @@
  */
 #include "GDCpp/Runtime/Collisions.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
 #include "GDCore/Project/ImageManager.h"
 #include "GDCpp/Runtime/RuntimeSpriteObject.h"
 
-bool PixelPerfectTest(const sf::Sprite& object1,
-                      const sf::Sprite& object2,
-                      sf::Uint8 AlphaLimit,
-                      const sf::Image& object1CollisionMask,
-                      const sf::Image& object2CollisionMask) {
-  sf::FloatRect intersection;
-  if (object1.getGlobalBounds().intersects(object2.getGlobalBounds(),
-                                           intersection)) {
-    // We've got an intersection we need to process the pixels
-    // in that Rect.
-
-    // Bail out now if AlphaLimit = 0
-    if (AlphaLimit == 0) return true;
+namespace {
 
-    // There are a few hacks here, sometimes the TransformToLocal returns
-    // negative points Or Points outside the image.  We need to check for these
-    // as they print to the error console which is slow, and then return black
-    // which registers as a hit.
+/**
+ * Return true if the transform is only a translation (no rotation, scale or
+ * flip).
+ */
+bool IsTranslation(const sf::Transform& transform) {
+  const float* matrix = transform.getMatrix();
+  return matrix[0] == 1 && matrix[1] == 0 && matrix[4] == 0 && matrix[5] == 1;
+}
 
-    sf::Vector2f o1v;
-    sf::Vector2f o2v;
-    // Loop through our pixels
-    for (int i = intersection.left; i < intersection.left + intersection.width;
-         i++)  // 4ian : Rect now uses width/height.
-    {
-      for (int j = intersection.top; j < intersection.top + intersection.height;
-           j++)  // 4ian : Rect now uses width/height.
-      {
-        o1v = object1.getInverseTransform().transformPoint(
-            i, j);  // Creating objects each loop :(
-        o2v = object2.getInverseTransform().transformPoint(i, j);
+/**
+ * Test the masks of two sprites that are only translated: the pixel (x, y) of
+ * the scene is the pixel (x - left, y - top) of a mask, so that the rows of
+ * the masks can be tested 64 pixels at once.
+ */
+bool TranslatedMasksTest(const gd::CollisionMask& mask1,
+                         int left1,
+                         int top1,
+                         const gd::CollisionMask& mask2,
+                         int left2,
+                         int top2) {
+  int left = std::max(left1, left2);
+  int top = std::max(top1, top2);
+  int right = std::min(left1 + static_cast<int>(mask1.GetWidth()),
+                       left2 + static_cast<int>(mask2.GetWidth()));
+  int bottom = std::min(top1 + static_cast<int>(mask1.GetHeight()),
+                        top2 + static_cast<int>(mask2.GetHeight()));
 
-        // Hack to make sure pixels fall within the Sprite's Image
-        if (o1v.x > 0 && o1v.y > 0 && o2v.x > 0 && o2v.y > 0 &&
-            o1v.x < object1CollisionMask.getSize().x &&
-            o1v.y < object1CollisionMask.getSize().y &&
-            o2v.x < object2CollisionMask.getSize().x &&
-            o2v.y < object2CollisionMask.getSize().y) {
-          // If both sprites have opaque pixels at the same point we've got a
-          // hit
-          if ((object1CollisionMask
-                   .getPixel(static_cast<int>(o1v.x), static_cast<int>(o1v.y))
-                   .a > AlphaLimit) &&
-              (object2CollisionMask
-                   .getPixel(static_cast<int>(o2v.x), static_cast<int>(o2v.y))
-                   .a > AlphaLimit)) {
-            return true;
-          }
-        }
-      }
+  // Pixels after the end of a mask are transparent, so there is no need to
+  // clear the pixels after the right of the intersection.
+  for (int y = top; y < bottom; ++y) {
+    for (int x = left; x < right; x += 64) {
+      if ((mask1.GetPixels(x - left1, y - top1) &
+           mask2.GetPixels(x - left2, y - top2)) != 0)
+        return true;
     }
+  }
+
+  return false;
+}
+
+/**
+ * Test the masks of two sprites that can be rotated, scaled or flipped: each
+ * pixel of the intersection of the sprites is transformed in the coordinates
+ * of the masks. Moving one pixel to the right in the scene only adds a
+ * constant to these coordinates, so only the first pixel of each row is
+ * transformed.
+ */
+bool TransformedMasksTest(const sf::Sprite& sprite1,
+                          const gd::CollisionMask& mask1,
+                          const sf::Sprite& sprite2,
+                          const gd::CollisionMask& mask2) {
+  sf::FloatRect intersection;
+  if (!sprite1.getGlobalBounds().intersects(sprite2.getGlobalBounds(),
+                                            intersection))
     return false;
+
+  const sf::Transform& inverse1 = sprite1.getInverseTransform();
+  const sf::Transform& inverse2 = sprite2.getInverseTransform();
+  const sf::Vector2f step1(inverse1.getMatrix()[0], inverse1.getMatrix()[1]);
+  const sf::Vector2f step2(inverse2.getMatrix()[0], inverse2.getMatrix()[1]);
+  const float width1 = mask1.GetWidth(), height1 = mask1.GetHeight();
+  const float width2 = mask2.GetWidth(), height2 = mask2.GetHeight();
+
+  int left = std::ceil(intersection.left);
+  int top = std::ceil(intersection.top);
+  int right = std::ceil(intersection.left + intersection.width);
+  int bottom = std::ceil(intersection.top + intersection.height);
+  for (int y = top; y < bottom; ++y) {
+    sf::Vector2f point1 = inverse1.transformPoint(left, y);
+    sf::Vector2f point2 = inverse2.transformPoint(left, y);
+    for (int x = left; x < right; ++x, point1 += step1, point2 += step2) {
+      if (point1.x >= 0 && point1.y >= 0 && point1.x < width1 &&
+          point1.y < height1 && point2.x >= 0 && point2.y >= 0 &&
+          point2.x < width2 && point2.y < height2 &&
+          mask1.IsOpaque(point1.x, point1.y) &&
+          mask2.IsOpaque(point2.x, point2.y))
+        return true;
+    }
   }
+
   return false;
 }
 
+}  // namespace
+
+bool GD_API PixelPerfectTest(const sf::Sprite& sprite1,
+                             const gd::CollisionMask& mask1,
+                             const sf::Sprite& sprite2,
+                             const gd::CollisionMask& mask2) {
+  const sf::Transform& transform1 = sprite1.getTransform();
+  const sf::Transform& transform2 = sprite2.getTransform();
+  if (IsTranslation(transform1) && IsTranslation(transform2)) {
+    // The pixel (x, y) of the scene is in the pixel
+    // (floor(x - translation.x), floor(y - translation.y)) of the mask.
+    return TranslatedMasksTest(mask1,
+                               std::ceil(transform1.getMatrix()[12]),
+                               std::ceil(transform1.getMatrix()[13]),
+                               mask2,
+                               std::ceil(transform2.getMatrix()[12]),
+                               std::ceil(transform2.getMatrix()[13]));
+  }
+
+  return TransformedMasksTest(sprite1, mask1, sprite2, mask2);
+}
+
 /**
  * Check for collision between two sprite objects
  */
 bool GD_API CheckCollision(const RuntimeSpriteObject* const objet1,
                            const RuntimeSpriteObject* const objet2) {
-  return PixelPerfectTest(objet1->GetCurrentSFMLSprite(),
-                          objet2->GetCurrentSFMLSprite(),
-                          1,
-                          objet1->GetCurrentSprite().GetSFMLTexture()->image,
-                          objet2->GetCurrentSprite().GetSFMLTexture()->image);
+  return PixelPerfectTest(
+      objet1->GetCurrentSFMLSprite(),
+      objet1->GetCurrentSprite().GetSFMLTexture()->collisionMask,
+      objet2->GetCurrentSFMLSprite(),
+      objet2->GetCurrentSprite().GetSFMLTexture()->collisionMask);
 }
@@ -6,6 +6,12 @@
 #ifndef COLLISIONS_H_INCLUDED
 #define COLLISIONS_H_INCLUDED
 #include "GDCpp/Runtime/RuntimeSpriteObject.h"
+namespace gd {
+class CollisionMask;
+}
+namespace sf {
+class Sprite;
+}
 
 /**
  * \brief Pixel perfect collision test between two sprite objects
@@ -19,4 +25,20 @@
 bool GD_API CheckCollision(const RuntimeSpriteObject* const objet1,
                            const RuntimeSpriteObject* const objet2);
 
+/**
+ * \brief Pixel perfect collision test between two sprites, using the
+ * collision masks of their images.
+ *
+ * Each pixel of the scene covered by both sprites is tested. Sprites that are
+ * neither rotated nor scaled are tested 64 pixels at once.
+ *
+ * \return true if opaque pixels of the sprites are overlapping
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API PixelPerfectTest(const sf::Sprite& sprite1,
+                             const gd::CollisionMask& mask1,
+                             const sf::Sprite& sprite2,
+                             const gd::CollisionMask& mask2);
+
 #endif  // COLLISIONS_H_INCLUDED
@@ -6,23 +6,45 @@
 #include <fstream>
 #include <iostream>
 #include "GDCpp/Runtime/Tools/FileStream.h"
+#if defined(WINDOWS)
+#include <windows.h>
+#elif defined(LINUX) || defined(MACOS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-DatFile::DatFile(void) { m_buffer = NULL; }
+namespace {
 
-DatFile::~DatFile(void) {
-  if (m_buffer != NULL) delete[] m_buffer;
+long AlignOffset(long offset) {
+  return (offset + DatFile::dataAlignment - 1) / DatFile::dataAlignment *
+         DatFile::dataAlignment;
 }
+
+}  // namespace
+
+const long DatFile::dataAlignment;
+
+DatFile::DatFile(void) : m_buffer(NULL), m_data(NULL), m_dataSize(0) {
+  memset(&m_header, 0, sizeof(m_header));
+}
+
+DatFile::~DatFile(void) { Close(); }
+
 bool DatFile::Create(std::vector<gd::String> files,
                      gd::String directory,
                      gd::String destination) {
+  Close();
+
   // An file entry in order to push it in the object's std::vector
   sFileEntry entry;
   // An input file stream to read each file included
   gd::FileStream file;
   // An output file stream to write our DAT file
   gd::FileStream datfile;
-  // The buffer used to read/write the DAT file
-  char buffer[1];
+  // Zeros written between files so that their data are aligned
+  char padding[dataAlignment] = {0};
 
   // DATHeader
   // We start by filling it with 0
@@ -42,7 +64,7 @@ bool DatFile::Create(std::vector<gd::String> files,
       // Filling the FileEntry with 0
       memset(&entry, 0, sizeof(sFileEntry));
       // We keep the file name
-      memcpy(entry.name, files[i].c_str(), strlen(files[i].c_str()));
+      strncpy(entry.name, files[i].c_str(), sizeof(entry.name) - 1);
       // We calculate its size
       file.seekg(0, std::ios::end);
       entry.size = file.tellg();
@@ -61,13 +83,15 @@ bool DatFile::Create(std::vector<gd::String> files,
     }
   }
 
-  // Now, we know everything about our files, we can update offsets
+  // Now, we know everything about our files, we can update offsets. Each file
+  // starts on an aligned offset, so that its data can be used directly once
+  // the DAT file is mapped in memory.
   long actual_offset = 0;
   actual_offset += sizeof(sDATHeader);
   actual_offset += m_header.nb_files * sizeof(sFileEntry);
   for (std::size_t i = 0; i < m_entries.size(); i++) {
-    m_entries[i].offset = actual_offset;
-    actual_offset += m_entries[i].size;
+    m_entries[i].offset = AlignOffset(actual_offset);
+    actual_offset = m_entries[i].offset + m_entries[i].size;
   }
 
   // And finally, we are writing the DAT file
@@ -82,12 +106,16 @@ bool DatFile::Create(std::vector<gd::String> files,
   }
 
   // Finally, we write each file
+  long written = sizeof(sDATHeader) + m_header.nb_files * sizeof(sFileEntry);
   for (std::size_t i = 0; i < m_entries.size(); i++) {
+    datfile.write(padding, m_entries[i].offset - written);
+    written = m_entries[i].offset + m_entries[i].size;
+
     gd::String fileToOpen = directory + "/" + files[i];
     file.open(fileToOpen, std::ios_base::in | std::ios_base::binary);
     if (file.is_open()) {
       file.seekg(0, std::ios::beg);
-      datfile << file.rdbuf();
+      if (m_entries[i].size > 0) datfile << file.rdbuf();
       file.close();
     }
   }
@@ -96,107 +124,194 @@ bool DatFile::Create(std::vector<gd::String> files,
   return true;
 }
 
+/**
+ * Map the whole DAT file in memory, or load it in memory if it can't be
+ * mapped. Return true on success
+ */
+bool DatFile::MapInMemory(const gd::String& source) {
+#if defined(WINDOWS)
+  HANDLE file = CreateFileW(source.ToWide().c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            NULL,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            NULL);
+  if (file != INVALID_HANDLE_VALUE) {
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+      HANDLE mapping =
+          CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping != NULL) {
+        // The view keeps the mapping alive once its handle is closed.
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view != NULL) {
+          m_content = std::shared_ptr<const char>(
+              static_cast<const char*>(view),
+              [](const char* data) { UnmapViewOfFile(data); });
+          m_dataSize = size.QuadPart;
+        }
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+    if (m_content) {
+      m_data = m_content.get();
+      return true;
+    }
+  }
+#elif defined(LINUX) || defined(MACOS)
+  int file = open(source.ToLocale().c_str(), O_RDONLY);
+  if (file != -1) {
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0) {
+      // The mapping stays valid once the file is closed.
+      std::size_t size = fileStat.st_size;
+      void* view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+      if (view != MAP_FAILED) {
+        m_content = std::shared_ptr<const char>(
+            static_cast<const char*>(view), [size](const char* data) {
+              munmap(const_cast<char*>(data), size);
+            });
+        m_dataSize = size;
+      }
+    }
+    close(file);
+    if (m_content) {
+      m_data = m_content.get();
+      return true;
+    }
+  }
+#endif
+
+  gd::FileStream datfile(source,
+                         std::ios_base::in | std::ios_base::binary |
+                             std::ios_base::ate);
+  if (!datfile.is_open()) return false;
+
+  std::streamoff size = datfile.tellg();
+  if (size <= 0) return false;
+
+  char* content = new char[size];
+  datfile.seekg(0, std::ios::beg);
+  if (!datfile.read(content, size)) {
+    delete[] content;
+    return false;
+  }
+
+  m_content = std::shared_ptr<const char>(
+      content, [](const char* data) { delete[] data; });
+  m_data = m_content.get();
+  m_dataSize = size;
+  return true;
+}
+
 /**
  * Load the DatFile from a file. Return true on success
  */
 bool DatFile::Read(gd::String source) {
-  bool success = false;
+  Close();
+  if (!MapInMemory(source)) return false;
 
-  // The input file stream from which we want informations
-  gd::FileStream datfile;
-  // A file entry in order to push it in the object's std::vector
-  sFileEntry entry;
+  // Reading the DAT Header
+  if (m_dataSize < sizeof(sDATHeader)) {
+    cout << "The DAT file " << source << " is too small." << endl;
+    Close();
+    return false;
+  }
+  memcpy(&m_header, m_data, sizeof(sDATHeader));
+  if (memcmp(m_header.uniqueID, "EXEGD", 5) != 0 ||
+      m_header.nb_files >
+          (m_dataSize - sizeof(sDATHeader)) / sizeof(sFileEntry)) {
+    cout << "The DAT file " << source << " is invalid." << endl;
+    Close();
+    return false;
+  }
 
-  // Filling the header with 0
-  memset(&m_header, 0, sizeof(m_header));
-  // We open the DAT file to read it
-  datfile.open(source, std::ios_base::in | std::ios_base::binary);
-  if (datfile.is_open()) {
-    // Getting to the Header position
-    datfile.seekg(0, std::ios::beg);
-    // Reading the DAT Header
-    datfile.read((char*)&m_header, sizeof(sDATHeader));
-    // Next we are reading each file entry
-    for (std::size_t i = 0; i < m_header.nb_files; i++) {
-      // Reading a File Entry
-      datfile.read((char*)&entry, sizeof(sFileEntry));
-      // Pushing it in our std::vector
-      m_entries.push_back(entry);
+  // Next we are reading each file entry
+  m_entries.resize(m_header.nb_files);
+  memcpy(m_entries.data(),
+         m_data + sizeof(sDATHeader),
+         m_header.nb_files * sizeof(sFileEntry));
+
+  m_index.reserve(m_entries.size());
+  for (std::size_t i = 0; i < m_entries.size(); i++) {
+    sFileEntry& entry = m_entries[i];
+    entry.name[sizeof(entry.name) - 1] = '\0';
+    if (entry.size < 0 || entry.offset < 0 ||
+        static_cast<std::size_t>(entry.offset) > m_dataSize ||
+        static_cast<std::size_t>(entry.size) > m_dataSize - entry.offset) {
+      cout << "The file " << entry.name << " is outside of the DAT file "
+           << source << endl;
+      Close();
+      return false;
     }
-    // Since all seems ok, we keep the DAT file name
-    m_datfile = source;
-    success = true;
+
+    m_index.emplace(gd::String(entry.name), i);
   }
-  // Closing the DAT file
-  datfile.close();
-  return success;
+
+  // Since all seems ok, we keep the DAT file name
+  m_datfile = source;
+  return true;
+}
+
+void DatFile::Close() {
+  if (m_buffer != NULL) {
+    delete[] m_buffer;
+    m_buffer = NULL;
+  }
+
+  // The content is unmapped once not used anymore by GetSharedFileData users.
+  m_content.reset();
+  m_data = NULL;
+  m_dataSize = 0;
+
+  memset(&m_header, 0, sizeof(m_header));
+  m_entries.clear();
+  m_index.clear();
+  m_datfile.clear();
+}
+
+const sFileEntry* DatFile::FindEntry(const gd::String& filename) const {
+  auto it = m_index.find(filename);
+  return it != m_index.end() ? &m_entries[it->second] : nullptr;
 }
 
 ////////////////////////////////////////////////////////////
 /// Check if the DatFile contains a file
 ////////////////////////////////////////////////////////////
-bool DatFile::ContainsFile(const gd::String& filename) {
-  if (m_header.nb_files != m_entries.size()) return false;
+bool DatFile::ContainsFile(const gd::String& filename) const {
+  return FindEntry(filename) != nullptr;
+}
 
-  for (std::size_t i = 0; i < m_header.nb_files; i++) {
-    if (gd::String(m_entries[i].name) == filename) return true;
-  }
+const char* DatFile::GetFileData(const gd::String& filename) const {
+  const sFileEntry* entry = FindEntry(filename);
+  return entry ? m_data + entry->offset : nullptr;
+}
 
-  return false;
+std::shared_ptr<const char> DatFile::GetSharedFileData(
+    const gd::String& filename) const {
+  const sFileEntry* entry = FindEntry(filename);
+  return entry ? std::shared_ptr<const char>(m_content, m_data + entry->offset)
+               : nullptr;
 }
 
 char* DatFile::GetFile(gd::String filename) {
-  // The input file stream from which we want information
-  gd::FileStream datfile;
-
   // Cleaning properly an ancient file loaded
   if (m_buffer != NULL) {
     delete[] m_buffer;
     m_buffer = NULL;
   }
 
-  // First, we have to find the file needed
-  for (std::size_t i = 0; i < m_header.nb_files; i++) {
-    // If we found it
-    if (gd::String(m_entries[i].name) == filename) {
-      // We are allocating memory to the buffer
-      m_buffer = new char[(m_entries[i].size)];
-      // Simple error catch
-      if (m_buffer == NULL) {
-        cout << "Unable to allocate a buffer of length " << (m_entries[i].size)
-             << " when loading " << filename << endl;
-        return (NULL);
-      }
+  const sFileEntry* entry = FindEntry(filename);
+  if (!entry) return (NULL);
 
-      // Opening the DAT file ot read the file datas needed
-      datfile.open(m_datfile, std::ios_base::in | std::ios_base::binary);
-      if (datfile.is_open()) {
-        // Going to the right position
-        datfile.seekg(m_entries[i].offset, std::ios::beg);
-        // Reading
-        datfile.read(m_buffer, m_entries[i].size);
-        // We can close the DAT file
-        datfile.close();
-        // Returning the buffer
-        cout << "Successfully loaded " << filename << endl;
-        return (m_buffer);
-      }
-      cout << "Unable to open file " << m_datfile << " when loading "
-           << filename << endl;
-    }
-  }
-  // Finally, there is no such file in our DAT file
-  return (NULL);
+  m_buffer = new char[entry->size];
+  memcpy(m_buffer, m_data + entry->offset, entry->size);
+  return (m_buffer);
 }
 
-long int DatFile::GetFileSize(gd::String filename) {
-  // First, we have to find the file needed
-  for (std::size_t i = 0; i < m_header.nb_files; i++) {
-    // If we found it
-    if (gd::String(m_entries[i].name) == filename) {
-      // Returning the size of the file found
-      return (m_entries[i].size);
-    }
-  }
-  return (0);
+long int DatFile::GetFileSize(const gd::String& filename) const {
+  const sFileEntry* entry = FindEntry(filename);
+  return entry ? entry->size : 0;
 }
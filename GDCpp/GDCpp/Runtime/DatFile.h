@@ -8,7 +8,9 @@
 #ifndef DATFILE_H
 #define DATFILE_H
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "GDCpp/Runtime/String.h"
 
@@ -40,6 +42,12 @@ struct sFileEntry {
 /**
  * \brief Internal class used to create and access "DAT files".
  *
+ * When read, the DAT file is mapped in memory once (or entirely loaded in
+ * memory if the system doesn't support memory mapping) and the files it
+ * contains are accessed without any copy with GetFileData, or with
+ * GetSharedFileData to keep them in memory after the DatFile is closed. The
+ * data of the files are aligned on DatFile::dataAlignment bytes by Create.
+ *
  * \ingroup ResourcesManagement
  */
 class GD_API DatFile {
@@ -47,17 +55,67 @@ class GD_API DatFile {
   gd::String m_datfile;               /// name of the DAT file
   sDATHeader m_header;                /// file header
   std::vector<sFileEntry> m_entries;  /// vector of files entries
-  char* m_buffer;                     /// Buffer pointing on a file in memory
+  std::unordered_map<gd::String, std::size_t>
+      m_index;           /// Position of the entry of each file in m_entries
+  char* m_buffer;        /// Buffer pointing on a file in memory
+  std::shared_ptr<const char> m_content;  /// The content of the DAT file,
+                                          /// mapped in memory (or loaded if
+                                          /// it can't be mapped), unmapped
+                                          /// when not shared anymore
+  const char* m_data;      /// The content of the DAT file (m_content.get())
+  std::size_t m_dataSize;  /// The size of the DAT file
+
+  const sFileEntry* FindEntry(const gd::String& filename) const;
+  bool MapInMemory(const gd::String& source);
+
  public:
+  static const long dataAlignment = 16;
+
   DatFile(void);
   ~DatFile(void);
+  DatFile(const DatFile&) = delete;
+  DatFile& operator=(const DatFile&) = delete;
+
   bool Create(std::vector<gd::String> files,
               gd::String directory,
               gd::String destination);
-  bool ContainsFile(const gd::String& filename);
+  bool ContainsFile(const gd::String& filename) const;
   bool Read(gd::String source);
+
+  /**
+   * \brief Unmap the DAT file and forget about the files it contains.
+   */
+  void Close();
+
+  /**
+   * \brief Return a pointer to the content of a file stored in the DAT file,
+   * or nullptr if there is no such file.
+   *
+   * The content is not copied: it stays valid until the DatFile is closed or
+   * destroyed, and must not be modified. Use GetFileSize to know its size.
+   */
+  const char* GetFileData(const gd::String& filename) const;
+
+  /**
+   * \brief Return a pointer to the content of a file stored in the DAT file,
+   * or nullptr if there is no such file.
+   *
+   * Like GetFileData, the content is not copied, but the whole DAT file stays
+   * in memory as long as the returned pointer (or a copy of it) is alive, even
+   * if the DatFile is closed or destroyed.
+   */
+  std::shared_ptr<const char> GetSharedFileData(
+      const gd::String& filename) const;
+
+  /**
+   * \brief Return a copy of the content of a file stored in the DAT file, or
+   * NULL if there is no such file.
+   *
+   * The copy is owned by the DatFile and is freed at the next call.
+   * \see GetFileData
+   */
   char* GetFile(gd::String filename);
-  long int GetFileSize(gd::String filename);
+  long int GetFileSize(const gd::String& filename) const;
 };
 
 #endif  // DATFILE_H
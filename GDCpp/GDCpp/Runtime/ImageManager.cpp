@@ -5,5 +5,8 @@
  */
 
 #if !defined(GD_IDE_ONLY)
+// Load images with the ResourcesLoader of games, which can read them from the
+// resource file: it must be included first, as it replaces the one of GDCore.
+#include "GDCpp/Runtime/ResourcesLoader.h"
 #include "GDCore/Project/ImageManager.cpp"
 #endif
@@ -4,63 +4,192 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include <limits>
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/profile.h"
 
+namespace {
+/**
+ * \brief The identifiers given to objects names, shared by all the
+ * containers.
+ */
+struct ObjectNamesIds {
+  std::unordered_map<gd::String, std::size_t> ids;
+  std::vector<gd::String> names;
+};
+
+ObjectNamesIds& GetObjectNamesIds() {
+  static ObjectNamesIds objectNamesIds;
+  return objectNamesIds;
+}
+}  // namespace
+
+std::size_t ObjInstancesHolder::GetObjectNameId(const gd::String& name) {
+  ObjectNamesIds& objectNamesIds = GetObjectNamesIds();
+  auto it = objectNamesIds.ids.find(name);
+  if (it != objectNamesIds.ids.end()) return it->second;
+
+  std::size_t id = objectNamesIds.names.size();
+  objectNamesIds.names.push_back(name);
+  objectNamesIds.ids[name] = id;
+  return id;
+}
+
+std::size_t ObjInstancesHolder::GetObjectNamesCount() {
+  return GetObjectNamesIds().names.size();
+}
+
+void ObjInstancesHolder::Reserve(std::size_t objectNamesCount) {
+  if (objectsInstances.size() >= objectNamesCount) return;
+
+  objectsInstances.resize(objectNamesCount);
+  objectsInstancesRefs.resize(objectNamesCount);
+  listsHavingRemovedObjects.resize(objectNamesCount, false);
+}
+
 RuntimeObject* ObjInstancesHolder::AddObject(RuntimeObjSPtr&& object) {
-  auto it = objectsInstances[object->GetName()].insert(
-      objectsInstances[object->GetName()].end(), std::move(object));
-  objectsInstancesRefs[(*it)->GetName()].push_back(it->get());
+  RuntimeObject* objectPtr = object.get();
+  if (objectPtr->GetName().empty()) {
+    if (renderQueue) renderQueue->RemoveObject(objectPtr);
 
-  return it->get();
+    objectPtr->instancesHolderNameId = std::numeric_limits<std::size_t>::max();
+    objectPtr->instancesHolderIndex = objectsToBeDeleted.size();
+    objectsToBeDeleted.push_back(std::move(object));
+    objectsToBeDeletedRefs.push_back(objectPtr);
+
+    return objectPtr;
+  }
+
+  std::size_t id = GetObjectNameId(objectPtr->GetName());
+  Reserve(id + 1);
+  if (renderQueue) renderQueue->AddObject(objectPtr);
+
+  objectPtr->instancesHolderNameId = id;
+  objectPtr->instancesHolderIndex = objectsInstances[id].size();
+  objectsInstances[id].push_back(std::move(object));
+  objectsInstancesRefs[id].push_back(objectPtr);
+
+  return objectPtr;
+}
+
+RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
+    std::size_t objectNameId) {
+  if (objectNameId >= objectsInstancesRefs.size())
+    return RuntimeObjNonOwningPtrList();
+
+  if (listsHavingRemovedObjects[objectNameId]) CompactList(objectNameId);
+  return objectsInstancesRefs[objectNameId];
 }
 
 RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
     const gd::String& name) {
-  return objectsInstancesRefs[name];
+  return GetObjectsRawPointers(GetObjectNameId(name));
 }
 
-void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
-  std::unique_ptr<RuntimeObject> theObject;  // We need the object to keep
-                                             // alive.
-
-  // Find and erase the object from the object lists.
-  for (auto it = objectsInstances.begin(); it != objectsInstances.end(); ++it) {
-    RuntimeObjList& list = it->second;
-    for (std::size_t i = 0; i < list.size(); ++i) {
-      if (list[i].get() == object) {
-        theObject = std::move(list[i]);
-        list.erase(list.begin() + i);
-        break;
-      }
+void ObjInstancesHolder::GetAllObjects(RuntimeObjNonOwningPtrList& objList) {
+  CompactLists();
+  objList.clear();
+  for (auto& list : objectsInstancesRefs)
+    objList.insert(objList.end(), list.begin(), list.end());
+}
+
+std::unique_ptr<RuntimeObject> ObjInstancesHolder::TakeObject(
+    const RuntimeObject* object) {
+  // Objects know their position in their list, so there is no need to search
+  // for them.
+  std::size_t id = object->instancesHolderNameId;
+  std::size_t index = object->instancesHolderIndex;
+  if (id < objectsInstances.size() && index < objectsInstances[id].size() &&
+      objectsInstances[id][index].get() == object) {
+    std::unique_ptr<RuntimeObject> theObject =
+        std::move(objectsInstances[id][index]);
+    objectsInstancesRefs[id][index] = nullptr;
+    if (!listsHavingRemovedObjects[id]) {
+      listsHavingRemovedObjects[id] = true;
+      listsToCompact.push_back(id);
     }
+
+    return theObject;
   }
-  // Find and erase the object from the object raw pointers lists.
-  for (auto it = objectsInstancesRefs.begin(); it != objectsInstancesRefs.end();
-       ++it) {
-    RuntimeObjNonOwningPtrList& associatedList = it->second;
-    associatedList.erase(
-        std::remove(associatedList.begin(), associatedList.end(), object),
-        associatedList.end());
+
+  for (std::size_t i = 0; i < objectsToBeDeleted.size(); ++i) {
+    if (objectsToBeDeleted[i].get() == object) {
+      std::unique_ptr<RuntimeObject> theObject =
+          std::move(objectsToBeDeleted[i]);
+      objectsToBeDeleted.erase(objectsToBeDeleted.begin() + i);
+      objectsToBeDeletedRefs.erase(objectsToBeDeletedRefs.begin() + i);
+      for (; i < objectsToBeDeleted.size(); ++i)
+        objectsToBeDeleted[i]->instancesHolderIndex = i;
+
+      return theObject;
+    }
   }
 
-  AddObject(std::move(theObject));
+  return nullptr;
+}
+
+void ObjInstancesHolder::CompactList(std::size_t objectNameId) {
+  RuntimeObjList& list = objectsInstances[objectNameId];
+  RuntimeObjNonOwningPtrList& associatedList =
+      objectsInstancesRefs[objectNameId];
+
+  std::size_t finalSize = 0;
+  for (std::size_t i = 0; i < list.size(); ++i) {
+    if (!list[i]) continue;
+
+    if (i != finalSize) {
+      list[finalSize] = std::move(list[i]);
+      associatedList[finalSize] = associatedList[i];
+      associatedList[finalSize]->instancesHolderIndex = finalSize;
+    }
+    finalSize++;
+  }
+  list.resize(finalSize);
+  associatedList.resize(finalSize);
+  listsHavingRemovedObjects[objectNameId] = false;
+}
+
+void ObjInstancesHolder::CompactLists() {
+  for (std::size_t id : listsToCompact) {
+    if (listsHavingRemovedObjects[id]) CompactList(id);
+  }
+  listsToCompact.clear();
+}
+
+void ObjInstancesHolder::RemoveObject(RuntimeObject* object) {
+  TakeObject(object);  // The object is destroyed with the returned pointer.
+}
+
+void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
+  std::unique_ptr<RuntimeObject> theObject =
+      TakeObject(object);  // We need the object to keep alive.
+
+  if (theObject) AddObject(std::move(theObject));
+}
+
+void ObjInstancesHolder::DestroyObjectsToBeDeleted() {
+  objectsToBeDeleted.clear();
+  objectsToBeDeletedRefs.clear();
 }
 
 void ObjInstancesHolder::Init(const ObjInstancesHolder& other) {
-  objectsInstances.clear();
-  objectsInstancesRefs.clear();
+  Clear();
 
   for (auto it = other.objectsInstances.cbegin();
        it != other.objectsInstances.cend();
        ++it) {
-    for (std::size_t i = 0; i < it->second.size();
+    for (std::size_t i = 0; i < it->size();
          ++i)  // We need to really copy the objects
-      AddObject(std::unique_ptr<RuntimeObject>(it->second[i]->Clone()));
+      if ((*it)[i])
+        AddObject(std::unique_ptr<RuntimeObject>((*it)[i]->Clone()));
   }
+  for (std::size_t i = 0; i < other.objectsToBeDeleted.size(); ++i)
+    AddObject(
+        std::unique_ptr<RuntimeObject>(other.objectsToBeDeleted[i]->Clone()));
 }
 
-ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder& other) {
+ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder& other)
+    : renderQueue(nullptr) {
   Init(other);
 }
 
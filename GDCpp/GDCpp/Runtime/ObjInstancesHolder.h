@@ -2,11 +2,13 @@
 #define OBJINSTANCESHOLDER_H
 
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "GDCpp/Runtime/RenderQueue.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/String.h"
 
@@ -20,6 +22,11 @@ using RuntimeObjSPtr = std::unique_ptr<RuntimeObject>;
 /**
  * \brief Contains lists of objects classified by the name of the objects.
  *
+ * Names of objects are associated to a dense integer identifier (see
+ * GetObjectNameId), and lists are stored in arrays indexed by these
+ * identifiers. Code called often (events generated code, extensions) should
+ * resolve names once and then use the functions taking an identifier.
+ *
  * \see RuntimeScene
  * \ingroup GameEngine
  */
@@ -28,7 +35,7 @@ class GD_API ObjInstancesHolder {
   /**
    * \brief Default constructor
    */
-  ObjInstancesHolder(){};
+  ObjInstancesHolder() : renderQueue(nullptr){};
 
   /**
    * \brief Copy constructor
@@ -46,6 +53,21 @@ class GD_API ObjInstancesHolder {
    */
   ObjInstancesHolder& operator=(const ObjInstancesHolder& other);
 
+  /**
+   * \brief Return the identifier associated to an object name.
+   *
+   * Identifiers are given the first time a name is seen, are dense (from 0 to
+   * GetObjectNamesCount() - 1) and are shared by all the containers, so that
+   * they can be resolved once (for example when a scene or events code is
+   * loaded) and then used with any scene.
+   */
+  static std::size_t GetObjectNameId(const gd::String& name);
+
+  /**
+   * \brief Return the number of identifiers given by GetObjectNameId.
+   */
+  static std::size_t GetObjectNamesCount();
+
   /**
    * \brief Add a new object to the lists.
    * \note The object is then hold in the container and you can
@@ -53,13 +75,30 @@ class GD_API ObjInstancesHolder {
    */
   RuntimeObject* AddObject(RuntimeObjSPtr&& object);
 
+  /**
+   * \brief Get all objects with the specified name identifier
+   * \see GetObjectNameId
+   */
+  inline const RuntimeObjList& GetObjects(std::size_t objectNameId) {
+    if (objectNameId >= objectsInstances.size()) Reserve(objectNameId + 1);
+    if (listsHavingRemovedObjects[objectNameId]) CompactList(objectNameId);
+    return objectsInstances[objectNameId];
+  }
+
   /**
    * \brief Get all objects with the specified name
    */
   inline const RuntimeObjList& GetObjects(const gd::String& name) {
-    return objectsInstances[name];
+    return GetObjects(GetObjectNameId(name));
   }
 
+  /**
+   * \brief Get a "raw pointers" list to objects with the specified name
+   * identifier
+   * \see GetObjectNameId
+   */
+  RuntimeObjNonOwningPtrList GetObjectsRawPointers(std::size_t objectNameId);
+
   /**
    * \brief Get a "raw pointers" list to objects with the specified name
    */
@@ -70,79 +109,150 @@ class GD_API ObjInstancesHolder {
    */
   inline RuntimeObjNonOwningPtrList GetAllObjects() {
     RuntimeObjNonOwningPtrList objList;
-
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
-        objList.push_back(it2->get());
-      }
-    }
+    GetAllObjects(objList);
 
     return objList;
   }
 
   /**
-   * \brief Remove an object
+   * \brief Fill \a objList with all objects contained.
    *
-   * \warning During the game, do not directly remove an object using this
-   * function, but make its name empty instead. Example: \code
-   * myObject->SetName(""); //The scene will take care of deleting the object
-   * scene.objectsInstances.ObjectNameHasChanged(myObject);
-   * \endcode
-   */
-  inline void RemoveObject(RuntimeObject* object) {
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      RuntimeObjList& associatedList = it->second;
-      associatedList.erase(
-          std::remove_if(
-              associatedList.begin(),
-              associatedList.end(),
-              [&object](const std::unique_ptr<RuntimeObject>& objectPtr) {
-                return objectPtr.get() == object;
-              }),
-          associatedList.end());
-    }
-    for (auto it = objectsInstancesRefs.begin();
-         it != objectsInstancesRefs.end();
-         ++it) {
-      RuntimeObjNonOwningPtrList& associatedList = it->second;
-      associatedList.erase(
-          std::remove(associatedList.begin(), associatedList.end(), object),
-          associatedList.end());
+   * Prefer this to GetAllObjects() when called at each frame: the same list
+   * can be reused to avoid any allocation.
+   */
+  void GetAllObjects(RuntimeObjNonOwningPtrList& objList);
+
+  /**
+   * \brief Call \a callback for each object contained, without creating any
+   * list.
+   *
+   * \warning Objects must not be added, removed or renamed by \a callback.
+   * Use GetAllObjects if this can happen.
+   */
+  template <typename Callback>
+  void ForEachObject(Callback callback) {
+    CompactLists();
+    for (auto& list : objectsInstances) {
+      for (auto& object : list) callback(object.get());
     }
   }
 
+  /**
+   * \brief Remove and destroy an object
+   *
+   * \warning During the game, do not directly remove an object using this
+   * function, but use RuntimeObject::DeleteFromScene instead. The object is
+   * then moved to the objects to be deleted (see GetObjectsToBeDeleted) and
+   * the scene will take care of deleting it.
+   */
+  void RemoveObject(RuntimeObject* object);
+
+  /**
+   * \brief Remove an entire list of object with a given name identifier
+   */
+  inline void RemoveObjects(std::size_t objectNameId) {
+    if (objectNameId >= objectsInstances.size()) return;
+    objectsInstances[objectNameId].clear();
+    objectsInstancesRefs[objectNameId].clear();
+    listsHavingRemovedObjects[objectNameId] = false;
+  }
+
   /**
    * \brief Remove an entire list of object with a given name
    */
   inline void RemoveObjects(const gd::String& name) {
-    objectsInstances[name].clear();
-    objectsInstancesRefs[name].clear();
+    RemoveObjects(GetObjectNameId(name));
   }
 
   /**
    * \brief To be called when an object has changed its name.
+   *
+   * Objects with an empty name are moved to the objects to be deleted.
+   * This is done in constant time: the list containing the object is only
+   * compacted the next time it is accessed, once for all the objects removed
+   * from it.
    */
   void ObjectNameHasChanged(const RuntimeObject* object);
 
+  /**
+   * \brief Return the objects that were deleted from the scene (i.e: having
+   * an empty name) and are waiting to be destroyed.
+   *
+   * \see DestroyObjectsToBeDeleted
+   */
+  const RuntimeObjNonOwningPtrList& GetObjectsToBeDeleted() const {
+    return objectsToBeDeletedRefs;
+  }
+
+  /**
+   * \brief Destroy the objects returned by GetObjectsToBeDeleted.
+   */
+  void DestroyObjectsToBeDeleted();
+
+  /**
+   * \brief Set the render queue where objects are added, or nullptr.
+   *
+   * Objects are added to the queue when they are added to the container, and
+   * removed from it when they are deleted or destroyed.
+   */
+  void SetRenderQueue(RenderQueue* renderQueue_) { renderQueue = renderQueue_; }
+
+  /**
+   * \brief Make sure that lists exist for the identifiers from 0 to
+   * \a objectNamesCount - 1, so that no list is created during the game.
+   */
+  void Reserve(std::size_t objectNamesCount);
+
   /**
    * \brief Clear the container.
    * \note All objects contained inside are destroyed.
    */
   inline void Clear() {
+    if (renderQueue) renderQueue->Clear();
     objectsInstances.clear();
     objectsInstancesRefs.clear();
+    listsHavingRemovedObjects.clear();
+    listsToCompact.clear();
+    objectsToBeDeleted.clear();
+    objectsToBeDeletedRefs.clear();
   }
 
  private:
   void Init(const ObjInstancesHolder& other);
 
-  std::unordered_map<gd::String, RuntimeObjList>
-      objectsInstances;  ///< The list of all objects, classified by name
-  std::unordered_map<gd::String, RuntimeObjNonOwningPtrList>
+  /**
+   * \brief Take an object out of the list containing it, leaving an empty
+   * slot that will be removed by CompactList.
+   * \return The object, or nullptr if it is not in the container.
+   */
+  std::unique_ptr<RuntimeObject> TakeObject(const RuntimeObject* object);
+
+  /**
+   * \brief Remove the empty slots of a list, keeping the order of objects.
+   */
+  void CompactList(std::size_t objectNameId);
+
+  /**
+   * \brief Remove the empty slots of all lists.
+   */
+  void CompactLists();
+
+  std::deque<RuntimeObjList>
+      objectsInstances;  ///< The list of all objects, indexed by the
+                         ///< identifier of their name. A deque is used so
+                         ///< that references to lists stay valid when new
+                         ///< lists are added.
+  std::deque<RuntimeObjNonOwningPtrList>
       objectsInstancesRefs;  ///< Clones of the objectsInstances lists, but with
                              ///< references instead.
+  std::vector<bool> listsHavingRemovedObjects;  ///< For each list, true if it
+                                                ///< has empty slots.
+  std::vector<std::size_t>
+      listsToCompact;  ///< The identifiers of the lists having empty slots.
+  RuntimeObjList objectsToBeDeleted;  ///< Objects with an empty name.
+  RuntimeObjNonOwningPtrList objectsToBeDeletedRefs;
+  RenderQueue* renderQueue;  ///< The render queue where objects are added, if
+                             ///< any.
 };
 
 #endif  // OBJINSTANCESHOLDER_H
@@ -0,0 +1,115 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
+#include <cmath>
+#include <limits>
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+const int ObjectsBroadPhase::maxCellsPerItem = 16;
+
+ObjectsBroadPhase::ObjectsBroadPhase()
+    : cellSize(1), cellSizeInverse(1), queryStamp(0) {}
+
+void ObjectsBroadPhase::Reset() {
+  itemsBounds.clear();
+  cellEntries.clear();
+  largeItems.clear();
+  unboundedItems.clear();
+}
+
+std::size_t ObjectsBroadPhase::Add(const sf::FloatRect& bounds) {
+  itemsBounds.push_back(bounds);
+  return itemsBounds.size() - 1;
+}
+
+void ObjectsBroadPhase::Build() {
+  cellEntries.clear();
+  largeItems.clear();
+  unboundedItems.clear();
+  if (itemsStamp.size() < itemsBounds.size())
+    itemsStamp.resize(itemsBounds.size(), queryStamp);
+
+  // Use the average size of the items as the cell size: most items will
+  // then be in one to four cells.
+  double extentsSum = 0;
+  std::size_t finiteItemsCount = 0;
+  for (const sf::FloatRect& bounds : itemsBounds) {
+    if (!IsFinite(bounds)) continue;
+    extentsSum += std::max(bounds.width, bounds.height);
+    finiteItemsCount++;
+  }
+  cellSize = finiteItemsCount > 0 ? extentsSum / finiteItemsCount : 1;
+  if (!(cellSize >= 1)) cellSize = 1;
+  cellSizeInverse = 1 / cellSize;
+
+  for (std::size_t item = 0; item < itemsBounds.size(); ++item) {
+    const sf::FloatRect& bounds = itemsBounds[item];
+    if (!IsFinite(bounds)) {
+      unboundedItems.push_back(item);
+      continue;
+    }
+
+    int left = CellCoordinate(bounds.left);
+    int top = CellCoordinate(bounds.top);
+    int right = CellCoordinate(bounds.left + bounds.width);
+    int bottom = CellCoordinate(bounds.top + bounds.height);
+    if (static_cast<double>(right - left + 1) * (bottom - top + 1) >
+        maxCellsPerItem) {
+      largeItems.push_back(item);
+      continue;
+    }
+
+    for (int y = top; y <= bottom; ++y) {
+      for (int x = left; x <= right; ++x) {
+        CellEntry entry;
+        entry.cell = CellKey(x, y);
+        entry.item = item;
+        cellEntries.push_back(entry);
+      }
+    }
+  }
+
+  std::sort(cellEntries.begin(), cellEntries.end());
+}
+
+void ObjectsBroadPhase::NextQueryStamp() {
+  queryStamp++;
+  if (queryStamp == 0) {  // Overflow: forget about all the previous queries.
+    std::fill(itemsStamp.begin(), itemsStamp.end(), 0);
+    queryStamp = 1;
+  }
+}
+
+int ObjectsBroadPhase::CellCoordinate(float value) const {
+  double cell = std::floor(static_cast<double>(value) * cellSizeInverse);
+  if (cell < std::numeric_limits<int>::min() / 2)
+    return std::numeric_limits<int>::min() / 2;
+  if (cell > std::numeric_limits<int>::max() / 2)
+    return std::numeric_limits<int>::max() / 2;
+
+  return static_cast<int>(cell);
+}
+
+bool ObjectsBroadPhase::IsFinite(const sf::FloatRect& rect) {
+  return std::isfinite(rect.left) && std::isfinite(rect.top) &&
+         std::isfinite(rect.width) && std::isfinite(rect.height) &&
+         rect.width >= 0 && rect.height >= 0;
+}
+
+sf::FloatRect ObjectsBroadPhase::GetBoundingCircleAABB(RuntimeObject& object) {
+  float width = object.GetWidth();
+  float height = object.GetHeight();
+  float radius = sqrt(width * width + height * height) / 2.0;
+
+  // Add a small margin so that rounding errors never discard an object
+  // that the exact bounding circle test would have kept.
+  radius += 1;
+
+  return sf::FloatRect(object.GetDrawableX() + object.GetCenterX() - radius,
+                       object.GetDrawableY() + object.GetCenterY() - radius,
+                       radius * 2,
+                       radius * 2);
+}
@@ -0,0 +1,177 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSBROADPHASE_H
+#define OBJECTSBROADPHASE_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+class RuntimeObject;
+
+/**
+ * \brief A uniform grid used to quickly find the items having their bounds
+ * overlapping a rectangle.
+ *
+ * Objects can be moved at any time by events, so the grid is rebuilt each
+ * time it is needed (building it is linear in the number of items). Its
+ * storage is kept between builds, so that it does not allocate anything once
+ * the scene is running.
+ *
+ * Usage:
+ * \code
+ * broadPhase.Reset();
+ * for (...) broadPhase.Add(bounds);
+ * broadPhase.Build();
+ * broadPhase.Query(rect, [](std::size_t item) {
+ *   // item is the index of an item whose bounds are overlapping rect.
+ * });
+ * \endcode
+ *
+ * \see RuntimeScene::GetObjectsBroadPhase
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsBroadPhase {
+ public:
+  ObjectsBroadPhase();
+  virtual ~ObjectsBroadPhase(){};
+
+  /**
+   * \brief Remove all the items, keeping the allocated memory.
+   */
+  void Reset();
+
+  /**
+   * \brief Add an item with the given bounds.
+   * \return The index of the item, that will be given to Query callbacks.
+   */
+  std::size_t Add(const sf::FloatRect& bounds);
+
+  /**
+   * \brief Build the grid from the items added since the last Reset.
+   * Must be called before any call to Query.
+   */
+  void Build();
+
+  /**
+   * \brief Return the number of items added since the last Reset.
+   */
+  std::size_t GetItemsCount() const { return itemsBounds.size(); }
+
+  /**
+   * \brief Return the size of the cells of the grid, as computed by Build.
+   */
+  float GetCellSize() const { return cellSize; }
+
+  /**
+   * \brief Call \a callback once for each item having its bounds overlapping
+   * (or touching) \a rect.
+   *
+   * Items are not given in any specific order.
+   */
+  template <typename Callback>
+  void Query(const sf::FloatRect& rect, Callback callback) {
+    NextQueryStamp();
+
+    for (std::size_t item : unboundedItems) {
+      itemsStamp[item] = queryStamp;
+      callback(item);
+    }
+
+    if (!IsFinite(rect)) {
+      for (std::size_t item = 0; item < itemsBounds.size(); ++item) {
+        if (itemsStamp[item] != queryStamp) callback(item);
+      }
+      return;
+    }
+
+    for (std::size_t item : largeItems) {
+      if (Overlaps(itemsBounds[item], rect)) callback(item);
+    }
+
+    int left = CellCoordinate(rect.left);
+    int top = CellCoordinate(rect.top);
+    int right = CellCoordinate(rect.left + rect.width);
+    int bottom = CellCoordinate(rect.top + rect.height);
+
+    // A query covering more cells than there are entries is better done
+    // by testing every item.
+    if (static_cast<double>(right - left + 1) * (bottom - top + 1) >
+        cellEntries.size()) {
+      for (const CellEntry& entry : cellEntries) {
+        if (itemsStamp[entry.item] == queryStamp) continue;
+        itemsStamp[entry.item] = queryStamp;
+        if (Overlaps(itemsBounds[entry.item], rect)) callback(entry.item);
+      }
+      return;
+    }
+
+    for (int y = top; y <= bottom; ++y) {
+      for (int x = left; x <= right; ++x) {
+        std::uint64_t key = CellKey(x, y);
+        auto it = std::lower_bound(
+            cellEntries.begin(),
+            cellEntries.end(),
+            key,
+            [](const CellEntry& entry, std::uint64_t key) {
+              return entry.cell < key;
+            });
+        for (; it != cellEntries.end() && it->cell == key; ++it) {
+          if (itemsStamp[it->item] == queryStamp) continue;
+          itemsStamp[it->item] = queryStamp;
+          if (Overlaps(itemsBounds[it->item], rect)) callback(it->item);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Return the axis-aligned bounding box of the bounding circle of an
+   * object.
+   *
+   * The bounding circle is the one used by RuntimeObject::IsCollidingWith and
+   * RuntimeObject::RaycastTest to discard objects before testing their
+   * hitboxes, so any object outside this box can't be colliding.
+   */
+  static sf::FloatRect GetBoundingCircleAABB(RuntimeObject& object);
+
+ private:
+  struct CellEntry {
+    std::uint64_t cell;
+    std::size_t item;
+
+    bool operator<(const CellEntry& other) const {
+      return cell < other.cell || (cell == other.cell && item < other.item);
+    }
+  };
+
+  void NextQueryStamp();
+  int CellCoordinate(float value) const;
+  static std::uint64_t CellKey(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+           static_cast<std::uint32_t>(y);
+  }
+  static bool IsFinite(const sf::FloatRect& rect);
+  static bool Overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+           a.top <= b.top + b.height && b.top <= a.top + a.height;
+  }
+
+  float cellSize;  ///< The size of a cell, computed from the items bounds.
+  float cellSizeInverse;
+  std::vector<sf::FloatRect> itemsBounds;
+  std::vector<CellEntry> cellEntries;  ///< Sorted by cell, then by item.
+  std::vector<std::size_t>
+      largeItems;  ///< Items covering too many cells to be put in the grid.
+  std::vector<std::size_t>
+      unboundedItems;  ///< Items with invalid bounds, always returned.
+  std::vector<unsigned int> itemsStamp;  ///< Avoid returning an item twice.
+  unsigned int queryStamp;
+
+  static const int maxCellsPerItem;
+};
+
+#endif  // OBJECTSBROADPHASE_H
@@ -9,6 +9,15 @@
 #include <cmath>
 #include "GDCpp/Runtime/Polygon2d.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GD_POLYGON_COLLISION_AVX
+#elif defined(__SSE__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define GD_POLYGON_COLLISION_SSE
+#endif
+
 namespace {
 
 void normalise(sf::Vector2f& v) {
@@ -61,8 +70,8 @@ float distance(float minA, float maxA, float minB, float maxB) {
 
 }  // namespace
 
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
                                             bool ignoreTouchingEdges) {
   if (p1.vertices.size() < 3 || p2.vertices.size() < 3) {
     CollisionResult result;
@@ -72,8 +81,10 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
     return result;
   }
 
-  p1.ComputeEdges();
-  p2.ComputeEdges();
+  // Hitboxes have their edges up to date, but not polygons created or changed
+  // without calling Polygon2d::ComputeEdges.
+  if (p1.edges.size() != p1.vertices.size()) p1.ComputeEdges();
+  if (p2.edges.size() != p2.vertices.size()) p2.ComputeEdges();
 
   sf::Vector2f edge;
   sf::Vector2f move_axis(0, 0);
@@ -132,8 +143,11 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
   return result;
 }
 
-RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY) {
+RaycastResult GD_API PolygonRaycastTest(const Polygon2d& poly,
+                                        float startX,
+                                        float startY,
+                                        float endX,
+                                        float endY) {
   RaycastResult result;
   result.collision = false;
 
@@ -141,7 +155,8 @@ RaycastResult GD_API PolygonRaycastTest(
     return result;
   }
 
-  poly.ComputeEdges();
+  if (poly.edges.size() != poly.vertices.size()) poly.ComputeEdges();
+
   sf::Vector2f p, q, r, s;
   float minSqDist = FLT_MAX;
 
@@ -216,7 +231,245 @@ RaycastResult GD_API PolygonRaycastTest(
   return result;
 }
 
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y) {
+namespace {
+
+#if defined(GD_POLYGON_COLLISION_AVX)
+const std::size_t axesPerStep = 8;
+#elif defined(GD_POLYGON_COLLISION_SSE)
+const std::size_t axesPerStep = 4;
+#else
+const std::size_t axesPerStep = 1;
+#endif
+
+/**
+ * Project the vertices on axesPerStep axes at once, storing the minimum and
+ * the maximum of the projections on each axis.
+ */
+void projectOnAxes(const float* axesX,
+                   const float* axesY,
+                   const float* verticesX,
+                   const float* verticesY,
+                   std::size_t verticesCount,
+                   float* min,
+                   float* max) {
+#if defined(GD_POLYGON_COLLISION_AVX)
+  __m256 axisX = _mm256_loadu_ps(axesX);
+  __m256 axisY = _mm256_loadu_ps(axesY);
+  __m256 dp = _mm256_add_ps(_mm256_mul_ps(axisX, _mm256_set1_ps(verticesX[0])),
+                            _mm256_mul_ps(axisY, _mm256_set1_ps(verticesY[0])));
+  __m256 minDp = dp;
+  __m256 maxDp = dp;
+  for (std::size_t i = 1; i < verticesCount; ++i) {
+    dp = _mm256_add_ps(_mm256_mul_ps(axisX, _mm256_set1_ps(verticesX[i])),
+                       _mm256_mul_ps(axisY, _mm256_set1_ps(verticesY[i])));
+    minDp = _mm256_min_ps(minDp, dp);
+    maxDp = _mm256_max_ps(maxDp, dp);
+  }
+  _mm256_storeu_ps(min, minDp);
+  _mm256_storeu_ps(max, maxDp);
+#elif defined(GD_POLYGON_COLLISION_SSE)
+  __m128 axisX = _mm_loadu_ps(axesX);
+  __m128 axisY = _mm_loadu_ps(axesY);
+  __m128 dp = _mm_add_ps(_mm_mul_ps(axisX, _mm_set1_ps(verticesX[0])),
+                         _mm_mul_ps(axisY, _mm_set1_ps(verticesY[0])));
+  __m128 minDp = dp;
+  __m128 maxDp = dp;
+  for (std::size_t i = 1; i < verticesCount; ++i) {
+    dp = _mm_add_ps(_mm_mul_ps(axisX, _mm_set1_ps(verticesX[i])),
+                    _mm_mul_ps(axisY, _mm_set1_ps(verticesY[i])));
+    minDp = _mm_min_ps(minDp, dp);
+    maxDp = _mm_max_ps(maxDp, dp);
+  }
+  _mm_storeu_ps(min, minDp);
+  _mm_storeu_ps(max, maxDp);
+#else
+  for (std::size_t axis = 0; axis < axesPerStep; ++axis) {
+    float dp = axesX[axis] * verticesX[0] + axesY[axis] * verticesY[0];
+    min[axis] = dp;
+    max[axis] = dp;
+  }
+  for (std::size_t i = 1; i < verticesCount; ++i) {
+    for (std::size_t axis = 0; axis < axesPerStep; ++axis) {
+      float dp = axesX[axis] * verticesX[i] + axesY[axis] * verticesY[i];
+      if (dp < min[axis]) min[axis] = dp;
+      if (dp > max[axis]) max[axis] = dp;
+    }
+  }
+#endif
+}
+
+/**
+ * Add the vertices and the normalized axes of a polygon at the end of the
+ * arrays. Axes are padded with copies of the last axis, so that their count is
+ * a multiple of PolygonsBatch::axesAlignment.
+ */
+void addPolygon(const Polygon2d& polygon,
+                std::vector<float>& verticesX,
+                std::vector<float>& verticesY,
+                std::vector<float>& axesX,
+                std::vector<float>& axesY) {
+  const std::vector<sf::Vector2f>& vertices = polygon.vertices;
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    sf::Vector2f edge =
+        vertices[i + 1 < vertices.size() ? i + 1 : 0] - vertices[i];
+    sf::Vector2f axis(-edge.y, edge.x);
+    normalise(axis);
+
+    verticesX.push_back(vertices[i].x);
+    verticesY.push_back(vertices[i].y);
+    axesX.push_back(axis.x);
+    axesY.push_back(axis.y);
+  }
+
+  while (axesX.size() % PolygonsBatch::axesAlignment != 0) {
+    axesX.push_back(axesX.back());
+    axesY.push_back(axesY.back());
+  }
+}
+
+/**
+ * Project two polygons on the given axes (padded to a multiple of
+ * axesPerStep). Return false if one of the axes is separating the polygons,
+ * otherwise update minDist and moveAxis with the axis on which the overlap of
+ * the polygons is the smallest.
+ */
+bool overlapOnAxes(const float* axesX,
+                   const float* axesY,
+                   std::size_t axesCount,
+                   const float* verticesAX,
+                   const float* verticesAY,
+                   std::size_t verticesACount,
+                   const float* verticesBX,
+                   const float* verticesBY,
+                   std::size_t verticesBCount,
+                   bool ignoreTouchingEdges,
+                   float& minDist,
+                   sf::Vector2f& moveAxis) {
+  float minA[axesPerStep], maxA[axesPerStep], minB[axesPerStep],
+      maxB[axesPerStep];
+  for (std::size_t step = 0; step < axesCount; step += axesPerStep) {
+    projectOnAxes(axesX + step,
+                  axesY + step,
+                  verticesAX,
+                  verticesAY,
+                  verticesACount,
+                  minA,
+                  maxA);
+    projectOnAxes(axesX + step,
+                  axesY + step,
+                  verticesBX,
+                  verticesBY,
+                  verticesBCount,
+                  minB,
+                  maxB);
+
+    for (std::size_t i = 0; i < axesPerStep && step + i < axesCount; ++i) {
+      float dist = distance(minA[i], maxA[i], minB[i], maxB[i]);
+      if (dist > 0.0f || (dist == 0.0 && ignoreTouchingEdges)) return false;
+
+      float absDist = std::abs(dist);
+      if (absDist < minDist) {
+        minDist = absDist;
+        moveAxis = sf::Vector2f(axesX[step + i], axesY[step + i]);
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+const std::size_t PolygonsBatch::axesAlignment = 8;
+
+void PolygonsBatch::Clear() {
+  verticesX.clear();
+  verticesY.clear();
+  axesX.clear();
+  axesY.clear();
+  verticesOffsets.resize(1);
+  axesOffsets.resize(1);
+  centers.clear();
+}
+
+std::size_t PolygonsBatch::Add(const Polygon2d& polygon) {
+  addPolygon(polygon, verticesX, verticesY, axesX, axesY);
+  verticesOffsets.push_back(verticesX.size());
+  axesOffsets.push_back(axesX.size());
+  centers.push_back(polygon.vertices.empty() ? sf::Vector2f()
+                                             : polygon.ComputeCenter());
+
+  return centers.size() - 1;
+}
+
+void GD_API PolygonCollisionBatchTest(const Polygon2d& polygon,
+                                      const PolygonsBatch& candidates,
+                                      bool ignoreTouchingEdges,
+                                      std::vector<CollisionResult>& results,
+                                      PolygonsBatch& polygonBatch) {
+  CollisionResult noCollision;
+  noCollision.collision = false;
+  noCollision.move_axis = sf::Vector2f(0, 0);
+  results.assign(candidates.GetCount(), noCollision);
+  if (polygon.vertices.size() < 3) return;
+
+  polygonBatch.Clear();
+  polygonBatch.Add(polygon);
+  const std::vector<float>& verticesX = polygonBatch.verticesX;
+  const std::vector<float>& verticesY = polygonBatch.verticesY;
+  const std::vector<float>& axesX = polygonBatch.axesX;
+  const std::vector<float>& axesY = polygonBatch.axesY;
+  const std::size_t verticesCount = verticesX.size();
+  const sf::Vector2f center = polygonBatch.centers[0];
+
+  for (std::size_t candidate = 0; candidate < candidates.GetCount();
+       ++candidate) {
+    const std::size_t begin = candidates.verticesOffsets[candidate];
+    const std::size_t candidateVerticesCount =
+        candidates.verticesOffsets[candidate + 1] - begin;
+    if (candidateVerticesCount < 3) continue;
+
+    // Same as PolygonCollisionTest: the axes of the polygon are tested, then
+    // the axes of the candidate.
+    const std::size_t axesBegin = candidates.axesOffsets[candidate];
+    float minDist = FLT_MAX;
+    sf::Vector2f moveAxis(0, 0);
+    if (!overlapOnAxes(&axesX[0],
+                       &axesY[0],
+                       verticesCount,
+                       &verticesX[0],
+                       &verticesY[0],
+                       verticesCount,
+                       &candidates.verticesX[begin],
+                       &candidates.verticesY[begin],
+                       candidateVerticesCount,
+                       ignoreTouchingEdges,
+                       minDist,
+                       moveAxis) ||
+        !overlapOnAxes(&candidates.axesX[axesBegin],
+                       &candidates.axesY[axesBegin],
+                       candidateVerticesCount,
+                       &verticesX[0],
+                       &verticesY[0],
+                       verticesCount,
+                       &candidates.verticesX[begin],
+                       &candidates.verticesY[begin],
+                       candidateVerticesCount,
+                       ignoreTouchingEdges,
+                       minDist,
+                       moveAxis))
+      continue;
+
+    CollisionResult& result = results[candidate];
+    result.collision = true;
+
+    sf::Vector2f d = center - candidates.centers[candidate];
+    if (dotProduct(d, moveAxis) < 0.0f) moveAxis = -moveAxis;
+    result.move_axis = moveAxis * minDist;
+  }
+}
+
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y) {
   bool inside = false;
   sf::Vector2f vi, vj;
 
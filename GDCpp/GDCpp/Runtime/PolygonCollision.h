@@ -6,6 +6,7 @@
 #ifndef POLYGONCOLLISION_H
 #define POLYGONCOLLISION_H
 #include <SFML/System.hpp>
+#include <vector>
 class Polygon2d;
 
 /**
@@ -28,7 +29,10 @@ struct RaycastResult {
 
 /**
  * Do a collision test between the two polygons.
- * \warning Polygons must convexes.
+ * \warning Polygons must convexes. Their edges are computed if missing, but
+ * must be up to date if the vertices were changed directly since (see
+ * Polygon2d::ComputeEdges). Polygon2d::Move and Polygon2d::Rotate keep them up
+ * to date, as well as the hitboxes returned by RuntimeObject::GetHitBoxes.
  *
  * Uses Separating Axis Theorem (
  * http://en.wikipedia.org/wiki/Hyperplane_separation_theorem ) Based on
@@ -44,13 +48,15 @@ struct RaycastResult {
  *
  * \ingroup GameEngine
  */
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
                                             bool ignoreTouchingEdges = false);
 
 /**
  * Do a raycast test.
- * \warning Polygon must be convex.
+ * \warning Polygon must be convex. Its edges are computed if missing, but
+ * must be up to date if the vertices were changed directly since (see
+ * Polygon2d::ComputeEdges).
  * For some theory check "Find the Intersection Point of Two Line Segments"
  * (https://www.codeproject.com/Tips/862988/Find-the-Intersection-Point-of-Two-Line-Segments)
  *
@@ -58,8 +64,11 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
  *
  * \ingroup GameEngine
  */
-RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY);
+RaycastResult GD_API PolygonRaycastTest(const Polygon2d& poly,
+                                        float startX,
+                                        float startY,
+                                        float endX,
+                                        float endY);
 
 /**
  * Check if a point is inside a polygon.
@@ -71,6 +80,81 @@ RaycastResult GD_API PolygonRaycastTest(
  *
  * \ingroup GameEngine
  */
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y);
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y);
+
+/**
+ * \brief Polygons stored as a structure of arrays, with the normalized axes of
+ * their edges, so that a polygon can be tested against all of them at once
+ * with PolygonCollisionBatchTest.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API PolygonsBatch {
+ public:
+  PolygonsBatch() : verticesOffsets(1, 0), axesOffsets(1, 0){};
+
+  /**
+   * \brief Remove all the polygons.
+   */
+  void Clear();
+
+  /**
+   * \brief Add a polygon at the end of the batch.
+   * \return The index of the polygon in the batch.
+   */
+  std::size_t Add(const Polygon2d& polygon);
+
+  /**
+   * \brief Return the number of polygons in the batch.
+   */
+  std::size_t GetCount() const { return centers.size(); }
+
+  std::vector<float> verticesX;  ///< The x coordinates of the vertices
+  std::vector<float> verticesY;  ///< The y coordinates of the vertices
+  std::vector<float> axesX;  ///< The x coordinates of the normalized axes
+                             ///< perpendicular to each edge
+  std::vector<float> axesY;  ///< The y coordinates of the normalized axes
+                             ///< perpendicular to each edge
+  std::vector<std::size_t>
+      verticesOffsets;  ///< The index of the first vertex of each polygon,
+                        ///< followed by the total number of vertices.
+  std::vector<std::size_t>
+      axesOffsets;  ///< The index of the first axis of each polygon, followed
+                    ///< by the total number of axes.
+  std::vector<sf::Vector2f> centers;  ///< The center of each polygon
+
+  static const std::size_t axesAlignment;  ///< The axes of each polygon are
+                                           ///< padded with copies of its last
+                                           ///< axis to a multiple of this
+                                           ///< count, so that they can be
+                                           ///< projected several at a time.
+};
+
+/**
+ * Do a collision test between a polygon and each polygon of a batch.
+ *
+ * Gives the same results as calling PolygonCollisionTest on each pair, but the
+ * projections on the axes are done several axes at once (using SSE or AVX
+ * instructions when they are available) and the axes of the batch are only
+ * normalized once.
+ *
+ * \warning Polygons must be convexes.
+ *
+ * \param polygon The polygon to be tested
+ * \param candidates The polygons to be tested against polygon
+ * \param ignoreTouchingEdges If true, then edges that are touching each other,
+ * without the polygons actually overlapping, won't be considered in collision.
+ * \param results Filled with the result of the test for each polygon of
+ * candidates, in the same order.
+ * \param polygonBatch Used to store the vertices and the axes of polygon. Keep
+ * it between calls, so that its memory is reused.
+ *
+ * \ingroup GameEngine
+ */
+void GD_API PolygonCollisionBatchTest(const Polygon2d& polygon,
+                                      const PolygonsBatch& candidates,
+                                      bool ignoreTouchingEdges,
+                                      std::vector<CollisionResult>& results,
+                                      PolygonsBatch& polygonBatch);
 
 #endif  // POLYGONCOLLISION_H
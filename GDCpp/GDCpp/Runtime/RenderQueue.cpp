@@ -0,0 +1,311 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/RenderQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+namespace {
+const std::size_t pendingLayer = std::numeric_limits<std::size_t>::max();
+
+// Objects are put in the cell containing the center of their AABB, or in
+// one of these special cells:
+const std::int64_t notCullableCell =
+    std::numeric_limits<std::int64_t>::min();  ///< Always drawn.
+const std::int64_t largeObjectsCell =
+    notCullableCell + 1;  ///< Objects too large to be put in a cell.
+const std::int64_t boundsChangedCell =
+    notCullableCell + 2;  ///< Objects to be put in a cell by Update.
+
+bool HasLowerZOrder(const RuntimeObject* o1, const RuntimeObject* o2) {
+  return o1->GetZOrder() < o2->GetZOrder();
+}
+
+bool Overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+  return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+         a.top <= b.top + b.height && b.top <= a.top + a.height;
+}
+
+bool IsFinite(const sf::FloatRect& rect) {
+  return std::isfinite(rect.left) && std::isfinite(rect.top) &&
+         std::isfinite(rect.width) && std::isfinite(rect.height) &&
+         rect.width >= 0 && rect.height >= 0;
+}
+
+int CellCoordinate(float value, float cellSize) {
+  // Coordinates are clamped so that cells keys never collide with the
+  // special cells.
+  double cell = std::floor(static_cast<double>(value) / cellSize);
+  if (cell < std::numeric_limits<int>::min() / 2)
+    return std::numeric_limits<int>::min() / 2;
+  if (cell > std::numeric_limits<int>::max() / 2)
+    return std::numeric_limits<int>::max() / 2;
+
+  return static_cast<int>(cell);
+}
+
+std::int64_t CellKey(int x, int y) {
+  return static_cast<std::int64_t>(
+      (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+      static_cast<std::uint32_t>(y));
+}
+}
+
+const std::vector<RuntimeObject*> RenderQueue::noObjects;
+const float RenderQueue::cellSize = 128;
+
+RenderQueue::~RenderQueue() { Clear(); }
+
+void RenderQueue::SetLayers(const std::vector<gd::String>& layersNames_) {
+  layersNames = layersNames_;
+
+  std::vector<Layer> oldLayers;
+  oldLayers.swap(layers);
+  layers.resize(layersNames.size() + 1);
+  for (Layer& layer : oldLayers) {
+    for (RuntimeObject* object : layer.objects) {
+      if (!object) continue;
+
+      object->renderQueueLayer = pendingLayer;
+      object->renderQueueIndex = pendingObjects.size();
+      pendingObjects.push_back(object);
+    }
+  }
+}
+
+void RenderQueue::AddObject(RuntimeObject* object) {
+  if (object->renderQueue == this) return;
+  if (object->renderQueue) object->renderQueue->RemoveObject(object);
+
+  object->renderQueue = this;
+  object->renderQueueLayer = pendingLayer;
+  object->renderQueueIndex = pendingObjects.size();
+  pendingObjects.push_back(object);
+}
+
+void RenderQueue::RemoveObject(RuntimeObject* object) {
+  if (object->renderQueue != this) return;
+
+  TakeObject(object);
+  object->renderQueue = nullptr;
+}
+
+void RenderQueue::ObjectChanged(RuntimeObject* object) {
+  if (object->renderQueue != this) return;
+  if (object->renderQueueLayer == pendingLayer) return;
+
+  TakeObject(object);
+  object->renderQueueLayer = pendingLayer;
+  object->renderQueueIndex = pendingObjects.size();
+  pendingObjects.push_back(object);
+}
+
+void RenderQueue::ObjectBoundsChanged(RuntimeObject* object) {
+  if (object->renderQueue != this) return;
+  if (object->renderQueueLayer == pendingLayer) return;
+  if (object->renderQueueCell == boundsChangedCell ||
+      object->renderQueueCell == notCullableCell)
+    return;
+
+  Layer& layer = layers[object->renderQueueLayer];
+  RemoveFromCell(layer, object);
+  AddToCell(layer, object, boundsChangedCell);
+}
+
+void RenderQueue::TakeObject(RuntimeObject* object) {
+  // Only leave an empty slot, so that removing an object is done in constant
+  // time. Empty slots are removed by Update.
+  if (object->renderQueueLayer == pendingLayer) {
+    pendingObjects[object->renderQueueIndex] = nullptr;
+  } else {
+    Layer& layer = layers[object->renderQueueLayer];
+    layer.objects[object->renderQueueIndex] = nullptr;
+    layer.hasRemovedObjects = true;
+    RemoveFromCell(layer, object);
+  }
+}
+
+void RenderQueue::AddToCell(Layer& layer,
+                            RuntimeObject* object,
+                            std::int64_t cell) {
+  std::vector<RuntimeObject*>& cellObjects = layer.cells[cell];
+  object->renderQueueCell = cell;
+  object->renderQueueCellIndex = cellObjects.size();
+  cellObjects.push_back(object);
+}
+
+void RenderQueue::RemoveFromCell(Layer& layer, RuntimeObject* object) {
+  // Order of objects in a cell does not matter: swap with the last one.
+  std::vector<RuntimeObject*>& cellObjects = layer.cells[object->renderQueueCell];
+  std::size_t index = object->renderQueueCellIndex;
+  cellObjects[index] = cellObjects.back();
+  cellObjects[index]->renderQueueCellIndex = index;
+  cellObjects.pop_back();
+}
+
+void RenderQueue::UpdateCell(Layer& layer, RuntimeObject* object) {
+  if (!object->CanBeCulled()) {
+    AddToCell(layer, object, notCullableCell);
+    return;
+  }
+
+  object->renderQueueBounds = object->GetAABB();
+  const sf::FloatRect& bounds = object->renderQueueBounds;
+  if (!IsFinite(bounds) || bounds.width > cellSize ||
+      bounds.height > cellSize) {
+    AddToCell(layer, object, largeObjectsCell);
+    return;
+  }
+
+  AddToCell(layer,
+            object,
+            CellKey(CellCoordinate(bounds.left + bounds.width / 2, cellSize),
+                    CellCoordinate(bounds.top + bounds.height / 2, cellSize)));
+}
+
+void RenderQueue::Clear() {
+  for (Layer& layer : layers) {
+    for (RuntimeObject* object : layer.objects) {
+      if (object) object->renderQueue = nullptr;
+    }
+    layer.objects.clear();
+    layer.cells.clear();
+    layer.hasRemovedObjects = false;
+  }
+  for (RuntimeObject* object : pendingObjects) {
+    if (object) object->renderQueue = nullptr;
+  }
+  pendingObjects.clear();
+}
+
+std::size_t RenderQueue::GetVisibleLayerObjects(
+    std::size_t layerIndex,
+    const sf::FloatRect& viewRect,
+    std::vector<RuntimeObject*>& visibleObjects) const {
+  visibleObjects.clear();
+  if (layerIndex >= layers.size()) return 0;
+
+  const Layer& layer = layers[layerIndex];
+  auto isInView = [&viewRect](const RuntimeObject* object) {
+    return !IsFinite(object->renderQueueBounds) ||
+           Overlaps(object->renderQueueBounds, viewRect);
+  };
+
+  // Objects are in the cell containing their center, so the cells to be
+  // searched are the ones seen by the view, extended by half of a cell. When
+  // there are more cells to be searched than objects, it's faster to test
+  // every object.
+  bool testAllObjects = !IsFinite(viewRect);
+  int left = 0, top = 0, right = -1, bottom = -1;
+  if (!testAllObjects) {
+    left = CellCoordinate(viewRect.left - cellSize / 2, cellSize);
+    top = CellCoordinate(viewRect.top - cellSize / 2, cellSize);
+    right = CellCoordinate(viewRect.left + viewRect.width + cellSize / 2,
+                           cellSize);
+    bottom = CellCoordinate(viewRect.top + viewRect.height + cellSize / 2,
+                            cellSize);
+    testAllObjects =
+        static_cast<double>(right - left + 1) * (bottom - top + 1) >
+        layer.objects.size();
+  }
+
+  if (testAllObjects) {
+    for (RuntimeObject* object : layer.objects) {
+      if (object && (object->renderQueueCell == notCullableCell ||
+                     object->renderQueueCell == boundsChangedCell ||
+                     isInView(object)))
+        visibleObjects.push_back(object);
+    }
+    return layer.objects.size() - visibleObjects.size();
+  }
+
+  auto addCell = [&](std::int64_t cell, bool testBounds) {
+    auto it = layer.cells.find(cell);
+    if (it == layer.cells.end()) return;
+
+    for (RuntimeObject* object : it->second) {
+      if (!testBounds || isInView(object)) visibleObjects.push_back(object);
+    }
+  };
+  addCell(notCullableCell, false);
+  addCell(boundsChangedCell, false);
+  addCell(largeObjectsCell, true);
+  for (int y = top; y <= bottom; ++y) {
+    for (int x = left; x <= right; ++x) addCell(CellKey(x, y), true);
+  }
+
+  std::sort(visibleObjects.begin(),
+            visibleObjects.end(),
+            [](const RuntimeObject* o1, const RuntimeObject* o2) {
+              return o1->renderQueueIndex < o2->renderQueueIndex;
+            });
+
+  std::size_t objectsCount = layer.objects.size();
+  return objectsCount - std::min(objectsCount, visibleObjects.size());
+}
+
+std::size_t RenderQueue::GetLayerIndex(const gd::String& layerName) const {
+  for (std::size_t i = 0; i < layersNames.size(); ++i) {
+    if (layersNames[i] == layerName) return i;
+  }
+
+  return layersNames.size();
+}
+
+void RenderQueue::Update() {
+  if (layers.empty()) layers.resize(1);
+
+  for (Layer& layer : layers) {
+    layer.sortedObjectsCount = layer.objects.size();
+    if (!layer.hasRemovedObjects) continue;
+
+    layer.objects.erase(
+        std::remove(layer.objects.begin(), layer.objects.end(), nullptr),
+        layer.objects.end());
+    layer.sortedObjectsCount = layer.objects.size();
+    layer.hasRemovedObjects = false;
+    for (std::size_t i = 0; i < layer.objects.size(); ++i)
+      layer.objects[i]->renderQueueIndex = i;
+  }
+
+  // Put the objects that were moved or changed in their new cell.
+  for (Layer& layer : layers) {
+    auto it = layer.cells.find(boundsChangedCell);
+    if (it == layer.cells.end() || it->second.empty()) continue;
+
+    objectsToUpdate.swap(it->second);
+    for (RuntimeObject* object : objectsToUpdate) UpdateCell(layer, object);
+    objectsToUpdate.clear();
+  }
+
+  if (pendingObjects.empty()) return;
+
+  // Add the new or changed objects at the end of their layer, then sort them
+  // and merge them with the objects already sorted.
+  for (RuntimeObject* object : pendingObjects) {
+    if (!object) continue;
+
+    object->renderQueueLayer = GetLayerIndex(object->GetLayer());
+    Layer& layer = layers[object->renderQueueLayer];
+    layer.objects.push_back(object);
+    UpdateCell(layer, object);
+  }
+  pendingObjects.clear();
+
+  for (Layer& layer : layers) {
+    if (layer.sortedObjectsCount == layer.objects.size()) continue;
+
+    auto firstNewObject = layer.objects.begin() + layer.sortedObjectsCount;
+    std::stable_sort(firstNewObject, layer.objects.end(), HasLowerZOrder);
+    std::inplace_merge(layer.objects.begin(),
+                       firstNewObject,
+                       layer.objects.end(),
+                       HasLowerZOrder);
+    for (std::size_t i = 0; i < layer.objects.size(); ++i)
+      layer.objects[i]->renderQueueIndex = i;
+  }
+}
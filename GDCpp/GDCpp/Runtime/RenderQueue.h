@@ -0,0 +1,162 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+class RuntimeObject;
+
+/**
+ * \brief The objects to be rendered, sorted by layer and then by Z order.
+ *
+ * The queue is kept between frames: objects tell the queue when their Z order
+ * or their layer is changed, and only these objects (and the objects added
+ * since the last frame) are put back at their place by Update. Objects with
+ * the same Z order are drawn in the order they were put in the queue.
+ *
+ * Objects remove themselves from the queue when they are destroyed.
+ *
+ * The objects that can be culled (see RuntimeObject::CanBeCulled) are also
+ * put in a grid, according to their AABB, so that only the objects near a
+ * camera are drawn. The AABB of an object is only computed again when the
+ * object tells the queue that it was moved or changed.
+ *
+ * \see RuntimeScene::Render
+ * \ingroup GameEngine
+ */
+class GD_API RenderQueue {
+ public:
+  RenderQueue() : layers(1){};
+
+  /**
+   * \brief Copy constructor
+   * \note Only the layers are copied: objects can only be in one queue.
+   */
+  RenderQueue(const RenderQueue& other)
+      : layersNames(other.layersNames), layers(other.layers.size()){};
+
+  /**
+   * \brief Assignment operator
+   * \note Only the layers are copied: objects can only be in one queue.
+   */
+  RenderQueue& operator=(const RenderQueue& other) {
+    if (this != &other) SetLayers(other.layersNames);
+    return *this;
+  }
+
+  virtual ~RenderQueue();
+
+  /**
+   * \brief Set the names of the layers, in the order they are rendered.
+   *
+   * Objects already in the queue are put in their new layer at the next
+   * Update.
+   */
+  void SetLayers(const std::vector<gd::String>& layersNames);
+
+  /**
+   * \brief Add an object to the queue. Does nothing if the object is already
+   * in the queue.
+   */
+  void AddObject(RuntimeObject* object);
+
+  /**
+   * \brief Remove an object from the queue. Does nothing if the object is not
+   * in the queue.
+   */
+  void RemoveObject(RuntimeObject* object);
+
+  /**
+   * \brief Remove all the objects from the queue.
+   */
+  void Clear();
+
+  /**
+   * \brief To be called when the Z order or the layer of an object in the
+   * queue has changed.
+   * \note This is automatically done by RuntimeObject::SetZOrder and
+   * RuntimeObject::SetLayer.
+   */
+  void ObjectChanged(RuntimeObject* object);
+
+  /**
+   * \brief To be called when the AABB of an object in the queue has changed.
+   * \note This is automatically done by RuntimeObject::SetX,
+   * RuntimeObject::SetY and RuntimeObject::NotifyBoundsChanged.
+   */
+  void ObjectBoundsChanged(RuntimeObject* object);
+
+  /**
+   * \brief Put the objects that were added or changed since the last call at
+   * their place. Must be called before using GetLayerObjects.
+   */
+  void Update();
+
+  /**
+   * \brief Return the objects of a layer, sorted by Z order.
+   *
+   * \param layerIndex The index of the layer, in the list given to SetLayers.
+   */
+  const std::vector<RuntimeObject*>& GetLayerObjects(
+      std::size_t layerIndex) const {
+    return layerIndex < layers.size() ? layers[layerIndex].objects
+                                      : noObjects;
+  }
+
+  /**
+   * \brief Fill \a visibleObjects with the objects of a layer that can be
+   * visible in the area \a viewRect, sorted by Z order.
+   *
+   * Objects that can't be culled are always part of the visible objects.
+   *
+   * \param layerIndex The index of the layer, in the list given to SetLayers.
+   * \param viewRect The area of the scene seen by the camera.
+   * \param visibleObjects The list to be filled.
+   * \return The number of objects of the layer that were culled.
+   */
+  std::size_t GetVisibleLayerObjects(
+      std::size_t layerIndex,
+      const sf::FloatRect& viewRect,
+      std::vector<RuntimeObject*>& visibleObjects) const;
+
+ private:
+  struct Layer {
+    Layer() : hasRemovedObjects(false), sortedObjectsCount(0){};
+
+    std::vector<RuntimeObject*> objects;  ///< Sorted by Z order. Can contain
+                                          ///< nullptr until the next Update.
+    bool hasRemovedObjects;
+    std::size_t sortedObjectsCount;  ///< Used by Update.
+    std::unordered_map<std::int64_t, std::vector<RuntimeObject*>>
+        cells;  ///< The objects of the layer, by cell of the grid.
+  };
+
+  void TakeObject(RuntimeObject* object);
+  std::size_t GetLayerIndex(const gd::String& layerName) const;
+  void AddToCell(Layer& layer, RuntimeObject* object, std::int64_t cell);
+  void RemoveFromCell(Layer& layer, RuntimeObject* object);
+  void UpdateCell(Layer& layer, RuntimeObject* object);
+
+  std::vector<gd::String> layersNames;
+  std::vector<Layer> layers;  ///< One more than the number of layers names,
+                              ///< the last one containing the objects on an
+                              ///< unknown layer.
+  std::vector<RuntimeObject*>
+      pendingObjects;  ///< Objects added or changed since the last Update.
+                       ///< Can contain nullptr.
+
+  std::vector<RuntimeObject*>
+      objectsToUpdate;  ///< Used by Update, kept to avoid allocations.
+
+  static const std::vector<RuntimeObject*> noObjects;
+  static const float cellSize;  ///< The size of the cells of the grid.
+};
+
+#endif  // RENDERQUEUE_H
@@ -36,7 +36,7 @@ bool ResourcesLoader::SetResourceFile(const gd::String& filename) {
 void ResourcesLoader::LoadSFMLImage(const gd::String& filename,
                                     sf::Image& image) {
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
+    const char* buffer = resFile.GetFileData(filename);
     if (buffer == NULL)
       cout << "Failed to get the file of a SFML image from resource file: "
            << filename << endl;
@@ -62,7 +62,7 @@ sf::Texture ResourcesLoader::LoadSFMLTexture(const gd::String& filename) {
 void ResourcesLoader::LoadSFMLTexture(const gd::String& filename,
                                       sf::Texture& texture) {
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
+    const char* buffer = resFile.GetFileData(filename);
     if (buffer == NULL)
       cout << "Failed to get the file of a SFML texture from resource file: "
            << filename << endl;
@@ -80,27 +80,26 @@ void ResourcesLoader::LoadSFMLTexture(const gd::String& filename,
 std::pair<sf::Font*, StreamHolder*> ResourcesLoader::LoadFont(
     const gd::String& filename) {
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    size_t bufferSize = resFile.GetFileSize(filename);
-    if (buffer == nullptr) {
+    // The font reads its data while it's used: they are not copied in a
+    // buffer, but the stream holder keeps them in memory, even if the
+    // resource file is changed.
+    std::shared_ptr<const char> data = resFile.GetSharedFileData(filename);
+    size_t dataSize = resFile.GetFileSize(filename);
+    if (data == nullptr) {
       cout << "Failed to get the file of a font from resource file:" << filename
            << endl;
       return std::make_pair((sf::Font*)nullptr, (StreamHolder*)nullptr);
     }
 
     sf::Font* font = new sf::Font();
-    char* fontBuffer = new char[bufferSize];
-    memcpy(fontBuffer, buffer, bufferSize);
-
-    if (!font->loadFromMemory(fontBuffer, bufferSize)) {
+    if (!font->loadFromMemory(data.get(), dataSize)) {
       cout << "Failed to load a font from resource file: " << filename << endl;
       delete font;
-      delete fontBuffer;
       return std::make_pair((sf::Font*)nullptr, (StreamHolder*)nullptr);
     }
 
     StreamHolder* streamHolder = new StreamHolder();
-    streamHolder->buffer = fontBuffer;
+    streamHolder->data = std::move(data);
     return std::make_pair(font, streamHolder);
   } else {
     sf::Font* font = new sf::Font();
@@ -122,7 +121,7 @@ sf::SoundBuffer ResourcesLoader::LoadSoundBuffer(const gd::String& filename) {
   sf::SoundBuffer sbuffer;
 
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
+    const char* buffer = resFile.GetFileData(filename);
     if (buffer == NULL)
       cout << "Failed to get the file of a sound buffer from resource file: "
            << filename << endl;
@@ -143,11 +142,12 @@ gd::String ResourcesLoader::LoadPlainText(const gd::String& filename) {
   gd::String text;
 
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
+    const char* buffer = resFile.GetFileData(filename);
     if (!buffer) {
       cout << "Failed to read a file from resource file: " << filename << endl;
     } else {
-      text = gd::String::FromUTF8(std::string(buffer));
+      text = gd::String::FromUTF8(
+          std::string(buffer, resFile.GetFileSize(filename)));
     }
   } else {
     char* buffer = LoadBinaryFile(filename);
@@ -16,6 +16,7 @@
 class Music;
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <string>
 #include "GDCpp/Runtime/String.h"
 #include "GDCpp/Runtime/Tools/FileStream.h"
@@ -34,6 +35,8 @@ struct StreamHolder {
   }
 
   char *buffer;
+  std::shared_ptr<const char> data;  ///< Data of a file of the resource file,
+                                     ///< kept in memory without copy.
   gd::SFMLFileStream stream;
 };
 
@@ -0,0 +1,340 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include <SFML/Audio.hpp>
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Direction.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/Project/Layout.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+#include "GDCpp/Runtime/ResourcesLoader.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/SoundManager.h"
+#if defined(GD_IDE_ONLY)
+#include "GDCore/IDE/Project/ResourcesInUseHelper.h"
+#endif
+
+namespace {
+
+#if !defined(GD_IDE_ONLY)
+void AddSpriteObjectImages(const gd::Object& object,
+                           std::vector<gd::String>& imageNames) {
+  const gd::SpriteObject* spriteObject =
+      dynamic_cast<const gd::SpriteObject*>(&object);
+  if (!spriteObject) return;
+
+  for (std::size_t a = 0; a < spriteObject->GetAnimationsCount(); ++a) {
+    const gd::Animation& animation = spriteObject->GetAnimation(a);
+    for (std::size_t d = 0; d < animation.GetDirectionsCount(); ++d) {
+      const gd::Direction& direction = animation.GetDirection(d);
+      for (std::size_t s = 0; s < direction.GetSpritesCount(); ++s)
+        imageNames.push_back(direction.GetSprite(s).GetImageName());
+    }
+  }
+}
+#endif
+
+}  // namespace
+
+ResourcesPreloader::ResourcesPreloader(std::size_t threadsCount_)
+    : requestedCount(0),
+      loadedCount(0),
+      resourcesLoader(gd::ResourcesLoader::Get()),
+      threadsCount(threadsCount_),
+      stopping(false) {
+  if (threadsCount == 0) {
+    unsigned int cores = std::thread::hardware_concurrency();
+    threadsCount = cores > 1 ? cores - 1 : 1;
+  }
+}
+
+ResourcesPreloader::~ResourcesPreloader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  jobQueued.notify_all();
+  for (auto& thread : threads) thread.join();
+}
+
+void ResourcesPreloader::PreloadLayout(RuntimeGame& game,
+                                       const gd::String& layoutName) {
+  if (!game.HasLayoutNamed(layoutName)) return;
+
+  gd::Layout& layout = game.GetLayout(layoutName);
+  std::vector<gd::String> imageNames;
+  std::vector<gd::String> audioNames;
+#if defined(GD_IDE_ONLY)
+  gd::ResourcesInUseHelper resourcesInUse;
+  for (auto& object : game.GetObjects())
+    object->ExposeResources(resourcesInUse);
+  for (auto& object : layout.GetObjects())
+    object->ExposeResources(resourcesInUse);
+  gd::LaunchResourceWorkerOnEvents(game, layout.GetEvents(), resourcesInUse);
+
+  imageNames.assign(resourcesInUse.GetAllImages().begin(),
+                    resourcesInUse.GetAllImages().end());
+  audioNames.assign(resourcesInUse.GetAllAudios().begin(),
+                    resourcesInUse.GetAllAudios().end());
+#else
+  // Objects can't expose their resources in games: only the images of the
+  // sprite objects are known.
+  for (auto& object : game.GetObjects())
+    AddSpriteObjectImages(*object, imageNames);
+  for (auto& object : layout.GetObjects())
+    AddSpriteObjectImages(*object, imageNames);
+#endif
+
+  Preload(layoutName,
+          game.GetResourcesManager(),
+          *game.GetImageManager(),
+          imageNames,
+          audioNames);
+}
+
+void ResourcesPreloader::Preload(const gd::String& group,
+                                 const gd::ResourcesManager& resourcesManager,
+                                 const gd::ImageManager& imageManager,
+                                 const std::vector<gd::String>& imageNames,
+                                 const std::vector<gd::String>& audioNames) {
+  Group& resources = groups[group];
+  if (IsDone()) {
+    requestedCount = 0;
+    loadedCount = 0;
+  }
+
+  std::map<gd::String, Job> atlasJobs;  // By file of the atlas.
+  for (const gd::String& name : imageNames) {
+    if (!resourcesManager.HasResource(name)) continue;
+    const gd::ImageResource* image = dynamic_cast<const gd::ImageResource*>(
+        &resourcesManager.GetResource(name));
+    if (!image) continue;
+
+    resources.images.insert(name);
+    if (preloadedImages.find(name) != preloadedImages.end() ||
+        loadingImages.find(name) != loadingImages.end())
+      continue;
+
+    if (imageManager.HasLoadedSFMLTexture(name)) {
+      imageManager.PinSFMLTexture(name);
+      preloadedImages.insert(name);
+      continue;
+    }
+
+    // Images in an atlas are extracted by the job loading the atlas, so that
+    // it is decoded once.
+    if (image->IsInAtlas()) {
+      Job& job = atlasJobs[image->GetAtlasFile()];
+      job.isImage = true;
+      job.name = image->GetAtlasFile();
+      job.file = image->GetAtlasFile();
+      job.smooth = image->IsSmooth();
+
+      AtlasImage atlasImage;
+      atlasImage.name = name;
+      atlasImage.rect = sf::IntRect(image->GetAtlasX(),
+                                    image->GetAtlasY(),
+                                    image->GetAtlasWidth(),
+                                    image->GetAtlasHeight());
+      job.atlasImages.push_back(std::move(atlasImage));
+      loadingImages.insert(name);
+      continue;
+    }
+
+    Job job;
+    job.isImage = true;
+    job.name = name;
+    job.file = image->GetFile();
+    job.smooth = image->IsSmooth();
+    loadingImages.insert(name);
+    Queue(std::move(job));
+  }
+  for (auto& it : atlasJobs) Queue(std::move(it.second));
+
+  for (const gd::String& name : audioNames) {
+    const gd::String& file = resourcesManager.HasResource(name)
+                                 ? resourcesManager.GetResource(name).GetFile()
+                                 : name;
+    if (file.empty()) continue;
+
+    resources.sounds.insert(file);
+    if (preloadedSoundBuffers.find(file) != preloadedSoundBuffers.end() ||
+        loadingSounds.find(file) != loadingSounds.end())
+      continue;
+
+    Job job;
+    job.isImage = false;
+    job.name = file;
+    job.file = file;
+    job.smooth = false;
+    loadingSounds.insert(file);
+    Queue(std::move(job));
+  }
+}
+
+void ResourcesPreloader::Queue(Job job) {
+  // The images of an atlas are counted, rather than the atlas.
+  requestedCount += job.atlasImages.empty() ? 1 : job.atlasImages.size();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pendingJobs.push_back(std::move(job));
+  }
+  jobQueued.notify_one();
+
+  if (threads.empty()) {
+    for (std::size_t i = 0; i < threadsCount; ++i)
+      threads.emplace_back(&ResourcesPreloader::LoadJobs, this);
+  }
+}
+
+void ResourcesPreloader::LoadJobs() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    jobQueued.wait(lock, [this]() { return stopping || !pendingJobs.empty(); });
+    if (stopping) return;
+
+    Job job = std::move(pendingJobs.front());
+    pendingJobs.pop_front();
+    lock.unlock();
+
+    Load(job);
+
+    lock.lock();
+    loadedJobs.push_back(std::move(job));
+    jobLoaded.notify_all();
+  }
+}
+
+void ResourcesPreloader::Load(Job& job) {
+  if (job.isImage) {
+    job.texture = std::make_shared<SFMLTextureWrapper>();
+    resourcesLoader->LoadSFMLImage(job.file, job.texture->image);
+    if (job.atlasImages.empty()) {
+      job.texture->collisionMask.Build(job.texture->image);
+      return;
+    }
+
+    // Same as gd::ImageManager::LoadFromAtlas, except for the texture of the
+    // atlas which is set when uploaded.
+    for (AtlasImage& atlasImage : job.atlasImages) {
+      atlasImage.texture = std::make_shared<SFMLTextureWrapper>();
+      SFMLTextureWrapper& texture = *atlasImage.texture;
+      texture.atlasRect = atlasImage.rect;
+      texture.image.create(atlasImage.rect.width, atlasImage.rect.height);
+      texture.image.copy(job.texture->image, 0, 0, atlasImage.rect);
+      texture.collisionMask.Build(texture.image);
+    }
+  } else {
+    job.soundBuffer = std::make_shared<sf::SoundBuffer>(
+        resourcesLoader->LoadSoundBuffer(job.file));
+  }
+}
+
+std::size_t ResourcesPreloader::UploadPreloadedResources(
+    const gd::ImageManager& imageManager,
+    SoundManager& soundManager,
+    std::size_t maxCount) {
+  std::vector<Job> jobs;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!loadedJobs.empty() && jobs.size() < maxCount) {
+      jobs.push_back(std::move(loadedJobs.front()));
+      loadedJobs.pop_front();
+    }
+  }
+
+  for (Job& job : jobs) {
+    if (!job.atlasImages.empty()) {
+      loadedCount += job.atlasImages.size();
+      UploadAtlas(job, imageManager);
+      continue;
+    }
+
+    ++loadedCount;
+    if (job.isImage) {
+      loadingImages.erase(job.name);
+      if (!IsInAGroup(job.name, true)) continue;
+
+      job.texture->texture.loadFromImage(job.texture->image);
+      job.texture->texture.setSmooth(job.smooth);
+      imageManager.AddLoadedSFMLTexture(job.name, job.texture);
+      imageManager.PinSFMLTexture(job.name);
+      preloadedImages.insert(job.name);
+    } else {
+      loadingSounds.erase(job.name);
+      if (!IsInAGroup(job.name, false)) continue;
+
+      preloadedSoundBuffers[job.name] = job.soundBuffer;
+      soundManager.AddPreloadedSoundBuffer(job.name, job.soundBuffer);
+    }
+  }
+
+  return jobs.size();
+}
+
+void ResourcesPreloader::UploadAtlas(Job& job,
+                                     const gd::ImageManager& imageManager) {
+  std::shared_ptr<SFMLTextureWrapper> atlas;
+  for (AtlasImage& atlasImage : job.atlasImages) {
+    loadingImages.erase(atlasImage.name);
+    if (!IsInAGroup(atlasImage.name, true)) continue;
+
+    // The atlas is uploaded if one of its images is still needed, unless the
+    // image manager loaded it in the meantime.
+    if (!atlas) {
+      atlas = imageManager.AddLoadedAtlas(job.file, job.texture);
+      if (atlas == job.texture) {
+        atlas->texture.loadFromImage(atlas->image);
+        atlas->texture.setSmooth(job.smooth);
+      }
+    }
+
+    atlasImage.texture->atlas = atlas;
+    imageManager.AddLoadedSFMLTexture(atlasImage.name, atlasImage.texture);
+    imageManager.PinSFMLTexture(atlasImage.name);
+    preloadedImages.insert(atlasImage.name);
+  }
+}
+
+void ResourcesPreloader::FinishPreloading(const gd::ImageManager& imageManager,
+                                          SoundManager& soundManager) {
+  while (!IsDone()) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobLoaded.wait(lock, [this]() { return !loadedJobs.empty(); });
+    }
+    UploadPreloadedResources(imageManager, soundManager);
+  }
+}
+
+bool ResourcesPreloader::IsInAGroup(const gd::String& name,
+                                    bool isImage) const {
+  for (auto& it : groups) {
+    const std::set<gd::String>& names =
+        isImage ? it.second.images : it.second.sounds;
+    if (names.find(name) != names.end()) return true;
+  }
+
+  return false;
+}
+
+void ResourcesPreloader::Release(const gd::String& group,
+                                 const gd::ImageManager& imageManager) {
+  auto released = groups.find(group);
+  if (released == groups.end()) return;
+
+  Group resources = std::move(released->second);
+  groups.erase(released);
+
+  for (const gd::String& name : resources.images) {
+    if (IsInAGroup(name, true) || preloadedImages.erase(name) == 0) continue;
+    imageManager.UnpinSFMLTexture(name);
+  }
+  for (const gd::String& file : resources.sounds)
+    if (!IsInAGroup(file, false)) preloadedSoundBuffers.erase(file);
+}
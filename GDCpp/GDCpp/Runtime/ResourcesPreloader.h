@@ -0,0 +1,219 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef RESOURCESPRELOADER_H
+#define RESOURCESPRELOADER_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+namespace gd {
+class ImageManager;
+class ResourcesLoader;
+class ResourcesManager;
+}  // namespace gd
+namespace sf {
+class SoundBuffer;
+}
+class RuntimeGame;
+class SFMLTextureWrapper;
+class SoundManager;
+
+/**
+ * \brief Load images and sounds in the background, using a pool of threads,
+ * so that scenes can start without loading their resources.
+ *
+ * Images are decoded (and their collision masks built) and sounds are loaded
+ * by the threads. Only the upload of the textures, done by
+ * UploadPreloadedResources, must be done on the main thread. Images packed in
+ * a texture atlas are loaded with their atlas: a thread decodes the atlas once
+ * and extracts all the requested images it contains, and only the atlas is
+ * uploaded.
+ *
+ * Preloaded resources are kept loaded by the preloader, in groups (usually
+ * one by layout), until their group is released. Images are pinned in the
+ * gd::ImageManager so that its cache does not unload them.
+ *
+ * Usage example, to prefetch the next scene while the current one is running:
+ * \code
+ * preloader.PreloadLayout(game, "Level 2");
+ *
+ * // At each frame:
+ * preloader.UploadPreloadedResources(*game.GetImageManager(),
+ *                                    game.GetSoundManager(), 4);
+ * std::cout << preloader.GetProgress() * 100 << "%" << std::endl;
+ * \endcode
+ *
+ * \see SceneStack
+ * \ingroup ResourcesManagement
+ */
+class GD_API ResourcesPreloader {
+ public:
+  /**
+   * \brief Create a preloader.
+   * \param threadsCount_ The number of threads loading resources. If 0, one
+   * thread is used for each core of the processor except one.
+   */
+  ResourcesPreloader(std::size_t threadsCount_ = 0);
+  virtual ~ResourcesPreloader();
+
+  /**
+   * \brief Start to load the resources used by a layout of the game, in a
+   * group having the name of the layout.
+   *
+   * \note In the IDE, all the resources exposed by the objects and events of
+   * the layout are preloaded. Games don't have this information, so only the
+   * images of the sprite objects are preloaded: other resources are loaded
+   * when they are used.
+   */
+  void PreloadLayout(RuntimeGame& game, const gd::String& layoutName);
+
+  /**
+   * \brief Start to load the specified resources, in the specified group.
+   *
+   * Resources already loaded, or being loaded, are not loaded again.
+   * \param imageNames The names of the image resources to load.
+   * \param audioNames The names of the audio resources, or the filenames, of
+   * the sounds to load.
+   */
+  void Preload(const gd::String& group,
+               const gd::ResourcesManager& resourcesManager,
+               const gd::ImageManager& imageManager,
+               const std::vector<gd::String>& imageNames,
+               const std::vector<gd::String>& audioNames);
+
+  /**
+   * \brief Upload the textures of the images decoded by the threads and give
+   * the loaded resources to the image and sound managers.
+   *
+   * Must be called on the main thread, for example once by frame.
+   * \param maxCount The maximum number of resources to upload, so that the
+   * time taken is limited.
+   * \return The number of resources uploaded.
+   */
+  std::size_t UploadPreloadedResources(
+      const gd::ImageManager& imageManager,
+      SoundManager& soundManager,
+      std::size_t maxCount = std::numeric_limits<std::size_t>::max());
+
+  /**
+   * \brief Wait for all the requested resources to be loaded, and upload
+   * them.
+   */
+  void FinishPreloading(const gd::ImageManager& imageManager,
+                        SoundManager& soundManager);
+
+  /**
+   * \brief Stop keeping loaded the resources of a group, unless they are also
+   * in another group. Resources not loaded yet won't be uploaded.
+   */
+  void Release(const gd::String& group, const gd::ImageManager& imageManager);
+
+  /**
+   * \brief Return true if a group of resources was preloaded (or is being
+   * preloaded).
+   */
+  bool HasGroup(const gd::String& group) const {
+    return groups.find(group) != groups.end();
+  }
+
+  /**
+   * \brief Return the number of resources requested since the preloader was
+   * last done.
+   */
+  std::size_t GetRequestedCount() const { return requestedCount; }
+
+  /**
+   * \brief Return the number of resources loaded and uploaded, among the
+   * requested ones.
+   */
+  std::size_t GetLoadedCount() const { return loadedCount; }
+
+  /**
+   * \brief Return the progress of the preloading, between 0 and 1.
+   */
+  float GetProgress() const {
+    return requestedCount == 0
+               ? 1.f
+               : static_cast<float>(loadedCount) / requestedCount;
+  }
+
+  /**
+   * \brief Return true if all the requested resources are loaded and
+   * uploaded.
+   */
+  bool IsDone() const { return loadedCount == requestedCount; }
+
+ private:
+  /**
+   * \brief An image packed in the texture atlas loaded by a job.
+   */
+  struct AtlasImage {
+    gd::String name;
+    sf::IntRect rect;  ///< The area of the atlas covered by the image.
+    std::shared_ptr<SFMLTextureWrapper> texture;  ///< The extracted image.
+  };
+
+  /**
+   * \brief A resource to be loaded by a thread.
+   */
+  struct Job {
+    bool isImage;
+    gd::String name;  ///< The name of the image, or the file of the sound or
+                      ///< of the atlas.
+    gd::String file;
+    bool smooth;
+    std::shared_ptr<SFMLTextureWrapper> texture;  ///< The loaded image.
+    std::shared_ptr<sf::SoundBuffer> soundBuffer;  ///< The loaded sound.
+    std::vector<AtlasImage> atlasImages;  ///< The images to extract, if the
+                                          ///< job loads a texture atlas.
+  };
+
+  /**
+   * \brief The resources of a group.
+   */
+  struct Group {
+    std::set<gd::String> images;
+    std::set<gd::String> sounds;  ///< The files of the sounds.
+  };
+
+  void Queue(Job job);
+  void LoadJobs();  ///< The function run by the threads.
+  void Load(Job& job);
+  void UploadAtlas(Job& job, const gd::ImageManager& imageManager);
+  bool IsInAGroup(const gd::String& name, bool isImage) const;
+
+  std::map<gd::String, Group> groups;
+  std::set<gd::String> preloadedImages;  ///< The images pinned in the image
+                                        ///< manager.
+  std::map<gd::String, std::shared_ptr<sf::SoundBuffer> >
+      preloadedSoundBuffers;  ///< The loaded sounds, kept alive.
+  std::set<gd::String> loadingImages;  ///< Images queued but not uploaded.
+  std::set<gd::String> loadingSounds;  ///< Sounds queued but not uploaded.
+  std::size_t requestedCount;
+  std::size_t loadedCount;
+
+  gd::ResourcesLoader* resourcesLoader;
+  std::size_t threadsCount;
+  std::vector<std::thread> threads;  ///< Started with the first job.
+
+  // Members shared with the threads, protected by the mutex:
+  std::mutex mutex;
+  std::condition_variable jobQueued;
+  std::condition_variable jobLoaded;
+  std::deque<Job> pendingJobs;
+  std::deque<Job> loadedJobs;
+  bool stopping;
+};
+
+#endif  // RESOURCESPRELOADER_H
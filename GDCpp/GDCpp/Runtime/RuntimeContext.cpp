@@ -25,28 +25,23 @@ std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
   return scene->objectsInstances.GetObjectsRawPointers(name);
 }
 
-RuntimeVariablesContainer &RuntimeContext::GetSceneVariables() {
-  return scene->GetVariables();
+std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
+    std::size_t objectNameId) {
+  return scene->objectsInstances.GetObjectsRawPointers(objectNameId);
 }
 
-RuntimeVariablesContainer &RuntimeContext::GetGameVariables() {
-  return scene->game->GetVariables();
+std::size_t RuntimeContext::GetObjectNameId(const gd::String &name) {
+  return ObjInstancesHolder::GetObjectNameId(name);
 }
 
-RuntimeContext &RuntimeContext::ClearObjectListsMap() {
-  temporaryMap.clear();
-
-  return *this;
+RuntimeVariablesContainer &RuntimeContext::GetSceneVariables() {
+  return scene->GetVariables();
 }
 
-RuntimeContext &RuntimeContext::AddObjectListToMap(
-    const gd::String &objectName, std::vector<RuntimeObject *> &list) {
-  temporaryMap[objectName] = &list;
-
-  return *this;
+RuntimeVariablesContainer &RuntimeContext::GetGameVariables() {
+  return scene->game->GetVariables();
 }
 
-std::map<gd::String, std::vector<RuntimeObject *> *>
-RuntimeContext::ReturnObjectListsMap() {
-  return temporaryMap;
+ObjectsPickingScratch *RuntimeContext::GetObjectsPickingScratch() {
+  return &scene->GetObjectsPickingScratch();
 }
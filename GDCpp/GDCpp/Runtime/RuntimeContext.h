@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
 #include "GDCpp/Runtime/String.h"
 class RuntimeObject;
 class RuntimeScene;
@@ -30,6 +31,20 @@ class GD_API RuntimeContext {
    */
   std::vector<RuntimeObject *> GetObjectsRawPointers(const gd::String &name);
 
+  /**
+   * \brief Shortcut to get a "raw pointers" list to objects with a specific
+   * name identifier.
+   * \see RuntimeContext::GetObjectNameId
+   */
+  std::vector<RuntimeObject *> GetObjectsRawPointers(std::size_t objectNameId);
+
+  /**
+   * \brief Shortcut for ObjInstancesHolder::GetObjectNameId(name).
+   *
+   * Used by events generated code to resolve the names of objects only once.
+   */
+  static std::size_t GetObjectNameId(const gd::String &name);
+
   /**
    * \brief Shortcut for scene->GetVariables();
    */
@@ -52,15 +67,17 @@ class GD_API RuntimeContext {
    */
   void StartNewFrame();
 
-  RuntimeContext &ClearObjectListsMap();
-  RuntimeContext &AddObjectListToMap(const gd::String &objectName,
-                                     std::vector<RuntimeObject *> &list);
-  std::map<gd::String, std::vector<RuntimeObject *> *> ReturnObjectListsMap();
+  /**
+   * \brief Shortcut for &scene->GetObjectsPickingScratch().
+   *
+   * Given by events generated code to the RuntimeObjectsLists passed to
+   * functions.
+   */
+  ObjectsPickingScratch *GetObjectsPickingScratch();
 
   RuntimeScene *scene;  ///< The associated scene.
 
  private:
-  std::map<gd::String, std::vector<RuntimeObject *> *> temporaryMap;
   std::map<std::size_t, bool> onceConditionsTriggered;
   std::map<std::size_t, bool> onceConditionsTriggeredLastFrame;
 };
@@ -15,10 +15,12 @@
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/PolygonCollision.h"
+#include "GDCpp/Runtime/RenderQueue.h"
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 
 using namespace std;
 
@@ -29,7 +31,14 @@ RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
       Y(0),
       zOrder(0),
       hidden(false),
-      objectVariables(object.GetVariables()) {
+      objectVariables(object.GetVariables()),
+      instancesHolderNameId(std::numeric_limits<std::size_t>::max()),
+      instancesHolderIndex(0),
+      renderQueue(nullptr),
+      renderQueueLayer(0),
+      renderQueueIndex(0),
+      renderQueueCell(0),
+      renderQueueCellIndex(0) {
   ClearForce();
 
   // Create the behaviors
@@ -44,7 +53,9 @@ RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
   }
 }
 
-RuntimeObject::~RuntimeObject() {}
+RuntimeObject::~RuntimeObject() {
+  if (renderQueue) renderQueue->RemoveObject(this);
+}
 
 void RuntimeObject::Init(const RuntimeObject &object) {
   name = object.name;
@@ -67,6 +78,16 @@ void RuntimeObject::Init(const RuntimeObject &object) {
         gd::make_unique<RuntimeBehavior>(*it->second->Clone());
     behaviors[it->first]->SetOwner(this);
   }
+
+  if (renderQueue) RenderingOrderChanged();
+}
+
+void RuntimeObject::RenderingOrderChanged() {
+  renderQueue->ObjectChanged(this);
+}
+
+void RuntimeObject::RenderingBoundsChanged() {
+  renderQueue->ObjectBoundsChanged(this);
 }
 
 /**
@@ -137,7 +158,7 @@ bool RuntimeObject::ChangeProperty(std::size_t propertyNb,
     } else
       SetHidden(false);
   } else if (propertyNb == 4) {
-    layer = newValue;
+    SetLayer(newValue);
   } else if (propertyNb == 5) {
     SetZOrder(newValue.To<int>());
   } else if (propertyNb == 6) {
@@ -236,17 +257,26 @@ void RuntimeObject::AddForceToMoveAround(float positionX,
   forces.push_back(Force(newX - oldX, newY - oldY, clearing));
 }
 
-void RuntimeObject::Duplicate(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+void RuntimeObject::Duplicate(RuntimeScene &scene,
+                              const RuntimeObjectsLists &pickedObjectLists) {
   RuntimeObject *newObject =
       scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(Clone()));
 
-  if (pickedObjectLists[name] != NULL &&
-      find(pickedObjectLists[name]->begin(),
-           pickedObjectLists[name]->end(),
-           newObject) == pickedObjectLists[name]->end())
-    pickedObjectLists[name]->push_back(newObject);
+  std::vector<RuntimeObject *> *list = pickedObjectLists.Get(name);
+  if (list != NULL && find(list->begin(), list->end(), newObject) == list->end())
+    list->push_back(newObject);
+}
+
+bool RuntimeObject::DrawInBatch(sf::RenderTarget& renderTarget,
+                                SpriteBatch& spriteBatch) {
+  // Don't draw anything if hidden (and keep batching the sprites)
+  if (hidden) return true;
+
+  spriteBatch.Flush(renderTarget);
+  if (!Draw(renderTarget)) return false;
+
+  spriteBatch.CountDrawCall();
+  return true;
 }
 
 bool RuntimeObject::IsStopped() { return TotalForceLength() == 0; }
@@ -298,11 +328,9 @@ double RuntimeObject::GetDistanceWithObject(RuntimeObject *object) {
 }
 
 bool RuntimeObject::SeparateFromObjects(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    bool ignoreTouchingEdges) {
+    const RuntimeObjectsLists &pickedObjectLists, bool ignoreTouchingEdges) {
   vector<RuntimeObject *> objects;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
+  for (RuntimeObjectsLists::const_iterator it = pickedObjectLists.begin();
        it != pickedObjectLists.end();
        ++it) {
     if (it->second != NULL) {
@@ -321,8 +349,10 @@ bool RuntimeObject::SeparateFromObjects(
   sf::Vector2f moveVector;
   for (std::size_t j = 0; j < objects.size(); ++j) {
     if (objects[j] != this) {
-      std::vector<Polygon2d> hitBoxes = GetHitBoxes(objects[j]->GetAABB());
-      vector<Polygon2d> otherHitBoxes = objects[j]->GetHitBoxes(GetAABB());
+      const std::vector<Polygon2d>& hitBoxes =
+          GetHitBoxes(objects[j]->GetAABB());
+      const std::vector<Polygon2d>& otherHitBoxes =
+          objects[j]->GetHitBoxes(GetAABB());
       for (std::size_t k = 0; k < hitBoxes.size(); ++k) {
         for (std::size_t l = 0; l < otherHitBoxes.size(); ++l) {
           CollisionResult result = PolygonCollisionTest(
@@ -410,8 +440,8 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject *obj2,
   sf::FloatRect objRect = obj1->GetAABB();
   sf::FloatRect obj2Rect = obj2->GetAABB();
 
-  vector<Polygon2d> objHitboxes = obj1->GetHitBoxes(obj2Rect);
-  vector<Polygon2d> obj2Hitboxes = obj2->GetHitBoxes(objRect);
+  const vector<Polygon2d>& objHitboxes = obj1->GetHitBoxes(obj2Rect);
+  const vector<Polygon2d>& obj2Hitboxes = obj2->GetHitBoxes(objRect);
   for (std::size_t k = 0; k < objHitboxes.size(); ++k) {
     for (std::size_t l = 0; l < obj2Hitboxes.size(); ++l) {
       if (PolygonCollisionTest(
@@ -425,7 +455,7 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject *obj2,
 }
 
 bool RuntimeObject::IsCollidingWithPoint(float pointX, float pointY) {
-  vector<Polygon2d> hitBoxes = GetHitBoxes();
+  const vector<Polygon2d>& hitBoxes = GetHitBoxes();
   for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
     if (IsPointInsidePolygon(hitBoxes[i], pointX, pointY)) return true;
   }
@@ -451,7 +481,7 @@ RaycastResult RuntimeObject::RaycastTest(
 
   float testSqDist = closest ? sqDist : 0.0f;
 
-  vector<Polygon2d> hitboxes = GetHitBoxes();
+  const vector<Polygon2d>& hitboxes = GetHitBoxes();
   for (std::size_t i = 0; i < hitboxes.size(); ++i) {
     RaycastResult res = PolygonRaycastTest(hitboxes[i], x, y, endX, endY);
 
@@ -471,10 +501,9 @@ RaycastResult RuntimeObject::RaycastTest(
 }
 
 void RuntimeObject::SeparateObjectsWithoutForces(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+    const RuntimeObjectsLists &pickedObjectLists) {
   vector<RuntimeObject *> objects2;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
+  for (RuntimeObjectsLists::const_iterator it = pickedObjectLists.begin();
        it != pickedObjectLists.end();
        ++it) {
     if (it->second != NULL) {
@@ -511,10 +540,9 @@ void RuntimeObject::SeparateObjectsWithoutForces(
 }
 
 void RuntimeObject::SeparateObjectsWithForces(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+    const RuntimeObjectsLists &pickedObjectLists) {
   vector<RuntimeObject *> objects2;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
+  for (RuntimeObjectsLists::const_iterator it = pickedObjectLists.begin();
        it != pickedObjectLists.end();
        ++it) {
     if (it->second != NULL) {
@@ -626,17 +654,28 @@ sf::FloatRect RuntimeObject::GetAABB() const {
   return resultTransform.transformRect(notTransformedAABB);
 }
 
-std::vector<Polygon2d> RuntimeObject::GetHitBoxes() const {
-  std::vector<Polygon2d> mask;
-  Polygon2d rectangle = Polygon2d::CreateRectangle(GetWidth(), GetHeight());
+const std::vector<Polygon2d>& RuntimeObject::GetHitBoxes() const {
+  // The storage of the hitbox is reused to avoid allocations: the vertices
+  // are updated in place (like Polygon2d::CreateRectangle would create them)
+  // and the edges are computed again in the same vector by Move.
+  defaultHitBoxes.resize(1);
+  Polygon2d& rectangle = defaultHitBoxes[0];
+  std::vector<sf::Vector2f>& vertices = rectangle.vertices;
+  float halfWidth = GetWidth() / 2.0f;
+  float halfHeight = GetHeight() / 2.0f;
+  vertices.resize(4);
+  vertices[0] = sf::Vector2f(-halfWidth, -halfHeight);
+  vertices[1] = sf::Vector2f(+halfWidth, -halfHeight);
+  vertices[2] = sf::Vector2f(+halfWidth, +halfHeight);
+  vertices[3] = sf::Vector2f(-halfWidth, +halfHeight);
   rectangle.Rotate(GetAngle() / 180 * 3.14159);
   rectangle.Move(GetX() + GetCenterX(), GetY() + GetCenterY());
 
-  mask.push_back(rectangle);
-  return mask;
+  return defaultHitBoxes;
 }
 
-std::vector<Polygon2d> RuntimeObject::GetHitBoxes(sf::FloatRect hint) const {
+const std::vector<Polygon2d>& RuntimeObject::GetHitBoxes(
+    sf::FloatRect hint) const {
   return GetHitBoxes();
 }
 
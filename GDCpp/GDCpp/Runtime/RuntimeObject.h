@@ -7,13 +7,17 @@
 #define RUNTIMEOBJECT_H
 
 #include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include "GDCore/Tools/MakeUnique.h"
 #include "GDCpp/Runtime/Force.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/String.h"
 namespace gd {
@@ -23,9 +27,10 @@ class Object;
 namespace sf {
 class RenderTarget;
 }
-class Polygon2d;
 class RaycastResult;
+class RenderQueue;
 class RuntimeScene;
+class SpriteBatch;
 
 /**
  * \brief A RuntimeObject is something displayed on the scene.
@@ -90,7 +95,16 @@ class GD_API RuntimeObject {
   /**
    * \brief Copy constructor. Calls Init().
    */
-  RuntimeObject(const RuntimeObject& object) { Init(object); };
+  RuntimeObject(const RuntimeObject& object)
+      : instancesHolderNameId(std::numeric_limits<std::size_t>::max()),
+        instancesHolderIndex(0),
+        renderQueue(nullptr),
+        renderQueueLayer(0),
+        renderQueueIndex(0),
+        renderQueueCell(0),
+        renderQueueCellIndex(0) {
+    Init(object);
+  };
 
   /**
    * \brief Assignment operator. Calls Init().
@@ -136,6 +150,20 @@ class GD_API RuntimeObject {
    */
   virtual bool Draw(sf::RenderTarget& renderTarget) { return true; };
 
+  /**
+   * \brief Draw the object, using a batch so that consecutive objects sharing
+   * a texture are drawn at once.
+   *
+   * The default implementation draws the sprites of the batch, then calls
+   * Draw and counts it as a draw call, unless the object is hidden. Redefine
+   * it if your object is made of sprites.
+   *
+   * \param renderTarget The SFML Rendertarget where object must be drawn.
+   * \param spriteBatch The batch of sprites to be drawn.
+   */
+  virtual bool DrawInBatch(sf::RenderTarget& renderTarget,
+                           SpriteBatch& spriteBatch);
+
   /** \name Object's variables
    * Members functions providing access to the object's variables.
    */
@@ -211,7 +239,12 @@ class GD_API RuntimeObject {
   /**
    * \brief Change the Z order of the object
    */
-  inline void SetZOrder(int zOrder_) { zOrder = zOrder_; }
+  inline void SetZOrder(int zOrder_) {
+    if (zOrder == zOrder_) return;
+
+    zOrder = zOrder_;
+    if (renderQueue) RenderingOrderChanged();
+  }
 
   /**
    * \brief Return if the object is hidden or not
@@ -231,7 +264,12 @@ class GD_API RuntimeObject {
   /**
    * \brief Change the layer of the object
    */
-  inline void SetLayer(const gd::String& layer_) { layer = layer_; }
+  inline void SetLayer(const gd::String& layer_) {
+    if (layer == layer_) return;
+
+    layer = layer_;
+    if (renderQueue) RenderingOrderChanged();
+  }
 
   /**
    * \brief Get the layer of the object
@@ -247,22 +285,40 @@ class GD_API RuntimeObject {
 
   /**
    * \brief Get the object AABB
+   * \note Default implementation computes the AABB from the object
+   * width/height, center and angle. Objects can redefine it to cache the AABB.
+   */
+  virtual sf::FloatRect GetAABB() const;
+
+  /**
+   * \brief Return true if the object can be skipped when it is outside of the
+   * area seen by a camera.
+   *
+   * Objects returning true must call NotifyBoundsChanged when their AABB
+   * changes for another reason than a change of their position.
+   *
+   * \note Default implementation returns false: the object is always drawn.
+   * \see RenderQueue::GetVisibleLayerObjects
    */
-  sf::FloatRect GetAABB() const;
+  virtual bool CanBeCulled() const { return false; }
 
   /**
-   * \brief Get the object hitbox(es)
+   * \brief Get the object hitbox(es), with their edges computed.
+   *
+   * The hitboxes are owned by the object: the reference is only valid until
+   * the object is changed or until the next call to GetHitBoxes.
+   *
    * \note Default implementation returns a basic bounding box, according to the
    * object width/height and angle.
    */
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes() const;
 
   /**
    * \brief Get the object hitbox(es) preferably intersecting with hint
    * \note The default implementation returns all the hitbox given by
    * GetHitBoxes()
    */
-  virtual std::vector<Polygon2d> GetHitBoxes(sf::FloatRect hint) const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes(sf::FloatRect hint) const;
 
   /**
    * \brief Check collision between two objects using their hitboxes.
@@ -394,6 +450,7 @@ class GD_API RuntimeObject {
    */
   void SetX(float x_) {
     X = x_;
+    if (renderQueue) RenderingBoundsChanged();
     OnPositionChanged();
   }
 
@@ -404,6 +461,7 @@ class GD_API RuntimeObject {
    */
   void SetY(float y_) {
     Y = y_;
+    if (renderQueue) RenderingBoundsChanged();
     OnPositionChanged();
   }
 
@@ -576,9 +634,8 @@ class GD_API RuntimeObject {
              const char* yOperator,
              float yValue);
 
-  void Duplicate(
-      RuntimeScene& scene,
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
+  void Duplicate(RuntimeScene& scene,
+                 const RuntimeObjectsLists& pickedObjectLists);
   void ActivateBehavior(const gd::String& behaviorName, bool activate = true);
   bool BehaviorActivated(const gd::String& behaviorName);
 
@@ -588,19 +645,18 @@ class GD_API RuntimeObject {
   double GetSqDistanceWithObject(RuntimeObject* other);
   double GetDistanceWithObject(RuntimeObject* other);
 
-  bool SeparateFromObjects(
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists,
-      bool ignoreTouchingEdges = false);
+  bool SeparateFromObjects(const RuntimeObjectsLists& pickedObjectLists,
+                           bool ignoreTouchingEdges = false);
 
   /** \deprecated
    */
   void SeparateObjectsWithoutForces(
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
+      const RuntimeObjectsLists& pickedObjectLists);
 
   /** \deprecated
    */
   void SeparateObjectsWithForces(
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
+      const RuntimeObjectsLists& pickedObjectLists);
   ///@}
 
  protected:
@@ -625,6 +681,49 @@ class GD_API RuntimeObject {
    * assign-op. \warning Don't forget to update me if members were changed!
    */
   void Init(const RuntimeObject& object);
+
+  /**
+   * \brief To be called by objects that can be culled when their AABB changed
+   * (because their size, their angle or their animation changed for example).
+   * \see CanBeCulled
+   */
+  void NotifyBoundsChanged() {
+    if (renderQueue) RenderingBoundsChanged();
+  }
+
+ private:
+  friend class ObjInstancesHolder;
+  friend class RenderQueue;
+
+  /**
+   * \brief Tell the render queue containing the object that its Z order or
+   * its layer changed.
+   */
+  void RenderingOrderChanged();
+
+  /**
+   * \brief Tell the render queue containing the object that its AABB changed.
+   */
+  void RenderingBoundsChanged();
+
+  std::size_t instancesHolderNameId;  ///< The identifier of the list of the
+                                      ///< ObjInstancesHolder containing the
+                                      ///< object.
+  std::size_t instancesHolderIndex;   ///< The position of the object in this
+                                      ///< list.
+  RenderQueue* renderQueue;       ///< The render queue containing the object,
+                                  ///< if any.
+  std::size_t renderQueueLayer;   ///< The layer of the object in renderQueue.
+  std::size_t renderQueueIndex;   ///< The position of the object in this
+                                  ///< layer.
+  sf::FloatRect renderQueueBounds;  ///< The AABB of the object, as known by
+                                    ///< renderQueue.
+  std::int64_t renderQueueCell;       ///< The cell of the object in its layer.
+  std::size_t renderQueueCellIndex;   ///< The position of the object in this
+                                      ///< cell.
+  mutable std::vector<Polygon2d>
+      defaultHitBoxes;  ///< Filled by the default implementation of
+                        ///< GetHitBoxes.
 };
 
 #endif  // RUNTIMEOBJECT_H
@@ -0,0 +1,19 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
+
+void ObjectsPickingScratch::Reset(const RuntimeObjectsLists &objectsLists1,
+                                  const RuntimeObjectsLists &objectsLists2) {
+  firstFlags.clear();
+  firstFlags.push_back(0);
+  for (const RuntimeObjectsLists *objectsLists : {&objectsLists1, &objectsLists2}) {
+    for (const auto &list : *objectsLists)
+      firstFlags.push_back(firstFlags.back() +
+                           (list.second ? list.second->size() : 0));
+  }
+
+  picked.assign(firstFlags.back(), false);
+}
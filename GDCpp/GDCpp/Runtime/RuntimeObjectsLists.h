@@ -0,0 +1,158 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef RUNTIMEOBJECTSLISTS_H
+#define RUNTIMEOBJECTSLISTS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+class RuntimeObject;
+class ObjectsPickingScratch;
+
+/**
+ * \brief A non-owning view on lists of picked objects, given to the functions
+ * called by events generated code.
+ *
+ * Each list is a pair made of the name of the objects and a pointer to the
+ * list of picked objects having this name. Nothing is copied: the view only
+ * refers to an array of these pairs. Events generated code creates the array
+ * as a temporary std::initializer_list, which lives until the called function
+ * returns:
+ * \code
+ * PickedObjectsCount(RuntimeObjectsLists(
+ *     {{&GDPlayerObjectsName, &GDPlayerObjects}},
+ *     runtimeContext->GetObjectsPickingScratch()));
+ * \endcode
+ *
+ * \warning A function must not keep a RuntimeObjectsLists after it returns.
+ *
+ * \see RuntimeObjectsListsTools.h
+ * \ingroup GameEngine
+ */
+class GD_API RuntimeObjectsLists {
+ public:
+  typedef std::pair<const gd::String *, std::vector<RuntimeObject *> *> List;
+  typedef const List *const_iterator;
+
+  /**
+   * \brief Construct a view on the lists of an initializer list.
+   *
+   * \warning The array of an initializer list only lives until the end of the
+   * full-expression: only use this constructor in a function call.
+   * \param scratch_ The memory that functions picking objects can use (can be
+   * nullptr).
+   */
+  RuntimeObjectsLists(std::initializer_list<List> lists_,
+                      ObjectsPickingScratch *scratch_ = nullptr)
+      : lists(lists_.begin()), count(lists_.size()), scratch(scratch_){};
+
+  /**
+   * \brief Construct a view on the lists of an array.
+   */
+  template <std::size_t N>
+  RuntimeObjectsLists(const List (&lists_)[N],
+                      ObjectsPickingScratch *scratch_ = nullptr)
+      : lists(lists_), count(N), scratch(scratch_){};
+
+  const_iterator begin() const { return lists; }
+  const_iterator end() const { return lists + count; }
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  /**
+   * \brief Return the list of the objects having the specified name, or
+   * nullptr if there is no list for these objects.
+   */
+  std::vector<RuntimeObject *> *Get(const gd::String &name) const {
+    for (std::size_t i = 0; i < count; ++i)
+      if (*lists[i].first == name) return lists[i].second;
+
+    return nullptr;
+  }
+
+  /**
+   * \brief Return the memory to be used by functions picking objects, or
+   * nullptr if none was given.
+   */
+  ObjectsPickingScratch *GetPickingScratch() const { return scratch; }
+
+ private:
+  const List *lists;
+  std::size_t count;
+  ObjectsPickingScratch *scratch;
+};
+
+/**
+ * \brief Memory used by the functions picking objects from two
+ * RuntimeObjectsLists (see TwoObjectListsTest) to mark the objects to be
+ * kept in the lists.
+ *
+ * It's owned by the scene, so that it's reused between calls instead of
+ * being allocated each time objects are tested.
+ *
+ * \see RuntimeScene::GetObjectsPickingScratch
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsPickingScratch {
+ public:
+  ObjectsPickingScratch(){};
+  virtual ~ObjectsPickingScratch(){};
+
+  /**
+   * \brief Mark all the objects of the lists as not picked.
+   *
+   * Lists are numbered from the first list of \a objectsLists1 to the last
+   * list of \a objectsLists2.
+   */
+  void Reset(const RuntimeObjectsLists &objectsLists1,
+             const RuntimeObjectsLists &objectsLists2);
+
+  /**
+   * \brief Return the position, in the flags, of the flag of the first object
+   * of the specified list.
+   */
+  std::size_t GetFirstFlag(std::size_t listIndex) const {
+    return firstFlags[listIndex];
+  }
+
+  /**
+   * \brief Return the number of objects of the specified list when Reset
+   * was called.
+   */
+  std::size_t GetListSize(std::size_t listIndex) const {
+    return firstFlags[listIndex + 1] - firstFlags[listIndex];
+  }
+
+  /**
+   * \brief Return the index of the list containing the object at the specified
+   * position in the flags.
+   */
+  std::size_t GetListOfFlag(std::size_t flag) const {
+    return std::upper_bound(firstFlags.begin(), firstFlags.end(), flag) -
+           firstFlags.begin() - 1;
+  }
+
+  /**
+   * \brief Return true if the object at the specified position in the flags is
+   * picked.
+   */
+  bool IsPicked(std::size_t flag) const { return picked[flag]; }
+
+  /**
+   * \brief Mark the object at the specified position in the flags as picked.
+   */
+  void SetPicked(std::size_t flag) { picked[flag] = true; }
+
+ private:
+  std::vector<bool> picked;  ///< A flag for each object of the lists.
+  std::vector<std::size_t> firstFlags;  ///< The position of the flag of the
+                                        ///< first object of each list.
+};
+
+#endif  // RUNTIMEOBJECTSLISTS_H
@@ -4,19 +4,46 @@
  * reserved. This project is released under the MIT License.
  */
 #include "RuntimeObjectsListsTools.h"
-#include <map>
 #include <string>
 #include <vector>
 #include "RuntimeObject.h"
 #include "RuntimeScene.h"
 
-void GD_API PickOnly(RuntimeObjectsLists& pickedObjectsLists,
+void GD_API PickOnly(const RuntimeObjectsLists& pickedObjectsLists,
                      RuntimeObject* thisOne) {
   for (auto it = pickedObjectsLists.begin(); it != pickedObjectsLists.end();
        ++it) {
     if (it->second != NULL) it->second->clear();
   }
 
-  if (pickedObjectsLists[thisOne->GetName()] != NULL)
-    pickedObjectsLists[thisOne->GetName()]->push_back(thisOne);
+  std::vector<RuntimeObject*>* list = pickedObjectsLists.Get(thisOne->GetName());
+  if (list != NULL) list->push_back(thisOne);
+}
+
+void GD_API TrimNotPickedObjects(const RuntimeObjectsLists& objectsLists,
+                                 const ObjectsPickingScratch& scratch,
+                                 std::size_t firstList,
+                                 bool skipAlreadyTrimmedLists) {
+  std::size_t i = firstList;
+  for (auto it = objectsLists.begin(); it != objectsLists.end(); ++it, ++i) {
+    if (!it->second) continue;
+    std::vector<RuntimeObject*>& arr = *it->second;
+
+    //*This is important*! We can have a list that has already been trimmed
+    // just before (if the same list is used twice): if the size of the objects
+    // list is not the size of the list when the flags were reset, skip it.
+    if (skipAlreadyTrimmedLists && arr.size() != scratch.GetListSize(i))
+      continue;
+
+    std::size_t firstFlag = scratch.GetFirstFlag(i);
+    std::size_t finalSize = 0;
+    for (std::size_t k = 0; k < arr.size(); ++k) {
+      RuntimeObject* obj = arr[k];
+      if (scratch.IsPicked(firstFlag + k)) {
+        arr[finalSize] = obj;
+        finalSize++;
+      }
+    }
+    arr.resize(finalSize);
+  }
 }
@@ -6,28 +6,46 @@
 #ifndef OBJECTSLISTSTOOLS_H
 #define OBJECTSLISTSTOOLS_H
 
-#include <map>
 #include <string>
 #include <vector>
+#include "ObjectsBroadPhase.h"
+#include "RuntimeObjectsLists.h"
 #include "RuntimeObject.h"
 #include "RuntimeScene.h"
 
-typedef std::map<gd::String, std::vector<RuntimeObject *> *>
-    RuntimeObjectsLists;
-
 /**
  * \brief Keep only the specified object in the lists of picked objects.
  * \param objectsLists The lists of objects to trim
  * \param thisOne The object to keep in the lists
  * \ingroup GameEngine
  */
-void GD_API PickOnly(RuntimeObjectsLists &pickedObjectsLists,
+void GD_API PickOnly(const RuntimeObjectsLists &pickedObjectsLists,
                      RuntimeObject *thisOne);
 
+/**
+ * \brief Remove from the lists the objects that are not marked as picked.
+ *
+ * \param objectsLists The lists of objects to trim
+ * \param scratch The flags telling, for each object, if it must be kept.
+ * \param firstList The index, in \a scratch, of the first list of \a
+ * objectsLists.
+ * \param skipAlreadyTrimmedLists If true, lists having a size different from
+ * their size when the flags were reset are considered as already trimmed and
+ * left untouched. This is important when the same list is used twice in a
+ * test.
+ *
+ * \ingroup GameEngine
+ */
+void GD_API TrimNotPickedObjects(const RuntimeObjectsLists &objectsLists,
+                                 const ObjectsPickingScratch &scratch,
+                                 std::size_t firstList,
+                                 bool skipAlreadyTrimmedLists);
+
 /**
  * \brief Filter objects to keep only the one that fullfil the predicate
  *
  * Objects that do not fullfil the predicate are removed from objects lists.
+ * Lists are filtered in place, without allocating memory.
  *
  * \param objectsLists The lists of objects to trim
  * \param negatePredicate If set to true, the result of the predicate is
@@ -43,46 +61,19 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
                    Pred predicate) {
   bool isTrue = false;
 
-  // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList.push_back(arr);
-  }
-
-  // Pick objects which are fulfulling the predicate.
-  std::size_t i = 0;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it, ++i) {
-    if (!it->second) continue;
-    const std::vector<RuntimeObject *> &arr1 = *it->second;
-
-    for (std::size_t k = 0; k < arr1.size(); ++k) {
-      if (negatePredicate ^ predicate(arr1[k])) {
-        pickedList[i][k] = true;
-        isTrue = true;
-      }
-    }
-  }
-
-  // Trim not picked objects from lists.
-  i = 0;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it, ++i) {
-    size_t finalSize = 0;
-    if (!it->second) continue;
-    std::vector<RuntimeObject *> &arr = *it->second;
+  // Keep the objects which are fulfilling the predicate, moving them to the
+  // beginning of their list.
+  for (const auto &list : pickedObjectsLists) {
+    if (!list.second) continue;
+    std::vector<RuntimeObject *> &arr = *list.second;
 
+    std::size_t finalSize = 0;
     for (std::size_t k = 0; k < arr.size(); ++k) {
       RuntimeObject *obj = arr[k];
-      if (pickedList[i][k]) {
+      if (negatePredicate ^ predicate(obj)) {
         arr[finalSize] = obj;
         finalSize++;
+        isTrue = true;
       }
     }
     arr.resize(finalSize);
@@ -103,47 +94,38 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
  * predicate won't be called again.
  *
  * objectsLists1 and objectsLists2 may contains one or more identical pointers
- * to some lists (See *This is important* comment at the end of the algorithm,
- * when trimming the list).
+ * to some lists (See *This is important* comment in TrimNotPickedObjects).
+ *
+ * The objects are marked as picked using the ObjectsPickingScratch of
+ * objectsLists1, so that no memory is allocated (a temporary one is used if
+ * the lists were not given one).
  *
  * Cost (Worst case, predicate being always false):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Resetting NbObjList1+NbObjList2 booleans)
  *  + Cost(predicate)*NbObjList1*NbObjList2
  *  + Cost(Testing NbObjList1+NbObjList2 booleans)
  *  + Cost(Removing NbObjList1+NbObjList2 objects from all the lists)
  *
  * Cost (Best case, predicate being always true):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Resetting NbObjList1+NbObjList2 booleans)
  *  + Cost(predicate)*(NbObjList1+NbObjList2)
  *  + Cost(Testing NbObjList1+NbObjList2 booleans)
  *
  * \ingroup GameEngine
  */
 template <typename Pred>
-bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
-                        RuntimeObjectsLists objectsLists2,
+bool TwoObjectListsTest(const RuntimeObjectsLists &objectsLists1,
+                        const RuntimeObjectsLists &objectsLists2,
                         bool negatePredicate,
                         Pred predicate) {
   bool isTrue = false;
 
   // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList1;
-  std::vector<std::vector<bool> > pickedList2;
-
-  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
-       it != objectsLists1.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList1.push_back(arr);
-  }
-  for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-       it != objectsLists2.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList2.push_back(arr);
-  }
+  ObjectsPickingScratch temporaryScratch;
+  ObjectsPickingScratch &scratch = objectsLists1.GetPickingScratch()
+                                       ? *objectsLists1.GetPickingScratch()
+                                       : temporaryScratch;
+  scratch.Reset(objectsLists1, objectsLists2);
 
   // Launch the function each object of the first list with each object
   // of the second list.
@@ -153,19 +135,22 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
        ++it, ++i) {
     if (!it->second) continue;
     const std::vector<RuntimeObject *> &arr1 = *it->second;
+    std::size_t firstFlag1 = scratch.GetFirstFlag(i);
 
     for (std::size_t k = 0; k < arr1.size(); ++k) {
       bool atLeastOneObject = false;
 
-      std::size_t j = 0;
+      std::size_t j = objectsLists1.size();
       for (RuntimeObjectsLists::const_iterator it2 = objectsLists2.begin();
            it2 != objectsLists2.end();
            ++it2, ++j) {
         if (!it2->second) continue;
         const std::vector<RuntimeObject *> &arr2 = *it2->second;
+        std::size_t firstFlag2 = scratch.GetFirstFlag(j);
 
         for (std::size_t l = 0; l < arr2.size(); ++l) {
-          if (pickedList1[i][k] && pickedList2[j][l])
+          if (scratch.IsPicked(firstFlag1 + k) &&
+              scratch.IsPicked(firstFlag2 + l))
             continue;  // Avoid unnecessary costly call to functor.
 
           if (std::addressof(arr1[k]) != std::addressof(arr2[l]) &&
@@ -174,8 +159,8 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
               isTrue = true;
 
               // Pick the objects
-              pickedList1[i][k] = true;
-              pickedList2[j][l] = true;
+              scratch.SetPicked(firstFlag1 + k);
+              scratch.SetPicked(firstFlag2 + l);
             }
 
             atLeastOneObject = true;
@@ -186,57 +171,121 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
       if (!atLeastOneObject &&
           negatePredicate) {  // The object is not overlapping any other object.
         isTrue = true;
-        pickedList1[i][k] = true;
+        scratch.SetPicked(firstFlag1 + k);
       }
     }
   }
 
-  // Trim not picked objects from lists.
-  i = 0;
+  TrimNotPickedObjects(objectsLists1, scratch, 0, false);
+  if (!negatePredicate)
+    TrimNotPickedObjects(objectsLists2, scratch, objectsLists1.size(), true);
+
+  return isTrue;
+}
+
+/**
+ * \brief Same as TwoObjectListsTest, but using a broad-phase so that the
+ * predicate is only called on pairs of objects that are near each other.
+ *
+ * Objects of objectsLists2 are put in the broad-phase using \a getBounds.
+ * Then, for each object of objectsLists1, only the objects having their bounds
+ * overlapping the rectangle returned by \a getQueryRect are given to the
+ * predicate.
+ *
+ * \warning The predicate must be false for all the pairs of objects that
+ * are not found by the broad-phase, otherwise results will differ from
+ * TwoObjectListsTest.
+ *
+ * Cost (Objects being uniformly spread):
+ *    Cost(Building the broad-phase with NbObjList2 objects)
+ *  + Cost(predicate)*NbObjList1*(Number of objects near each object)
+ *
+ * \see ObjectsBroadPhase
+ * \ingroup GameEngine
+ */
+template <typename Pred, typename BoundsFunc, typename QueryRectFunc>
+bool TwoObjectListsTestWithBroadPhase(const RuntimeObjectsLists &objectsLists1,
+                                      const RuntimeObjectsLists &objectsLists2,
+                                      bool negatePredicate,
+                                      ObjectsBroadPhase &broadPhase,
+                                      BoundsFunc getBounds,
+                                      QueryRectFunc getQueryRect,
+                                      Pred predicate) {
+  bool isTrue = false;
+
+  // Create a boolean for each object
+  ObjectsPickingScratch temporaryScratch;
+  ObjectsPickingScratch &scratch = objectsLists1.GetPickingScratch()
+                                       ? *objectsLists1.GetPickingScratch()
+                                       : temporaryScratch;
+  scratch.Reset(objectsLists1, objectsLists2);
+
+  // Put all objects of the second lists in the broad-phase: as items are
+  // added in the same order as the flags, the flag of an item is its index
+  // plus the flag of the first object of the second lists.
+  std::size_t firstFlag2 = scratch.GetFirstFlag(objectsLists1.size());
+  broadPhase.Reset();
+  for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
+       it != objectsLists2.end();
+       ++it) {
+    if (!it->second) continue;
+
+    const std::vector<RuntimeObject *> &arr2 = *it->second;
+    for (std::size_t l = 0; l < arr2.size(); ++l)
+      broadPhase.Add(getBounds(arr2[l]));
+  }
+  broadPhase.Build();
+
+  // Launch the function on each object of the first list with each object
+  // of the second list found by the broad-phase.
+  std::size_t i = 0;
   for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
        it != objectsLists1.end();
        ++it, ++i) {
-    size_t finalSize = 0;
     if (!it->second) continue;
-    std::vector<RuntimeObject *> &arr = *it->second;
+    const std::vector<RuntimeObject *> &arr1 = *it->second;
+    std::size_t firstFlag1 = scratch.GetFirstFlag(i);
 
-    for (std::size_t k = 0; k < arr.size(); ++k) {
-      RuntimeObject *obj = arr[k];
-      if (pickedList1[i][k]) {
-        arr[finalSize] = obj;
-        finalSize++;
-      }
-    }
-    arr.resize(finalSize);
-  }
+    for (std::size_t k = 0; k < arr1.size(); ++k) {
+      bool atLeastOneObject = false;
+
+      broadPhase.Query(getQueryRect(arr1[k]), [&](std::size_t item) {
+        std::size_t flag2 = firstFlag2 + item;
+        std::size_t j = scratch.GetListOfFlag(flag2);
+        const std::vector<RuntimeObject *> &arr2 =
+            *objectsLists2.begin()[j - objectsLists1.size()].second;
+        std::size_t l = flag2 - scratch.GetFirstFlag(j);
 
-  if (!negatePredicate) {
-    std::size_t i = 0;
-    for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-         it != objectsLists2.end();
-         ++it, ++i) {
-      size_t finalSize = 0;
-      if (!it->second) continue;
-      std::vector<RuntimeObject *> &arr = *it->second;
-
-      //*This is important*! We can have a list that has already been trimmed
-      // just before
-      if (arr.size() !=
-          pickedList2[i].size())  // If the size of the objects list != size of
-                                  // the boolean "picked" list...
-        continue;  //... then the object list was already trimmed, skip it.
-
-      for (std::size_t k = 0; k < arr.size(); ++k) {
-        RuntimeObject *obj = arr[k];
-        if (pickedList2[i][k]) {
-          arr[finalSize] = obj;
-          finalSize++;
+        if (scratch.IsPicked(firstFlag1 + k) && scratch.IsPicked(flag2))
+          return;  // Avoid unnecessary costly call to functor.
+
+        if (std::addressof(arr1[k]) != std::addressof(arr2[l]) &&
+            predicate(arr1[k], arr2[l])) {
+          if (!negatePredicate) {
+            isTrue = true;
+
+            // Pick the objects
+            scratch.SetPicked(firstFlag1 + k);
+            scratch.SetPicked(flag2);
+          }
+
+          atLeastOneObject = true;
         }
+      });
+
+      if (!atLeastOneObject &&
+          negatePredicate) {  // The object is not overlapping any other object.
+        isTrue = true;
+        scratch.SetPicked(firstFlag1 + k);
       }
-      arr.resize(finalSize);
     }
   }
 
+  TrimNotPickedObjects(objectsLists1, scratch, 0, false);
+  if (!negatePredicate)
+    TrimNotPickedObjects(objectsLists2, scratch, objectsLists1.size(), true);
+
   return isTrue;
 }
+
 #endif
@@ -55,7 +55,11 @@ RuntimeScene::RuntimeScene(sf::RenderWindow* renderWindow_, RuntimeGame* game_)
 #endif
       isFullScreen(false),
       inputManager(renderWindow_),
+      lastDrawnObjectsCount(0),
+      lastCulledObjectsCount(0),
+      lastDrawCallsCount(0),
       codeExecutionEngine(new CodeExecutionEngine) {
+  objectsInstances.SetRenderQueue(&renderQueue);
   ChangeRenderWindow(renderWindow);
 }
 
@@ -154,6 +158,12 @@ bool RuntimeScene::RenderAndStep() {
   if (GetProfiler() && GetProfiler()->profilingActivated) {
     GetProfiler()->lastRenderingTime =
         GetProfiler()->renderingClock.getTimeMicroseconds();
+    GetProfiler()->lastDrawnObjectsCount = lastDrawnObjectsCount;
+    GetProfiler()->lastCulledObjectsCount = lastCulledObjectsCount;
+    GetProfiler()->lastDrawCallsCount = lastDrawCallsCount;
+    if (game)
+      GetProfiler()->lastTextureCacheStats =
+          game->GetImageManager()->GetTextureCacheStats();
     GetProfiler()->totalSceneTime +=
         GetProfiler()->lastRenderingTime + GetProfiler()->lastEventsTime;
     GetProfiler()->totalEventsTime += GetProfiler()->lastEventsTime;
@@ -197,13 +207,15 @@ void RuntimeScene::RenderWithoutStep() {
 void RuntimeScene::Render() {
   if (!renderWindow) return;
 
+  lastDrawnObjectsCount = 0;
+  lastCulledObjectsCount = 0;
+  spriteBatch.ResetDrawCallsCount();
   renderWindow->clear(sf::Color(GetBackgroundColorRed(),
                                 GetBackgroundColorGreen(),
                                 GetBackgroundColorBlue()));
 
-  // Sort object by order to render them
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  OrderObjectsByZOrder(allObjects);
+  // Put objects added or changed since the last frame at their place
+  renderQueue.Update();
 
 #if !defined(ANDROID)  // TODO: OpenGL
   // To allow using OpenGL to draw:
@@ -248,11 +260,16 @@ void RuntimeScene::Render() {
         // Prepare SFML rendering
         renderWindow->setView(camera.GetSFMLView());
 
-        // Rendering all objects
-        for (std::size_t id = 0; id < allObjects.size(); ++id) {
-          if (allObjects[id]->GetLayer() == layers[layerIndex].GetName())
-            allObjects[id]->Draw(*renderWindow);
-        }
+        // Rendering the objects of the layer seen by the camera
+        sf::FloatRect viewRect =
+            camera.GetSFMLView().getInverseTransform().transformRect(
+                sf::FloatRect(-1, -1, 2, 2));
+        lastCulledObjectsCount += renderQueue.GetVisibleLayerObjects(
+            layerIndex, viewRect, visibleObjectsList);
+        lastDrawnObjectsCount += visibleObjectsList.size();
+        for (RuntimeObject* object : visibleObjectsList)
+          object->DrawInBatch(*renderWindow, spriteBatch);
+        spriteBatch.Flush(*renderWindow);
       }
     }
   }
@@ -263,23 +280,7 @@ void RuntimeScene::Render() {
   renderWindow->popGLStates();
 #endif
   renderWindow->display();
-}
-
-bool RuntimeScene::OrderObjectsByZOrder(RuntimeObjNonOwningPtrList& objList) {
-  if (StandardSortMethod())
-    std::sort(objList.begin(),
-              objList.end(),
-              [](const RuntimeObject* o1, const RuntimeObject* o2) {
-                return o1->GetZOrder() < o2->GetZOrder();
-              });
-  else
-    std::stable_sort(objList.begin(),
-                     objList.end(),
-                     [](const RuntimeObject* o1, const RuntimeObject* o2) {
-                       return o1->GetZOrder() < o2->GetZOrder();
-                     });
-
-  return true;
+  lastDrawCallsCount = spriteBatch.GetDrawCallsCount();
 }
 
 RuntimeLayer& RuntimeScene::GetRuntimeLayer(const gd::String& name) {
@@ -300,23 +301,21 @@ const RuntimeLayer& RuntimeScene::GetRuntimeLayer(
 }
 
 void RuntimeScene::ManageObjectsAfterEvents() {
-  // Delete objects that were removed.
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  for (std::size_t id = 0; id < allObjects.size(); ++id) {
-    if (allObjects[id]->GetName().empty()) {
-      for (std::size_t i = 0; i < extensionsToBeNotifiedOnObjectDeletion.size();
-           ++i)
-        extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(
-            *this, allObjects[id]);
-
-      objectsInstances.RemoveObject(
-          allObjects[id]);  // Remove from objects instances, not from the
-                            // temporary list!
-    }
+  // Delete objects that were removed, all at once.
+  const RuntimeObjNonOwningPtrList& deletedObjects =
+      objectsInstances.GetObjectsToBeDeleted();
+  if (!deletedObjects.empty()) {
+    for (std::size_t i = 0; i < extensionsToBeNotifiedOnObjectDeletion.size();
+         ++i)
+      extensionsToBeNotifiedOnObjectDeletion[i]->ObjectsDeletedFromScene(
+          *this, deletedObjects);
+
+    objectsInstances.DestroyObjectsToBeDeleted();
   }
 
   // Update objects positions, forces and behaviors
-  allObjects = objectsInstances.GetAllObjects();
+  RuntimeObjNonOwningPtrList& allObjects = allObjectsList;
+  objectsInstances.GetAllObjects(allObjects);
   for (RuntimeObject* object : allObjects) {
     double elapsedTimeInSeconds =
         static_cast<double>(object->GetElapsedTime(*this)) / 1000000.0;
@@ -331,7 +330,8 @@ void RuntimeScene::ManageObjectsAfterEvents() {
 }
 
 void RuntimeScene::ManageObjectsBeforeEvents() {
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
+  RuntimeObjNonOwningPtrList& allObjects = allObjectsList;
+  objectsInstances.GetAllObjects(allObjects);
   for (std::size_t id = 0; id < allObjects.size(); ++id)
     allObjects[id]->DoBehaviorsPreEvents(*this);
 }
@@ -349,23 +349,15 @@ class ObjectsFromInitialInstanceCreator : public gd::InitialInstanceFunctor {
   virtual ~ObjectsFromInitialInstanceCreator(){};
 
   virtual void operator()(gd::InitialInstance& instance) {
-    std::vector<ObjSPtr>::const_iterator sceneObject =
-        std::find_if(scene.GetObjects().begin(),
-                     scene.GetObjects().end(),
-                     std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-    std::vector<ObjSPtr>::const_iterator globalObject =
-        std::find_if(game.GetObjects().begin(),
-                     game.GetObjects().end(),
-                     std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-
+    const gd::String& name = instance.GetObjectName();
     RuntimeObjSPtr newObject;
 
-    if (sceneObject !=
-        scene.GetObjects().end())  // We check first scene's objects' list.
-      newObject = CppPlatform::Get().CreateRuntimeObject(scene, **sceneObject);
-    else if (globalObject !=
-             scene.game->GetObjects().end())  // Then the global object list
-      newObject = CppPlatform::Get().CreateRuntimeObject(scene, **globalObject);
+    if (scene.HasObjectNamed(name))  // We check first scene's objects' list.
+      newObject =
+          CppPlatform::Get().CreateRuntimeObject(scene, scene.GetObject(name));
+    else if (game.HasObjectNamed(name))  // Then the global object list
+      newObject =
+          CppPlatform::Get().CreateRuntimeObject(scene, game.GetObject(name));
 
     if (newObject != std::unique_ptr<RuntimeObject>()) {
       newObject->SetX(instance.GetX() + xOffset);
@@ -426,6 +418,14 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
   objectsInstances.Clear();
   timeManager.Reset();
 
+  // Give an identifier to all objects names now, so that the lists of
+  // objects are not created during the game.
+  for (std::size_t i = 0; i < game->GetObjectsCount(); ++i)
+    ObjInstancesHolder::GetObjectNameId(game->GetObject(i).GetName());
+  for (std::size_t i = 0; i < GetObjectsCount(); ++i)
+    ObjInstancesHolder::GetObjectNameId(GetObject(i).GetName());
+  objectsInstances.Reserve(ObjInstancesHolder::GetObjectNamesCount());
+
   std::cout << ".";
   codeExecutionEngine->runtimeContext.scene = this;
   inputManager.DisableInputWhenFocusIsLost(IsInputDisabledWhenFocusIsLost());
@@ -440,9 +440,12 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
                                      0.0f,
                                      game->GetGameResolutionWidth(),
                                      game->GetGameResolutionHeight()));
+  std::vector<gd::String> layersNames;
   for (std::size_t i = 0; i < GetLayersCount(); ++i) {
     layers.push_back(RuntimeLayer(GetLayer(i), defaultView));
+    layersNames.push_back(GetLayer(i).GetName());
   }
+  renderQueue.SetLayers(layersNames);
 
   // Create object instances which are originally positioned on scene
   std::cout << ".";
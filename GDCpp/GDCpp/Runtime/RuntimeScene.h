@@ -14,9 +14,13 @@
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedDataHolder.h"
 #include "GDCpp/Runtime/InputManager.h"
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
+#include "GDCpp/Runtime/RenderQueue.h"
 #include "GDCpp/Runtime/Project/Layout.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
+#include "GDCpp/Runtime/RuntimeObjectsLists.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 #include "GDCpp/Runtime/TimeManager.h"
 namespace sf {
 class RenderWindow;
@@ -122,6 +126,25 @@ class GD_API RuntimeScene : public Scene {
     return behaviorsSharedDatas.GetBehaviorSharedData(behaviorName);
   }
 
+  /**
+   * \brief Get the broad-phase used by conditions testing pairs of objects
+   * (collisions, distances...) or rays against objects.
+   *
+   * \note The broad-phase is rebuilt by each function using it: it is owned by
+   * the scene only to reuse its memory between frames.
+   */
+  ObjectsBroadPhase& GetObjectsBroadPhase() { return objectsBroadPhase; }
+
+  /**
+   * \brief Get the memory used by conditions testing pairs of objects to mark
+   * the picked objects.
+   *
+   * \see ObjectsPickingScratch
+   */
+  ObjectsPickingScratch& GetObjectsPickingScratch() {
+    return objectsPickingScratch;
+  }
+
   /**
    * \brief Set up the RuntimeScene using a gd::Layout.
    *
@@ -179,6 +202,28 @@ class GD_API RuntimeScene : public Scene {
    */
   void RenderWithoutStep();
 
+  /**
+   * \brief Return the number of objects drawn during the last rendered frame
+   * (an object seen by two cameras is counted twice).
+   */
+  std::size_t GetLastDrawnObjectsCount() const {
+    return lastDrawnObjectsCount;
+  }
+
+  /**
+   * \brief Return the number of objects not drawn during the last rendered
+   * frame because they were outside of the area seen by the cameras.
+   */
+  std::size_t GetLastCulledObjectsCount() const {
+    return lastCulledObjectsCount;
+  }
+
+  /**
+   * \brief Return the number of draw calls done to render the objects during
+   * the last rendered frame.
+   */
+  std::size_t GetLastDrawCallsCount() const { return lastDrawCallsCount; }
+
   /** \name Code execution engine
    * Functions members giving access to the code execution engine.
    */
@@ -222,11 +267,6 @@ class GD_API RuntimeScene : public Scene {
    */
   void ManageRenderTargetEvents();
 
-  /**
-   * \brief Order an object list according to object's Z coordinate.
-   */
-  bool OrderObjectsByZOrder(RuntimeObjNonOwningPtrList& objList);
-
   /**
    * \brief Render a frame in the window
    */
@@ -265,6 +305,22 @@ class GD_API RuntimeScene : public Scene {
       behaviorsSharedDatas;  ///< Contains all behaviors shared datas.
   std::vector<RuntimeLayer>
       layers;  ///< The layers used at runtime to display the scene.
+  ObjectsBroadPhase objectsBroadPhase;  ///< Used to find objects near to
+                                        ///< each other.
+  ObjectsPickingScratch
+      objectsPickingScratch;  ///< Used to mark the picked objects.
+  RuntimeObjNonOwningPtrList
+      allObjectsList;  ///< Reused at each frame to list all the objects.
+  RenderQueue renderQueue;  ///< The objects to be rendered, sorted by layer
+                            ///< and Z order.
+  std::vector<RuntimeObject*>
+      visibleObjectsList;  ///< Reused at each frame to list the objects seen
+                           ///< by a camera.
+  std::size_t lastDrawnObjectsCount;   ///< See GetLastDrawnObjectsCount.
+  std::size_t lastCulledObjectsCount;  ///< See GetLastCulledObjectsCount.
+  std::size_t lastDrawCallsCount;      ///< See GetLastDrawCallsCount.
+  SpriteBatch spriteBatch;  ///< Used to draw the objects sharing a texture at
+                            ///< once.
   std::shared_ptr<CodeExecutionEngine> codeExecutionEngine;
   SceneChange
       requestedChange;  ///< What should be done at the end of the frame.
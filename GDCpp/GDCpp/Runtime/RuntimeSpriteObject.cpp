@@ -17,6 +17,7 @@
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 #include "GDCpp/Runtime/TinyXml/tinyxml.h"
 #if defined(GD_IDE_ONLY)
 #include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
@@ -28,6 +29,18 @@
 #include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.cpp"
 #endif
 
+namespace {
+
+sf::BlendMode GetSFMLBlendMode(unsigned int blendMode) {
+  return blendMode == 0
+             ? sf::BlendAlpha
+             : (blendMode == 1
+                    ? sf::BlendAdd
+                    : (blendMode == 2 ? sf::BlendMultiply : sf::BlendNone));
+}
+
+}  // namespace
+
 gd::Animation RuntimeSpriteObject::badAnimation;
 gd::Sprite* RuntimeSpriteObject::badSpriteDatas = NULL;
 
@@ -43,6 +56,8 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
       animationSpeedScale(1.f),
       ptrToCurrentSprite(NULL),
       needUpdateCurrentSprite(true),
+      needUpdateHitBoxes(true),
+      needUpdateAABB(true),
       opacity(255),
       blendMode(0),
       isFlippedX(false),
@@ -86,14 +101,19 @@ bool RuntimeSpriteObject::Draw(sf::RenderTarget& renderTarget) {
   // Don't draw anything if hidden
   if (hidden) return true;
 
-  renderTarget.draw(
-      GetCurrentSFMLSprite(),
-      sf::RenderStates(
-          blendMode == 0
-              ? sf::BlendAlpha
-              : (blendMode == 1
-                     ? sf::BlendAdd
-                     : (blendMode == 2 ? sf::BlendMultiply : sf::BlendNone))));
+  renderTarget.draw(GetCurrentSFMLSprite(),
+                    sf::RenderStates(GetSFMLBlendMode(blendMode)));
+
+  return true;
+}
+
+bool RuntimeSpriteObject::DrawInBatch(sf::RenderTarget& renderTarget,
+                                      SpriteBatch& spriteBatch) {
+  // Don't draw anything if hidden
+  if (hidden) return true;
+
+  spriteBatch.Draw(
+      renderTarget, GetCurrentSFMLSprite(), GetSFMLBlendMode(blendMode));
 
   return true;
 }
@@ -121,6 +141,7 @@ void RuntimeSpriteObject::SetWidth(float newWidth) {
     scaleX = newWidth / GetCurrentSFMLSprite().getLocalBounds().width;
     if (isFlippedX) scaleX *= -1;
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
   }
 }
 
@@ -129,6 +150,7 @@ void RuntimeSpriteObject::SetHeight(float newHeight) {
     scaleY = newHeight / GetCurrentSFMLSprite().getLocalBounds().height;
     if (isFlippedY) scaleY *= -1;
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
   }
 }
 
@@ -179,6 +201,7 @@ void RuntimeSpriteObject::SetScaleX(float val) {
 
   scaleX = val * (isFlippedX ? -1.0 : 1.0);
   needUpdateCurrentSprite = true;
+  HitBoxesChanged();
 }
 
 void RuntimeSpriteObject::SetScaleY(float val) {
@@ -187,6 +210,7 @@ void RuntimeSpriteObject::SetScaleY(float val) {
 
   scaleY = val * (isFlippedY ? -1.0 : 1.0);
   needUpdateCurrentSprite = true;
+  HitBoxesChanged();
 }
 
 float RuntimeSpriteObject::GetScaleX() const { return fabs(scaleX); }
@@ -222,7 +246,7 @@ void RuntimeSpriteObject::CopyImageOnImageOfCurrentSprite(
                    yPosition,
                    sf::IntRect(0, 0, 0, 0),
                    useTransparency);
-  dest->texture.loadFromImage(dest->image);
+  dest->UpdateFromImage();
 }
 
 void RuntimeSpriteObject::MakeColorTransparent(const gd::String& colorStr) {
@@ -242,7 +266,7 @@ void RuntimeSpriteObject::MakeColorTransparent(const gd::String& colorStr) {
   // Update texture and pixel perfect collision mask
   dest->image.createMaskFromColor(
       sf::Color(colors[0].To<int>(), colors[1].To<int>(), colors[2].To<int>()));
-  dest->texture.loadFromImage(dest->image);
+  dest->UpdateFromImage();
 }
 
 void RuntimeSpriteObject::SetColor(const gd::String& colorStr) {
@@ -318,6 +342,7 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
       animations[currentAnimation].Get().GetDirection(currentDirection);
 
   float delay = direction.GetTimeBetweenFrames();
+  std::size_t oldSprite = currentSprite;
 
   if (timeElapsedOnCurrentSprite > delay) {
     if (delay != 0) {
@@ -337,6 +362,7 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
   }
 
   needUpdateCurrentSprite = true;
+  if (currentSprite != oldSprite) HitBoxesChanged();
 }
 
 const sf::Sprite& RuntimeSpriteObject::GetCurrentSFMLSprite() const {
@@ -351,30 +377,44 @@ const gd::Sprite& RuntimeSpriteObject::GetCurrentSprite() const {
   return *ptrToCurrentSprite;
 }
 
-std::vector<Polygon2d> RuntimeSpriteObject::GetHitBoxes() const {
+void RuntimeSpriteObject::HitBoxesChanged() {
+  needUpdateHitBoxes = true;
+  needUpdateAABB = true;
+  NotifyBoundsChanged();
+}
+
+sf::FloatRect RuntimeSpriteObject::GetAABB() const {
+  if (needUpdateAABB) {
+    aabb = RuntimeObject::GetAABB();
+    needUpdateAABB = false;
+  }
+
+  return aabb;
+}
+
+const std::vector<Polygon2d>& RuntimeSpriteObject::GetHitBoxes() const {
+  if (!needUpdateHitBoxes) return hitBoxes;
+
+  needUpdateHitBoxes = false;
   if (currentAnimation >= animations.size()) {
-    std::vector<Polygon2d> hitboxes;  // Invalid animation, bail out.
-    return hitboxes;
+    hitBoxes.clear();  // Invalid animation, bail out.
+    return hitBoxes;
   }
-  const sf::Sprite& currentSFMLSprite = GetCurrentSFMLSprite();
-
-  std::vector<Polygon2d> polygons = GetCurrentSprite().GetCollisionMask();
-  for (std::size_t i = 0; i < polygons.size(); ++i) {
-    for (std::size_t j = 0; j < polygons[i].vertices.size(); ++j) {
-      sf::Vector2f newVertice = currentSFMLSprite.getTransform().transformPoint(
-          !isFlippedX
-              ? polygons[i].vertices[j].x
-              : GetCurrentSprite().GetSFMLSprite().getLocalBounds().width -
-                    polygons[i].vertices[j].x,
-          !isFlippedY
-              ? polygons[i].vertices[j].y
-              : GetCurrentSprite().GetSFMLSprite().getLocalBounds().height -
-                    polygons[i].vertices[j].y);
-      polygons[i].vertices[j] = newVertice;
+  const sf::Transform& transform = GetCurrentSFMLSprite().getTransform();
+  const sf::FloatRect localBounds =
+      GetCurrentSprite().GetSFMLSprite().getLocalBounds();
+
+  hitBoxes = GetCurrentSprite().GetCollisionMask();
+  for (Polygon2d& polygon : hitBoxes) {
+    for (sf::Vector2f& vertex : polygon.vertices) {
+      vertex = transform.transformPoint(
+          !isFlippedX ? vertex.x : localBounds.width - vertex.x,
+          !isFlippedY ? vertex.y : localBounds.height - vertex.y);
     }
+    polygon.ComputeEdges();
   }
 
-  return polygons;
+  return hitBoxes;
 }
 
 bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
@@ -391,6 +431,7 @@ bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
   timeElapsedOnCurrentSprite = 0;
 
   needUpdateCurrentSprite = true;
+  HitBoxesChanged();
   return true;
 }
 
@@ -403,6 +444,7 @@ bool RuntimeSpriteObject::SetCurrentAnimation(std::size_t nb) {
   timeElapsedOnCurrentSprite = 0;
 
   needUpdateCurrentSprite = true;
+  HitBoxesChanged();
   return true;
 }
 
@@ -433,6 +475,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
     currentAngle = nb;
 
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
     return true;
   } else {
     if (nb >= animations[currentAnimation].Get().GetDirectionsCount() ||
@@ -446,6 +489,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
     timeElapsedOnCurrentSprite = 0;
 
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
     return true;
   }
 }
@@ -457,6 +501,7 @@ bool RuntimeSpriteObject::SetAngle(float newAngle) {
     currentAngle = newAngle;
 
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
   } else {
     newAngle = static_cast<int>(newAngle) % 360;
     if (newAngle < 0) newAngle += 360;
@@ -517,6 +562,7 @@ void RuntimeSpriteObject::FlipX(bool flip) {
   if (flip != isFlippedX) {
     scaleX *= -1.0;
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
   }
   isFlippedX = flip;
 }
@@ -525,6 +571,7 @@ void RuntimeSpriteObject::FlipY(bool flip) {
   if (flip != isFlippedY) {
     scaleY *= -1.0;
     needUpdateCurrentSprite = true;
+    HitBoxesChanged();
   }
   isFlippedY = flip;
 }
@@ -59,6 +59,8 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
       const gd::InitialInstance& position);
 
   virtual bool Draw(sf::RenderTarget& renderTarget);
+  virtual bool DrawInBatch(sf::RenderTarget& renderTarget,
+                           SpriteBatch& spriteBatch);
 
 #if defined(GD_IDE_ONLY)
   virtual void GetPropertyForDebugger(std::size_t propertyNb,
@@ -70,7 +72,13 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
 
   virtual void Update(const RuntimeScene& scene);
 
-  virtual void OnPositionChanged() { needUpdateCurrentSprite = true; };
+  virtual void OnPositionChanged() {
+    needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
+    needUpdateAABB = true;
+  };
+
+  virtual bool CanBeCulled() const { return true; };
 
   virtual float GetWidth() const;
   virtual float GetHeight() const;
@@ -86,7 +94,15 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   virtual bool SetAngle(float newAngle);
   virtual float GetAngle() const;
 
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
+  virtual sf::FloatRect GetAABB() const;
+
+  /**
+   * \brief Get the hitboxes of the object.
+   *
+   * The hitboxes are only computed again when the position, the angle, the
+   * scale, the flipping or the current frame of the object changed.
+   */
+  virtual const std::vector<Polygon2d>& GetHitBoxes() const;
   virtual bool CursorOnObject(RuntimeScene& scene, bool accurate);
 
   /**
@@ -323,6 +339,12 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   void TurnTowardObject(RuntimeObject* object, RuntimeScene& scene);
 
  private:
+  /**
+   * \brief To be called when the hitboxes and the AABB of the object must be
+   * computed again.
+   */
+  void HitBoxesChanged();
+
   // Animations, direction and current frame:
   std::size_t currentAnimation;
   std::size_t currentDirection;
@@ -336,6 +358,11 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   mutable gd::Sprite* ptrToCurrentSprite;  // Pointer to the current sprite
   mutable bool needUpdateCurrentSprite;
 
+  mutable std::vector<Polygon2d> hitBoxes;  ///< Cache for GetHitBoxes
+  mutable bool needUpdateHitBoxes;
+  mutable sf::FloatRect aabb;  ///< Cache for GetAABB
+  mutable bool needUpdateAABB;
+
   std::vector<AnimationProxy> animations;
 
   float opacity;
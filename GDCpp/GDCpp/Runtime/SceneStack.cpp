@@ -5,13 +5,24 @@
  */
 #include "SceneStack.h"
 #include "CodeExecutionEngine.h"
+#include "ImageManager.h"
 #include "RuntimeGame.h"
 #include "RuntimeScene.h"
 #include "SceneNameMangler.h"
 
+namespace {
+
+const std::size_t maxUploadsByStep =
+    4;  ///< The number of prefetched resources uploaded at each step.
+
+}  // namespace
+
 bool SceneStack::Step() {
   if (stack.empty()) return false;
 
+  preloader.UploadPreloadedResources(
+      *game.GetImageManager(), game.GetSoundManager(), maxUploadsByStep);
+
   auto& scene = stack.back();
   if (scene->RenderAndStep()) {
     auto request = scene->GetRequestedChange();
@@ -39,6 +50,7 @@ std::unique_ptr<RuntimeScene> SceneStack::Pop() {
 
   std::unique_ptr<RuntimeScene> scene = std::move(stack.back());
   stack.pop_back();
+  ReleaseSceneResources(scene->GetName());
   return scene;
 }
 
@@ -49,10 +61,15 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
     return nullptr;
   }
 
+  // Load the resources with several threads before objects use them.
+  preloader.PreloadLayout(game, newSceneName);
+  preloader.FinishPreloading(*game.GetImageManager(), game.GetSoundManager());
+
   std::unique_ptr<RuntimeScene> newScene(new RuntimeScene(window, &game));
   if (!newScene->LoadFromScene(game.GetLayout(newSceneName))) {
     if (errorCallback)
       errorCallback("Unable to load scene \"" + newSceneName + "\".");
+    ReleaseSceneResources(newSceneName);
     return nullptr;
   }
 
@@ -60,6 +77,7 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
     if (errorCallback)
       errorCallback("Unable to setup execution engine for scene \"" +
                     newScene->GetName() + "\".");
+    ReleaseSceneResources(newSceneName);
     return nullptr;
   }
 
@@ -69,10 +87,36 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
 }
 
 RuntimeScene* SceneStack::Replace(gd::String newSceneName, bool clear) {
+  std::vector<gd::String> removedScenes;
   if (clear) {
-    while (!stack.empty()) stack.pop_back();
+    while (!stack.empty()) {
+      removedScenes.push_back(stack.back()->GetName());
+      stack.pop_back();
+    }
   } else {
-    if (!stack.empty()) stack.pop_back();
+    if (!stack.empty()) {
+      removedScenes.push_back(stack.back()->GetName());
+      stack.pop_back();
+    }
   }
-  return Push(newSceneName);
+
+  // Resources are released after the new scene is loaded, so that the ones it
+  // uses are not reloaded.
+  RuntimeScene* newScene = Push(newSceneName);
+  for (const gd::String& sceneName : removedScenes)
+    ReleaseSceneResources(sceneName);
+  game.GetImageManager()->TrimTextureCache();
+
+  return newScene;
+}
+
+void SceneStack::Prefetch(gd::String sceneName) {
+  preloader.PreloadLayout(game, sceneName);
+}
+
+void SceneStack::ReleaseSceneResources(const gd::String& sceneName) {
+  for (auto& scene : stack)
+    if (scene->GetName() == sceneName) return;
+
+  preloader.Release(sceneName, *game.GetImageManager());
 }
@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <vector>
+#include "GDCpp/Runtime/ResourcesPreloader.h"
 class RuntimeGame;
 class RuntimeScene;
 namespace sf {
@@ -64,6 +65,21 @@ class GD_API SceneStack {
    */
   RuntimeScene *Replace(gd::String newSceneName, bool clear = false);
 
+  /**
+   * \brief Start to load in the background the resources of a scene, so that
+   * it starts faster when it's pushed on the stack later.
+   *
+   * The resources are kept loaded until the scene is pushed and then removed
+   * from the stack.
+   */
+  void Prefetch(gd::String sceneName);
+
+  /**
+   * \brief Return the preloader loading the resources of the scenes, for
+   * example to know the progress of a prefetch.
+   */
+  ResourcesPreloader &GetResourcesPreloader() { return preloader; }
+
   /**
    * \brief Set the callback called when an error occurs (loading failed...)
    */
@@ -77,9 +93,18 @@ class GD_API SceneStack {
   }
 
  private:
+  /**
+   * \brief Release the resources preloaded for a scene, unless the scene is
+   * still in the stack.
+   */
+  void ReleaseSceneResources(const gd::String &sceneName);
+
   RuntimeGame &game;
   sf::RenderWindow *window;
   std::vector<std::unique_ptr<RuntimeScene>> stack;
   std::function<void(gd::String)> errorCallback;
   std::function<bool(RuntimeScene &)> loadCallback;
+  ResourcesPreloader preloader;  ///< Preload the resources of the scenes, and
+                                 ///< keep them loaded while the scenes are in
+                                 ///< the stack.
 };
@@ -18,9 +18,20 @@ Sound::Sound(gd::String pFile) : file(pFile), volume(100) {
   sound.setBuffer(buffer);
 }
 
+Sound::Sound(gd::String pFile, std::shared_ptr<sf::SoundBuffer> sharedBuffer_)
+    : sharedBuffer(sharedBuffer_), file(pFile), volume(100) {
+  sound.setBuffer(*sharedBuffer);
+}
+
 Sound::Sound() : volume(100) { sound.setBuffer(buffer); }
 
-Sound::Sound(const Sound& copy) : file(copy.file) {
+Sound::Sound(const Sound& copy)
+    : sharedBuffer(copy.sharedBuffer), file(copy.file) {
+  if (sharedBuffer) {
+    sound.setBuffer(*sharedBuffer);
+    return;
+  }
+
   buffer = gd::ResourcesLoader::Get()->LoadSoundBuffer(file);
   sound.setBuffer(buffer);
 }
@@ -6,6 +6,7 @@
 #ifndef SOUND_H
 #define SOUND_H
 #include <SFML/Audio.hpp>
+#include <memory>
 #include "GDCpp/Runtime/String.h"
 
 /**
@@ -18,6 +19,12 @@ class GD_API Sound : sf::NonCopyable {
  public:
   Sound();
   Sound(gd::String file);
+
+  /**
+   * \brief Create a sound playing an already loaded sound buffer, shared with
+   * other sounds.
+   */
+  Sound(gd::String file, std::shared_ptr<sf::SoundBuffer> sharedBuffer);
   Sound(const Sound& copy);
   virtual ~Sound(){};
 
@@ -64,6 +71,8 @@ class GD_API Sound : sf::NonCopyable {
   };
 
   // Order is important :
+  std::shared_ptr<sf::SoundBuffer>
+      sharedBuffer;  ///< The buffer played, if shared with other sounds.
   sf::SoundBuffer buffer;
   sf::Sound sound;
 
@@ -22,13 +22,25 @@ const gd::String& SoundManager::GetFileFromSoundName(
   return resourcesManager->GetResource(name).GetFile();
 }
 
+std::shared_ptr<Sound> SoundManager::CreateSound(const gd::String& name) {
+  const gd::String& file = GetFileFromSoundName(name);
+  auto it = preloadedSoundBuffers.find(file);
+  if (it != preloadedSoundBuffers.end()) {
+    if (std::shared_ptr<sf::SoundBuffer> buffer = it->second.lock())
+      return std::make_shared<Sound>(file, buffer);
+
+    preloadedSoundBuffers.erase(it);
+  }
+
+  return std::make_shared<Sound>(file);
+}
+
 void SoundManager::PlaySoundOnChannel(const gd::String& name,
                                       unsigned int channel,
                                       bool repeat,
                                       float volume,
                                       float pitch) {
-  std::shared_ptr<Sound> sound =
-      std::make_shared<Sound>(GetFileFromSoundName(name));
+  std::shared_ptr<Sound> sound = CreateSound(name);
   sound->sound.play();
   sound->sound.setRelativeToListener(true);
 
@@ -42,8 +54,7 @@ void SoundManager::PlaySound(const gd::String& name,
                              bool repeat,
                              float volume,
                              float pitch) {
-  sounds.push_back(
-      std::shared_ptr<Sound>(new Sound(GetFileFromSoundName(name))));
+  sounds.push_back(CreateSound(name));
   sounds.back()->sound.play();
   sounds.back()->sound.setRelativeToListener(true);
 
@@ -142,11 +142,31 @@ class GD_API SoundManager {
    */
   void ManageGarbage();
 
+  /**
+   * \brief Make the sounds played from \a file use a sound buffer loaded
+   * elsewhere (for example by a ResourcesPreloader) instead of loading it.
+   *
+   * The SoundManager doesn't own the buffer: it's used as long as it's kept
+   * alive by its owner or by the sounds playing it.
+   */
+  void AddPreloadedSoundBuffer(const gd::String& file,
+                               std::weak_ptr<sf::SoundBuffer> buffer) {
+    preloadedSoundBuffers[file] = buffer;
+  }
+
  private:
   const gd::String& GetFileFromSoundName(const gd::String& name) const;
 
+  /**
+   * \brief Create a sound, using the preloaded sound buffer of its file if
+   * any.
+   */
+  std::shared_ptr<Sound> CreateSound(const gd::String& name);
+
   std::map<std::size_t, std::shared_ptr<Sound> > soundsChannel;
   std::map<std::size_t, std::shared_ptr<Music> > musicsChannel;
+  std::map<gd::String, std::weak_ptr<sf::SoundBuffer> >
+      preloadedSoundBuffers;  ///< The preloaded sound buffers of files.
 
   float globalVolume;
   gd::ResourcesManager* resourcesManager;
@@ -0,0 +1,69 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/SpriteBatch.h"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <cmath>
+
+SpriteBatch::SpriteBatch() : texture(nullptr), drawCallsCount(0) {}
+
+void SpriteBatch::Draw(sf::RenderTarget& renderTarget,
+                       const sf::Sprite& sprite,
+                       const sf::BlendMode& blendMode_) {
+  if (!vertices.empty() &&
+      (sprite.getTexture() != texture || blendMode_ != blendMode))
+    Flush(renderTarget);
+
+  texture = sprite.getTexture();
+  blendMode = blendMode_;
+
+  // Same vertices as the ones of sf::Sprite, transformed here so that
+  // sprites with different transforms can be drawn together.
+  const sf::Transform& transform = sprite.getTransform();
+  const sf::IntRect& rect = sprite.getTextureRect();
+  float width = std::abs(rect.width);
+  float height = std::abs(rect.height);
+  float left = rect.left;
+  float right = left + rect.width;
+  float top = rect.top;
+  float bottom = top + rect.height;
+
+  sf::Vertex topLeft(transform.transformPoint(0, 0),
+                     sprite.getColor(),
+                     sf::Vector2f(left, top));
+  sf::Vertex bottomLeft(transform.transformPoint(0, height),
+                        sprite.getColor(),
+                        sf::Vector2f(left, bottom));
+  sf::Vertex topRight(transform.transformPoint(width, 0),
+                      sprite.getColor(),
+                      sf::Vector2f(right, top));
+  sf::Vertex bottomRight(transform.transformPoint(width, height),
+                         sprite.getColor(),
+                         sf::Vector2f(right, bottom));
+
+  vertices.push_back(topLeft);
+  vertices.push_back(bottomLeft);
+  vertices.push_back(topRight);
+  vertices.push_back(topRight);
+  vertices.push_back(bottomLeft);
+  vertices.push_back(bottomRight);
+}
+
+void SpriteBatch::Flush(sf::RenderTarget& renderTarget) {
+  if (vertices.empty()) return;
+
+  sf::RenderStates states(blendMode);
+  states.texture = texture;
+  DrawVertices(renderTarget, vertices, states);
+  drawCallsCount++;
+  vertices.clear();
+}
+
+void SpriteBatch::DrawVertices(sf::RenderTarget& renderTarget,
+                               const std::vector<sf::Vertex>& vertices,
+                               const sf::RenderStates& states) {
+  renderTarget.draw(&vertices[0], vertices.size(), sf::Triangles, states);
+}
@@ -0,0 +1,86 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+#include <vector>
+namespace sf {
+class RenderTarget;
+class Sprite;
+class Texture;
+}  // namespace sf
+
+/**
+ * \brief Draw consecutive sprites sharing the same texture and blend mode in a
+ * single draw call.
+ *
+ * Sprites are transformed into vertices, which are accumulated until a sprite
+ * with another texture or blend mode is drawn, or until Flush is called.
+ * Images packed in the same texture atlas share their texture, so that they
+ * can be drawn at once.
+ *
+ * Usage example:
+ * \code
+ * spriteBatch.Draw(renderTarget, sprite1);
+ * spriteBatch.Draw(renderTarget, sprite2, sf::BlendAdd);
+ * spriteBatch.Flush(renderTarget);  // Before drawing anything else.
+ * \endcode
+ *
+ * \see RuntimeObject::DrawInBatch
+ * \ingroup GameEngine
+ */
+class GD_API SpriteBatch {
+ public:
+  SpriteBatch();
+  virtual ~SpriteBatch(){};
+
+  /**
+   * \brief Add a sprite to the batch, drawing the sprites already in the
+   * batch first if they don't share the texture and the blend mode.
+   */
+  void Draw(sf::RenderTarget& renderTarget,
+            const sf::Sprite& sprite,
+            const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+  /**
+   * \brief Draw the sprites of the batch. Must be called before drawing
+   * anything without the batch, or changing the view of the render target.
+   */
+  void Flush(sf::RenderTarget& renderTarget);
+
+  /**
+   * \brief Count a draw call done without the batch.
+   */
+  void CountDrawCall() { drawCallsCount++; }
+
+  /**
+   * \brief Return the number of draw calls since the last call to
+   * ResetDrawCallsCount.
+   */
+  std::size_t GetDrawCallsCount() const { return drawCallsCount; }
+
+  void ResetDrawCallsCount() { drawCallsCount = 0; }
+
+ protected:
+  /**
+   * \brief Draw the vertices of the batch (two triangles by sprite).
+   */
+  virtual void DrawVertices(sf::RenderTarget& renderTarget,
+                            const std::vector<sf::Vertex>& vertices,
+                            const sf::RenderStates& states);
+
+ private:
+  std::vector<sf::Vertex> vertices;  ///< The vertices of the sprites to draw.
+  const sf::Texture* texture;        ///< The texture of the sprites to draw.
+  sf::BlendMode blendMode;           ///< The blend mode of the sprites to draw.
+  std::size_t drawCallsCount;
+};
+
+#endif  // SPRITEBATCH_H
@@ -133,6 +133,7 @@ int main( int argc, char *p_argv[] )
 
         TiXmlHandle hdl(&doc);
         gd::SerializerElement rootElement;
+        rootElement.AllocateChildrenInArena();
         gd::Serializer::FromXML(rootElement, hdl.FirstChildElement().Element());
         game.UnserializeFrom(rootElement);
 	}
@@ -0,0 +1,236 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the pixel perfect collisions between sprites.
+ */
+#include "GDCpp/Runtime/Collisions.h"
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "GDCpp/Runtime/CollisionMask.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * Create an image with an opaque disc in a transparent square.
+ */
+sf::Image CreateDiscImage(unsigned int size) {
+  sf::Image image;
+  image.create(size, size, sf::Color(255, 255, 255, 0));
+  float radius = size / 2.0f;
+  for (unsigned int y = 0; y < size; ++y) {
+    for (unsigned int x = 0; x < size; ++x) {
+      float dx = x + 0.5f - radius, dy = y + 0.5f - radius;
+      if (dx * dx + dy * dy < radius * radius)
+        image.setPixel(x, y, sf::Color(255, 255, 255, 255));
+    }
+  }
+
+  return image;
+}
+
+sf::Sprite CreateSprite(const sf::Image& image,
+                        float x,
+                        float y,
+                        float angle = 0,
+                        float scale = 1) {
+  sf::Sprite sprite;
+  sprite.setTextureRect(
+      sf::IntRect(0, 0, image.getSize().x, image.getSize().y));
+  sprite.setOrigin(image.getSize().x / 2.0f, image.getSize().y / 2.0f);
+  sprite.setPosition(x, y);
+  sprite.setRotation(angle);
+  sprite.setScale(scale, scale);
+  return sprite;
+}
+
+/**
+ * Test every pixel of the intersection of the sprites, reading the alpha of
+ * the pixels in the images.
+ */
+bool ReferencePixelPerfectTest(const sf::Sprite& sprite1,
+                               const sf::Image& image1,
+                               const sf::Sprite& sprite2,
+                               const sf::Image& image2) {
+  sf::FloatRect intersection;
+  if (!sprite1.getGlobalBounds().intersects(sprite2.getGlobalBounds(),
+                                            intersection))
+    return false;
+
+  for (int y = std::ceil(intersection.top);
+       y < intersection.top + intersection.height;
+       ++y) {
+    for (int x = std::ceil(intersection.left);
+         x < intersection.left + intersection.width;
+         ++x) {
+      sf::Vector2f point1 = sprite1.getInverseTransform().transformPoint(x, y);
+      sf::Vector2f point2 = sprite2.getInverseTransform().transformPoint(x, y);
+      if (point1.x >= 0 && point1.y >= 0 && point1.x < image1.getSize().x &&
+          point1.y < image1.getSize().y && point2.x >= 0 && point2.y >= 0 &&
+          point2.x < image2.getSize().x && point2.y < image2.getSize().y &&
+          image1.getPixel(point1.x, point1.y).a > 1 &&
+          image2.getPixel(point2.x, point2.y).a > 1)
+        return true;
+    }
+  }
+
+  return false;
+}
+}
+
+TEST_CASE("CollisionMask", "[game-engine]") {
+  SECTION("Opaque pixels") {
+    sf::Image image;
+    image.create(100, 3, sf::Color(0, 0, 0, 0));
+    image.setPixel(0, 0, sf::Color(0, 0, 0, 255));
+    image.setPixel(63, 1, sf::Color(0, 0, 0, 2));
+    image.setPixel(64, 1, sf::Color(0, 0, 0, 255));
+    image.setPixel(99, 2, sf::Color(0, 0, 0, 255));
+    image.setPixel(50, 2, sf::Color(0, 0, 0, 1));
+
+    gd::CollisionMask mask;
+    mask.Build(image);
+    REQUIRE(mask.GetWidth() == 100);
+    REQUIRE(mask.GetHeight() == 3);
+    REQUIRE(mask.IsOpaque(0, 0) == true);
+    REQUIRE(mask.IsOpaque(1, 0) == false);
+    REQUIRE(mask.IsOpaque(63, 1) == true);
+    REQUIRE(mask.IsOpaque(64, 1) == true);
+    REQUIRE(mask.IsOpaque(99, 2) == true);
+    REQUIRE(mask.IsOpaque(50, 2) == false);  // Alpha must be greater than 1.
+
+    // Rows are read 64 pixels at once, even across words.
+    REQUIRE(mask.GetPixels(0, 0) == 1);
+    REQUIRE(mask.GetPixels(63, 1) == 3);
+    REQUIRE(mask.GetPixels(60, 2) == std::uint64_t(1) << 39);
+    REQUIRE(mask.GetPixels(99, 2) == 1);
+    REQUIRE(mask.GetPixels(100, 2) == 0);
+    REQUIRE(mask.GetPixels(200, 2) == 0);
+
+    mask.Build(image, 1);
+    REQUIRE(mask.IsOpaque(63, 1) == true);
+    mask.Build(image, 2);
+    REQUIRE(mask.IsOpaque(63, 1) == false);
+  }
+  SECTION("Empty image") {
+    gd::CollisionMask mask;
+    mask.Build(sf::Image());
+    REQUIRE(mask.GetWidth() == 0);
+    REQUIRE(mask.GetHeight() == 0);
+  }
+}
+
+TEST_CASE("PixelPerfectTest", "[game-engine]") {
+  sf::Image disc = CreateDiscImage(100);
+  gd::CollisionMask discMask;
+  discMask.Build(disc);
+
+  SECTION("Translated sprites") {
+    // Bounding boxes are overlapping, but not the discs.
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0),
+                             discMask,
+                             CreateSprite(disc, 80, 80),
+                             discMask) == false);
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0),
+                             discMask,
+                             CreateSprite(disc, 60, 60),
+                             discMask) == true);
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0),
+                             discMask,
+                             CreateSprite(disc, 99, 0),
+                             discMask) == true);
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0),
+                             discMask,
+                             CreateSprite(disc, 100, 0),
+                             discMask) == false);
+  }
+  SECTION("Rotated and scaled sprites") {
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0, 45),
+                             discMask,
+                             CreateSprite(disc, 80, 80, 30),
+                             discMask) == false);
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0, 45),
+                             discMask,
+                             CreateSprite(disc, 60, 60, 30),
+                             discMask) == true);
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0),
+                             discMask,
+                             CreateSprite(disc, 140, 0, 0, 2),
+                             discMask) == true);
+    REQUIRE(PixelPerfectTest(CreateSprite(disc, 0, 0),
+                             discMask,
+                             CreateSprite(disc, 160, 0, 0, 2),
+                             discMask) == false);
+  }
+  SECTION("Same results as reading the pixels of the images") {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-100, 100);
+    std::uniform_real_distribution<float> angle(0, 360);
+    std::uniform_real_distribution<float> scale(0.5f, 2);
+    for (std::size_t i = 0; i < 500; ++i) {
+      bool transformed = i % 2 == 0;
+      sf::Sprite sprite1 = CreateSprite(disc, 0, 0);
+      sf::Sprite sprite2 =
+          transformed ? CreateSprite(disc,
+                                     position(generator),
+                                     position(generator),
+                                     angle(generator),
+                                     scale(generator))
+                      : CreateSprite(disc,
+                                     std::round(position(generator) * 4) / 4,
+                                     std::round(position(generator) * 4) / 4);
+
+      REQUIRE(PixelPerfectTest(sprite1, discMask, sprite2, discMask) ==
+              ReferencePixelPerfectTest(sprite1, disc, sprite2, disc));
+    }
+  }
+}
+
+TEST_CASE("PixelPerfectTest - Benchmarks", "[game-engine]") {
+  sf::Image disc = CreateDiscImage(256);
+  gd::CollisionMask discMask;
+  discMask.Build(disc);
+
+  // Sprites are close to each other, without being in collision, so that
+  // every pixel of the intersection is tested.
+  auto benchmark = [&](const char* name, float angle) {
+    sf::Sprite sprite1 = CreateSprite(disc, 0, 0, angle);
+    sf::Sprite sprite2 = CreateSprite(disc, 200, 200, angle);
+
+    bool referenceResult = false;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100; ++i)
+      referenceResult |=
+          ReferencePixelPerfectTest(sprite1, disc, sprite2, disc);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Pixel perfect collisions between " << name
+              << " sprites, reading the images benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+
+    bool result = false;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100; ++i)
+      result |= PixelPerfectTest(sprite1, discMask, sprite2, discMask);
+    end = std::chrono::steady_clock::now();
+    std::cout << "Pixel perfect collisions between " << name
+              << " sprites, using the collision masks benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+
+    REQUIRE(result == referenceResult);
+    REQUIRE(result == false);
+  };
+
+  benchmark("translated", 0);
+  benchmark("rotated", 30);
+}
@@ -0,0 +1,129 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the DAT files storing the resources of games.
+ */
+#include "GDCpp/Runtime/DatFile.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "GDCpp/Runtime/Tools/FileStream.h"
+#include "catch.hpp"
+
+namespace {
+
+void WriteFile(const gd::String &filename, const std::string &content) {
+  gd::FileStream file(filename, std::ios_base::out | std::ios_base::binary);
+  file.write(content.data(), content.size());
+}
+
+}  // namespace
+
+TEST_CASE("DatFile", "[game-engine]") {
+  std::vector<gd::String> files = {
+      "DatFileTest1.txt", "DatFileTest2.txt", "DatFileTest3.txt"};
+  WriteFile("DatFileTest1.txt", "Hello world");
+  WriteFile("DatFileTest2.txt", "");
+  WriteFile("DatFileTest3.txt", std::string("\0binary\0data", 12));
+
+  {
+    DatFile writer;
+    REQUIRE(writer.Create(files, ".", "DatFileTest.dat") == true);
+  }
+
+  SECTION("Read") {
+    DatFile datFile;
+    REQUIRE(datFile.Read("DatFileTest.dat") == true);
+    REQUIRE(datFile.ContainsFile("DatFileTest1.txt") == true);
+    REQUIRE(datFile.ContainsFile("DatFileTest4.txt") == false);
+
+    REQUIRE(datFile.GetFileSize("DatFileTest1.txt") == 11);
+    REQUIRE(std::string(datFile.GetFileData("DatFileTest1.txt"), 11) ==
+            "Hello world");
+    REQUIRE(datFile.GetFileSize("DatFileTest2.txt") == 0);
+    REQUIRE(datFile.GetFileData("DatFileTest2.txt") != nullptr);
+    REQUIRE(std::string(datFile.GetFileData("DatFileTest3.txt"), 12) ==
+            std::string("\0binary\0data", 12));
+    REQUIRE(datFile.GetFileData("DatFileTest4.txt") == nullptr);
+    REQUIRE(datFile.GetFileSize("DatFileTest4.txt") == 0);
+
+    // Data of the files are aligned.
+    for (auto &file : files) {
+      std::uintptr_t address =
+          reinterpret_cast<std::uintptr_t>(datFile.GetFileData(file));
+      REQUIRE((address % DatFile::dataAlignment) == 0);
+    }
+
+    // GetFile returns a copy.
+    char *copy = datFile.GetFile("DatFileTest1.txt");
+    REQUIRE(copy != datFile.GetFileData("DatFileTest1.txt"));
+    REQUIRE(std::string(copy, 11) == "Hello world");
+    REQUIRE(datFile.GetFile("DatFileTest4.txt") == NULL);
+
+    datFile.Close();
+    REQUIRE(datFile.ContainsFile("DatFileTest1.txt") == false);
+  }
+
+  SECTION("Shared data") {
+    std::shared_ptr<const char> data;
+    {
+      DatFile datFile;
+      REQUIRE(datFile.Read("DatFileTest.dat") == true);
+      data = datFile.GetSharedFileData("DatFileTest1.txt");
+      REQUIRE(data.get() == datFile.GetFileData("DatFileTest1.txt"));
+      REQUIRE(datFile.GetSharedFileData("DatFileTest4.txt") == nullptr);
+
+      // The data stay in memory when another DAT file is read.
+      REQUIRE(datFile.Read("DatFileTest.dat") == true);
+    }
+
+    REQUIRE(std::string(data.get(), 11) == "Hello world");
+  }
+
+  SECTION("Invalid files") {
+    DatFile datFile;
+    REQUIRE(datFile.Read("DatFileTest-missing.dat") == false);
+    REQUIRE(datFile.Read("DatFileTest1.txt") == false);
+    REQUIRE(datFile.ContainsFile("DatFileTest1.txt") == false);
+  }
+
+  for (auto &file : files) std::remove(file.c_str());
+  std::remove("DatFileTest.dat");
+}
+
+TEST_CASE("DatFile - Benchmarks", "[game-engine]") {
+  const std::size_t filesCount = 2000;
+  std::vector<gd::String> files;
+  for (std::size_t i = 0; i < filesCount; ++i) {
+    files.push_back("DatFileBenchmark" + gd::String::From(i) + ".png");
+    WriteFile(files.back(), std::string(1000 + i * 10, 'a' + i % 26));
+  }
+
+  DatFile writer;
+  REQUIRE(writer.Create(files, ".", "DatFileBenchmark.dat") == true);
+
+  auto start = std::chrono::steady_clock::now();
+  DatFile datFile;
+  datFile.Read("DatFileBenchmark.dat");
+  std::size_t total = 0;
+  for (auto &file : files) {
+    const char *data = datFile.GetFileData(file);
+    total += data[datFile.GetFileSize(file) - 1];
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::cout << "Loading " << filesCount << " files from a DAT file benchmark: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                     start)
+                   .count()
+            << " microseconds" << std::endl;
+
+  REQUIRE(total > 0);
+
+  for (auto &file : files) std::remove(file.c_str());
+  std::remove("DatFileBenchmark.dat");
+}
@@ -0,0 +1,138 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the cache of textures of the image manager.
+ */
+#include "GDCpp/Runtime/ImageManager.h"
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <vector>
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+#include "ResourcesHelpers.h"
+#include "catch.hpp"
+
+TEST_CASE("ImageManager", "[game-engine]") {
+  sf::Image image;
+  image.create(8, 4, sf::Color::Red);
+  image.saveToFile("ImageManagerTest.png");
+  const std::size_t imageBytes = 8 * 4 * 4 * 2;  // Image and texture.
+
+  gd::ResourcesManager resourcesManager;
+  UnserializeImageResources(
+      resourcesManager, {"Image1", "Image2", "Image3"}, "ImageManagerTest.png");
+  gd::ImageManager imageManager;
+  imageManager.SetResourcesManager(&resourcesManager);
+  const gd::TextureCacheStats& stats = imageManager.GetTextureCacheStats();
+
+  SECTION("Unused textures stay loaded") {
+    std::shared_ptr<SFMLTextureWrapper> texture =
+        imageManager.GetSFMLTexture("Image1");
+    texture.reset();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+
+    texture = imageManager.GetSFMLTexture("Image1");
+    REQUIRE(texture->image.getSize().x == 8);
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.texturesCount == 1);
+    REQUIRE(stats.residentBytes == imageBytes);
+
+    imageManager.ResetTextureCacheStats();
+    REQUIRE(stats.hits == 0);
+    REQUIRE(stats.misses == 0);
+    REQUIRE(stats.residentBytes == imageBytes);
+  }
+
+  SECTION("Least recently used textures are unloaded") {
+    imageManager.SetTextureCacheBudget(imageBytes * 2);
+    imageManager.GetSFMLTexture("Image1");
+    imageManager.GetSFMLTexture("Image2");
+    imageManager.GetSFMLTexture("Image1");
+    imageManager.GetSFMLTexture("Image3");
+
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image2") == false);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image3") == true);
+    REQUIRE(stats.evictions == 1);
+    REQUIRE(stats.texturesCount == 2);
+    REQUIRE(stats.residentBytes == imageBytes * 2);
+
+    imageManager.SetTextureCacheBudget(0);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == false);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image3") == false);
+    REQUIRE(stats.evictions == 3);
+    REQUIRE(stats.residentBytes == 0);
+  }
+
+  SECTION("Used textures are not unloaded") {
+    imageManager.SetTextureCacheBudget(0);
+    std::shared_ptr<SFMLTextureWrapper> texture =
+        imageManager.GetSFMLTexture("Image1");
+    imageManager.GetSFMLTexture("Image2");
+    imageManager.TrimTextureCache();
+
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image2") == false);
+    REQUIRE(stats.residentBytes == imageBytes);
+
+    texture.reset();
+    imageManager.TrimTextureCache();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == false);
+  }
+
+  SECTION("Pinned textures are not unloaded") {
+    imageManager.SetTextureCacheBudget(0);
+    imageManager.PinSFMLTexture("Image1");
+    imageManager.PinSFMLTexture("Image1");
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+    REQUIRE(stats.misses == 1);
+
+    imageManager.UnpinSFMLTexture("Image1");
+    imageManager.TrimTextureCache();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+
+    imageManager.UnpinSFMLTexture("Image1");
+    imageManager.TrimTextureCache();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == false);
+  }
+
+  SECTION("Images in an atlas share its texture") {
+    UnserializeImageResources(resourcesManager, {"Image4", "Image5"}, "");
+    dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("Image4"))
+        .SetAtlas("ImageManagerTest.png", 0, 0, 4, 2);
+    dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("Image5"))
+        .SetAtlas("ImageManagerTest.png", 4, 2, 4, 2);
+
+    std::shared_ptr<SFMLTextureWrapper> texture4 =
+        imageManager.GetSFMLTexture("Image4");
+    std::shared_ptr<SFMLTextureWrapper> texture5 =
+        imageManager.GetSFMLTexture("Image5");
+    REQUIRE(texture4->atlas != nullptr);
+    REQUIRE(texture4->atlas == texture5->atlas);
+    REQUIRE(&texture4->GetDrawableTexture() == &texture5->GetDrawableTexture());
+    REQUIRE(texture4->image.getSize().x == 4);
+    REQUIRE(texture4->image.getSize().y == 2);
+    REQUIRE(texture5->GetDrawableTextureRect() == sf::IntRect(4, 2, 4, 2));
+
+    // The atlas is counted once, and the images only for their own image.
+    const std::size_t atlasImageBytes = 4 * 2 * 4;
+    REQUIRE(stats.residentBytes == imageBytes + atlasImageBytes * 2);
+
+    // The atlas is unloaded with the images it contains.
+    std::weak_ptr<SFMLTextureWrapper> atlas = texture4->atlas;
+    texture4.reset();
+    imageManager.SetTextureCacheBudget(0);
+    REQUIRE(atlas.expired() == false);
+    REQUIRE(stats.residentBytes == imageBytes + atlasImageBytes);
+
+    texture5.reset();
+    imageManager.TrimTextureCache();
+    REQUIRE(atlas.expired() == true);
+    REQUIRE(stats.residentBytes == 0);
+  }
+
+  std::remove("ImageManagerTest.png");
+}
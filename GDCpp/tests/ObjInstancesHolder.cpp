@@ -62,4 +62,93 @@ TEST_CASE("ObjInstancesHolder", "[common]") {
     REQUIRE(container.GetObjects("2").size() == 3);
     REQUIRE(container.GetObjectsRawPointers("2").size() == 3);
   }
+
+  SECTION("Object names identifiers") {
+    gd::Object obj1("1");
+    gd::Object obj2("2");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    std::size_t id1 = ObjInstancesHolder::GetObjectNameId("1");
+    std::size_t id2 = ObjInstancesHolder::GetObjectNameId("2");
+    REQUIRE(id1 != id2);
+    REQUIRE(ObjInstancesHolder::GetObjectNameId("1") == id1);
+    REQUIRE(ObjInstancesHolder::GetObjectNamesCount() > id1);
+    REQUIRE(ObjInstancesHolder::GetObjectNamesCount() > id2);
+
+    ObjInstancesHolder container;
+    REQUIRE(container.GetObjects(id1).size() == 0);
+    REQUIRE(container.GetObjectsRawPointers(id2).size() == 0);
+
+    RuntimeObject* obj1APtr = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+    REQUIRE(container.GetObjects(id1).size() == 1);
+    REQUIRE(container.GetObjectsRawPointers(id2).size() == 2);
+
+    // Lists can be filled again without being reallocated.
+    RuntimeObjNonOwningPtrList allObjects;
+    container.GetAllObjects(allObjects);
+    REQUIRE(allObjects.size() == 3);
+    container.GetAllObjects(allObjects);
+    REQUIRE(allObjects.size() == 3);
+
+    std::size_t count = 0;
+    container.ForEachObject([&count](RuntimeObject* object) { count++; });
+    REQUIRE(count == 3);
+
+    container.RemoveObject(obj1APtr);
+    REQUIRE(container.GetObjects(id1).size() == 0);
+    REQUIRE(container.GetObjectsRawPointers("2").size() == 2);
+
+    container.RemoveObjects(id2);
+    REQUIRE(container.GetAllObjects().size() == 0);
+  }
+
+  SECTION("Deleting objects") {
+    gd::Object obj1("1");
+    gd::Object obj2("2");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    ObjInstancesHolder& container = scene.objectsInstances;
+
+    std::vector<RuntimeObject*> objects1;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      objects1.push_back(container.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1))));
+    }
+    RuntimeObject* obj2APtr = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+
+    // Delete one object out of two
+    for (std::size_t i = 0; i < objects1.size(); i += 2)
+      objects1[i]->DeleteFromScene(scene);
+    obj2APtr->DeleteFromScene(scene);
+
+    REQUIRE(container.GetObjectsToBeDeleted().size() == 501);
+    REQUIRE(container.GetObjectsToBeDeleted()[0] == objects1[0]);
+    REQUIRE(container.GetObjectsToBeDeleted()[500] == obj2APtr);
+    REQUIRE(container.GetObjects("2").size() == 0);
+
+    // Remaining objects are kept in the same order.
+    std::vector<RuntimeObject*> remainingObjects1 =
+        container.GetObjectsRawPointers("1");
+    REQUIRE(remainingObjects1.size() == 500);
+    for (std::size_t i = 0; i < remainingObjects1.size(); ++i)
+      REQUIRE(remainingObjects1[i] == objects1[i * 2 + 1]);
+
+    // Objects can still be deleted after the list was compacted.
+    remainingObjects1[0]->DeleteFromScene(scene);
+    REQUIRE(container.GetObjects("1").size() == 499);
+    REQUIRE(container.GetObjects("1")[0].get() == objects1[3]);
+
+    container.DestroyObjectsToBeDeleted();
+    REQUIRE(container.GetObjectsToBeDeleted().size() == 0);
+    REQUIRE(container.GetAllObjects().size() == 499);
+  }
 }
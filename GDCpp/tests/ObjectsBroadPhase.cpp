@@ -0,0 +1,262 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the broad-phase used by conditions on pairs of objects.
+ */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Extensions/Builtin/ObjectTools.h"
+#include "GDCpp/Extensions/Builtin/RuntimeSceneTools.h"
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include "GDCpp/Runtime/Project/Variable.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+class SizedRuntimeObject : public RuntimeObject {
+ public:
+  SizedRuntimeObject(RuntimeScene& scene,
+                     const gd::Object& object,
+                     float width_,
+                     float height_)
+      : RuntimeObject(scene, object), width(width_), height(height_){};
+
+  virtual float GetWidth() const { return width; };
+  virtual float GetHeight() const { return height; };
+
+ private:
+  float width;
+  float height;
+};
+
+void CreateObjects(RuntimeScene& scene,
+                   const gd::Object& object,
+                   std::size_t count,
+                   float areaSize,
+                   std::mt19937& generator,
+                   std::vector<std::unique_ptr<RuntimeObject>>& owner,
+                   std::vector<RuntimeObject*>& list) {
+  std::uniform_real_distribution<float> position(0, areaSize);
+  std::uniform_real_distribution<float> size(4, 32);
+  for (std::size_t i = 0; i < count; ++i) {
+    owner.push_back(gd::make_unique<SizedRuntimeObject>(
+        scene, object, size(generator), size(generator)));
+    owner.back()->SetX(position(generator));
+    owner.back()->SetY(position(generator));
+    list.push_back(owner.back().get());
+  }
+}
+}
+
+TEST_CASE("ObjectsBroadPhase", "[game-engine]") {
+  SECTION("Query") {
+    ObjectsBroadPhase broadPhase;
+    broadPhase.Add(sf::FloatRect(0, 0, 10, 10));
+    broadPhase.Add(sf::FloatRect(100, 100, 10, 10));
+    broadPhase.Add(sf::FloatRect(5, 5, 200, 200));
+    broadPhase.Add(sf::FloatRect(-50, -50, 10, 10));
+    broadPhase.Build();
+    REQUIRE(broadPhase.GetItemsCount() == 4);
+
+    auto query = [&broadPhase](const sf::FloatRect& rect) {
+      std::vector<std::size_t> items;
+      broadPhase.Query(rect,
+                       [&items](std::size_t item) { items.push_back(item); });
+      std::sort(items.begin(), items.end());
+      return items;
+    };
+
+    REQUIRE(query(sf::FloatRect(1, 1, 2, 2)) ==
+            std::vector<std::size_t>({0}));
+    REQUIRE(query(sf::FloatRect(8, 8, 2, 2)) ==
+            std::vector<std::size_t>({0, 2}));
+    REQUIRE(query(sf::FloatRect(110, 110, 1, 1)) ==
+            std::vector<std::size_t>({1, 2}));
+    REQUIRE(query(sf::FloatRect(-45, -45, 1, 1)) ==
+            std::vector<std::size_t>({3}));
+    REQUIRE(query(sf::FloatRect(-1000, -1000, 3000, 3000)) ==
+            std::vector<std::size_t>({0, 1, 2, 3}));
+    REQUIRE(query(sf::FloatRect(500, 500, 1, 1)).empty());
+
+    // Touching bounds are reported.
+    REQUIRE(query(sf::FloatRect(-40, -40, 1, 1)) ==
+            std::vector<std::size_t>({3}));
+
+    broadPhase.Reset();
+    broadPhase.Build();
+    REQUIRE(query(sf::FloatRect(1, 1, 2, 2)).empty());
+  }
+  SECTION("Same results as testing all pairs") {
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    gd::Object bullet("Bullet");
+    gd::Object enemy("Enemy");
+    gd::String bulletName = "Bullet";
+    gd::String enemyName = "Enemy";
+    std::mt19937 generator(42);
+    std::vector<std::unique_ptr<RuntimeObject>> objects;
+    std::vector<RuntimeObject*> allBullets;
+    std::vector<RuntimeObject*> allEnemies;
+    CreateObjects(scene, bullet, 300, 800, generator, objects, allBullets);
+    CreateObjects(scene, enemy, 60, 800, generator, objects, allEnemies);
+
+    for (bool inverted : {false, true}) {
+      std::vector<RuntimeObject*> bullets1 = allBullets, enemies1 = allEnemies;
+      std::vector<RuntimeObject*> bullets2 = allBullets, enemies2 = allEnemies;
+      RuntimeObjectsLists::List bulletsLists1[] = {{&bulletName, &bullets1}};
+      RuntimeObjectsLists::List enemiesLists1[] = {{&enemyName, &enemies1}};
+      RuntimeObjectsLists::List bulletsLists2[] = {{&bulletName, &bullets2}};
+      RuntimeObjectsLists::List enemiesLists2[] = {{&enemyName, &enemies2}};
+
+      REQUIRE(HitBoxesCollision(
+                  bulletsLists1, enemiesLists1, inverted, scene) ==
+              TwoObjectListsTest(bulletsLists2,
+                                 enemiesLists2,
+                                 inverted,
+                                 [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                                   return obj1->IsCollidingWith(obj2);
+                                 }));
+      REQUIRE(bullets1 == bullets2);
+      REQUIRE(enemies1 == enemies2);
+
+      bullets1 = bullets2 = allBullets;
+      enemies1 = enemies2 = allEnemies;
+      REQUIRE(DistanceBetweenObjects(
+                  bulletsLists1, enemiesLists1, 25, inverted, scene) ==
+              TwoObjectListsTest(bulletsLists2,
+                                 enemiesLists2,
+                                 inverted,
+                                 [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                                   float x = obj1->GetDrawableX() +
+                                             obj1->GetCenterX() -
+                                             (obj2->GetDrawableX() +
+                                              obj2->GetCenterX());
+                                   float y = obj1->GetDrawableY() +
+                                             obj1->GetCenterY() -
+                                             (obj2->GetDrawableY() +
+                                              obj2->GetCenterY());
+                                   return x * x + y * y <= 25 * 25;
+                                 }));
+      REQUIRE(bullets1 == bullets2);
+      REQUIRE(enemies1 == enemies2);
+    }
+
+    SECTION("Objects tested against themselves") {
+      std::vector<RuntimeObject*> bullets1 = allBullets;
+      std::vector<RuntimeObject*> bullets2 = allBullets;
+      RuntimeObjectsLists::List bulletsLists1[] = {{&bulletName, &bullets1}};
+      RuntimeObjectsLists::List bulletsLists2[] = {{&bulletName, &bullets2}};
+
+      REQUIRE(HitBoxesCollision(bulletsLists1, bulletsLists1, false, scene) ==
+              TwoObjectListsTest(bulletsLists2,
+                                 bulletsLists2,
+                                 false,
+                                 [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                                   return obj1->IsCollidingWith(obj2);
+                                 }));
+      REQUIRE(bullets1 == bullets2);
+    }
+
+    SECTION("Raycasts") {
+      std::uniform_real_distribution<float> position(-100, 900);
+      for (std::size_t i = 0; i < 50; ++i) {
+        float x = position(generator), y = position(generator);
+        float endX = position(generator), endY = position(generator);
+        for (bool inverted : {false, true}) {
+          // Expected result, found by testing all the objects.
+          RuntimeObject* expectedObject = NULL;
+          float testSqDist =
+              inverted ? 0 : (endX - x) * (endX - x) + (endY - y) * (endY - y);
+          for (RuntimeObject* object : allBullets) {
+            RaycastResult result =
+                object->RaycastTest(x, y, endX, endY, !inverted);
+            if (!result.collision) continue;
+            float sqDist = inverted ? result.farSqDist : result.closeSqDist;
+            if (inverted ? sqDist >= testSqDist : sqDist <= testSqDist) {
+              testSqDist = sqDist;
+              expectedObject = object;
+            }
+          }
+
+          std::vector<RuntimeObject*> bullets = allBullets;
+          RuntimeObjectsLists::List bulletsLists[] = {{&bulletName, &bullets}};
+          gd::Variable varX, varY;
+          REQUIRE(RaycastObjectToPosition(bulletsLists,
+                                          x,
+                                          y,
+                                          endX,
+                                          endY,
+                                          varX,
+                                          varY,
+                                          inverted) == (expectedObject != NULL));
+          if (expectedObject) {
+            REQUIRE(bullets.size() == 1);
+            REQUIRE(bullets[0] == expectedObject);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("ObjectsBroadPhase - Benchmarks", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object bullet("Bullet");
+  gd::Object enemy("Enemy");
+  gd::String bulletName = "Bullet";
+  gd::String enemyName = "Enemy";
+
+  // Objects are spread so that the density stays the same whatever the
+  // number of objects.
+  auto benchmark = [&](std::size_t objectsCount, bool withBroadPhase) {
+    std::mt19937 generator(42);
+    std::vector<std::unique_ptr<RuntimeObject>> objects;
+    std::vector<RuntimeObject*> bullets;
+    std::vector<RuntimeObject*> enemies;
+    float areaSize = 40 * sqrt(objectsCount);
+    CreateObjects(
+        scene, bullet, objectsCount * 5 / 6, areaSize, generator, objects, bullets);
+    CreateObjects(
+        scene, enemy, objectsCount / 6, areaSize, generator, objects, enemies);
+
+    RuntimeObjectsLists::List bulletsLists[] = {{&bulletName, &bullets}};
+    RuntimeObjectsLists::List enemiesLists[] = {{&enemyName, &enemies}};
+
+    auto start = std::chrono::steady_clock::now();
+    if (withBroadPhase)
+      HitBoxesCollision(bulletsLists, enemiesLists, false, scene);
+    else
+      TwoObjectListsTest(bulletsLists,
+                         enemiesLists,
+                         false,
+                         [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                           return obj1->IsCollidingWith(obj2);
+                         });
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Collisions between " << objectsCount << " objects "
+              << (withBroadPhase ? "with" : "without")
+              << " broad-phase benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  for (std::size_t objectsCount : {120, 1200, 3000}) {
+    benchmark(objectsCount, false);
+    benchmark(objectsCount, true);
+  }
+  benchmark(10000, true);
+}
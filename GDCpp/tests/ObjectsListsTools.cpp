@@ -31,10 +31,28 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
   RuntimeObject obj2A(scene, obj2);
   RuntimeObject obj2B(scene, obj2);
   RuntimeObject obj2C(scene, obj2);
+
+  gd::String name1 = "1";
+  gd::String name2 = "2";
+  SECTION("RuntimeObjectsLists") {
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    std::vector<RuntimeObject*> list2 = {&obj2A};
+    RuntimeObjectsLists::List lists[] = {{&name1, &list1}, {&name2, &list2}};
+    RuntimeObjectsLists map(lists);
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.Get("1") == &list1);
+    REQUIRE(map.Get("2") == &list2);
+    REQUIRE(map.Get("3") == nullptr);
+
+    PickOnly(map, &obj1B);
+    REQUIRE(list1.size() == 1);
+    REQUIRE(list1[0] == &obj1B);
+    REQUIRE(list2.empty());
+  }
   SECTION("PickObjectsIf") {
-    std::map<gd::String, std::vector<RuntimeObject*>*> map;
     std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-    map["1"] = &list1;
+    RuntimeObjectsLists::List map[] = {{&name1, &list1}};
 
     REQUIRE(PickObjectsIf(map, false, [](RuntimeObject*) { return true; }) ==
             true);
@@ -60,12 +78,14 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1[0] == &obj1A);
   }
   SECTION("TwoObjectListsTest") {
-    std::map<gd::String, std::vector<RuntimeObject*>*> map1;
-    std::map<gd::String, std::vector<RuntimeObject*>*> map2;
     std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
     std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B, &obj2C};
-    map1["1"] = &list1;
-    map2["2"] = &list2;
+    RuntimeObjectsLists::List lists1[] = {{&name1, &list1}};
+    RuntimeObjectsLists::List lists2[] = {{&name2, &list2}};
+
+    // Use the memory of the scene to mark the picked objects.
+    RuntimeObjectsLists map1(lists1, &scene.GetObjectsPickingScratch());
+    RuntimeObjectsLists map2(lists2, &scene.GetObjectsPickingScratch());
 
     REQUIRE(TwoObjectListsTest(
                 map1, map2, false, [](RuntimeObject*, RuntimeObject*) {
@@ -101,10 +121,26 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1[0] == &obj1A);
     REQUIRE(list2[0] == &obj2C);
   }
+  SECTION("TwoObjectListsTest with the same list twice") {
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    RuntimeObjectsLists::List map[] = {{&name1, &list1}};
+
+    REQUIRE(TwoObjectListsTest(
+                map,
+                map,
+                false,
+                [&obj1A, &obj1C](RuntimeObject* obj1, RuntimeObject* obj2) {
+                  REQUIRE(obj1 != obj2);
+                  return (obj1 == &obj1A && obj2 == &obj1C) ||
+                         (obj1 == &obj1C && obj2 == &obj1A);
+                }) == true);
+    REQUIRE(list1.size() == 2);
+    REQUIRE(list1[0] == &obj1A);
+    REQUIRE(list1[1] == &obj1C);
+  }
   SECTION("PickNearestObject") {
-    std::map<gd::String, std::vector<RuntimeObject*>*> map;
     std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-    map["1"] = &list1;
+    RuntimeObjectsLists::List map[] = {{&name1, &list1}};
     obj1A.SetX(50);
     obj1A.SetY(50);
     obj1B.SetX(160);
@@ -117,9 +153,8 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1[0] == &obj1A);
 
     SECTION("Furthest") {
-      std::map<gd::String, std::vector<RuntimeObject*>*> map;
       std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-      map["1"] = &list1;
+      RuntimeObjectsLists::List map[] = {{&name1, &list1}};
 
       REQUIRE(PickNearestObject(map, 100, 90, true) == true);
       REQUIRE(list1.size() == 1);
@@ -0,0 +1,214 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the collision tests between polygons.
+ */
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "catch.hpp"
+
+namespace {
+Polygon2d CreateRegularPolygon(std::size_t verticesCount,
+                               float radius,
+                               float angle,
+                               float x,
+                               float y) {
+  Polygon2d polygon;
+  for (std::size_t i = 0; i < verticesCount; ++i) {
+    float vertexAngle = angle + 2 * 3.14159f * i / verticesCount;
+    polygon.vertices.push_back(sf::Vector2f(x + radius * cos(vertexAngle),
+                                            y + radius * sin(vertexAngle)));
+  }
+  polygon.ComputeEdges();
+
+  return polygon;
+}
+
+Polygon2d CreateRandomPolygon(std::mt19937& generator, float areaSize) {
+  std::uniform_real_distribution<float> position(0, areaSize);
+  std::uniform_real_distribution<float> size(2, 40);
+  std::uniform_real_distribution<float> angle(0, 6.28f);
+  std::uniform_int_distribution<int> verticesCount(3, 10);
+
+  if (generator() % 2 == 0) {
+    Polygon2d rectangle =
+        Polygon2d::CreateRectangle(size(generator), size(generator));
+    rectangle.Rotate(angle(generator));
+    rectangle.Move(position(generator), position(generator));
+    return rectangle;
+  }
+
+  return CreateRegularPolygon(verticesCount(generator),
+                              size(generator),
+                              angle(generator),
+                              position(generator),
+                              position(generator));
+}
+}
+
+TEST_CASE("PolygonCollision", "[game-engine]") {
+  SECTION("Batch test gives the same results as testing each pair") {
+    std::mt19937 generator(42);
+    PolygonsBatch polygonBatch;
+    for (bool ignoreTouchingEdges : {false, true}) {
+      for (std::size_t i = 0; i < 50; ++i) {
+        Polygon2d polygon = CreateRandomPolygon(generator, 100);
+        std::vector<Polygon2d> candidates;
+        PolygonsBatch batch;
+        for (std::size_t j = 0; j < 50; ++j) {
+          candidates.push_back(CreateRandomPolygon(generator, 100));
+          REQUIRE(batch.Add(candidates.back()) == j);
+        }
+
+        std::vector<CollisionResult> results;
+        PolygonCollisionBatchTest(
+            polygon, batch, ignoreTouchingEdges, results, polygonBatch);
+        REQUIRE(results.size() == candidates.size());
+        for (std::size_t j = 0; j < candidates.size(); ++j) {
+          CollisionResult expected = PolygonCollisionTest(
+              polygon, candidates[j], ignoreTouchingEdges);
+          REQUIRE(results[j].collision == expected.collision);
+          REQUIRE(results[j].move_axis.x == Approx(expected.move_axis.x));
+          REQUIRE(results[j].move_axis.y == Approx(expected.move_axis.y));
+        }
+      }
+    }
+  }
+  SECTION("Polygons without edges") {
+    // Edges of created rectangles are not computed.
+    Polygon2d polygon = Polygon2d::CreateRectangle(10, 10);
+    Polygon2d other = Polygon2d::CreateRectangle(10, 10);
+    REQUIRE(PolygonCollisionTest(polygon, other).collision == true);
+
+    Polygon2d farPolygon = Polygon2d::CreateRectangle(10, 10);
+    for (sf::Vector2f& vertex : farPolygon.vertices) vertex.x += 20;
+    REQUIRE(PolygonCollisionTest(polygon, farPolygon).collision == false);
+
+    Polygon2d raycasted = Polygon2d::CreateRectangle(10, 10);
+    RaycastResult result = PolygonRaycastTest(raycasted, -20, 0, 20, 0);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.closePoint.x == Approx(-5));
+    REQUIRE(result.farPoint.x == Approx(5));
+  }
+  SECTION("Rotated polygons") {
+    // The edges are updated by Rotate, so that the axes of the rotated
+    // polygon are used.
+    Polygon2d diamond = Polygon2d::CreateRectangle(10, 10);
+    diamond.Move(0, 0);
+    diamond.Rotate(3.14159f / 4);
+    Polygon2d corner = Polygon2d::CreateRectangle(10, 10);
+    corner.Move(11, 11);
+    REQUIRE(PolygonCollisionTest(diamond, corner).collision == false);
+    REQUIRE(PolygonCollisionTest(corner, diamond).collision == false);
+
+    corner.Move(-3, -3);
+    REQUIRE(PolygonCollisionTest(diamond, corner).collision == true);
+  }
+  SECTION("Touching edges") {
+    Polygon2d polygon = Polygon2d::CreateRectangle(10, 10);
+    Polygon2d touching = Polygon2d::CreateRectangle(10, 10);
+    touching.Move(10, 0);
+    polygon.ComputeEdges();
+
+    PolygonsBatch batch;
+    batch.Add(touching);
+    std::vector<CollisionResult> results;
+    PolygonsBatch polygonBatch;
+    PolygonCollisionBatchTest(polygon, batch, false, results, polygonBatch);
+    REQUIRE(results[0].collision == true);
+    PolygonCollisionBatchTest(polygon, batch, true, results, polygonBatch);
+    REQUIRE(results[0].collision == false);
+  }
+  SECTION("Invalid polygons") {
+    Polygon2d polygon = Polygon2d::CreateRectangle(10, 10);
+    Polygon2d line;
+    line.vertices.push_back(sf::Vector2f(0, 0));
+    line.vertices.push_back(sf::Vector2f(1, 1));
+
+    PolygonsBatch batch;
+    batch.Add(line);
+    batch.Add(Polygon2d());
+    batch.Add(polygon);
+    std::vector<CollisionResult> results;
+    PolygonsBatch polygonBatch;
+    PolygonCollisionBatchTest(polygon, batch, false, results, polygonBatch);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].collision == false);
+    REQUIRE(results[1].collision == false);
+    REQUIRE(results[2].collision == true);
+
+    PolygonCollisionBatchTest(line, batch, false, results, polygonBatch);
+    REQUIRE(results[2].collision == false);
+
+    batch.Clear();
+    REQUIRE(batch.GetCount() == 0);
+    PolygonCollisionBatchTest(polygon, batch, false, results, polygonBatch);
+    REQUIRE(results.empty());
+  }
+}
+
+TEST_CASE("PolygonCollision - Benchmarks", "[game-engine]") {
+  auto benchmark = [](const char* name, std::size_t verticesCount) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(0, 1000);
+    std::uniform_real_distribution<float> angle(0, 6.28f);
+
+    const std::size_t candidatesCount = 2000;
+    std::vector<Polygon2d> polygons;
+    PolygonsBatch batch;
+    for (std::size_t i = 0; i < candidatesCount; ++i) {
+      polygons.push_back(CreateRegularPolygon(verticesCount,
+                                              20,
+                                              angle(generator),
+                                              position(generator),
+                                              position(generator)));
+      batch.Add(polygons.back());
+    }
+
+    std::size_t collisionsCount = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100; ++i) {
+      for (std::size_t j = 0; j < candidatesCount; ++j) {
+        if (PolygonCollisionTest(polygons[i], polygons[j]).collision)
+          collisionsCount++;
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Collisions between " << name
+              << " one pair at a time benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+
+    std::size_t batchCollisionsCount = 0;
+    std::vector<CollisionResult> results;
+    PolygonsBatch polygonBatch;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100; ++i) {
+      PolygonCollisionBatchTest(
+          polygons[i], batch, false, results, polygonBatch);
+      for (const CollisionResult& result : results) {
+        if (result.collision) batchCollisionsCount++;
+      }
+    }
+    end = std::chrono::steady_clock::now();
+    std::cout << "Collisions between " << name << " in batch benchmark: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+
+    REQUIRE(batchCollisionsCount == collisionsCount);
+  };
+
+  benchmark("rectangles", 4);
+  benchmark("8-gons", 8);
+}
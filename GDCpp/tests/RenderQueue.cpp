@@ -0,0 +1,173 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the render queue used to draw objects of a scene.
+ */
+#include "GDCpp/Runtime/RenderQueue.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+class CullableRuntimeObject : public RuntimeObject {
+ public:
+  CullableRuntimeObject(RuntimeScene& scene,
+                        const gd::Object& object,
+                        float width_,
+                        float height_)
+      : RuntimeObject(scene, object), width(width_), height(height_){};
+
+  virtual float GetWidth() const { return width; };
+  virtual float GetHeight() const { return height; };
+  virtual void SetWidth(float newWidth) {
+    width = newWidth;
+    NotifyBoundsChanged();
+  };
+
+  virtual bool CanBeCulled() const { return true; };
+
+ private:
+  float width;
+  float height;
+};
+}
+
+TEST_CASE("RenderQueue", "[game-engine]") {
+  gd::Object obj("MyObject");
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+
+  RenderQueue renderQueue;
+  renderQueue.SetLayers({"", "Foreground"});
+
+  std::unique_ptr<RuntimeObject> objA(new RuntimeObject(scene, obj));
+  std::unique_ptr<RuntimeObject> objB(new RuntimeObject(scene, obj));
+  std::unique_ptr<RuntimeObject> objC(new RuntimeObject(scene, obj));
+  std::unique_ptr<RuntimeObject> objD(new RuntimeObject(scene, obj));
+  objA->SetZOrder(3);
+  objB->SetZOrder(1);
+  objC->SetZOrder(2);
+  objD->SetLayer("Foreground");
+  renderQueue.AddObject(objA.get());
+  renderQueue.AddObject(objB.get());
+  renderQueue.AddObject(objC.get());
+  renderQueue.AddObject(objD.get());
+  renderQueue.Update();
+
+  SECTION("Objects are sorted by layer and Z order") {
+    REQUIRE(renderQueue.GetLayerObjects(0) ==
+            std::vector<RuntimeObject*>({objB.get(), objC.get(), objA.get()}));
+    REQUIRE(renderQueue.GetLayerObjects(1) ==
+            std::vector<RuntimeObject*>({objD.get()}));
+  }
+  SECTION("Changing Z order or layer") {
+    objA->SetZOrder(0);
+    objC->SetLayer("Foreground");
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetLayerObjects(0) ==
+            std::vector<RuntimeObject*>({objA.get(), objB.get()}));
+    REQUIRE(renderQueue.GetLayerObjects(1) ==
+            std::vector<RuntimeObject*>({objD.get(), objC.get()}));
+
+    // Objects with the same Z order keep the order they were put in.
+    objB->SetZOrder(0);
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetLayerObjects(0) ==
+            std::vector<RuntimeObject*>({objA.get(), objB.get()}));
+
+    // Objects on an unknown layer are not drawn.
+    objB->SetLayer("Unknown layer");
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetLayerObjects(0) ==
+            std::vector<RuntimeObject*>({objA.get()}));
+  }
+  SECTION("Removing objects") {
+    renderQueue.RemoveObject(objC.get());
+    objA.reset();  // Destroyed objects are removed from the queue.
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetLayerObjects(0) ==
+            std::vector<RuntimeObject*>({objB.get()}));
+
+    // Removed objects are not updated anymore.
+    objC->SetZOrder(-1);
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetLayerObjects(0) ==
+            std::vector<RuntimeObject*>({objB.get()}));
+
+    renderQueue.Clear();
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetLayerObjects(0).empty());
+    REQUIRE(renderQueue.GetLayerObjects(1).empty());
+  }
+  SECTION("Culling") {
+    std::unique_ptr<RuntimeObject> nearObj(
+        new CullableRuntimeObject(scene, obj, 10, 10));
+    std::unique_ptr<RuntimeObject> farObj(
+        new CullableRuntimeObject(scene, obj, 10, 10));
+    std::unique_ptr<RuntimeObject> largeObj(
+        new CullableRuntimeObject(scene, obj, 5000, 10));
+    nearObj->SetX(50);
+    nearObj->SetY(50);
+    farObj->SetX(1000);
+    farObj->SetY(1000);
+    largeObj->SetX(-2000);
+    largeObj->SetZOrder(10);
+    renderQueue.AddObject(nearObj.get());
+    renderQueue.AddObject(farObj.get());
+    renderQueue.AddObject(largeObj.get());
+
+    // Objects far away from the view, so that the grid is used.
+    std::vector<std::unique_ptr<RuntimeObject>> otherObjects;
+    for (std::size_t i = 0; i < 20; ++i) {
+      otherObjects.emplace_back(new CullableRuntimeObject(scene, obj, 10, 10));
+      otherObjects.back()->SetX(10000 + i * 20);
+      otherObjects.back()->SetY(10000);
+      renderQueue.AddObject(otherObjects.back().get());
+    }
+    renderQueue.Update();
+
+    // Objects that can't be culled are always visible.
+    std::vector<RuntimeObject*> visibleObjects;
+    sf::FloatRect viewRect(0, 0, 200, 200);
+    REQUIRE(renderQueue.GetVisibleLayerObjects(0, viewRect, visibleObjects) ==
+            21);
+    REQUIRE(visibleObjects ==
+            std::vector<RuntimeObject*>({nearObj.get(),
+                                         objB.get(),
+                                         objC.get(),
+                                         objA.get(),
+                                         largeObj.get()}));
+
+    // Moved or resized objects are culled according to their new AABB.
+    nearObj->SetX(3000);
+    farObj->SetX(100);
+    farObj->SetY(100);
+    renderQueue.Update();
+    renderQueue.GetVisibleLayerObjects(0, viewRect, visibleObjects);
+    REQUIRE(visibleObjects ==
+            std::vector<RuntimeObject*>({farObj.get(),
+                                         objB.get(),
+                                         objC.get(),
+                                         objA.get(),
+                                         largeObj.get()}));
+
+    largeObj->SetWidth(10);
+    renderQueue.Update();
+    REQUIRE(renderQueue.GetVisibleLayerObjects(0, viewRect, visibleObjects) ==
+            22);
+    REQUIRE(visibleObjects ==
+            std::vector<RuntimeObject*>(
+                {farObj.get(), objB.get(), objC.get(), objA.get()}));
+
+    // A view larger than the grid gives the same results.
+    sf::FloatRect largeViewRect(-100000, -100000, 200000, 200000);
+    REQUIRE(renderQueue.GetVisibleLayerObjects(
+                0, largeViewRect, visibleObjects) == 0);
+    REQUIRE(visibleObjects == renderQueue.GetLayerObjects(0));
+  }
+}
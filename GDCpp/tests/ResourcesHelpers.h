@@ -0,0 +1,38 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Helpers used by the tests to set up resources.
+ */
+#ifndef GDCPP_TESTS_RESOURCESHELPERS_H
+#define GDCPP_TESTS_RESOURCESHELPERS_H
+#include <vector>
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/String.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+
+/**
+ * \brief Set the images of the resources manager as a game would, all of them
+ * using the given file (gd::ResourcesManager::AddResource is only available
+ * in the IDE).
+ */
+inline void UnserializeImageResources(gd::ResourcesManager& resourcesManager,
+                                      const std::vector<gd::String>& names,
+                                      const gd::String& file) {
+  gd::SerializerElement element;
+  gd::SerializerElement& resourcesElement = element.AddChild("resources");
+  resourcesElement.ConsiderAsArrayOf("resource");
+  for (const gd::String& name : names) {
+    gd::SerializerElement& resourceElement =
+        resourcesElement.AddChild("resource");
+    resourceElement.SetAttribute("kind", "image");
+    resourceElement.SetAttribute("name", name);
+    resourceElement.SetAttribute("file", file);
+    resourceElement.SetAttribute("smoothed", true);
+  }
+  resourcesManager.UnserializeFrom(element);
+}
+
+#endif  // GDCPP_TESTS_RESOURCESHELPERS_H
@@ -0,0 +1,119 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the preloading of resources in the background.
+ */
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <vector>
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+#include "GDCpp/Runtime/SoundManager.h"
+#include "ResourcesHelpers.h"
+#include "catch.hpp"
+
+TEST_CASE("ResourcesPreloader", "[game-engine]") {
+  sf::Image image;
+  image.create(8, 4, sf::Color::Red);
+  image.saveToFile("ResourcesPreloaderTest.png");
+
+  gd::ResourcesManager resourcesManager;
+  UnserializeImageResources(
+      resourcesManager, {"Image1", "Image2"}, "ResourcesPreloaderTest.png");
+  gd::ImageManager imageManager;
+  imageManager.SetResourcesManager(&resourcesManager);
+  imageManager.SetTextureCacheBudget(0);
+  SoundManager soundManager;
+  ResourcesPreloader preloader(2);
+
+  SECTION("Preload and release") {
+    preloader.Preload("Group",
+                      resourcesManager,
+                      imageManager,
+                      {"Image1", "Image2", "Unknown image"},
+                      {});
+    REQUIRE(preloader.GetRequestedCount() == 2);
+
+    preloader.FinishPreloading(imageManager, soundManager);
+    REQUIRE(preloader.IsDone() == true);
+    REQUIRE(preloader.GetLoadedCount() == 2);
+    REQUIRE(preloader.GetProgress() == 1);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image2") == true);
+    REQUIRE(imageManager.GetSFMLTexture("Image1")->image.getSize().x == 8);
+    REQUIRE(imageManager.GetSFMLTexture("Image1")->texture.getSize().y == 4);
+
+    preloader.Release("Group", imageManager);
+    REQUIRE(preloader.HasGroup("Group") == false);
+    imageManager.TrimTextureCache();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == false);
+  }
+
+  SECTION("Resources in several groups") {
+    preloader.Preload("Group1", resourcesManager, imageManager, {"Image1"}, {});
+    preloader.Preload(
+        "Group2", resourcesManager, imageManager, {"Image1", "Image2"}, {});
+    REQUIRE(preloader.GetRequestedCount() == 2);
+    preloader.FinishPreloading(imageManager, soundManager);
+
+    preloader.Release("Group1", imageManager);
+    imageManager.TrimTextureCache();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == true);
+    preloader.Release("Group2", imageManager);
+    imageManager.TrimTextureCache();
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == false);
+  }
+
+  SECTION("Images already loaded") {
+    auto texture = imageManager.GetSFMLTexture("Image1");
+    preloader.Preload(
+        "Group", resourcesManager, imageManager, {"Image1", "Image2"}, {});
+    REQUIRE(preloader.GetRequestedCount() == 1);
+    preloader.FinishPreloading(imageManager, soundManager);
+    REQUIRE(imageManager.GetSFMLTexture("Image1") == texture);
+  }
+
+  SECTION("Group released before its resources are uploaded") {
+    preloader.Preload("Group", resourcesManager, imageManager, {"Image1"}, {});
+    preloader.Release("Group", imageManager);
+    preloader.FinishPreloading(imageManager, soundManager);
+    REQUIRE(preloader.IsDone() == true);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image1") == false);
+  }
+
+  SECTION("Images in an atlas") {
+    UnserializeImageResources(
+        resourcesManager, {"Image3", "Image4", "Image5"}, "");
+    dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("Image3"))
+        .SetAtlas("ResourcesPreloaderTest.png", 0, 0, 4, 2);
+    dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("Image4"))
+        .SetAtlas("ResourcesPreloaderTest.png", 4, 2, 4, 2);
+    dynamic_cast<gd::ImageResource&>(resourcesManager.GetResource("Image5"))
+        .SetAtlas("ResourcesPreloaderTest.png", 4, 0, 4, 2);
+
+    preloader.Preload(
+        "Group", resourcesManager, imageManager, {"Image3", "Image4"}, {});
+    REQUIRE(preloader.GetRequestedCount() == 2);
+    REQUIRE(imageManager.HasLoadedSFMLTexture("Image3") == false);
+
+    preloader.FinishPreloading(imageManager, soundManager);
+    REQUIRE(preloader.GetLoadedCount() == 2);
+    std::shared_ptr<SFMLTextureWrapper> texture3 =
+        imageManager.GetSFMLTexture("Image3");
+    std::shared_ptr<SFMLTextureWrapper> texture4 =
+        imageManager.GetSFMLTexture("Image4");
+    REQUIRE(texture3->atlas != nullptr);
+    REQUIRE(texture3->atlas == texture4->atlas);
+    REQUIRE(texture4->image.getSize().x == 4);
+    REQUIRE(texture4->GetDrawableTextureRect() == sf::IntRect(4, 2, 4, 2));
+
+    // The other images of the atlas are loaded from the preloaded atlas.
+    REQUIRE(imageManager.GetSFMLTexture("Image5")->atlas == texture3->atlas);
+  }
+
+  std::remove("ResourcesPreloaderTest.png");
+}
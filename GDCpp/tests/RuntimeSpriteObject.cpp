@@ -13,6 +13,7 @@
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
@@ -29,6 +30,9 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     anim.SetName("First animation");
     gd::Sprite sprite;
     sprite.SetImageName("Image.png");
+    sprite.SetCustomCollisionMask(
+        std::vector<Polygon2d>(1, Polygon2d::CreateRectangle(10, 10)));
+    sprite.SetCollisionMaskAutomatic(false);
     anim.SetDirectionsCount(1);
     anim.GetDirection(0).AddSprite(sprite);
     obj1.AddAnimation(anim);
@@ -60,6 +64,37 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     object.SetAngle(42);
     REQUIRE(object.GetAngle() == 42);
   }
+  SECTION("Hitboxes") {
+    REQUIRE(object.GetHitBoxes().size() == 1);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0] == sf::Vector2f(-5, -5));
+    REQUIRE(object.GetHitBoxes()[0].vertices[2] == sf::Vector2f(5, 5));
+
+    // Hitboxes are updated when the object is moved or scaled, with their
+    // edges.
+    object.SetX(100);
+    object.SetScaleX(2);
+    const std::vector<Polygon2d>& hitBoxes = object.GetHitBoxes();
+    REQUIRE(hitBoxes.size() == 1);
+    REQUIRE(hitBoxes[0].vertices[0] == sf::Vector2f(90, -5));
+    REQUIRE(hitBoxes[0].vertices[2] == sf::Vector2f(110, 5));
+    REQUIRE(hitBoxes[0].edges.size() == 4);
+    REQUIRE(hitBoxes[0].edges[0] == sf::Vector2f(20, 0));
+
+    // Hitboxes are not computed again if the object did not change.
+    REQUIRE(&object.GetHitBoxes() == &hitBoxes);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0] == sf::Vector2f(90, -5));
+
+    object.SetY(50);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0] == sf::Vector2f(90, 45));
+
+    // Hitboxes are computed again when the animation changes. There is no
+    // sprite in this animation, so the hitbox falls back to the default
+    // rectangle of an empty image, with all its vertices at the same point.
+    object.SetCurrentAnimation(1);
+    REQUIRE(object.GetHitBoxes().size() == 1);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0] ==
+            object.GetHitBoxes()[0].vertices[2]);
+  }
   SECTION("Animations") {
     REQUIRE(object.GetCurrentAnimation() == 0);
     REQUIRE(object.GetCurrentAnimationName() == "First animation");
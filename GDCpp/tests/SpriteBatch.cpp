@@ -0,0 +1,166 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the drawing of sprites in batches.
+ */
+#include "GDCpp/Runtime/SpriteBatch.h"
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief A batch which records the vertices instead of drawing them.
+ */
+class RecordingSpriteBatch : public SpriteBatch {
+ public:
+  std::vector<std::size_t> drawnVerticesCounts;
+  std::vector<sf::Vertex> lastVertices;
+
+ protected:
+  virtual void DrawVertices(sf::RenderTarget& renderTarget,
+                            const std::vector<sf::Vertex>& vertices,
+                            const sf::RenderStates& states) {
+    drawnVerticesCounts.push_back(vertices.size());
+    lastVertices = vertices;
+  }
+};
+
+class NullRenderTarget : public sf::RenderTarget {
+ public:
+  virtual sf::Vector2u getSize() const { return sf::Vector2u(800, 600); }
+};
+}
+
+TEST_CASE("SpriteBatch", "[game-engine]") {
+  NullRenderTarget renderTarget;
+  sf::Texture texture1;
+  sf::Texture texture2;
+  RecordingSpriteBatch spriteBatch;
+
+  SECTION("Sprites sharing a texture are drawn at once") {
+    sf::Sprite sprite1(texture1, sf::IntRect(0, 0, 8, 8));
+    sf::Sprite sprite2(texture1, sf::IntRect(8, 0, 8, 8));
+    spriteBatch.Draw(renderTarget, sprite1);
+    spriteBatch.Draw(renderTarget, sprite2);
+    spriteBatch.Draw(renderTarget, sprite1);
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 0);
+
+    spriteBatch.Flush(renderTarget);
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 1);
+    REQUIRE(spriteBatch.drawnVerticesCounts.size() == 1);
+    REQUIRE(spriteBatch.drawnVerticesCounts[0] == 18);
+
+    spriteBatch.Flush(renderTarget);
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 1);
+  }
+
+  SECTION("Changing the texture or the blend mode draws the batch") {
+    sf::Sprite sprite1(texture1, sf::IntRect(0, 0, 8, 8));
+    sf::Sprite sprite2(texture2, sf::IntRect(0, 0, 8, 8));
+    spriteBatch.Draw(renderTarget, sprite1);
+    spriteBatch.Draw(renderTarget, sprite2);
+    spriteBatch.Draw(renderTarget, sprite2, sf::BlendAdd);
+    spriteBatch.Draw(renderTarget, sprite2, sf::BlendAdd);
+    spriteBatch.Flush(renderTarget);
+
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 3);
+    REQUIRE(spriteBatch.drawnVerticesCounts[0] == 6);
+    REQUIRE(spriteBatch.drawnVerticesCounts[1] == 6);
+    REQUIRE(spriteBatch.drawnVerticesCounts[2] == 12);
+
+    spriteBatch.ResetDrawCallsCount();
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 0);
+  }
+
+  SECTION("Objects drawn without the batch") {
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    gd::Object object("object");
+    RuntimeObject runtimeObject(scene, object);
+    sf::Sprite sprite(texture1, sf::IntRect(0, 0, 8, 8));
+
+    // Hidden objects are not counted, and don't draw the batch.
+    runtimeObject.SetHidden();
+    spriteBatch.Draw(renderTarget, sprite);
+    runtimeObject.DrawInBatch(renderTarget, spriteBatch);
+    spriteBatch.Draw(renderTarget, sprite);
+    spriteBatch.Flush(renderTarget);
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 1);
+
+    runtimeObject.SetHidden(false);
+    spriteBatch.Draw(renderTarget, sprite);
+    runtimeObject.DrawInBatch(renderTarget, spriteBatch);
+    spriteBatch.Draw(renderTarget, sprite);
+    spriteBatch.Flush(renderTarget);
+    REQUIRE(spriteBatch.GetDrawCallsCount() == 4);
+  }
+
+  SECTION("Vertices are transformed") {
+    sf::Sprite sprite(texture1, sf::IntRect(2, 3, 4, 5));
+    sprite.setPosition(10, 20);
+    sprite.setColor(sf::Color(255, 0, 0));
+    spriteBatch.Draw(renderTarget, sprite);
+    spriteBatch.Flush(renderTarget);
+
+    const std::vector<sf::Vertex>& vertices = spriteBatch.lastVertices;
+    REQUIRE(vertices.size() == 6);
+    REQUIRE(vertices[0].position == sf::Vector2f(10, 20));
+    REQUIRE(vertices[0].texCoords == sf::Vector2f(2, 3));
+    REQUIRE(vertices[5].position == sf::Vector2f(14, 25));
+    REQUIRE(vertices[5].texCoords == sf::Vector2f(6, 8));
+    REQUIRE(vertices[5].color == sf::Color(255, 0, 0));
+  }
+}
+
+TEST_CASE("SpriteBatch - Benchmarks", "[game-engine]") {
+  NullRenderTarget renderTarget;
+
+  // Sprites with their own texture, as when images are not packed, or sharing
+  // the texture of an atlas.
+  auto benchmark = [&](std::size_t spritesCount, bool withAtlas) {
+    std::vector<std::unique_ptr<sf::Texture>> textures;
+    std::vector<sf::Sprite> sprites;
+    for (std::size_t i = 0; i < spritesCount; ++i) {
+      if (!withAtlas || textures.empty())
+        textures.push_back(std::unique_ptr<sf::Texture>(new sf::Texture));
+      sprites.push_back(sf::Sprite(*textures.back(),
+                                   sf::IntRect((i % 32) * 32, 0, 32, 32)));
+      sprites.back().setPosition(i % 800, i % 600);
+    }
+
+    RecordingSpriteBatch spriteBatch;
+    auto start = std::chrono::steady_clock::now();
+    for (const sf::Sprite& sprite : sprites)
+      spriteBatch.Draw(renderTarget, sprite);
+    spriteBatch.Flush(renderTarget);
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Batching " << spritesCount << " sprites "
+              << (withAtlas ? "with" : "without")
+              << " texture atlas benchmark: "
+              << spriteBatch.GetDrawCallsCount() << " draw calls, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start)
+                     .count()
+              << " microseconds" << std::endl;
+
+    if (withAtlas) REQUIRE(spriteBatch.GetDrawCallsCount() == 1);
+    if (!withAtlas)
+      REQUIRE(spriteBatch.GetDrawCallsCount() == spritesCount);
+  };
+
+  for (std::size_t spritesCount : {100, 1000, 10000}) {
+    benchmark(spritesCount, false);
+    benchmark(spritesCount, true);
+  }
+}
@@ -117,6 +117,7 @@ gd::String ExporterHelper::ExportToJSON(gd::AbstractFileSystem &fs,
 
   // Save the project to JSON
   gd::SerializerElement rootElement;
+  rootElement.AllocateChildrenInArena();
   project.SerializeTo(rootElement);
 
   gd::String output = gd::Serializer::ToJSON(rootElement);